@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+/*
+ * Packed bitfield codec versus the shift-and-mask codec (*Bytes functions)
+ * for the messages with the most bitfields and multi-byte fields, and the
+ * fixed-point Location decoder. The other message types are benchmarked in
+ * bench_message.cpp.
+ */
+
+static void initLocation(ODID_Location_data *location)
+{
+    odid_initLocationData(location);
+    location->Status = ODID_STATUS_AIRBORNE;
+    location->Direction = 215;
+    location->SpeedHorizontal = 70;
+    location->SpeedVertical = -2.5f;
+    location->Latitude = 51.4791;
+    location->Longitude = -0.0013;
+    location->AltitudeBaro = 100;
+    location->AltitudeGeo = 110;
+    location->HeightType = ODID_HEIGHT_REF_OVER_GROUND;
+    location->Height = 80;
+    location->HorizAccuracy = ODID_HOR_ACC_10_METER;
+    location->VertAccuracy = ODID_VER_ACC_3_METER;
+    location->BaroAccuracy = ODID_VER_ACC_1_METER;
+    location->SpeedAccuracy = ODID_SPEED_ACC_1_METERS_PER_SECOND;
+    location->TSAccuracy = ODID_TIME_ACC_0_2_SECOND;
+    location->TimeStamp = 1234.5f;
+}
+
+static void initSystem(ODID_System_data *system)
+{
+    odid_initSystemData(system);
+    system->OperatorLocationType = ODID_OPERATOR_LOCATION_TYPE_LIVE_GNSS;
+    system->ClassificationType = ODID_CLASSIFICATION_TYPE_EU;
+    system->OperatorLatitude = 51.48;
+    system->OperatorLongitude = -0.002;
+    system->AreaCount = 1;
+    system->AreaRadius = 100;
+    system->AreaCeiling = 120;
+    system->AreaFloor = 0;
+    system->CategoryEU = ODID_CATEGORY_EU_OPEN;
+    system->ClassEU = ODID_CLASS_EU_CLASS_1;
+    system->OperatorAltitudeGeo = 20.5f;
+    system->Timestamp = 28000000;
+}
+
+template <int (*Encode)(ODID_Location_encoded *, const ODID_Location_data *)>
+static void BM_encodeLocation(benchmark::State &state)
+{
+    ODID_Location_data location;
+    initLocation(&location);
+    ODID_Location_encoded encoded;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Encode(&encoded, &location));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_encodeLocation, encodeLocationMessage);
+BENCHMARK_TEMPLATE(BM_encodeLocation, encodeLocationMessageBytes);
+
+template <int (*Decode)(ODID_Location_data *, const ODID_Location_encoded *)>
+static void BM_decodeLocation(benchmark::State &state)
+{
+    ODID_Location_data location;
+    initLocation(&location);
+    ODID_Location_encoded encoded;
+    encodeLocationMessage(&encoded, &location);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Decode(&location, &encoded));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_decodeLocation, decodeLocationMessage);
+BENCHMARK_TEMPLATE(BM_decodeLocation, decodeLocationMessageBytes);
+
+static void BM_decodeLocationFixed(benchmark::State &state)
+{
+    ODID_Location_data location;
+    initLocation(&location);
+    ODID_Location_encoded encoded;
+    encodeLocationMessage(&encoded, &location);
+    ODID_Location_fixed fixed;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decodeLocationMessageFixed(&fixed, &encoded));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_decodeLocationFixed);
+
+template <int (*Encode)(ODID_System_encoded *, const ODID_System_data *)>
+static void BM_encodeSystem(benchmark::State &state)
+{
+    ODID_System_data system;
+    initSystem(&system);
+    ODID_System_encoded encoded;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Encode(&encoded, &system));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_encodeSystem, encodeSystemMessage);
+BENCHMARK_TEMPLATE(BM_encodeSystem, encodeSystemMessageBytes);
+
+template <int (*Decode)(ODID_System_data *, const ODID_System_encoded *)>
+static void BM_decodeSystem(benchmark::State &state)
+{
+    ODID_System_data system;
+    initSystem(&system);
+    ODID_System_encoded encoded;
+    encodeSystemMessage(&encoded, &system);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Decode(&system, &encoded));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_decodeSystem, decodeSystemMessage);
+BENCHMARK_TEMPLATE(BM_decodeSystem, decodeSystemMessageBytes);
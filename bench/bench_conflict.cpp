@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Conflict detection for 1k to 100k UAS at a constant traffic density of one
+ * UAS per 500 by 500 m, flying at up to 20 m/s, each reporting its Location
+ * in turn: the detector versus comparing each update with all other UAS. The
+ * time per update of the detector does not depend on the number of UAS, so
+ * that a full round of updates scales linearly.
+ */
+
+static const double AREA_LATITUDE = 45;
+static const double AREA_LONGITUDE = 5;
+static const double METERS_PER_DEGREE = 6371008.8 * M_PI / 180;
+static const double SPACING = 500;
+static const size_t UPDATE_COUNT = 4096;
+
+struct ConflictFixture {
+    std::vector<ODID_Conflict_state> states;
+    std::vector<ODID_Spatial_entry> entries;
+    std::vector<uint32_t> buckets;
+    std::vector<uint32_t> candidates;
+    std::vector<ODID_Location_data> locations;
+    std::vector<uint32_t> order;
+    ODID_Spatial_index index;
+    ODID_Conflict_detector detector;
+    ODID_Conflict out[64];
+
+    explicit ConflictFixture(uint32_t count)
+        : states(count), entries(count), candidates(count), locations(count), order(UPDATE_COUNT)
+    {
+        uint32_t bucketCount = 1;
+        while (bucketCount < count)
+            bucketCount <<= 1;
+        buckets.resize(bucketCount);
+        odid_spatial_init(&index, entries.data(), count, buckets.data(), bucketCount, 0.01);
+        detector.Horizontal = 50;
+        detector.Vertical = 15;
+        detector.LookAhead = 20;
+        detector.MaxSpeed = 20;
+        detector.MaxAge = 0;
+        odid_conflict_init(&detector, states.data(), count, &index, candidates.data(), count, 1000);
+
+        double size = sqrt((double) count) * SPACING / METERS_PER_DEGREE;
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> offset(0, size);
+        std::uniform_real_distribution<float> direction(0, 360), speed(0, 20), altitude(30, 120);
+        for (uint32_t i = 0; i < count; i++) {
+            ODID_Location_data &l = locations[i];
+            odid_initLocationData(&l);
+            l.Latitude = AREA_LATITUDE + offset(gen);
+            l.Longitude = AREA_LONGITUDE + offset(gen) / cos(AREA_LATITUDE * M_PI / 180);
+            l.AltitudeGeo = altitude(gen);
+            l.Direction = direction(gen);
+            l.SpeedHorizontal = speed(gen);
+            odid_conflict_update(&detector, i, 0, &l, out, 64);
+        }
+        std::uniform_int_distribution<uint32_t> pick(0, count - 1);
+        for (auto &id : order)
+            id = pick(gen);
+    }
+};
+
+#define CONFLICT_SIZES Arg(1000)->Arg(10000)->Arg(100000)
+
+static void BM_conflictUpdate(benchmark::State &state)
+{
+    ConflictFixture f((uint32_t) state.range(0));
+    for (auto _ : state) {
+        for (uint32_t id : f.order)
+            benchmark::DoNotOptimize(odid_conflict_update(&f.detector, id, 0, &f.locations[id], f.out, 64));
+    }
+    state.SetItemsProcessed(state.iterations() * UPDATE_COUNT);
+}
+BENCHMARK(BM_conflictUpdate)->CONFLICT_SIZES;
+
+// Current separation only, against every other UAS
+static void BM_conflictUpdate_allPairs(benchmark::State &state)
+{
+    ConflictFixture f((uint32_t) state.range(0));
+    for (auto _ : state) {
+        for (uint32_t id : f.order) {
+            const ODID_Location_data &l = f.locations[id];
+            uint32_t found = 0;
+            for (uint32_t other = 0; other < f.locations.size(); other++) {
+                const ODID_Location_data &o = f.locations[other];
+                found += other != id && fabs(o.AltitudeGeo - l.AltitudeGeo) <= 15 &&
+                         odid_distance(l.Latitude, l.Longitude, o.Latitude, o.Longitude) <= 50;
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * UPDATE_COUNT);
+}
+BENCHMARK(BM_conflictUpdate_allPairs)->Arg(1000)->Arg(10000);
@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/*
+ * Message type dispatch of decodeOpenDroneID() on a mix of messages as sent
+ * by the simulator in test/opendroneid_sim.c, with Location messages sent
+ * three times as often as the others, like most transmitters do.
+ *
+ * legacy_decodeOpenDroneID() is the switch based dispatch that was used
+ * before the dispatch table, kept here as a baseline for comparison.
+ */
+
+static const size_t MIX_COUNT = 4096;
+
+static __attribute__((noinline)) ODID_messagetype_t legacy_decodeOpenDroneID(ODID_UAS_Data *uasData, const uint8_t *msgData)
+{
+    switch (decodeMessageType(msgData[0]))
+    {
+    case ODID_MESSAGETYPE_BASIC_ID:
+        if (decodeBasicIDMessage(&uasData->BasicID[0], (ODID_BasicID_encoded *) msgData) == ODID_SUCCESS)
+            return ODID_MESSAGETYPE_BASIC_ID;
+        break;
+    case ODID_MESSAGETYPE_LOCATION:
+        if (decodeLocationMessage(&uasData->Location, (ODID_Location_encoded *) msgData) == ODID_SUCCESS)
+            return ODID_MESSAGETYPE_LOCATION;
+        break;
+    case ODID_MESSAGETYPE_AUTH:
+        if (decodeAuthMessage(&uasData->Auth[0], (ODID_Auth_encoded *) msgData) == ODID_SUCCESS)
+            return ODID_MESSAGETYPE_AUTH;
+        break;
+    case ODID_MESSAGETYPE_SELF_ID:
+        if (decodeSelfIDMessage(&uasData->SelfID, (ODID_SelfID_encoded *) msgData) == ODID_SUCCESS)
+            return ODID_MESSAGETYPE_SELF_ID;
+        break;
+    case ODID_MESSAGETYPE_SYSTEM:
+        if (decodeSystemMessage(&uasData->System, (ODID_System_encoded *) msgData) == ODID_SUCCESS)
+            return ODID_MESSAGETYPE_SYSTEM;
+        break;
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+        if (decodeOperatorIDMessage(&uasData->OperatorID, (ODID_OperatorID_encoded *) msgData) == ODID_SUCCESS)
+            return ODID_MESSAGETYPE_OPERATOR_ID;
+        break;
+    default:
+        break;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static std::vector<ODID_Message_encoded> simulatorMix()
+{
+    ODID_Message_encoded msgs[ODID_MESSAGETYPE_OPERATOR_ID + 1];
+
+    ODID_BasicID_data basicId;
+    odid_initBasicIDData(&basicId);
+    basicId.IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    basicId.UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    strcpy(basicId.UASID, "INTCE123456789012345");
+    encodeBasicIDMessage(&msgs[ODID_MESSAGETYPE_BASIC_ID].basicId, &basicId);
+
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Direction = 361;
+    location.SpeedHorizontal = 0;
+    location.SpeedVertical = 2;
+    location.Latitude = 45.539309;
+    location.Longitude = -122.966389;
+    location.AltitudeBaro = 100;
+    location.AltitudeGeo = 100;
+    location.HeightType = ODID_HEIGHT_REF_OVER_GROUND;
+    location.Height = 50;
+    location.HorizAccuracy = createEnumHorizontalAccuracy(2.5f);
+    location.VertAccuracy = createEnumVerticalAccuracy(2.5f);
+    location.BaroAccuracy = createEnumVerticalAccuracy(3.5f);
+    location.SpeedAccuracy = createEnumSpeedAccuracy(0.2f);
+    location.TSAccuracy = createEnumTimestampAccuracy(0.5f);
+    location.TimeStamp = 60;
+    encodeLocationMessage(&msgs[ODID_MESSAGETYPE_LOCATION].location, &location);
+
+    ODID_Auth_data auth;
+    odid_initAuthData(&auth);
+    auth.AuthType = ODID_AUTH_UAS_ID_SIGNATURE;
+    auth.Length = 12;
+    auth.Timestamp = 23000000;
+    memcpy(auth.AuthData, "030a0cd033a3", 12);
+    encodeAuthMessage(&msgs[ODID_MESSAGETYPE_AUTH].auth, &auth);
+
+    ODID_SelfID_data selfId;
+    odid_initSelfIDData(&selfId);
+    selfId.DescType = ODID_DESC_TYPE_TEXT;
+    strcpy(selfId.Desc, "Real Estate Photos");
+    encodeSelfIDMessage(&msgs[ODID_MESSAGETYPE_SELF_ID].selfId, &selfId);
+
+    ODID_System_data system;
+    odid_initSystemData(&system);
+    system.OperatorLocationType = ODID_OPERATOR_LOCATION_TYPE_TAKEOFF;
+    system.ClassificationType = ODID_CLASSIFICATION_TYPE_EU;
+    system.OperatorLatitude = 45.539380;
+    system.OperatorLongitude = -122.966475;
+    system.AreaCount = 35;
+    system.AreaRadius = 75;
+    system.AreaCeiling = 176.9f;
+    system.AreaFloor = 41.7f;
+    system.CategoryEU = ODID_CATEGORY_EU_SPECIFIC;
+    system.ClassEU = ODID_CLASS_EU_CLASS_3;
+    system.OperatorAltitudeGeo = 16.5f;
+    system.Timestamp = 23000000;
+    encodeSystemMessage(&msgs[ODID_MESSAGETYPE_SYSTEM].system, &system);
+
+    ODID_OperatorID_data operatorId;
+    odid_initOperatorIDData(&operatorId);
+    operatorId.OperatorIdType = ODID_OPERATOR_ID;
+    strcpy(operatorId.OperatorId, "98765432100123456789");
+    encodeOperatorIDMessage(&msgs[ODID_MESSAGETYPE_OPERATOR_ID].operatorId, &operatorId);
+
+    std::vector<ODID_Message_encoded> mix;
+    while (mix.size() < MIX_COUNT) {
+        for (int type = ODID_MESSAGETYPE_BASIC_ID; type <= ODID_MESSAGETYPE_OPERATOR_ID; type++) {
+            mix.push_back(msgs[type]);
+            if (type == ODID_MESSAGETYPE_LOCATION) {
+                mix.push_back(msgs[type]);
+                mix.push_back(msgs[type]);
+            }
+        }
+    }
+    mix.resize(MIX_COUNT);
+
+    // Messages from several UAS arrive interleaved in no particular order
+    std::shuffle(mix.begin(), mix.end(), std::mt19937(42));
+    return mix;
+}
+
+template <ODID_messagetype_t (*Decode)(ODID_UAS_Data *, const uint8_t *)>
+static void BM_decodeMix(benchmark::State &state)
+{
+    auto mix = simulatorMix();
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    for (auto _ : state) {
+        for (const auto &msg : mix)
+            benchmark::DoNotOptimize(Decode(&uas, msg.rawData));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MIX_COUNT);
+}
+BENCHMARK_TEMPLATE(BM_decodeMix, legacy_decodeOpenDroneID);
+BENCHMARK_TEMPLATE(BM_decodeMix, decodeOpenDroneID);
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Batch geodesy over the positions of 4096 aircraft within about 20 km of a
+ * receiver, per instruction set, versus a plain libm loop. The distance
+ * benchmarks also report the largest deviation from the libm haversine, in
+ * meters, as the max_error counter.
+ */
+
+static const size_t GEO_COUNT = 4096;
+static const double GEO_LATITUDE = 47.3977;
+static const double GEO_LONGITUDE = 8.5456;
+
+struct GeoFixture {
+    std::vector<int32_t> latitudeE7, longitudeE7;
+    std::vector<double> latitude, longitude, reference, out0, out1, out2;
+    std::vector<float> altitude;
+    ODID_Geo_points points;
+
+    GeoFixture()
+        : latitudeE7(GEO_COUNT), longitudeE7(GEO_COUNT), latitude(GEO_COUNT), longitude(GEO_COUNT),
+          reference(GEO_COUNT), out0(GEO_COUNT), out1(GEO_COUNT), out2(GEO_COUNT), altitude(GEO_COUNT)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> offset(-0.2, 0.2);
+        std::uniform_real_distribution<float> height(0, 500);
+        for (size_t i = 0; i < GEO_COUNT; i++) {
+            latitudeE7[i] = (int32_t) lround((GEO_LATITUDE + offset(gen)) * 1E7);
+            longitudeE7[i] = (int32_t) lround((GEO_LONGITUDE + offset(gen)) * 1E7);
+            latitude[i] = latitudeE7[i] * 1E-7;
+            longitude[i] = longitudeE7[i] * 1E-7;
+            altitude[i] = height(gen);
+            reference[i] = odid_distance(GEO_LATITUDE, GEO_LONGITUDE, latitude[i], longitude[i]);
+        }
+        points = { nullptr, nullptr, latitudeE7.data(), longitudeE7.data(), altitude.data() };
+    }
+
+    double maxError() const
+    {
+        double error = 0;
+        for (size_t i = 0; i < GEO_COUNT; i++)
+            error = std::fmax(error, std::fabs(out0[i] - reference[i]));
+        return error;
+    }
+};
+
+#define GEO_LEVELS Arg(ODID_SIMD_SCALAR)->Arg(ODID_SIMD_AVX2)
+
+static void BM_geoDistanceLibm(benchmark::State &state)
+{
+    GeoFixture f;
+    for (auto _ : state) {
+        for (size_t i = 0; i < GEO_COUNT; i++)
+            f.out0[i] = odid_distance(GEO_LATITUDE, GEO_LONGITUDE, f.latitude[i], f.longitude[i]);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * GEO_COUNT);
+}
+BENCHMARK(BM_geoDistanceLibm);
+
+static void BM_geoDistance(benchmark::State &state)
+{
+    GeoFixture f;
+    odid_simd_select((ODID_simd_t) state.range(0));
+    for (auto _ : state) {
+        odid_geo_distance(&f.points, GEO_COUNT, GEO_LATITUDE, GEO_LONGITUDE, f.out0.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["max_error"] = f.maxError();
+    state.SetItemsProcessed(state.iterations() * GEO_COUNT);
+    odid_simd_select(ODID_SIMD_AUTO);
+}
+BENCHMARK(BM_geoDistance)->GEO_LEVELS;
+
+static void BM_geoDistanceFast(benchmark::State &state)
+{
+    GeoFixture f;
+    odid_simd_select((ODID_simd_t) state.range(0));
+    for (auto _ : state) {
+        odid_geo_distance_fast(&f.points, GEO_COUNT, GEO_LATITUDE, GEO_LONGITUDE, f.out0.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["max_error"] = f.maxError();
+    state.SetItemsProcessed(state.iterations() * GEO_COUNT);
+    odid_simd_select(ODID_SIMD_AUTO);
+}
+BENCHMARK(BM_geoDistanceFast)->GEO_LEVELS;
+
+static void BM_geoBearing(benchmark::State &state)
+{
+    GeoFixture f;
+    odid_simd_select((ODID_simd_t) state.range(0));
+    for (auto _ : state) {
+        odid_geo_bearing(&f.points, GEO_COUNT, GEO_LATITUDE, GEO_LONGITUDE, f.out0.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * GEO_COUNT);
+    odid_simd_select(ODID_SIMD_AUTO);
+}
+BENCHMARK(BM_geoBearing)->GEO_LEVELS;
+
+static void BM_geoEnu(benchmark::State &state)
+{
+    GeoFixture f;
+    odid_simd_select((ODID_simd_t) state.range(0));
+    for (auto _ : state) {
+        odid_geo_to_enu(&f.points, GEO_COUNT, GEO_LATITUDE, GEO_LONGITUDE, 400,
+                        f.out0.data(), f.out1.data(), f.out2.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * GEO_COUNT);
+    odid_simd_select(ODID_SIMD_AUTO);
+}
+BENCHMARK(BM_geoEnu)->GEO_LEVELS;
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Checking positions against 1k to 10k restricted zones, octagons of 0.5 to
+ * 5 km spread over a 10 by 10 degree area, with a grid of 0.05 degree cells:
+ * the geofence versus a bounding box and point-in-polygon scan of all zones.
+ */
+
+static const double AREA_LATITUDE = 45;
+static const double AREA_LONGITUDE = 5;
+static const double AREA_SIZE = 10;
+static const double CELL_SIZE = 0.05;
+static const size_t CHECK_COUNT = 256;
+static const int ZONE_VERTICES = 8;
+
+struct GeofenceFixture {
+    std::vector<ODID_Geofence_zone> zones;
+    std::vector<ODID_Geofence_vertex> vertices;
+    std::vector<uint32_t> buckets;
+    std::vector<ODID_Geofence_ref> refs;
+    std::vector<ODID_Geofence_state> states;
+    std::vector<ODID_Location_data> locations;
+    uint64_t epoch;
+    ODID_Geofence_zones set;
+    ODID_Geofence fence;
+
+    explicit GeofenceFixture(uint32_t count)
+        : zones(count), states(CHECK_COUNT), locations(CHECK_COUNT)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> offset(0, AREA_SIZE), radius(0.005, 0.05);
+        for (uint32_t i = 0; i < count; i++) {
+            double lat = AREA_LATITUDE + offset(gen), lon = AREA_LONGITUDE + offset(gen), r = radius(gen);
+            zones[i] = {};
+            zones[i].Id = i;
+            zones[i].FirstVertex = (uint32_t) vertices.size();
+            zones[i].VertexCount = ZONE_VERTICES;
+            zones[i].Floor = INV_ALT;
+            zones[i].Ceiling = 120;
+            for (int k = 0; k < ZONE_VERTICES; k++)
+                vertices.push_back({ lat + r * sin(2 * M_PI * k / ZONE_VERTICES),
+                                     lon + r * cos(2 * M_PI * k / ZONE_VERTICES) });
+        }
+        odid_geofence_zones_init(&set, zones.data(), count, vertices.data(),
+                                 (uint32_t) vertices.size(), CELL_SIZE);
+        uint32_t bucketCount = 1;
+        while (bucketCount < set.RefCount)
+            bucketCount <<= 1;
+        buckets.resize(bucketCount + 1);
+        refs.resize(set.RefCount);
+        odid_geofence_zones_build(&set, buckets.data(), bucketCount, refs.data(), set.RefCount);
+        odid_geofence_init(&fence, states.data(), CHECK_COUNT, &epoch, 1, nullptr, nullptr);
+        odid_geofence_swap(&fence, &set);
+
+        for (auto &l : locations) {
+            odid_initLocationData(&l);
+            l.Latitude = AREA_LATITUDE + offset(gen);
+            l.Longitude = AREA_LONGITUDE + offset(gen);
+            l.AltitudeGeo = 100;
+        }
+    }
+};
+
+#define GEOFENCE_SIZES Arg(1000)->Arg(10000)
+
+static void BM_geofenceCheck(benchmark::State &state)
+{
+    GeofenceFixture f((uint32_t) state.range(0));
+    uint64_t now = 0;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < CHECK_COUNT; i++)
+            benchmark::DoNotOptimize(odid_geofence_check(&f.fence, 0, i, now, &f.locations[i]));
+        now++;
+    }
+    state.SetItemsProcessed(state.iterations() * CHECK_COUNT);
+}
+BENCHMARK(BM_geofenceCheck)->GEOFENCE_SIZES;
+
+static void BM_geofenceCheck_linear(benchmark::State &state)
+{
+    GeofenceFixture f((uint32_t) state.range(0));
+    for (auto _ : state) {
+        for (auto &l : f.locations) {
+            uint32_t found = 0;
+            for (auto &zone : f.zones) {
+                if (l.Latitude < zone.LatMin || l.Latitude > zone.LatMax ||
+                    l.Longitude < zone.LonMin || l.Longitude > zone.LonMax)
+                    continue;
+                const ODID_Geofence_vertex *v = &f.vertices[zone.FirstVertex];
+                bool inside = false;
+                for (uint32_t i = 0, j = zone.VertexCount - 1; i < zone.VertexCount; j = i++) {
+                    if ((v[i].Latitude > l.Latitude) != (v[j].Latitude > l.Latitude) &&
+                        l.Longitude < v[j].Longitude + (l.Latitude - v[j].Latitude) *
+                                      (v[i].Longitude - v[j].Longitude) / (v[i].Latitude - v[j].Latitude))
+                        inside = !inside;
+                }
+                found += inside;
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * CHECK_COUNT);
+}
+BENCHMARK(BM_geofenceCheck_linear)->GEOFENCE_SIZES;
+
+static void BM_geofenceArea(benchmark::State &state)
+{
+    GeofenceFixture f((uint32_t) state.range(0));
+    ODID_System_data system;
+    odid_initSystemData(&system);
+    system.AreaRadius = MAX_AREA_RADIUS;
+    uint32_t out[16];
+    for (auto _ : state) {
+        for (auto &l : f.locations) {
+            system.OperatorLatitude = l.Latitude;
+            system.OperatorLongitude = l.Longitude;
+            benchmark::DoNotOptimize(odid_geofence_check_area(&f.fence, 0, &system, out, 16));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * CHECK_COUNT);
+}
+BENCHMARK(BM_geofenceArea)->GEOFENCE_SIZES;
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+extern "C" {
+#include <mav2odid.h>
+}
+
+#include <cstring>
+
+/*
+ * Parsing of a MAVLink OPEN_DRONE_ID_LOCATION message, as received by a
+ * transmitter from the flight controller, into an encoded Location message.
+ */
+
+#define MAVLINK_SYSTEM_ID       1
+#define MAVLINK_COMPONENT_ID    1
+
+static void BM_m2o_parseMavlink(benchmark::State &state)
+{
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Direction = 215;
+    location.SpeedHorizontal = 7.5f;
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    location.AltitudeGeo = 110.5f;
+    location.TimeStamp = 1234.5f;
+
+    mavlink_open_drone_id_location_t mavLocation;
+    memset(&mavLocation, 0, sizeof(mavLocation));
+    m2o_location2Mavlink(&mavLocation, &location);
+    mavlink_message_t msg;
+    mavlink_msg_open_drone_id_location_encode(MAVLINK_SYSTEM_ID, MAVLINK_COMPONENT_ID,
+                                              &msg, &mavLocation);
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    uint16_t len = mavlink_msg_to_send_buffer(buf, &msg);
+
+    mav2odid_t m2o;
+    m2o_init(&m2o);
+    for (auto _ : state) {
+        ODID_messagetype_t type = ODID_MESSAGETYPE_INVALID;
+        for (uint16_t i = 0; i < len; i++)
+            type = m2o_parseMavlink(&m2o, buf[i]);
+        benchmark::DoNotOptimize(type);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_m2o_parseMavlink);
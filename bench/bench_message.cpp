@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cstring>
+
+/*
+ * Encoding and decoding of the message types not covered by bench_codec.cpp
+ * and of message packs.
+ */
+
+static void initBasicID(ODID_BasicID_data *basicId)
+{
+    odid_initBasicIDData(basicId);
+    basicId->IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    basicId->UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    strcpy(basicId->UASID, "1596F0123456789ABCDE");
+}
+
+static void initAuth(ODID_Auth_data *auth)
+{
+    odid_initAuthData(auth);
+    auth->AuthType = ODID_AUTH_UAS_ID_SIGNATURE;
+    auth->LastPageIndex = 1;
+    auth->Length = 40;
+    auth->Timestamp = 28000000;
+    memcpy(auth->AuthData, "0123456789ABCDEFGHIJK", 21);
+}
+
+static void initSelfID(ODID_SelfID_data *selfId)
+{
+    odid_initSelfIDData(selfId);
+    selfId->DescType = ODID_DESC_TYPE_TEXT;
+    strcpy(selfId->Desc, "Survey flight");
+}
+
+static void initOperatorID(ODID_OperatorID_data *operatorId)
+{
+    odid_initOperatorIDData(operatorId);
+    operatorId->OperatorIdType = ODID_OPERATOR_ID;
+    strcpy(operatorId->OperatorId, "GBR-OP-1234");
+}
+
+#define BENCHMARK_MESSAGE_CODEC(name, dataType, encodedType, initFn)        \
+    static void BM_encode##name##Message(benchmark::State &state)           \
+    {                                                                       \
+        dataType data;                                                      \
+        initFn(&data);                                                      \
+        encodedType encoded;                                                \
+        for (auto _ : state) {                                              \
+            benchmark::DoNotOptimize(encode##name##Message(&encoded, &data)); \
+            benchmark::ClobberMemory();                                     \
+        }                                                                   \
+        state.SetItemsProcessed(state.iterations());                        \
+    }                                                                       \
+    BENCHMARK(BM_encode##name##Message);                                    \
+                                                                            \
+    static void BM_decode##name##Message(benchmark::State &state)           \
+    {                                                                       \
+        dataType data;                                                      \
+        initFn(&data);                                                      \
+        encodedType encoded;                                                \
+        encode##name##Message(&encoded, &data);                             \
+        for (auto _ : state) {                                              \
+            benchmark::DoNotOptimize(decode##name##Message(&data, &encoded)); \
+            benchmark::ClobberMemory();                                     \
+        }                                                                   \
+        state.SetItemsProcessed(state.iterations());                        \
+    }                                                                       \
+    BENCHMARK(BM_decode##name##Message)
+
+BENCHMARK_MESSAGE_CODEC(BasicID, ODID_BasicID_data, ODID_BasicID_encoded, initBasicID);
+BENCHMARK_MESSAGE_CODEC(Auth, ODID_Auth_data, ODID_Auth_encoded, initAuth);
+BENCHMARK_MESSAGE_CODEC(SelfID, ODID_SelfID_data, ODID_SelfID_encoded, initSelfID);
+BENCHMARK_MESSAGE_CODEC(OperatorID, ODID_OperatorID_data, ODID_OperatorID_encoded, initOperatorID);
+
+// A pack with one message of each type
+static void initMessagePack(ODID_MessagePack_data *pack)
+{
+    ODID_BasicID_data basicId;
+    ODID_Location_data location;
+    ODID_Auth_data auth;
+    ODID_SelfID_data selfId;
+    ODID_System_data system;
+    ODID_OperatorID_data operatorId;
+
+    initBasicID(&basicId);
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    initAuth(&auth);
+    initSelfID(&selfId);
+    odid_initSystemData(&system);
+    system.OperatorLatitude = 51.48;
+    system.OperatorLongitude = -0.002;
+    initOperatorID(&operatorId);
+
+    odid_initMessagePackData(pack);
+    encodeBasicIDMessage(&pack->Messages[0].basicId, &basicId);
+    encodeLocationMessage(&pack->Messages[1].location, &location);
+    encodeAuthMessage(&pack->Messages[2].auth, &auth);
+    encodeSelfIDMessage(&pack->Messages[3].selfId, &selfId);
+    encodeSystemMessage(&pack->Messages[4].system, &system);
+    encodeOperatorIDMessage(&pack->Messages[5].operatorId, &operatorId);
+    pack->MsgPackSize = 6;
+}
+
+static void BM_encodeMessagePack(benchmark::State &state)
+{
+    ODID_MessagePack_data data;
+    initMessagePack(&data);
+    ODID_MessagePack_encoded encoded;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(encodeMessagePack(&encoded, &data));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * data.MsgPackSize);
+}
+BENCHMARK(BM_encodeMessagePack);
+
+static void BM_decodeMessagePack(benchmark::State &state)
+{
+    ODID_MessagePack_data data;
+    initMessagePack(&data);
+    ODID_MessagePack_encoded encoded;
+    encodeMessagePack(&encoded, &data);
+    ODID_UAS_Data uas;
+    for (auto _ : state) {
+        odid_initUasData(&uas);
+        benchmark::DoNotOptimize(decodeMessagePack(&uas, &encoded));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * data.MsgPackSize);
+}
+BENCHMARK(BM_decodeMessagePack);
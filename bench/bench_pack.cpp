@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cstring>
+
+/*
+ * Transmit cycle: build a message pack with all message types, where only
+ * the Location message changes from one cycle to the next.
+ */
+
+static const int PACK_MESSAGES = 6;
+
+static void buildTestData(ODID_UAS_Data *uas)
+{
+    memset(uas, 0, sizeof(*uas));
+    odid_initUasData(uas);
+    uas->BasicID[0].UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    uas->BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas->BasicID[0].UASID, "1596F0123456789ABCDE");
+    uas->BasicIDValid[0] = 1;
+    uas->Location.Status = ODID_STATUS_AIRBORNE;
+    uas->Location.Latitude = 51.4791;
+    uas->Location.Longitude = -0.0013;
+    uas->LocationValid = 1;
+    uas->Auth[0].AuthType = ODID_AUTH_UAS_ID_SIGNATURE;
+    uas->AuthValid[0] = 1;
+    strcpy(uas->SelfID.Desc, "Survey flight");
+    uas->SelfIDValid = 1;
+    uas->SystemValid = 1;
+    strcpy(uas->OperatorID.OperatorId, "GBR-OP-1234");
+    uas->OperatorIDValid = 1;
+}
+
+static void BM_buildPack(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    for (auto _ : state) {
+        uas.Location.Latitude += 1E-7;
+        benchmark::DoNotOptimize(odid_message_build_pack(&uas, pack, sizeof(pack)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_buildPack);
+
+static void BM_buildPackCached(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    ODID_Encoder_context ctx;
+    odid_encoder_init(&ctx);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    for (auto _ : state) {
+        uas.Location.Latitude += 1E-7;
+        benchmark::DoNotOptimize(odid_message_build_pack_cached(&ctx, &uas, pack, sizeof(pack)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_buildPackCached);
+
+/*
+ * Receive cycle: decode the same pack into a fresh UAS structure versus
+ * merging it into the existing one.
+ */
+static void BM_processPack(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    int len = odid_message_build_pack(&uas, pack, sizeof(pack));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_message_process_pack(&uas, pack, len));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_processPack);
+
+static void BM_mergePack(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    int len = odid_message_build_pack(&uas, pack, sizeof(pack));
+    ODID_UAS_Timestamps timestamps;
+    odid_initUasTimestamps(&timestamps);
+    uint64_t now = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_message_merge_pack(&uas, &timestamps, now++, pack, len, nullptr, nullptr));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_mergePack);
+
+static void BM_mergePackChanges(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    int len = odid_message_build_pack(&uas, pack, sizeof(pack));
+    ODID_UAS_Timestamps timestamps;
+    odid_initUasTimestamps(&timestamps);
+    uint64_t now = 1;
+    for (auto _ : state) {
+        uint32_t changed = 0;
+        benchmark::DoNotOptimize(odid_message_merge_pack(&uas, &timestamps, now++, pack, len, &changed, nullptr));
+        benchmark::DoNotOptimize(changed);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_mergePackChanges);
+
+/*
+ * Receive cycle of a UAS that repeats its static messages unchanged: decode
+ * every message versus skipping those identical to the memoized ones.
+ */
+static void BM_decodePack(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    odid_message_build_pack(&uas, pack, sizeof(pack));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(decodeOpenDroneID(&uas, pack));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_decodePack);
+
+static void BM_decodePackMemo(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    odid_message_build_pack(&uas, pack, sizeof(pack));
+    ODID_Message_memo memo;
+    odid_initMessageMemo(&memo);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_decode_memo(&uas, &memo, pack));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_decodePackMemo);
+
+static void BM_mergePackMemo(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    int len = odid_message_build_pack(&uas, pack, sizeof(pack));
+    ODID_UAS_Timestamps timestamps;
+    odid_initUasTimestamps(&timestamps);
+    ODID_Message_memo memo;
+    odid_initMessageMemo(&memo);
+    uint64_t now = 1;
+    for (auto _ : state) {
+        uint32_t changed = 0;
+        benchmark::DoNotOptimize(odid_message_merge_pack(&uas, &timestamps, now++, pack, len, &changed, &memo));
+        benchmark::DoNotOptimize(changed);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_mergePackMemo);
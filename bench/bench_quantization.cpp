@@ -0,0 +1,281 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Micro-benchmarks of the accuracy enum and scaled field quantization.
+ *
+ * The legacy_* functions are copies of the branch chains that were used for
+ * the accuracy enums before the table driven implementation, kept here as a
+ * baseline for comparison. They are not inlined, but are still called
+ * directly, while the library functions are called through the PLT of the
+ * shared library, which costs about 1 ns per call.
+ */
+
+static const size_t SAMPLE_COUNT = 4096;
+
+static __attribute__((noinline)) ODID_Horizontal_accuracy_t legacy_createEnumHorizontalAccuracy(float Accuracy)
+{
+    if (Accuracy >= 18520)
+        return ODID_HOR_ACC_UNKNOWN;
+    else if (Accuracy >= 7408)
+        return ODID_HOR_ACC_10NM;
+    else if (Accuracy >= 3704)
+        return ODID_HOR_ACC_4NM;
+    else if (Accuracy >= 1852)
+        return ODID_HOR_ACC_2NM;
+    else if (Accuracy >= 926)
+        return ODID_HOR_ACC_1NM;
+    else if (Accuracy >= 555.6f)
+        return ODID_HOR_ACC_0_5NM;
+    else if (Accuracy >= 185.2f)
+        return ODID_HOR_ACC_0_3NM;
+    else if (Accuracy >= 92.6f)
+        return ODID_HOR_ACC_0_1NM;
+    else if (Accuracy >= 30)
+        return ODID_HOR_ACC_0_05NM;
+    else if (Accuracy >= 10)
+        return ODID_HOR_ACC_30_METER;
+    else if (Accuracy >= 3)
+        return ODID_HOR_ACC_10_METER;
+    else if (Accuracy >= 1)
+        return ODID_HOR_ACC_3_METER;
+    else if (Accuracy > 0)
+        return ODID_HOR_ACC_1_METER;
+    else
+        return ODID_HOR_ACC_UNKNOWN;
+}
+
+static __attribute__((noinline)) ODID_Vertical_accuracy_t legacy_createEnumVerticalAccuracy(float Accuracy)
+{
+    if (Accuracy >= 150)
+        return ODID_VER_ACC_UNKNOWN;
+    else if (Accuracy >= 45)
+        return ODID_VER_ACC_150_METER;
+    else if (Accuracy >= 25)
+        return ODID_VER_ACC_45_METER;
+    else if (Accuracy >= 10)
+        return ODID_VER_ACC_25_METER;
+    else if (Accuracy >= 3)
+        return ODID_VER_ACC_10_METER;
+    else if (Accuracy >= 1)
+        return ODID_VER_ACC_3_METER;
+    else if (Accuracy > 0)
+        return ODID_VER_ACC_1_METER;
+    else
+        return ODID_VER_ACC_UNKNOWN;
+}
+
+static __attribute__((noinline)) ODID_Speed_accuracy_t legacy_createEnumSpeedAccuracy(float Accuracy)
+{
+    if (Accuracy >= 10)
+        return ODID_SPEED_ACC_UNKNOWN;
+    else if (Accuracy >= 3)
+        return ODID_SPEED_ACC_10_METERS_PER_SECOND;
+    else if (Accuracy >= 1)
+        return ODID_SPEED_ACC_3_METERS_PER_SECOND;
+    else if (Accuracy >= 0.3f)
+        return ODID_SPEED_ACC_1_METERS_PER_SECOND;
+    else if (Accuracy > 0)
+        return ODID_SPEED_ACC_0_3_METERS_PER_SECOND;
+    else
+        return ODID_SPEED_ACC_UNKNOWN;
+}
+
+static __attribute__((noinline)) ODID_Timestamp_accuracy_t legacy_createEnumTimestampAccuracy(float Accuracy)
+{
+    if (Accuracy > 1.5f)
+        return ODID_TIME_ACC_UNKNOWN;
+    else if (Accuracy > 1.4f)
+        return ODID_TIME_ACC_1_5_SECOND;
+    else if (Accuracy > 1.3f)
+        return ODID_TIME_ACC_1_4_SECOND;
+    else if (Accuracy > 1.2f)
+        return ODID_TIME_ACC_1_3_SECOND;
+    else if (Accuracy > 1.1f)
+        return ODID_TIME_ACC_1_2_SECOND;
+    else if (Accuracy > 1.0f)
+        return ODID_TIME_ACC_1_1_SECOND;
+    else if (Accuracy > 0.9f)
+        return ODID_TIME_ACC_1_0_SECOND;
+    else if (Accuracy > 0.8f)
+        return ODID_TIME_ACC_0_9_SECOND;
+    else if (Accuracy > 0.7f)
+        return ODID_TIME_ACC_0_8_SECOND;
+    else if (Accuracy > 0.6f)
+        return ODID_TIME_ACC_0_7_SECOND;
+    else if (Accuracy > 0.5f)
+        return ODID_TIME_ACC_0_6_SECOND;
+    else if (Accuracy > 0.4f)
+        return ODID_TIME_ACC_0_5_SECOND;
+    else if (Accuracy > 0.3f)
+        return ODID_TIME_ACC_0_4_SECOND;
+    else if (Accuracy > 0.2f)
+        return ODID_TIME_ACC_0_3_SECOND;
+    else if (Accuracy > 0.1f)
+        return ODID_TIME_ACC_0_2_SECOND;
+    else if (Accuracy > 0.0f)
+        return ODID_TIME_ACC_0_1_SECOND;
+    else
+        return ODID_TIME_ACC_UNKNOWN;
+}
+
+/*
+ * Accuracy values in random order, log-uniformly distributed up to max, so
+ * that each bucket of the enums is hit a comparable number of times
+ */
+static std::vector<float> accuracySamples(float max)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(std::log(0.1f), std::log(max));
+    std::vector<float> samples(SAMPLE_COUNT);
+    for (auto &sample : samples)
+        sample = std::exp(dist(gen));
+    return samples;
+}
+
+static void BM_createEnumHorizontalAccuracy_legacy(benchmark::State &state)
+{
+    auto samples = accuracySamples(20000);
+    for (auto _ : state) {
+        for (float sample : samples)
+            benchmark::DoNotOptimize(legacy_createEnumHorizontalAccuracy(sample));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+BENCHMARK(BM_createEnumHorizontalAccuracy_legacy);
+
+static void BM_createEnumHorizontalAccuracy(benchmark::State &state)
+{
+    auto samples = accuracySamples(20000);
+    for (auto _ : state) {
+        for (float sample : samples)
+            benchmark::DoNotOptimize(createEnumHorizontalAccuracy(sample));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+BENCHMARK(BM_createEnumHorizontalAccuracy);
+
+static void BM_createEnumVerticalAccuracy_legacy(benchmark::State &state)
+{
+    auto samples = accuracySamples(160);
+    for (auto _ : state) {
+        for (float sample : samples)
+            benchmark::DoNotOptimize(legacy_createEnumVerticalAccuracy(sample));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+BENCHMARK(BM_createEnumVerticalAccuracy_legacy);
+
+static void BM_createEnumVerticalAccuracy(benchmark::State &state)
+{
+    auto samples = accuracySamples(160);
+    for (auto _ : state) {
+        for (float sample : samples)
+            benchmark::DoNotOptimize(createEnumVerticalAccuracy(sample));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+BENCHMARK(BM_createEnumVerticalAccuracy);
+
+static void BM_createEnumSpeedAccuracy_legacy(benchmark::State &state)
+{
+    auto samples = accuracySamples(12);
+    for (auto _ : state) {
+        for (float sample : samples)
+            benchmark::DoNotOptimize(legacy_createEnumSpeedAccuracy(sample));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+BENCHMARK(BM_createEnumSpeedAccuracy_legacy);
+
+static void BM_createEnumSpeedAccuracy(benchmark::State &state)
+{
+    auto samples = accuracySamples(12);
+    for (auto _ : state) {
+        for (float sample : samples)
+            benchmark::DoNotOptimize(createEnumSpeedAccuracy(sample));
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+BENCHMARK(BM_createEnumSpeedAccuracy);
+
+static void BM_decodeAccuracy(benchmark::State &state)
+{
+    for (auto _ : state) {
+        for (int i = 0; i < 16; i++) {
+            benchmark::DoNotOptimize(decodeHorizontalAccuracy((ODID_Horizontal_accuracy_t) i));
+            benchmark::DoNotOptimize(decodeVerticalAccuracy((ODID_Vertical_accuracy_t) i));
+            benchmark::DoNotOptimize(decodeSpeedAccuracy((ODID_Speed_accuracy_t) i));
+            benchmark::DoNotOptimize(decodeTimestampAccuracy((ODID_Timestamp_accuracy_t) i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 16 * 4);
+}
+BENCHMARK(BM_decodeAccuracy);
+
+/*
+ * GPS ingest: the work done for each position fix by a transmitter, i.e.
+ * converting the receiver accuracy estimates to enums and encoding the
+ * Location message, with the given accuracy enum encoders.
+ */
+template <ODID_Horizontal_accuracy_t (*horizontal)(float), ODID_Vertical_accuracy_t (*vertical)(float),
+          ODID_Speed_accuracy_t (*speed)(float), ODID_Timestamp_accuracy_t (*timestamp)(float)>
+static void gpsIngest(benchmark::State &state)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> acc(0.0f, 50.0f);
+    std::uniform_real_distribution<float> value(0.0f, 100.0f);
+    std::uniform_real_distribution<float> dir(0.0f, 359.0f);
+    std::uniform_real_distribution<double> lat(-90.0, 90.0);
+    std::uniform_real_distribution<double> lon(-180.0, 180.0);
+    std::vector<ODID_Location_data> fixes(SAMPLE_COUNT);
+    std::vector<float> accuracies(SAMPLE_COUNT * 4);
+    for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+        odid_initLocationData(&fixes[i]);
+        fixes[i].Status = ODID_STATUS_AIRBORNE;
+        fixes[i].Direction = dir(gen);
+        fixes[i].SpeedHorizontal = value(gen);
+        fixes[i].SpeedVertical = value(gen) - 50.0f;
+        fixes[i].Latitude = lat(gen);
+        fixes[i].Longitude = lon(gen);
+        fixes[i].AltitudeBaro = value(gen) * 10.0f;
+        fixes[i].AltitudeGeo = value(gen) * 10.0f;
+        fixes[i].Height = value(gen);
+        fixes[i].TimeStamp = 360.0f;
+        for (int j = 0; j < 4; j++)
+            accuracies[i * 4 + j] = acc(gen);
+    }
+
+    ODID_Location_encoded encoded;
+    for (auto _ : state) {
+        for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+            ODID_Location_data &fix = fixes[i];
+            fix.HorizAccuracy = horizontal(accuracies[i * 4]);
+            fix.VertAccuracy = vertical(accuracies[i * 4 + 1]);
+            fix.BaroAccuracy = vertical(accuracies[i * 4 + 2]);
+            fix.SpeedAccuracy = speed(accuracies[i * 4 + 3]);
+            fix.TSAccuracy = timestamp(accuracies[i * 4 + 3] / 30.0f);
+            benchmark::DoNotOptimize(encodeLocationMessage(&encoded, &fix));
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * SAMPLE_COUNT);
+}
+
+static void BM_gpsIngest_legacy(benchmark::State &state)
+{
+    gpsIngest<legacy_createEnumHorizontalAccuracy, legacy_createEnumVerticalAccuracy,
+              legacy_createEnumSpeedAccuracy, legacy_createEnumTimestampAccuracy>(state);
+}
+BENCHMARK(BM_gpsIngest_legacy);
+
+static void BM_gpsIngest(benchmark::State &state)
+{
+    gpsIngest<createEnumHorizontalAccuracy, createEnumVerticalAccuracy,
+              createEnumSpeedAccuracy, createEnumTimestampAccuracy>(state);
+}
+BENCHMARK(BM_gpsIngest);
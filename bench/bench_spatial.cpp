@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <random>
+#include <vector>
+
+/*
+ * Area queries over the positions of 10k to 1M tracked entities spread over
+ * a 10 by 10 degree area, with a grid of 0.05 degree cells: the spatial
+ * index versus a linear scan over the positions.
+ */
+
+static const double AREA_LATITUDE = 45;
+static const double AREA_LONGITUDE = 5;
+static const double AREA_SIZE = 10;
+static const double CELL_SIZE = 0.05;
+static const size_t QUERY_COUNT = 256;
+
+struct SpatialFixture {
+    std::vector<ODID_Spatial_entry> entries;
+    std::vector<uint32_t> buckets;
+    std::vector<ODID_Location_data> locations;
+    std::vector<ODID_Location_data> queries;
+    std::vector<uint32_t> out;
+    ODID_Spatial_index index;
+
+    explicit SpatialFixture(uint32_t count)
+        : entries(count), locations(count), queries(QUERY_COUNT), out(count)
+    {
+        uint32_t bucketCount = 1;
+        while (bucketCount < count)
+            bucketCount <<= 1;
+        buckets.resize(bucketCount);
+        odid_spatial_init(&index, entries.data(), count, buckets.data(), bucketCount, CELL_SIZE);
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> offset(0, AREA_SIZE);
+        for (uint32_t i = 0; i < count; i++) {
+            odid_initLocationData(&locations[i]);
+            locations[i].Latitude = AREA_LATITUDE + offset(gen);
+            locations[i].Longitude = AREA_LONGITUDE + offset(gen);
+            odid_spatial_update(&index, i, locations[i].Latitude, locations[i].Longitude);
+        }
+        for (auto &query : queries) {
+            query.Latitude = AREA_LATITUDE + offset(gen);
+            query.Longitude = AREA_LONGITUDE + offset(gen);
+        }
+    }
+};
+
+#define SPATIAL_SIZES Arg(10000)->Arg(100000)->Arg(1000000)
+
+static void BM_spatialBox(benchmark::State &state)
+{
+    SpatialFixture f((uint32_t) state.range(0));
+    for (auto _ : state) {
+        for (auto &q : f.queries)
+            benchmark::DoNotOptimize(odid_spatial_box(&f.index, q.Latitude, q.Longitude, q.Latitude + 0.1,
+                                                      q.Longitude + 0.1, f.out.data(), (uint32_t) f.out.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * QUERY_COUNT);
+}
+BENCHMARK(BM_spatialBox)->SPATIAL_SIZES;
+
+static void BM_spatialBox_linear(benchmark::State &state)
+{
+    SpatialFixture f((uint32_t) state.range(0));
+    for (auto _ : state) {
+        for (auto &q : f.queries) {
+            uint32_t found = 0;
+            for (uint32_t i = 0; i < f.locations.size(); i++) {
+                const ODID_Location_data &l = f.locations[i];
+                if (l.Latitude >= q.Latitude && l.Latitude <= q.Latitude + 0.1 &&
+                    l.Longitude >= q.Longitude && l.Longitude <= q.Longitude + 0.1)
+                    f.out[found++] = i;
+            }
+            benchmark::DoNotOptimize(found);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * QUERY_COUNT);
+}
+BENCHMARK(BM_spatialBox_linear)->SPATIAL_SIZES;
+
+static void BM_spatialRadius(benchmark::State &state)
+{
+    SpatialFixture f((uint32_t) state.range(0));
+    for (auto _ : state) {
+        for (auto &q : f.queries)
+            benchmark::DoNotOptimize(odid_spatial_radius(&f.index, q.Latitude, q.Longitude, 5000,
+                                                         f.out.data(), (uint32_t) f.out.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * QUERY_COUNT);
+}
+BENCHMARK(BM_spatialRadius)->SPATIAL_SIZES;
+
+static void BM_spatialNearest(benchmark::State &state)
+{
+    SpatialFixture f((uint32_t) state.range(0));
+    uint32_t nearest[10];
+    double distances[10];
+    for (auto _ : state) {
+        for (auto &q : f.queries)
+            benchmark::DoNotOptimize(odid_spatial_nearest(&f.index, q.Latitude, q.Longitude, 10,
+                                                          nearest, distances));
+    }
+    state.SetItemsProcessed(state.iterations() * QUERY_COUNT);
+}
+BENCHMARK(BM_spatialNearest)->SPATIAL_SIZES;
+
+// Entities moving by up to about 50 m per update
+static void BM_spatialUpdate(benchmark::State &state)
+{
+    SpatialFixture f((uint32_t) state.range(0));
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<uint32_t> pick(0, (uint32_t) f.locations.size() - 1);
+    std::uniform_real_distribution<double> step(-0.0005, 0.0005);
+    std::vector<uint32_t> order(QUERY_COUNT * 16);
+    for (auto &id : order)
+        id = pick(gen);
+    for (auto _ : state) {
+        for (uint32_t id : order) {
+            ODID_Location_data &l = f.locations[id];
+            l.Latitude += step(gen);
+            l.Longitude += step(gen);
+            odid_spatial_update(&f.index, id, l.Latitude, l.Longitude);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * order.size());
+}
+BENCHMARK(BM_spatialUpdate)->SPATIAL_SIZES;
@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <random>
+#include <vector>
+
+/*
+ * Receiver aggregating the Location messages of 50000 live UAS in a track
+ * table, in the random order in which they arrive. With timeouts, each
+ * message also restarts the lost contact and stale Location timers of its
+ * track, and the timing wheel is advanced every 1000 messages.
+ */
+
+static const uint32_t LIVE_TRACKS = 50000;
+static const uint32_t CAPACITY = 65536;
+static const size_t UPDATE_COUNT = 1 << 16;
+
+template <bool Timeouts>
+static void BM_trackDecode(benchmark::State &state)
+{
+    std::vector<ODID_Track> tracks(CAPACITY);
+    std::vector<ODID_Track_slot> slots(odid_track_slot_count(CAPACITY));
+    ODID_Track_table table;
+    odid_track_table_init(&table, tracks.data(), CAPACITY, slots.data(), (uint32_t) slots.size());
+    std::vector<ODID_Timer> timers(CAPACITY * ODID_TRACK_TIMERS);
+    ODID_Track_timeouts timeouts = {};
+    timeouts.Lost = 1 << 30;
+    timeouts.Stale[ODID_MESSAGETYPE_LOCATION] = 1 << 29;
+    if (Timeouts)
+        odid_track_enable_timeouts(&table, &timeouts, timers.data(), 0, 16);
+
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    ODID_Message_encoded msg;
+    encodeLocationMessage(&msg.location, &location);
+
+    std::vector<ODID_Track_key> keys(LIVE_TRACKS);
+    for (uint32_t i = 0; i < LIVE_TRACKS; i++) {
+        uint8_t mac[6] = { 0x02, 0x00, 0x00, (uint8_t) (i >> 16), (uint8_t) (i >> 8), (uint8_t) i };
+        odid_track_key_mac(&keys[i], mac);
+        odid_track_decode(&table, &keys[i], 0, msg.rawData);
+    }
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> pick(0, LIVE_TRACKS - 1);
+    std::vector<uint32_t> order(UPDATE_COUNT);
+    for (auto &index : order)
+        index = pick(gen);
+
+    uint64_t now = 1;
+    for (auto _ : state) {
+        for (uint32_t index : order) {
+            benchmark::DoNotOptimize(odid_track_decode(&table, &keys[index], now++, msg.rawData));
+            if (Timeouts && now % 1000 == 0)
+                odid_track_advance(&table, now);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * UPDATE_COUNT);
+}
+BENCHMARK_TEMPLATE(BM_trackDecode, false);
+BENCHMARK_TEMPLATE(BM_trackDecode, true);
+
+/*
+ * Timing wheel alone: restart random timers that all stay pending, with
+ * regular advances, as done for tracks that keep being received.
+ */
+static void BM_timerReschedule(benchmark::State &state)
+{
+    std::vector<ODID_Timer> timers(CAPACITY);
+    ODID_Timer_wheel wheel;
+    odid_timer_wheel_init(&wheel, timers.data(), CAPACITY, 0, 1);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> pick(0, CAPACITY - 1);
+    std::vector<uint32_t> order(UPDATE_COUNT);
+    for (auto &index : order)
+        index = pick(gen);
+
+    uint64_t now = 1;
+    for (auto _ : state) {
+        for (uint32_t index : order) {
+            odid_timer_schedule(&wheel, index, now + 30000);
+            if (++now % 64 == 0)
+                benchmark::DoNotOptimize(odid_timer_wheel_advance(&wheel, now, nullptr, nullptr));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * UPDATE_COUNT);
+}
+BENCHMARK(BM_timerReschedule);
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+/*
+ * Reading the position of a received Location message: full decoding into an
+ * ODID_UAS_Data structure compared to the view getters. Then filtering an
+ * array of Location messages on a box, an altitude band and a status, of
+ * which about 2 % match: decoding each message compared to the encoded-space
+ * filter.
+ */
+
+static void buildLocation(ODID_Message_encoded *msg)
+{
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    location.AltitudeGeo = 110.5f;
+    encodeLocationMessage(&msg->location, &location);
+}
+
+static void BM_decodeOpenDroneID_latlon(benchmark::State &state)
+{
+    ODID_Message_encoded msg;
+    buildLocation(&msg);
+    ODID_UAS_Data uas;
+    for (auto _ : state) {
+        odid_initUasData(&uas);
+        decodeOpenDroneID(&uas, msg.rawData);
+        benchmark::DoNotOptimize(uas.Location.Latitude);
+        benchmark::DoNotOptimize(uas.Location.Longitude);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_decodeOpenDroneID_latlon);
+
+static void BM_view_latlon(benchmark::State &state)
+{
+    ODID_Message_encoded msg;
+    buildLocation(&msg);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(msg.rawData);
+        ODID_Message_view view;
+        odid_view_init(&view, msg.rawData, sizeof(msg.rawData));
+        if (odid_view_type(view) == ODID_MESSAGETYPE_LOCATION) {
+            benchmark::DoNotOptimize(odid_view_location_lat(view));
+            benchmark::DoNotOptimize(odid_view_location_lon(view));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_view_latlon);
+
+static const size_t FILTER_COUNT = 4096;
+
+struct FilterFixture {
+    std::vector<ODID_Location_encoded> msgs;
+    std::vector<uint32_t> out;
+    ODID_Location_filter filter;
+
+    FilterFixture() : msgs(FILTER_COUNT), out(FILTER_COUNT)
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> lat(45, 55), lon(-5, 5);
+        std::uniform_real_distribution<float> alt(0, 500);
+        for (auto &msg : msgs) {
+            ODID_Location_data location;
+            odid_initLocationData(&location);
+            location.Status = gen() % 8 ? ODID_STATUS_AIRBORNE : ODID_STATUS_GROUND;
+            location.Latitude = lat(gen);
+            location.Longitude = lon(gen);
+            location.AltitudeGeo = alt(gen);
+            encodeLocationMessage(&msg, &location);
+        }
+        odid_location_filter_init(&filter);
+        odid_location_filter_box(&filter, 49, -1, 51, 1);
+        odid_location_filter_altitude(&filter, ODID_FILTER_ALTITUDE_GEO, 0, 120);
+        odid_location_filter_status(&filter, 1 << ODID_STATUS_AIRBORNE);
+    }
+};
+
+static void BM_filterDecode(benchmark::State &state)
+{
+    FilterFixture f;
+    for (auto _ : state) {
+        size_t found = 0;
+        for (size_t i = 0; i < FILTER_COUNT; i++) {
+            ODID_Location_data l;
+            if (decodeLocationMessage(&l, &f.msgs[i]) == ODID_SUCCESS &&
+                l.Latitude >= 49 && l.Latitude <= 51 && l.Longitude >= -1 && l.Longitude <= 1 &&
+                l.AltitudeGeo >= 0 && l.AltitudeGeo <= 120 && l.Status == ODID_STATUS_AIRBORNE)
+                f.out[found++] = (uint32_t) i;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * FILTER_COUNT);
+}
+BENCHMARK(BM_filterDecode);
+
+static void BM_filterEncoded(benchmark::State &state)
+{
+    FilterFixture f;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(odid_location_filter_batch(&f.filter, f.msgs.data(), FILTER_COUNT, f.out.data()));
+    state.SetItemsProcessed(state.iterations() * FILTER_COUNT);
+}
+BENCHMARK(BM_filterEncoded);
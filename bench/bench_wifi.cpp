@@ -0,0 +1,264 @@
+#include <benchmark/benchmark.h>
+#include <opendroneid.h>
+
+#include <cstring>
+
+/*
+ * Building complete Wi-Fi frames for transmission: a message pack with all
+ * message types in a NAN action frame and in a beacon frame, from scratch and
+ * from a prepared frame, and the French beacon element. Receiving beacon
+ * frames as captured from the air, with the elements access points add.
+ */
+
+static const int PACK_MESSAGES = 6;
+static const char MAC[6] = { 0x02, 0x00, 0x5E, 0x10, 0x00, 0x01 };
+static const char SSID[] = "UAS-1596F0123456789ABCDE";
+
+static void buildTestData(ODID_UAS_Data *uas)
+{
+    memset(uas, 0, sizeof(*uas));
+    odid_initUasData(uas);
+    uas->BasicID[0].UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    uas->BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas->BasicID[0].UASID, "1596F0123456789ABCDE");
+    uas->BasicIDValid[0] = 1;
+    uas->Location.Status = ODID_STATUS_AIRBORNE;
+    uas->Location.Latitude = 51.4791;
+    uas->Location.Longitude = -0.0013;
+    uas->LocationValid = 1;
+    uas->Auth[0].AuthType = ODID_AUTH_UAS_ID_SIGNATURE;
+    uas->AuthValid[0] = 1;
+    strcpy(uas->SelfID.Desc, "Survey flight");
+    uas->SelfIDValid = 1;
+    uas->SystemValid = 1;
+    strcpy(uas->OperatorID.OperatorId, "GBR-OP-1234");
+    uas->OperatorIDValid = 1;
+}
+
+static void BM_buildNanActionFrame(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t frame[1024];
+    uint8_t counter = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_wifi_build_message_pack_nan_action_frame(
+            &uas, MAC, counter++, frame, sizeof(frame)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_buildNanActionFrame);
+
+static void BM_buildBeaconFrame(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t frame[1024];
+    uint8_t counter = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_wifi_build_message_pack_beacon_frame(
+            &uas, MAC, SSID, sizeof(SSID) - 1, 100, counter++, frame, sizeof(frame)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_buildBeaconFrame);
+
+static void BM_buildPreparedFrame(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t buf[1024];
+    ODID_Wifi_frame frame;
+    odid_wifi_prepare_frame(&frame, (uint8_t) state.range(0), MAC, SSID, sizeof(SSID) - 1, 100,
+                            buf, sizeof(buf));
+    uint8_t counter = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_wifi_build_prepared_frame(&frame, &uas, counter++));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_buildPreparedFrame)->Arg(ODID_WIFI_NAN_ACTION)->Arg(ODID_WIFI_BEACON);
+
+// Beacon of an access point: DS parameter set, TIM, country, ERP, extended
+// rates, HT capabilities and operation, RSN and WMM, then the ODID element
+static const uint8_t AP_ELEMENTS[] = {
+    0x03, 0x01, 0x06,
+    0x05, 0x04, 0x00, 0x01, 0x00, 0x00,
+    0x07, 0x06, 'F', 'R', 0x20, 0x01, 0x0d, 0x14,
+    0x2a, 0x01, 0x00,
+    0x32, 0x04, 0x0c, 0x12, 0x18, 0x60,
+    0x2d, 0x1a, 0xef, 0x11, 0x17, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3d, 0x16, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x30, 0x14, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00,
+    0x00, 0x0f, 0xac, 0x02, 0x00, 0x00,
+    0xdd, 0x18, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x01, 0x80, 0x00, 0x03, 0xa4, 0x00, 0x00, 0x27, 0xa4,
+    0x00, 0x00, 0x42, 0x43, 0x5e, 0x00, 0x62, 0x32, 0x2f, 0x00,
+};
+
+static int buildCapturedBeacon(uint8_t *frame, size_t size)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t built[512];
+    int len = odid_wifi_build_message_pack_beacon_frame(&uas, MAC, SSID, sizeof(SSID) - 1, 100, 0,
+                                                        built, sizeof(built));
+    // The AP elements go after the SSID and supported rates elements
+    size_t body = 24 + 12 + 2 + (sizeof(SSID) - 1) + 3;
+    if (len < 0 || len + sizeof(AP_ELEMENTS) > size)
+        return -1;
+    memcpy(frame, built, body);
+    memcpy(frame + body, AP_ELEMENTS, sizeof(AP_ELEMENTS));
+    memcpy(frame + body + sizeof(AP_ELEMENTS), built + body, len - body);
+    return len + (int) sizeof(AP_ELEMENTS);
+}
+
+static void BM_findBeaconPack(benchmark::State &state)
+{
+    uint8_t frame[1024];
+    int len = buildCapturedBeacon(frame, sizeof(frame));
+    const uint8_t *pack;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(odid_wifi_find_message_pack_beacon_frame(frame, len, NULL, &pack, NULL));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_findBeaconPack);
+
+static void BM_receiveBeaconFrame(benchmark::State &state)
+{
+    uint8_t frame[1024];
+    int len = buildCapturedBeacon(frame, sizeof(frame));
+    ODID_UAS_Data uas;
+    char mac[6];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_wifi_receive_message_pack_beacon_frame(&uas, mac, frame, len));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_receiveBeaconFrame);
+
+static void BM_findNanActionPack(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t frame[1024];
+    int len = odid_wifi_build_message_pack_nan_action_frame(&uas, MAC, 0, frame, sizeof(frame));
+    ODID_Wifi_nan_attributes attrs;
+    const uint8_t *pack;
+    for (auto _ : state) {
+        odid_wifi_nan_action_frame_attributes(&attrs, frame, len, NULL);
+        benchmark::DoNotOptimize(odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, NULL));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_findNanActionPack);
+
+static void BM_receiveNanActionFrame(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    uint8_t frame[1024];
+    int len = odid_wifi_build_message_pack_nan_action_frame(&uas, MAC, 0, frame, sizeof(frame));
+    char mac[6];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(odid_wifi_receive_message_pack_nan_action_frame(&uas, mac, frame, len));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * PACK_MESSAGES);
+}
+BENCHMARK(BM_receiveNanActionFrame);
+
+static void BM_receiveFrame(benchmark::State &state)
+{
+    ODID_UAS_Data uas;
+    buildTestData(&uas);
+    FRDID_UAS_Data frdid;
+    frdid.Identifier = "ABC00000000000000000000001234";
+    frdid.ANSICTA2063Identifier = "1596F0123456789ABCDE";
+    frdid.Latitude = 48.8584;
+    frdid.Longitude = 2.2945;
+    frdid.Altitude = 120;
+    frdid.Height = 80;
+    frdid.TakeoffLatitude = 48.8580;
+    frdid.TakeoffLongitude = 2.2940;
+    frdid.HorizontalSpeed = 12;
+    frdid.TrueCourse = 215;
+
+    // NAN action, ODID beacon, FRDID beacon and access point beacon frames
+    static uint8_t frames[4][1024];
+    int lens[4];
+    lens[0] = odid_wifi_build_message_pack_nan_action_frame(&uas, MAC, 0, frames[0], sizeof(frames[0]));
+    lens[1] = buildCapturedBeacon(frames[1], sizeof(frames[1]));
+    lens[2] = frdid_wifi_build_beacon_frame(&frdid, MAC, SSID, sizeof(SSID) - 1, 100,
+                                            frames[2], sizeof(frames[2]));
+    memcpy(frames[3], frames[1], lens[1]);
+    lens[3] = lens[1] - (3 + 25 * PACK_MESSAGES + 7);
+
+    static ODID_Wifi_received rx;
+    const int protocols[4] = { ODID_WIFI_PROTOCOL_NAN, ODID_WIFI_PROTOCOL_BEACON, ODID_WIFI_PROTOCOL_FRDID,
+                               ODID_WIFI_PROTOCOL_NONE };
+    for (int i = 0; i < 4; i++) {
+        if (odid_wifi_receive_frame(&rx, frames[i], lens[i]) != protocols[i]) {
+            state.SkipWithError("unexpected protocol");
+            return;
+        }
+    }
+    for (auto _ : state) {
+        for (int i = 0; i < 4; i++)
+            benchmark::DoNotOptimize(odid_wifi_receive_frame(&rx, frames[i], lens[i]));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(BM_receiveFrame);
+
+static void BM_frdidBuild(benchmark::State &state)
+{
+    FRDID_UAS_Data uas;
+    uas.Identifier = "ABC1234567890";
+    uas.ANSICTA2063Identifier = "1596F0123456789ABCDE";
+    uas.Latitude = 48.8584;
+    uas.Longitude = 2.2945;
+    uas.Altitude = 120;
+    uas.Height = 80;
+    uas.TakeoffLatitude = 48.8580;
+    uas.TakeoffLongitude = 2.2940;
+    uas.HorizontalSpeed = 12;
+    uas.TrueCourse = 215;
+    uint8_t buf[256];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frdid_build(&uas, buf, sizeof(buf)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_frdidBuild);
+
+static void BM_frdidDecode(benchmark::State &state)
+{
+    FRDID_UAS_Data uas;
+    uas.Identifier = "ABC00000000000000000000001234";
+    uas.ANSICTA2063Identifier = "1596F0123456789ABCDE";
+    uas.Latitude = 48.8584;
+    uas.Longitude = 2.2945;
+    uas.Altitude = 120;
+    uas.Height = 80;
+    uas.TakeoffLatitude = 48.8580;
+    uas.TakeoffLongitude = 2.2940;
+    uas.HorizontalSpeed = 12;
+    uas.TrueCourse = 215;
+    uint8_t buf[256];
+    int len = frdid_build(&uas, buf, sizeof(buf));
+    char identifier[FRDID_ID_SIZE + 1], ansi[ODID_ID_SIZE + 1];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frdid_decode(&uas, identifier, ansi, buf, len));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_frdidDecode);
@@ -0,0 +1,317 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include <string.h>
+#include "opendroneid.h"
+
+/**
+* Initialize an Authentication page pool on top of caller provided storage
+*
+* @param pool The pool to initialize
+* @param blocks Array of count blocks. Each block holds all pages of one UAS
+* @param count Number of blocks in the array
+*/
+void odid_auth_pool_init(ODID_Auth_pool *pool, ODID_Auth_block *blocks, uint32_t count)
+{
+    if (!pool)
+        return;
+    if (!blocks)
+        count = 0;
+    pool->Blocks = blocks;
+    pool->Count = count;
+    for (uint32_t i = 0; i < count; i++)
+        blocks[i].NextFree = (i + 1 < count) ? i + 1 : ODID_COMPACT_NO_AUTH;
+    pool->FreeHead = count ? 0 : ODID_COMPACT_NO_AUTH;
+}
+
+static uint32_t authBlockAlloc(ODID_Auth_pool *pool)
+{
+    uint32_t index = pool->FreeHead;
+    if (index != ODID_COMPACT_NO_AUTH)
+        pool->FreeHead = pool->Blocks[index].NextFree;
+    return index;
+}
+
+static int authBlockFree(ODID_Auth_pool *pool, uint32_t index)
+{
+    if (!pool || index >= pool->Count)
+        return ODID_FAIL;
+    pool->Blocks[index].NextFree = pool->FreeHead;
+    pool->FreeHead = index;
+    return ODID_SUCCESS;
+}
+
+/**
+* Initialize a compact UAS record to the same default values as
+* odid_initUasData() uses, without any Authentication pages
+*
+* @param compact The record to initialize
+*/
+void odid_compact_init(ODID_UAS_compact *compact)
+{
+    if (!compact)
+        return;
+    ODID_UAS_Data data;
+    odid_initUasData(&data);
+    compact->AuthBlock = ODID_COMPACT_NO_AUTH;
+    odid_uas_to_compact(compact, &data, NULL);
+}
+
+/**
+* Return the Authentication pages of a compact UAS record to the pool
+*
+* @param compact The record. Its Authentication pages are marked invalid
+* @param pool The pool the pages were allocated from. Required if the record
+*             holds a block, which is otherwise kept by the record
+* @return ODID_SUCCESS or ODID_FAIL if the block could not be returned
+*/
+int odid_compact_release(ODID_UAS_compact *compact, ODID_Auth_pool *pool)
+{
+    if (!compact)
+        return ODID_FAIL;
+    compact->AuthValid = 0;
+    if (compact->AuthBlock != ODID_COMPACT_NO_AUTH) {
+        if (authBlockFree(pool, compact->AuthBlock) != ODID_SUCCESS)
+            return ODID_FAIL;
+        compact->AuthBlock = ODID_COMPACT_NO_AUTH;
+    }
+    return ODID_SUCCESS;
+}
+
+static void basicIDToCompact(ODID_BasicID_compact *out, const ODID_BasicID_data *in)
+{
+    out->UAType = (uint8_t) in->UAType;
+    out->IDType = (uint8_t) in->IDType;
+    memcpy(out->UASID, in->UASID, sizeof(out->UASID));
+}
+
+static void basicIDFromCompact(ODID_BasicID_data *out, const ODID_BasicID_compact *in)
+{
+    out->UAType = (ODID_uatype_t) in->UAType;
+    out->IDType = (ODID_idtype_t) in->IDType;
+    memcpy(out->UASID, in->UASID, sizeof(out->UASID));
+}
+
+static void locationToCompact(ODID_Location_compact *out, const ODID_Location_data *in)
+{
+    out->Latitude = in->Latitude;
+    out->Longitude = in->Longitude;
+    out->Direction = in->Direction;
+    out->SpeedHorizontal = in->SpeedHorizontal;
+    out->SpeedVertical = in->SpeedVertical;
+    out->AltitudeBaro = in->AltitudeBaro;
+    out->AltitudeGeo = in->AltitudeGeo;
+    out->Height = in->Height;
+    out->TimeStamp = in->TimeStamp;
+    out->Status = (uint8_t) in->Status;
+    out->HeightType = (uint8_t) in->HeightType;
+    out->HorizAccuracy = (uint8_t) in->HorizAccuracy;
+    out->VertAccuracy = (uint8_t) in->VertAccuracy;
+    out->BaroAccuracy = (uint8_t) in->BaroAccuracy;
+    out->SpeedAccuracy = (uint8_t) in->SpeedAccuracy;
+    out->TSAccuracy = (uint8_t) in->TSAccuracy;
+}
+
+static void locationFromCompact(ODID_Location_data *out, const ODID_Location_compact *in)
+{
+    out->Status = (ODID_status_t) in->Status;
+    out->Direction = in->Direction;
+    out->SpeedHorizontal = in->SpeedHorizontal;
+    out->SpeedVertical = in->SpeedVertical;
+    out->Latitude = in->Latitude;
+    out->Longitude = in->Longitude;
+    out->AltitudeBaro = in->AltitudeBaro;
+    out->AltitudeGeo = in->AltitudeGeo;
+    out->HeightType = (ODID_Height_reference_t) in->HeightType;
+    out->Height = in->Height;
+    out->HorizAccuracy = (ODID_Horizontal_accuracy_t) in->HorizAccuracy;
+    out->VertAccuracy = (ODID_Vertical_accuracy_t) in->VertAccuracy;
+    out->BaroAccuracy = (ODID_Vertical_accuracy_t) in->BaroAccuracy;
+    out->SpeedAccuracy = (ODID_Speed_accuracy_t) in->SpeedAccuracy;
+    out->TSAccuracy = (ODID_Timestamp_accuracy_t) in->TSAccuracy;
+    out->TimeStamp = in->TimeStamp;
+}
+
+static void authToCompact(ODID_Auth_compact *out, const ODID_Auth_data *in)
+{
+    out->Timestamp = in->Timestamp;
+    out->DataPage = in->DataPage;
+    out->AuthType = (uint8_t) in->AuthType;
+    out->LastPageIndex = in->LastPageIndex;
+    out->Length = in->Length;
+    memcpy(out->AuthData, in->AuthData, sizeof(out->AuthData));
+}
+
+static void authFromCompact(ODID_Auth_data *out, const ODID_Auth_compact *in)
+{
+    out->DataPage = in->DataPage;
+    out->AuthType = (ODID_authtype_t) in->AuthType;
+    out->LastPageIndex = in->LastPageIndex;
+    out->Length = in->Length;
+    out->Timestamp = in->Timestamp;
+    memcpy(out->AuthData, in->AuthData, sizeof(out->AuthData));
+}
+
+static void systemToCompact(ODID_System_compact *out, const ODID_System_data *in)
+{
+    out->OperatorLatitude = in->OperatorLatitude;
+    out->OperatorLongitude = in->OperatorLongitude;
+    out->AreaCeiling = in->AreaCeiling;
+    out->AreaFloor = in->AreaFloor;
+    out->OperatorAltitudeGeo = in->OperatorAltitudeGeo;
+    out->Timestamp = in->Timestamp;
+    out->AreaCount = in->AreaCount;
+    out->AreaRadius = in->AreaRadius;
+    out->OperatorLocationType = (uint8_t) in->OperatorLocationType;
+    out->ClassificationType = (uint8_t) in->ClassificationType;
+    out->CategoryEU = (uint8_t) in->CategoryEU;
+    out->ClassEU = (uint8_t) in->ClassEU;
+}
+
+static void systemFromCompact(ODID_System_data *out, const ODID_System_compact *in)
+{
+    out->OperatorLocationType = (ODID_operator_location_type_t) in->OperatorLocationType;
+    out->ClassificationType = (ODID_classification_type_t) in->ClassificationType;
+    out->OperatorLatitude = in->OperatorLatitude;
+    out->OperatorLongitude = in->OperatorLongitude;
+    out->AreaCount = in->AreaCount;
+    out->AreaRadius = in->AreaRadius;
+    out->AreaCeiling = in->AreaCeiling;
+    out->AreaFloor = in->AreaFloor;
+    out->CategoryEU = (ODID_category_EU_t) in->CategoryEU;
+    out->ClassEU = (ODID_class_EU_t) in->ClassEU;
+    out->OperatorAltitudeGeo = in->OperatorAltitudeGeo;
+    out->Timestamp = in->Timestamp;
+}
+
+/**
+* Convert a UAS record to its compact form
+*
+* All fields are copied, also those of messages that are not valid, except
+* for the Authentication pages: only the valid ones are stored, in a block
+* allocated from the pool the first time any page is valid. The block is
+* returned to the pool when no page is valid anymore.
+*
+* @param outCompact The compact record. Must have been initialized with
+*                   odid_compact_init() or a previous conversion
+* @param inData The UAS record to convert
+* @param pool Pool for the Authentication pages. May only be NULL if no page
+*             is valid and the record holds no block
+* @return ODID_SUCCESS or ODID_FAIL if the pool has no free block, or a held
+*         block could not be returned to it. In the latter cases all other
+*         fields have been converted
+*/
+int odid_uas_to_compact(ODID_UAS_compact *outCompact, const ODID_UAS_Data *inData, ODID_Auth_pool *pool)
+{
+    if (!outCompact || !inData)
+        return ODID_FAIL;
+
+    outCompact->BasicIDValid = 0;
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+        basicIDToCompact(&outCompact->BasicID[i], &inData->BasicID[i]);
+        if (inData->BasicIDValid[i])
+            outCompact->BasicIDValid |= (uint8_t) (1 << i);
+    }
+    locationToCompact(&outCompact->Location, &inData->Location);
+    systemToCompact(&outCompact->System, &inData->System);
+    outCompact->SelfID.DescType = (uint8_t) inData->SelfID.DescType;
+    memcpy(outCompact->SelfID.Desc, inData->SelfID.Desc, sizeof(outCompact->SelfID.Desc));
+    outCompact->OperatorID.OperatorIdType = (uint8_t) inData->OperatorID.OperatorIdType;
+    memcpy(outCompact->OperatorID.OperatorId, inData->OperatorID.OperatorId,
+           sizeof(outCompact->OperatorID.OperatorId));
+
+    outCompact->Valid = 0;
+    if (inData->LocationValid)
+        outCompact->Valid |= ODID_COMPACT_LOCATION_VALID;
+    if (inData->SelfIDValid)
+        outCompact->Valid |= ODID_COMPACT_SELF_ID_VALID;
+    if (inData->SystemValid)
+        outCompact->Valid |= ODID_COMPACT_SYSTEM_VALID;
+    if (inData->OperatorIDValid)
+        outCompact->Valid |= ODID_COMPACT_OPERATOR_ID_VALID;
+
+    uint16_t authValid = 0;
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+        if (inData->AuthValid[i])
+            authValid |= (uint16_t) (1 << i);
+    }
+    if (!authValid)
+        return odid_compact_release(outCompact, pool);
+
+    if (outCompact->AuthBlock == ODID_COMPACT_NO_AUTH) {
+        outCompact->AuthValid = 0;
+        if (!pool)
+            return ODID_FAIL;
+        outCompact->AuthBlock = authBlockAlloc(pool);
+        if (outCompact->AuthBlock == ODID_COMPACT_NO_AUTH)
+            return ODID_FAIL;
+    }
+    if (!pool || outCompact->AuthBlock >= pool->Count)
+        return ODID_FAIL;
+
+    ODID_Auth_block *block = &pool->Blocks[outCompact->AuthBlock];
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+        if (authValid & (1 << i))
+            authToCompact(&block->Pages[i], &inData->Auth[i]);
+    }
+    outCompact->AuthValid = authValid;
+    return ODID_SUCCESS;
+}
+
+/**
+* Convert a compact UAS record back to the full form
+*
+* Authentication pages that are not valid get the default values of
+* odid_initAuthData().
+*
+* @param outData The UAS record
+* @param inCompact The compact record to convert
+* @param pool Pool holding the Authentication pages of the compact record
+* @return ODID_SUCCESS or ODID_FAIL if the pages are not in the pool
+*/
+int odid_compact_to_uas(ODID_UAS_Data *outData, const ODID_UAS_compact *inCompact, const ODID_Auth_pool *pool)
+{
+    if (!outData || !inCompact)
+        return ODID_FAIL;
+
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+        basicIDFromCompact(&outData->BasicID[i], &inCompact->BasicID[i]);
+        outData->BasicIDValid[i] = (inCompact->BasicIDValid >> i) & 1;
+    }
+    locationFromCompact(&outData->Location, &inCompact->Location);
+    systemFromCompact(&outData->System, &inCompact->System);
+    outData->SelfID.DescType = (ODID_desctype_t) inCompact->SelfID.DescType;
+    memcpy(outData->SelfID.Desc, inCompact->SelfID.Desc, sizeof(outData->SelfID.Desc));
+    outData->OperatorID.OperatorIdType = (ODID_operatorIdType_t) inCompact->OperatorID.OperatorIdType;
+    memcpy(outData->OperatorID.OperatorId, inCompact->OperatorID.OperatorId,
+           sizeof(outData->OperatorID.OperatorId));
+
+    outData->LocationValid = (inCompact->Valid & ODID_COMPACT_LOCATION_VALID) ? 1 : 0;
+    outData->SelfIDValid = (inCompact->Valid & ODID_COMPACT_SELF_ID_VALID) ? 1 : 0;
+    outData->SystemValid = (inCompact->Valid & ODID_COMPACT_SYSTEM_VALID) ? 1 : 0;
+    outData->OperatorIDValid = (inCompact->Valid & ODID_COMPACT_OPERATOR_ID_VALID) ? 1 : 0;
+
+    const ODID_Auth_block *block = NULL;
+    if (inCompact->AuthValid) {
+        if (!pool || inCompact->AuthBlock >= pool->Count)
+            return ODID_FAIL;
+        block = &pool->Blocks[inCompact->AuthBlock];
+    }
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+        outData->AuthValid[i] = (inCompact->AuthValid >> i) & 1;
+        if (outData->AuthValid[i])
+            authFromCompact(&outData->Auth[i], &block->Pages[i]);
+        else
+            odid_initAuthData(&outData->Auth[i]);
+    }
+    return ODID_SUCCESS;
+}
@@ -0,0 +1,221 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include <math.h>
+#include "opendroneid.h"
+
+#ifndef M_PI
+#define M_PI                3.14159265358979323846
+#endif
+
+#define EARTH_RADIUS        6371008.8   // Mean radius in meters
+#define DEG2RAD             (M_PI / 180)
+#define METERS_PER_DEGREE   (EARTH_RADIUS * DEG2RAD)
+
+/**
+* Initialize a conflict detector on top of caller provided storage
+*
+* The Horizontal, Vertical, LookAhead, MaxSpeed and MaxAge fields of the
+* detector must be set by the caller, this function initializes the others.
+* The spatial index must be initialized by the caller with at least count
+* entries and is used by the detector only. A cell size in the order of the
+* search radius, i.e. Horizontal + (LookAhead * 2 + MaxAge) * MaxSpeed, works
+* best.
+*
+* @param detector       The detector to initialize
+* @param states         Array of count states, one per UAS
+* @param count          Number of UAS
+* @param index          Spatial index of the UAS positions
+* @param candidates     Array of candidateCount UAS ids, used by odid_conflict_update()
+* @param candidateCount Maximum number of UAS compared with an updated one
+* @param timeUnit       Number of time units per second, e.g. 1000 for times in ms
+* @return               ODID_SUCCESS or ODID_FAIL
+*/
+int odid_conflict_init(ODID_Conflict_detector *detector, ODID_Conflict_state *states, uint32_t count,
+                       ODID_Spatial_index *index, uint32_t *candidates, uint32_t candidateCount,
+                       uint64_t timeUnit)
+{
+    if (!detector || !states || !index || !candidates || count == 0 || index->Count < count ||
+        candidateCount == 0 || timeUnit == 0 || !(detector->Horizontal >= 0) ||
+        !(detector->Vertical >= 0) || !(detector->LookAhead >= 0) || !(detector->MaxSpeed >= 0) ||
+        !(detector->MaxAge >= 0))
+        return ODID_FAIL;
+
+    detector->Index = index;
+    detector->States = states;
+    detector->Candidates = candidates;
+    detector->Count = count;
+    detector->CandidateCount = candidateCount;
+    detector->TimeUnit = timeUnit;
+    for (uint32_t i = 0; i < count; i++)
+        odid_spatial_remove(index, i);
+    return ODID_SUCCESS;
+}
+
+/**
+* Stop checking a UAS for conflicts, e.g. when its track is removed
+*
+* @param detector   The conflict detector
+* @param id         Index of the UAS in the states of the detector
+*/
+void odid_conflict_remove(ODID_Conflict_detector *detector, uint32_t id)
+{
+    if (!detector || id >= detector->Count)
+        return;
+    odid_spatial_remove(detector->Index, id);
+}
+
+// Times in [*t0, *t1] at which |p + v * t| <= limit, in a plane or along a line
+static int withinInterval(double a, double b, double c, double *t0, double *t1)
+{
+    // a * t^2 + b * t + c <= 0
+    if (a == 0) {
+        if (c > 0)
+            return 0;
+        *t0 = -INFINITY;
+        *t1 = INFINITY;
+        return 1;
+    }
+    double d = b * b - 4 * a * c;
+    if (d < 0)
+        return 0;
+    d = sqrt(d);
+    *t0 = (-b - d) / (2 * a);
+    *t1 = (-b + d) / (2 * a);
+    return 1;
+}
+
+/*
+ * Compare a UAS with another one, extrapolated to the same time. Positions
+ * are relative to the first UAS in meters, in a local east/north plane.
+ */
+static int comparePair(const ODID_Conflict_detector *detector, const ODID_Conflict_state *own,
+                       const ODID_Conflict_state *other, uint64_t now, ODID_Conflict *conflict)
+{
+    double dt = (now >= other->Time ? (double) (now - other->Time) : -(double) (other->Time - now)) /
+                (double) detector->TimeUnit;
+    double dLon = other->Longitude - own->Longitude;
+    if (dLon >= 180)
+        dLon -= 360;
+    else if (dLon < -180)
+        dLon += 360;
+    double px = dLon * METERS_PER_DEGREE * cos(own->Latitude * DEG2RAD) + (double) other->VelocityEast * dt;
+    double py = (other->Latitude - own->Latitude) * METERS_PER_DEGREE + (double) other->VelocityNorth * dt;
+    double vx = other->VelocityEast - own->VelocityEast;
+    double vy = other->VelocityNorth - own->VelocityNorth;
+    // Without both altitudes, the UAS are taken as vertically close
+    double pz = 0, vz = 0;
+    if (own->Altitude != INV_ALT && other->Altitude != INV_ALT) {
+        pz = (double) other->Altitude + (double) other->VelocityUp * dt - (double) own->Altitude;
+        vz = other->VelocityUp - own->VelocityUp;
+    }
+
+    double h0, h1, v0, v1;
+    double horizontal = detector->Horizontal, vertical = detector->Vertical;
+    if (!withinInterval(vx * vx + vy * vy, 2 * (px * vx + py * vy),
+                        px * px + py * py - horizontal * horizontal, &h0, &h1) ||
+        !withinInterval(vz * vz, 2 * pz * vz, pz * pz - vertical * vertical, &v0, &v1))
+        return 0;
+    double lookAhead = detector->LookAhead;
+    double t0 = h0 > v0 ? h0 : v0, t1 = h1 < v1 ? h1 : v1;
+    if (t0 < 0)
+        t0 = 0;
+    if (t1 > lookAhead)
+        t1 = lookAhead;
+    if (t0 > t1)
+        return 0;
+
+    double speed = vx * vx + vy * vy;
+    double closest = speed > 0 ? -(px * vx + py * vy) / speed : 0;
+    if (closest < 0)
+        closest = 0;
+    else if (closest > lookAhead)
+        closest = lookAhead;
+    conflict->Type = t0 == 0 ? ODID_CONFLICT_NOW : ODID_CONFLICT_PREDICTED;
+    conflict->Time = (float) t0;
+    conflict->Horizontal = (float) hypot(px + vx * closest, py + vy * closest);
+    conflict->Vertical = (float) fabs(pz + vz * closest);
+    return 1;
+}
+
+/**
+* Update the position of a UAS and find the UAS it is in conflict with
+*
+* A conflict is reported when the horizontal and the vertical separations
+* are below their thresholds now, or will be within the look ahead time,
+* with both UAS keeping their velocity. The other UAS are moved forward from
+* their last report to now, and the search for them covers the distance they
+* may have flown since, for reports up to MaxAge old. Older reports are not
+* compared. The altitude is AltitudeGeo, or AltitudeBaro if that is not
+* valid. A position that is not valid removes the UAS from the detector.
+*
+* @param detector   The conflict detector
+* @param id         Index of the UAS in the states of the detector
+* @param now        Time of the position
+* @param location   The Location message data of the UAS
+* @param out        Array receiving at most maxOut conflicts
+* @param maxOut     Size of out
+* @return           Number of conflicts, which can exceed maxOut
+*/
+uint32_t odid_conflict_update(ODID_Conflict_detector *detector, uint32_t id, uint64_t now,
+                              const ODID_Location_data *location, ODID_Conflict *out, uint32_t maxOut)
+{
+    if (!detector || !location || id >= detector->Count || (!out && maxOut > 0))
+        return 0;
+    if (!(location->Latitude >= -90 && location->Latitude <= 90 &&
+          location->Longitude >= -180 && location->Longitude <= 180) ||
+        (location->Latitude == 0 && location->Longitude == 0)) {
+        odid_spatial_remove(detector->Index, id);
+        return 0;
+    }
+
+    ODID_Conflict_state *own = &detector->States[id];
+    own->Latitude = location->Latitude;
+    own->Longitude = location->Longitude;
+    own->Altitude = location->AltitudeGeo != INV_ALT ? location->AltitudeGeo : location->AltitudeBaro;
+    own->VelocityEast = own->VelocityNorth = own->VelocityUp = 0;
+    float speed = 0;
+    if (location->Direction <= MAX_DIR && location->SpeedHorizontal <= MAX_SPEED_H) {
+        speed = location->SpeedHorizontal;
+        own->VelocityEast = speed * (float) sin((double) location->Direction * DEG2RAD);
+        own->VelocityNorth = speed * (float) cos((double) location->Direction * DEG2RAD);
+    }
+    if (location->SpeedVertical >= MIN_SPEED_V && location->SpeedVertical <= MAX_SPEED_V)
+        own->VelocityUp = location->SpeedVertical;
+    own->Time = now;
+
+    // Other UAS may have moved up to MaxAge * MaxSpeed since their last report
+    double radius = detector->Horizontal + detector->LookAhead * (speed + detector->MaxSpeed) +
+                    detector->MaxAge * detector->MaxSpeed;
+    uint32_t candidates = odid_spatial_radius(detector->Index, own->Latitude, own->Longitude, radius,
+                                              detector->Candidates, detector->CandidateCount);
+    if (candidates > detector->CandidateCount)
+        candidates = detector->CandidateCount;
+
+    uint64_t maxAge = (uint64_t) ((double) detector->MaxAge * (double) detector->TimeUnit);
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < candidates; i++) {
+        uint32_t other = detector->Candidates[i];
+        const ODID_Conflict_state *state = &detector->States[other];
+        ODID_Conflict conflict;
+        if (other == id || (now > state->Time && now - state->Time > maxAge) ||
+            !comparePair(detector, own, state, now, &conflict))
+            continue;
+        if (found < maxOut) {
+            conflict.Other = other;
+            out[found] = conflict;
+        }
+        found++;
+    }
+    odid_spatial_update(detector->Index, id, own->Latitude, own->Longitude);
+    return found;
+}
@@ -0,0 +1,545 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include <math.h>
+#include "opendroneid.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define ODID_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#define GEO_PI          3.14159265358979323846
+#define GEO_PIO2        1.57079632679489661923
+#define GEO_PIO4        0.78539816339744830962
+#define GEO_TWO_OVER_PI 0.63661977236758134308
+#define GEO_DEG2RAD     (GEO_PI / 180)
+#define GEO_RAD2DEG     (180 / GEO_PI)
+#define GEO_E7_TO_RAD   (GEO_DEG2RAD / 10000000)
+
+#define EARTH_RADIUS    6371008.8           // Mean radius in meters
+#define WGS84_A         6378137.0           // Semi-major axis in meters
+#define WGS84_E2        6.69437999014E-3    // First eccentricity squared
+
+/*
+ * Polynomial approximations of sin, cos and atan from the Cephes library,
+ * accurate to about 1E-16. The scalar functions are the reference: the SIMD
+ * kernels perform the same double precision operations in the same order,
+ * without fused multiply-add, so that their results are bit-identical.
+ */
+// pi/2 split in three parts for the range reduction
+#define PIO2_1  1.57079625129699707031E0
+#define PIO2_2  7.54978941586159635336E-8
+#define PIO2_3  5.39030285815811905290E-15
+
+#define SIN_0   1.58962301576546568060E-10
+#define SIN_1   -2.50507477628578072866E-8
+#define SIN_2   2.75573136213857245213E-6
+#define SIN_3   -1.98412698295895385996E-4
+#define SIN_4   8.33333333332211858878E-3
+#define SIN_5   -1.66666666666666307295E-1
+
+#define COS_0   -1.13585365213876817300E-11
+#define COS_1   2.08757008419747316778E-9
+#define COS_2   -2.75573141792967388112E-7
+#define COS_3   2.48015872888517045348E-5
+#define COS_4   -1.38888888888730564116E-3
+#define COS_5   4.16666666666665929218E-2
+
+#define ATAN_P0 -8.750608600031904122785E-1
+#define ATAN_P1 -1.615753718733365076637E1
+#define ATAN_P2 -7.500855792314704667340E1
+#define ATAN_P3 -1.228866684490136173410E2
+#define ATAN_P4 -6.485021904942025371773E1
+#define ATAN_Q0 2.485846490142306297962E1
+#define ATAN_Q1 1.650270098316988542046E2
+#define ATAN_Q2 4.328810604912902668951E2
+#define ATAN_Q3 4.853903996359136964868E2
+#define ATAN_Q4 1.945506571482613964425E2
+#define ATAN_MOREBITS 6.123233995736765886130E-17
+
+#define GEO_BLOCK 4
+
+/*
+ * Positions of a block of points in radians, gathered from either input
+ * format. Lanes beyond the number of points are zero filled.
+ */
+typedef struct {
+    double latitude[GEO_BLOCK];
+    double longitude[GEO_BLOCK];
+    double altitude[GEO_BLOCK];
+} geo_block_t;
+
+// Reference position of the relative conversions
+typedef struct {
+    double latitude, longitude;
+    double sinLat, cosLat, sinLon, cosLon;
+    double x, y, z;             // ECEF
+} geo_ref_t;
+
+// Outputs of one block; unused outputs are NULL
+typedef struct {
+    double *out[3];
+} geo_out_t;
+
+typedef void (*geo_kernel_t)(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK]);
+
+static void geoSinCos(double x, double *s, double *c)
+{
+    double q = floor(x * GEO_TWO_OVER_PI + 0.5);
+    double r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+    double z = r * r;
+    double sr = r + r * z * (((((SIN_0 * z + SIN_1) * z + SIN_2) * z + SIN_3) * z + SIN_4) * z + SIN_5);
+    double cr = (1.0 - 0.5 * z) + z * z * (((((COS_0 * z + COS_1) * z + COS_2) * z + COS_3) * z + COS_4) * z + COS_5);
+
+    // Quadrant of x
+    double m = q - 4 * floor(q * 0.25);
+    int swap = m == 1 || m == 3;
+    double sv = swap ? cr : sr;
+    double cv = swap ? sr : cr;
+    *s = m >= 2 ? -sv : sv;
+    *c = (m == 1 || m == 2) ? -cv : cv;
+}
+
+// atan of t in [0, 1]
+static double geoAtan(double t)
+{
+    int big = t > 0.66;
+    double u = big ? (t - 1) / (t + 1) : t;
+    double z = u * u;
+    double p = (((ATAN_P0 * z + ATAN_P1) * z + ATAN_P2) * z + ATAN_P3) * z + ATAN_P4;
+    double q = ((((z + ATAN_Q0) * z + ATAN_Q1) * z + ATAN_Q2) * z + ATAN_Q3) * z + ATAN_Q4;
+    double r = u * (z * p / q) + u;
+    return big ? GEO_PIO4 + (r + 0.5 * ATAN_MOREBITS) : r;
+}
+
+static double geoAtan2(double y, double x)
+{
+    double ax = fabs(x), ay = fabs(y);
+    double mx = ax > ay ? ax : ay;
+    double mn = ax > ay ? ay : ax;
+    double r = geoAtan(mn / (mx == 0 ? 1 : mx));
+    if (ay > ax)
+        r = GEO_PIO2 - r;
+    if (x < 0)
+        r = GEO_PI - r;
+    return y < 0 ? -r : r;
+}
+
+// Earth-centered, earth-fixed coordinates of a position in radians
+static void geoEcef(double latitude, double longitude, double altitude,
+                    double *x, double *y, double *z)
+{
+    double sinLat, cosLat, sinLon, cosLon;
+    geoSinCos(latitude, &sinLat, &cosLat);
+    geoSinCos(longitude, &sinLon, &cosLon);
+    double n = WGS84_A / sqrt(1.0 - WGS84_E2 * (sinLat * sinLat));
+    double nh = n + altitude;
+    *x = nh * cosLat * cosLon;
+    *y = nh * cosLat * sinLon;
+    *z = (n * (1.0 - WGS84_E2) + altitude) * sinLat;
+}
+
+static void distanceKernelScalar(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    for (int i = 0; i < GEO_BLOCK; i++) {
+        double sinDLat, sinDLon, sinLat, cosLat, unused;
+        geoSinCos((blk->latitude[i] - ref->latitude) * 0.5, &sinDLat, &unused);
+        geoSinCos((blk->longitude[i] - ref->longitude) * 0.5, &sinDLon, &unused);
+        geoSinCos(blk->latitude[i], &sinLat, &cosLat);
+        double a = sinDLat * sinDLat + (ref->cosLat * cosLat) * (sinDLon * sinDLon);
+        a = a < 1.0 ? a : 1.0;
+        out[0][i] = (2 * EARTH_RADIUS) * geoAtan2(sqrt(a), sqrt(1.0 - a));
+    }
+}
+
+static void fastDistanceKernelScalar(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    for (int i = 0; i < GEO_BLOCK; i++) {
+        double dLon = blk->longitude[i] - ref->longitude;
+        dLon = dLon - (2 * GEO_PI) * floor(dLon * (0.5 / GEO_PI) + 0.5);
+        double x = dLon * ref->cosLat;
+        double y = blk->latitude[i] - ref->latitude;
+        out[0][i] = EARTH_RADIUS * sqrt(x * x + y * y);
+    }
+}
+
+static void bearingKernelScalar(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    for (int i = 0; i < GEO_BLOCK; i++) {
+        double sinDLon, cosDLon, sinLat, cosLat;
+        geoSinCos(blk->longitude[i] - ref->longitude, &sinDLon, &cosDLon);
+        geoSinCos(blk->latitude[i], &sinLat, &cosLat);
+        double y = sinDLon * cosLat;
+        double x = ref->cosLat * sinLat - (ref->sinLat * cosLat) * cosDLon;
+        double bearing = geoAtan2(y, x) * GEO_RAD2DEG;
+        out[0][i] = bearing < 0 ? bearing + 360 : bearing;
+    }
+}
+
+static void ecefKernelScalar(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    (void) ref;
+    for (int i = 0; i < GEO_BLOCK; i++)
+        geoEcef(blk->latitude[i], blk->longitude[i], blk->altitude[i], &out[0][i], &out[1][i], &out[2][i]);
+}
+
+static void enuKernelScalar(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    for (int i = 0; i < GEO_BLOCK; i++) {
+        double x, y, z;
+        geoEcef(blk->latitude[i], blk->longitude[i], blk->altitude[i], &x, &y, &z);
+        double dx = x - ref->x, dy = y - ref->y, dz = z - ref->z;
+        out[0][i] = ref->cosLon * dy - ref->sinLon * dx;
+        out[1][i] = ref->cosLat * dz - ref->sinLat * (ref->cosLon * dx + ref->sinLon * dy);
+        out[2][i] = ref->sinLat * dz + ref->cosLat * (ref->cosLon * dx + ref->sinLon * dy);
+    }
+}
+
+#ifdef ODID_SIMD_X86
+
+#define AVX_SET(x) _mm256_set1_pd(x)
+
+__attribute__((target("avx2")))
+static __m256d sel_avx2(__m256d mask, __m256d a, __m256d b)
+{
+    return _mm256_blendv_pd(b, a, mask);
+}
+
+__attribute__((target("avx2")))
+static void sincos_avx2(__m256d x, __m256d *s, __m256d *c)
+{
+    __m256d q = _mm256_floor_pd(_mm256_add_pd(_mm256_mul_pd(x, AVX_SET(GEO_TWO_OVER_PI)), AVX_SET(0.5)));
+    __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(q, AVX_SET(PIO2_1)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(q, AVX_SET(PIO2_2)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(q, AVX_SET(PIO2_3)));
+    __m256d z = _mm256_mul_pd(r, r);
+
+    __m256d p = _mm256_add_pd(_mm256_mul_pd(AVX_SET(SIN_0), z), AVX_SET(SIN_1));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(SIN_2));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(SIN_3));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(SIN_4));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(SIN_5));
+    __m256d sr = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), p));
+
+    p = _mm256_add_pd(_mm256_mul_pd(AVX_SET(COS_0), z), AVX_SET(COS_1));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(COS_2));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(COS_3));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(COS_4));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(COS_5));
+    __m256d cr = _mm256_add_pd(_mm256_sub_pd(AVX_SET(1.0), _mm256_mul_pd(AVX_SET(0.5), z)),
+                               _mm256_mul_pd(_mm256_mul_pd(z, z), p));
+
+    __m256d m = _mm256_sub_pd(q, _mm256_mul_pd(AVX_SET(4), _mm256_floor_pd(_mm256_mul_pd(q, AVX_SET(0.25)))));
+    __m256d m1 = _mm256_cmp_pd(m, AVX_SET(1), _CMP_EQ_OQ);
+    __m256d m2 = _mm256_cmp_pd(m, AVX_SET(2), _CMP_EQ_OQ);
+    __m256d m3 = _mm256_cmp_pd(m, AVX_SET(3), _CMP_EQ_OQ);
+    __m256d swap = _mm256_or_pd(m1, m3);
+    __m256d sv = sel_avx2(swap, cr, sr);
+    __m256d cv = sel_avx2(swap, sr, cr);
+    __m256d sign = AVX_SET(-0.0);
+    *s = _mm256_xor_pd(sv, _mm256_and_pd(_mm256_or_pd(m2, m3), sign));
+    *c = _mm256_xor_pd(cv, _mm256_and_pd(_mm256_or_pd(m1, m2), sign));
+}
+
+__attribute__((target("avx2")))
+static __m256d atan_avx2(__m256d t)
+{
+    __m256d big = _mm256_cmp_pd(t, AVX_SET(0.66), _CMP_GT_OQ);
+    __m256d u = sel_avx2(big, _mm256_div_pd(_mm256_sub_pd(t, AVX_SET(1)), _mm256_add_pd(t, AVX_SET(1))), t);
+    __m256d z = _mm256_mul_pd(u, u);
+    __m256d p = _mm256_add_pd(_mm256_mul_pd(AVX_SET(ATAN_P0), z), AVX_SET(ATAN_P1));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(ATAN_P2));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(ATAN_P3));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), AVX_SET(ATAN_P4));
+    __m256d q = _mm256_add_pd(z, AVX_SET(ATAN_Q0));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), AVX_SET(ATAN_Q1));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), AVX_SET(ATAN_Q2));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), AVX_SET(ATAN_Q3));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), AVX_SET(ATAN_Q4));
+    __m256d r = _mm256_add_pd(_mm256_mul_pd(u, _mm256_div_pd(_mm256_mul_pd(z, p), q)), u);
+    __m256d rBig = _mm256_add_pd(AVX_SET(GEO_PIO4), _mm256_add_pd(r, AVX_SET(0.5 * ATAN_MOREBITS)));
+    return sel_avx2(big, rBig, r);
+}
+
+__attribute__((target("avx2")))
+static __m256d atan2_avx2(__m256d y, __m256d x)
+{
+    __m256d sign = AVX_SET(-0.0);
+    __m256d ax = _mm256_andnot_pd(sign, x), ay = _mm256_andnot_pd(sign, y);
+    __m256d axBigger = _mm256_cmp_pd(ax, ay, _CMP_GT_OQ);
+    __m256d mx = sel_avx2(axBigger, ax, ay);
+    __m256d mn = sel_avx2(axBigger, ay, ax);
+    mx = sel_avx2(_mm256_cmp_pd(mx, _mm256_setzero_pd(), _CMP_EQ_OQ), AVX_SET(1), mx);
+    __m256d r = atan_avx2(_mm256_div_pd(mn, mx));
+    r = sel_avx2(_mm256_cmp_pd(ay, ax, _CMP_GT_OQ), _mm256_sub_pd(AVX_SET(GEO_PIO2), r), r);
+    r = sel_avx2(_mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ), _mm256_sub_pd(AVX_SET(GEO_PI), r), r);
+    return _mm256_xor_pd(r, _mm256_and_pd(_mm256_cmp_pd(y, _mm256_setzero_pd(), _CMP_LT_OQ), sign));
+}
+
+__attribute__((target("avx2")))
+static void ecef_avx2(__m256d latitude, __m256d longitude, __m256d altitude,
+                      __m256d *x, __m256d *y, __m256d *z)
+{
+    __m256d sinLat, cosLat, sinLon, cosLon;
+    sincos_avx2(latitude, &sinLat, &cosLat);
+    sincos_avx2(longitude, &sinLon, &cosLon);
+    __m256d n = _mm256_div_pd(AVX_SET(WGS84_A),
+                              _mm256_sqrt_pd(_mm256_sub_pd(AVX_SET(1.0),
+                                             _mm256_mul_pd(AVX_SET(WGS84_E2), _mm256_mul_pd(sinLat, sinLat)))));
+    __m256d nh = _mm256_add_pd(n, altitude);
+    *x = _mm256_mul_pd(_mm256_mul_pd(nh, cosLat), cosLon);
+    *y = _mm256_mul_pd(_mm256_mul_pd(nh, cosLat), sinLon);
+    *z = _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(n, AVX_SET(1.0 - WGS84_E2)), altitude), sinLat);
+}
+
+__attribute__((target("avx2")))
+static void distanceKernelAVX2(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    __m256d latitude = _mm256_loadu_pd(blk->latitude);
+    __m256d longitude = _mm256_loadu_pd(blk->longitude);
+    __m256d sinDLat, sinDLon, sinLat, cosLat, unused;
+    sincos_avx2(_mm256_mul_pd(_mm256_sub_pd(latitude, AVX_SET(ref->latitude)), AVX_SET(0.5)), &sinDLat, &unused);
+    sincos_avx2(_mm256_mul_pd(_mm256_sub_pd(longitude, AVX_SET(ref->longitude)), AVX_SET(0.5)), &sinDLon, &unused);
+    sincos_avx2(latitude, &sinLat, &cosLat);
+    __m256d a = _mm256_add_pd(_mm256_mul_pd(sinDLat, sinDLat),
+                              _mm256_mul_pd(_mm256_mul_pd(AVX_SET(ref->cosLat), cosLat),
+                                            _mm256_mul_pd(sinDLon, sinDLon)));
+    a = sel_avx2(_mm256_cmp_pd(a, AVX_SET(1.0), _CMP_LT_OQ), a, AVX_SET(1.0));
+    __m256d c = atan2_avx2(_mm256_sqrt_pd(a), _mm256_sqrt_pd(_mm256_sub_pd(AVX_SET(1.0), a)));
+    _mm256_storeu_pd(out[0], _mm256_mul_pd(AVX_SET(2 * EARTH_RADIUS), c));
+}
+
+__attribute__((target("avx2")))
+static void fastDistanceKernelAVX2(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    __m256d dLon = _mm256_sub_pd(_mm256_loadu_pd(blk->longitude), AVX_SET(ref->longitude));
+    __m256d turns = _mm256_floor_pd(_mm256_add_pd(_mm256_mul_pd(dLon, AVX_SET(0.5 / GEO_PI)), AVX_SET(0.5)));
+    dLon = _mm256_sub_pd(dLon, _mm256_mul_pd(AVX_SET(2 * GEO_PI), turns));
+    __m256d x = _mm256_mul_pd(dLon, AVX_SET(ref->cosLat));
+    __m256d y = _mm256_sub_pd(_mm256_loadu_pd(blk->latitude), AVX_SET(ref->latitude));
+    __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)));
+    _mm256_storeu_pd(out[0], _mm256_mul_pd(AVX_SET(EARTH_RADIUS), d));
+}
+
+__attribute__((target("avx2")))
+static void bearingKernelAVX2(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    __m256d sinDLon, cosDLon, sinLat, cosLat;
+    sincos_avx2(_mm256_sub_pd(_mm256_loadu_pd(blk->longitude), AVX_SET(ref->longitude)), &sinDLon, &cosDLon);
+    sincos_avx2(_mm256_loadu_pd(blk->latitude), &sinLat, &cosLat);
+    __m256d y = _mm256_mul_pd(sinDLon, cosLat);
+    __m256d x = _mm256_sub_pd(_mm256_mul_pd(AVX_SET(ref->cosLat), sinLat),
+                              _mm256_mul_pd(_mm256_mul_pd(AVX_SET(ref->sinLat), cosLat), cosDLon));
+    __m256d bearing = _mm256_mul_pd(atan2_avx2(y, x), AVX_SET(GEO_RAD2DEG));
+    __m256d negative = _mm256_cmp_pd(bearing, _mm256_setzero_pd(), _CMP_LT_OQ);
+    _mm256_storeu_pd(out[0], sel_avx2(negative, _mm256_add_pd(bearing, AVX_SET(360)), bearing));
+}
+
+__attribute__((target("avx2")))
+static void ecefKernelAVX2(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    (void) ref;
+    __m256d x, y, z;
+    ecef_avx2(_mm256_loadu_pd(blk->latitude), _mm256_loadu_pd(blk->longitude),
+              _mm256_loadu_pd(blk->altitude), &x, &y, &z);
+    _mm256_storeu_pd(out[0], x);
+    _mm256_storeu_pd(out[1], y);
+    _mm256_storeu_pd(out[2], z);
+}
+
+__attribute__((target("avx2")))
+static void enuKernelAVX2(const geo_ref_t *ref, const geo_block_t *blk, double out[3][GEO_BLOCK])
+{
+    __m256d x, y, z;
+    ecef_avx2(_mm256_loadu_pd(blk->latitude), _mm256_loadu_pd(blk->longitude),
+              _mm256_loadu_pd(blk->altitude), &x, &y, &z);
+    __m256d dx = _mm256_sub_pd(x, AVX_SET(ref->x));
+    __m256d dy = _mm256_sub_pd(y, AVX_SET(ref->y));
+    __m256d dz = _mm256_sub_pd(z, AVX_SET(ref->z));
+    __m256d cosLat = AVX_SET(ref->cosLat), sinLat = AVX_SET(ref->sinLat);
+    __m256d cosLon = AVX_SET(ref->cosLon), sinLon = AVX_SET(ref->sinLon);
+    __m256d horizontal = _mm256_add_pd(_mm256_mul_pd(cosLon, dx), _mm256_mul_pd(sinLon, dy));
+    _mm256_storeu_pd(out[0], _mm256_sub_pd(_mm256_mul_pd(cosLon, dy), _mm256_mul_pd(sinLon, dx)));
+    _mm256_storeu_pd(out[1], _mm256_sub_pd(_mm256_mul_pd(cosLat, dz), _mm256_mul_pd(sinLat, horizontal)));
+    _mm256_storeu_pd(out[2], _mm256_add_pd(_mm256_mul_pd(sinLat, dz), _mm256_mul_pd(cosLat, horizontal)));
+}
+
+#endif // ODID_SIMD_X86
+
+/*
+ * Kernels of each operation, indexed by instruction set. SSE2 uses the
+ * scalar kernels, which the compiler already builds with SSE2 on x86-64.
+ */
+enum { GEO_DISTANCE, GEO_DISTANCE_FAST, GEO_BEARING, GEO_ECEF, GEO_ENU, GEO_OPERATIONS };
+
+static const geo_kernel_t scalarKernels[GEO_OPERATIONS] = {
+    distanceKernelScalar, fastDistanceKernelScalar, bearingKernelScalar,
+    ecefKernelScalar, enuKernelScalar };
+
+#ifdef ODID_SIMD_X86
+static const geo_kernel_t avx2Kernels[GEO_OPERATIONS] = {
+    distanceKernelAVX2, fastDistanceKernelAVX2, bearingKernelAVX2,
+    ecefKernelAVX2, enuKernelAVX2 };
+#endif
+
+// Degrees are used when both are set, otherwise degE7, see geoBatch()
+static void gatherGeoBlock(geo_block_t *blk, const ODID_Geo_points *points, int degrees,
+                           size_t offset, size_t count)
+{
+    for (size_t i = 0; i < GEO_BLOCK; i++) {
+        size_t o = offset + i;
+        if (i >= count) {
+            blk->latitude[i] = blk->longitude[i] = blk->altitude[i] = 0;
+        } else if (degrees) {
+            blk->latitude[i] = points->Latitude[o] * GEO_DEG2RAD;
+            blk->longitude[i] = points->Longitude[o] * GEO_DEG2RAD;
+        } else {
+            blk->latitude[i] = points->LatitudeE7[o] * GEO_E7_TO_RAD;
+            blk->longitude[i] = points->LongitudeE7[o] * GEO_E7_TO_RAD;
+        }
+        if (i < count)
+            blk->altitude[i] = points->Altitude ? points->Altitude[o] : 0;
+    }
+}
+
+static int geoBatch(int operation, const ODID_Geo_points *points, size_t count,
+                    double latitude, double longitude, double altitude,
+                    double *out0, double *out1, double *out2)
+{
+    if (!points || !out0 || (operation >= GEO_ECEF && (!out1 || !out2)))
+        return ODID_FAIL;
+    int degrees = points->Latitude && points->Longitude;
+    if (count && !degrees && !(points->LatitudeE7 && points->LongitudeE7))
+        return ODID_FAIL;
+
+    geo_ref_t ref;
+    ref.latitude = latitude * GEO_DEG2RAD;
+    ref.longitude = longitude * GEO_DEG2RAD;
+    geoSinCos(ref.latitude, &ref.sinLat, &ref.cosLat);
+    geoSinCos(ref.longitude, &ref.sinLon, &ref.cosLon);
+    geoEcef(ref.latitude, ref.longitude, altitude, &ref.x, &ref.y, &ref.z);
+
+    geo_kernel_t kernel = scalarKernels[operation];
+#ifdef ODID_SIMD_X86
+    if (odid_simd_selected() == ODID_SIMD_AVX2)
+        kernel = avx2Kernels[operation];
+#endif
+
+    double *outs[3] = { out0, out1, out2 };
+    geo_block_t blk;
+    double result[3][GEO_BLOCK];
+    for (size_t i = 0; i < count; i += GEO_BLOCK) {
+        size_t n = count - i < GEO_BLOCK ? count - i : GEO_BLOCK;
+        gatherGeoBlock(&blk, points, degrees, i, n);
+        kernel(&ref, &blk, result);
+        for (int j = 0; j < 3; j++) {
+            if (!outs[j] || (j > 0 && operation < GEO_ECEF))
+                continue;
+            for (size_t k = 0; k < n; k++)
+                outs[j][i + k] = result[j][k];
+        }
+    }
+    return ODID_SUCCESS;
+}
+
+/**
+* Compute the great circle distances from a reference position to an array
+* of positions, with the haversine formula on a spherical earth
+*
+* @param points     The positions, see ODID_Geo_points
+* @param count      Number of positions
+* @param latitude   Latitude of the reference in degrees
+* @param longitude  Longitude of the reference in degrees
+* @param distance   Array receiving count distances in meters
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geo_distance(const ODID_Geo_points *points, size_t count,
+                      double latitude, double longitude, double *distance)
+{
+    return geoBatch(GEO_DISTANCE, points, count, latitude, longitude, 0, distance, NULL, NULL);
+}
+
+/**
+* Approximate the distances from a reference position to an array of
+* positions, on an equirectangular projection at the reference latitude
+*
+* Much faster than odid_geo_distance(), with an error below 0.1 % for
+* distances up to a few tens of km away from the poles.
+*
+* @param points     The positions, see ODID_Geo_points
+* @param count      Number of positions
+* @param latitude   Latitude of the reference in degrees
+* @param longitude  Longitude of the reference in degrees
+* @param distance   Array receiving count distances in meters
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geo_distance_fast(const ODID_Geo_points *points, size_t count,
+                           double latitude, double longitude, double *distance)
+{
+    return geoBatch(GEO_DISTANCE_FAST, points, count, latitude, longitude, 0, distance, NULL, NULL);
+}
+
+/**
+* Compute the initial great circle bearings from a reference position to an
+* array of positions
+*
+* @param points     The positions, see ODID_Geo_points
+* @param count      Number of positions
+* @param latitude   Latitude of the reference in degrees
+* @param longitude  Longitude of the reference in degrees
+* @param bearing    Array receiving count bearings in degrees clockwise from
+*                   true north, in [0, 360)
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geo_bearing(const ODID_Geo_points *points, size_t count,
+                     double latitude, double longitude, double *bearing)
+{
+    return geoBatch(GEO_BEARING, points, count, latitude, longitude, 0, bearing, NULL, NULL);
+}
+
+/**
+* Convert an array of WGS84 positions to earth-centered, earth-fixed
+* coordinates
+*
+* @param points The positions, see ODID_Geo_points
+* @param count  Number of positions
+* @param x      Array receiving count X coordinates in meters
+* @param y      Array receiving count Y coordinates in meters
+* @param z      Array receiving count Z coordinates in meters
+* @return       ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geo_to_ecef(const ODID_Geo_points *points, size_t count, double *x, double *y, double *z)
+{
+    return geoBatch(GEO_ECEF, points, count, 0, 0, 0, x, y, z);
+}
+
+/**
+* Convert an array of WGS84 positions to local east, north, up coordinates
+* around a reference position, e.g. a sensor or a protected site
+*
+* @param points     The positions, see ODID_Geo_points
+* @param count      Number of positions
+* @param latitude   Latitude of the reference in degrees
+* @param longitude  Longitude of the reference in degrees
+* @param altitude   Altitude of the reference in meters above the ellipsoid
+* @param east       Array receiving count east coordinates in meters
+* @param north      Array receiving count north coordinates in meters
+* @param up         Array receiving count up coordinates in meters
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geo_to_enu(const ODID_Geo_points *points, size_t count,
+                    double latitude, double longitude, double altitude,
+                    double *east, double *north, double *up)
+{
+    return geoBatch(GEO_ENU, points, count, latitude, longitude, altitude, east, north, up);
+}
@@ -0,0 +1,572 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include <math.h>
+#include <string.h>
+#include "opendroneid.h"
+
+/*
+ * Called by odid_geofence_swap() while it waits for the checks that use the
+ * previous zone set. Can be defined by the build, e.g. to a FreeRTOS
+ * taskYIELD(); without a scheduler to yield to the wait just spins.
+ */
+#ifndef ODID_GEOFENCE_YIELD
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO)
+#include <Arduino.h>
+#define ODID_GEOFENCE_YIELD() yield()
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define ODID_GEOFENCE_YIELD() sched_yield()
+#else
+#define ODID_GEOFENCE_YIELD() do { } while (0)
+#endif
+#endif
+
+#ifndef M_PI
+#define M_PI                3.14159265358979323846
+#endif
+
+#define EARTH_RADIUS        6371008.8   // Mean radius in meters
+#define DEG2RAD             (M_PI / 180)
+#define METERS_PER_DEGREE   (EARTH_RADIUS * DEG2RAD)
+
+// Longitude difference in degrees, in [-180, 180)
+static double wrapLongitude(double delta)
+{
+    if (delta >= 180)
+        delta -= 360;
+    else if (delta < -180)
+        delta += 360;
+    return delta;
+}
+
+static int validPosition(double latitude, double longitude)
+{
+    if (!(latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180))
+        return 0;
+    return latitude != 0 || longitude != 0;
+}
+
+static int32_t cellX(const ODID_Geofence_zones *set, double longitude)
+{
+    int32_t x = (int32_t) floor((longitude + 180) / set->CellSize);
+    return x < set->Columns ? x : set->Columns - 1;
+}
+
+static int32_t cellY(const ODID_Geofence_zones *set, double latitude)
+{
+    int32_t y = (int32_t) floor((latitude + 90) / set->CellSize);
+    return y < set->Rows ? y : set->Rows - 1;
+}
+
+static uint32_t cellBucket(const ODID_Geofence_zones *set, int32_t x, int32_t y)
+{
+    return (((uint32_t) x * 73856093u) ^ ((uint32_t) y * 19349663u)) & set->BucketMask;
+}
+
+// Number of grid columns from x0 to x1, wrapping around the antimeridian
+static int32_t cellColumns(const ODID_Geofence_zones *set, int32_t x0, int32_t x1, int crosses)
+{
+    int32_t columns = crosses ? x1 + set->Columns - x0 + 1 : x1 - x0 + 1;
+    return columns < set->Columns ? columns : set->Columns;
+}
+
+static uint32_t zoneRefCount(const ODID_Geofence_zones *set, const ODID_Geofence_zone *zone)
+{
+    int32_t columns = cellColumns(set, zone->CellX, cellX(set, zone->LonMax), zone->LonMin > zone->LonMax);
+    return (uint32_t) columns * (uint32_t) (cellY(set, zone->LatMax) - zone->CellY + 1);
+}
+
+/**
+* Initialize a zone set on top of caller provided zones and vertices
+*
+* The Id, FirstVertex, VertexCount, Floor, Ceiling and Dwell fields of the
+* zones must be set by the caller, this function computes their bounding
+* boxes. The vertices of a zone are given in order, either way round, and
+* its edges must span less than 180 degrees of longitude. RefCount is then
+* the number of references to provide to odid_geofence_zones_build(). A cell
+* size in the order of the size of typical zones works best, e.g. 0.05
+* degrees for airports.
+*
+* @param set            The zone set to initialize
+* @param zones          Array of zoneCount zones
+* @param zoneCount      Number of zones
+* @param vertices       Array of vertexCount vertices used by the zones
+* @param vertexCount    Number of vertices
+* @param cellSize       Size of the grid cells in degrees
+* @return               ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geofence_zones_init(ODID_Geofence_zones *set, ODID_Geofence_zone *zones, uint32_t zoneCount,
+                             const ODID_Geofence_vertex *vertices, uint32_t vertexCount, double cellSize)
+{
+    if (!set || (!zones && zoneCount > 0) || (!vertices && vertexCount > 0) ||
+        zoneCount == ODID_GEOFENCE_NONE || !(cellSize >= 1E-5 && cellSize <= 180))
+        return ODID_FAIL;
+
+    set->Zones = zones;
+    set->Vertices = vertices;
+    set->Refs = NULL;
+    set->Buckets = NULL;
+    set->ZoneCount = zoneCount;
+    set->VertexCount = vertexCount;
+    set->RefCount = 0;
+    set->BucketMask = 0;
+    set->CellSize = cellSize;
+    set->Columns = (int32_t) ceil(360 / cellSize);
+    set->Rows = (int32_t) ceil(180 / cellSize);
+
+    uint64_t refCount = 0;
+    for (uint32_t i = 0; i < zoneCount; i++) {
+        ODID_Geofence_zone *zone = &zones[i];
+        if (zone->VertexCount < 3 || zone->FirstVertex > vertexCount ||
+            zone->VertexCount > vertexCount - zone->FirstVertex)
+            return ODID_FAIL;
+
+        // Longitudes relative to the first vertex, so that zones may cross the antimeridian
+        const ODID_Geofence_vertex *v = &vertices[zone->FirstVertex];
+        double lonMin = 0, lonMax = 0, lon = 0;
+        zone->LatMin = zone->LatMax = v[0].Latitude;
+        for (uint32_t j = 0; j < zone->VertexCount; j++) {
+            if (!(v[j].Latitude >= -90 && v[j].Latitude <= 90 &&
+                  v[j].Longitude >= -180 && v[j].Longitude <= 180))
+                return ODID_FAIL;
+            if (j > 0)
+                lon += wrapLongitude(v[j].Longitude - v[j - 1].Longitude);
+            lonMin = lon < lonMin ? lon : lonMin;
+            lonMax = lon > lonMax ? lon : lonMax;
+            zone->LatMin = v[j].Latitude < zone->LatMin ? v[j].Latitude : zone->LatMin;
+            zone->LatMax = v[j].Latitude > zone->LatMax ? v[j].Latitude : zone->LatMax;
+        }
+        if (lonMax - lonMin >= 360)
+            return ODID_FAIL;
+        zone->LonMin = v[0].Longitude + lonMin;
+        if (zone->LonMin < -180)
+            zone->LonMin += 360;
+        zone->LonMax = v[0].Longitude + lonMax;
+        if (zone->LonMax > 180)
+            zone->LonMax -= 360;
+        zone->CellX = cellX(set, zone->LonMin);
+        zone->CellY = cellY(set, zone->LatMin);
+        refCount += zoneRefCount(set, zone);
+    }
+    if (refCount >= UINT32_MAX)
+        return ODID_FAIL;
+    set->RefCount = (uint32_t) refCount;
+    return ODID_SUCCESS;
+}
+
+/**
+* Index the zones of a zone set by grid cell
+*
+* The references of the grid cells are hashed into bucketCount lists, which
+* are stored one after the other in refs. The zone set must not be changed
+* once it is in use by a geofence.
+*
+* @param set            A zone set initialized by odid_geofence_zones_init()
+* @param buckets        Array of bucketCount + 1 offsets into refs
+* @param bucketCount    Power of two, e.g. the smallest one not below RefCount
+* @param refs           Array of refCount references
+* @param refCount       At least the RefCount of the zone set
+* @return               ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geofence_zones_build(ODID_Geofence_zones *set, uint32_t *buckets, uint32_t bucketCount,
+                              ODID_Geofence_ref *refs, uint32_t refCount)
+{
+    if (!set || !buckets || (!refs && set->RefCount > 0) || refCount < set->RefCount ||
+        bucketCount == 0 || bucketCount == UINT32_MAX || (bucketCount & (bucketCount - 1)) != 0)
+        return ODID_FAIL;
+
+    set->Buckets = buckets;
+    set->Refs = refs;
+    set->BucketMask = bucketCount - 1;
+    memset(buckets, 0, (bucketCount + 1) * sizeof(*buckets));
+
+    // Count the references of each bucket, then place them from the end of the buckets down
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < set->ZoneCount; i++) {
+            const ODID_Geofence_zone *zone = &set->Zones[i];
+            int32_t columns = cellColumns(set, zone->CellX, cellX(set, zone->LonMax),
+                                          zone->LonMin > zone->LonMax);
+            int32_t y1 = cellY(set, zone->LatMax);
+            for (int32_t y = zone->CellY; y <= y1; y++) {
+                for (int32_t c = 0; c < columns; c++) {
+                    int32_t x = (zone->CellX + c) % set->Columns;
+                    uint32_t bucket = cellBucket(set, x, y);
+                    if (pass == 0) {
+                        buckets[bucket]++;
+                        continue;
+                    }
+                    ODID_Geofence_ref *ref = &refs[--buckets[bucket]];
+                    ref->CellX = x;
+                    ref->CellY = y;
+                    ref->Zone = i;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (uint32_t b = 1; b <= bucketCount; b++)
+                buckets[b] += buckets[b - 1];
+        }
+    }
+    return ODID_SUCCESS;
+}
+
+// Even-odd rule, with the point at the origin and x in degrees of longitude
+static int zoneContains(const ODID_Geofence_zones *set, const ODID_Geofence_zone *zone,
+                        double latitude, double longitude)
+{
+    if (latitude < zone->LatMin || latitude > zone->LatMax)
+        return 0;
+    if (zone->LonMin <= zone->LonMax ?
+        (longitude < zone->LonMin || longitude > zone->LonMax) :
+        (longitude < zone->LonMin && longitude > zone->LonMax))
+        return 0;
+
+    const ODID_Geofence_vertex *v = &set->Vertices[zone->FirstVertex];
+    const ODID_Geofence_vertex *prev = &v[zone->VertexCount - 1];
+    double ax = wrapLongitude(prev->Longitude - longitude), ay = prev->Latitude - latitude;
+    int inside = 0;
+    for (uint32_t i = 0; i < zone->VertexCount; i++) {
+        double bx = wrapLongitude(v[i].Longitude - longitude), by = v[i].Latitude - latitude;
+        if ((ay > 0) != (by > 0) && ax + ay * (bx - ax) / (ay - by) > 0)
+            inside = !inside;
+        ax = bx;
+        ay = by;
+    }
+    return inside;
+}
+
+// Whether an altitude range overlaps the floor and ceiling of a zone. INV_ALT is unbounded
+static int zoneOverlaps(const ODID_Geofence_zone *zone, float floor, float ceiling)
+{
+    if (zone->Floor != INV_ALT && ceiling != INV_ALT && ceiling < zone->Floor)
+        return 0;
+    if (zone->Ceiling != INV_ALT && floor != INV_ALT && floor > zone->Ceiling)
+        return 0;
+    return 1;
+}
+
+/**
+* Find the zones of a zone set that contain a position
+*
+* @param set        A zone set built by odid_geofence_zones_build()
+* @param latitude   Latitude in degrees
+* @param longitude  Longitude in degrees
+* @param altitude   Geodetic altitude in meters. INV_ALT matches all altitudes
+* @param out        Array receiving the indexes of at most maxOut zones
+* @param maxOut     Size of out
+* @return           Number of zones containing the position, which can exceed maxOut
+*/
+uint32_t odid_geofence_zones_find(const ODID_Geofence_zones *set, double latitude, double longitude,
+                                  float altitude, uint32_t *out, uint32_t maxOut)
+{
+    if (!set || !set->Buckets || (!out && maxOut > 0) ||
+        !(latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180))
+        return 0;
+
+    int32_t x = cellX(set, longitude), y = cellY(set, latitude);
+    uint32_t bucket = cellBucket(set, x, y);
+    uint32_t found = 0;
+    for (uint32_t r = set->Buckets[bucket]; r < set->Buckets[bucket + 1]; r++) {
+        const ODID_Geofence_ref *ref = &set->Refs[r];
+        if (ref->CellX != x || ref->CellY != y)
+            continue;
+        const ODID_Geofence_zone *zone = &set->Zones[ref->Zone];
+        if (!zoneOverlaps(zone, altitude, altitude) || !zoneContains(set, zone, latitude, longitude))
+            continue;
+        if (found < maxOut)
+            out[found] = ref->Zone;
+        found++;
+    }
+    return found;
+}
+
+/**
+* Initialize a geofence without zones on top of caller provided storage
+*
+* Each UAS, e.g. each track of a track table, is identified by its index into
+* the states and must only be checked by one thread at a time. Each thread
+* that checks positions uses its own reader index.
+*
+* @param fence          The geofence to initialize
+* @param states         Array of count states, one per UAS
+* @param count          Number of UAS
+* @param readerEpochs   Array of readerCount epochs, one per checking thread
+* @param readerCount    Number of checking threads
+* @param callback       Called for each event, or NULL
+* @param context        Passed to the callback
+* @return               ODID_SUCCESS or ODID_FAIL
+*/
+int odid_geofence_init(ODID_Geofence *fence, ODID_Geofence_state *states, uint32_t count,
+                       uint64_t *readerEpochs, uint32_t readerCount,
+                       ODID_geofence_fn callback, void *context)
+{
+    if (!fence || !states || !readerEpochs || count == 0 || readerCount == 0)
+        return ODID_FAIL;
+
+    fence->Zones = NULL;
+    fence->States = states;
+    fence->ReaderEpochs = readerEpochs;
+    fence->Count = count;
+    fence->ReaderCount = readerCount;
+    fence->Epoch = 1;
+    fence->Callback = callback;
+    fence->Context = context;
+    for (uint32_t i = 0; i < count; i++)
+        states[i].Inside = 0;
+    for (uint32_t i = 0; i < readerCount; i++)
+        readerEpochs[i] = 0;
+    return ODID_SUCCESS;
+}
+
+/*
+ * The __atomic builtins are those of GCC and Clang, which includes the
+ * ESP32 toolchains.
+ *
+ * A reader publishes the current epoch before it loads the zone set, and
+ * clears its epoch when done. A reader that loaded the old zone set did so
+ * before the writer bumped the epoch, so it is seen with an older epoch.
+ */
+static const ODID_Geofence_zones *readLock(ODID_Geofence *fence, uint32_t reader)
+{
+    uint64_t epoch = __atomic_load_n(&fence->Epoch, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&fence->ReaderEpochs[reader], epoch, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&fence->Zones, __ATOMIC_SEQ_CST);
+}
+
+static void readUnlock(ODID_Geofence *fence, uint32_t reader)
+{
+    __atomic_store_n(&fence->ReaderEpochs[reader], 0, __ATOMIC_RELEASE);
+}
+
+/**
+* Replace the zone set of a geofence while other threads keep checking
+*
+* Waits until no check uses the previous zone set anymore, which is then
+* returned to the caller for reuse. Must not be called from the callback, or
+* concurrently with itself. The states of the UAS are kept: zones that are
+* missing from the new zone set are exited at the next check of each UAS.
+*
+* @param fence  The geofence
+* @param set    Zone set built by odid_geofence_zones_build(), or NULL for none
+* @return       The previous zone set, or NULL. Set itself if it is not built
+*/
+ODID_Geofence_zones *odid_geofence_swap(ODID_Geofence *fence, ODID_Geofence_zones *set)
+{
+    if (!fence || (set && !set->Buckets))
+        return set;
+
+    ODID_Geofence_zones *old = __atomic_exchange_n(&fence->Zones, set, __ATOMIC_SEQ_CST);
+    uint64_t epoch = __atomic_add_fetch(&fence->Epoch, 1, __ATOMIC_SEQ_CST);
+    for (uint32_t i = 0; i < fence->ReaderCount; i++) {
+        for (;;) {
+            uint64_t reader = __atomic_load_n(&fence->ReaderEpochs[i], __ATOMIC_ACQUIRE);
+            if (reader == 0 || reader >= epoch)
+                break;
+            ODID_GEOFENCE_YIELD();
+        }
+    }
+    return old;
+}
+
+/**
+* Clear the zones a UAS is inside without exit events, e.g. when its track is removed
+*
+* @param fence  The geofence
+* @param uas    Index of the UAS in the states of the geofence
+*/
+void odid_geofence_forget(ODID_Geofence *fence, uint32_t uas)
+{
+    if (!fence || uas >= fence->Count)
+        return;
+    fence->States[uas].Inside = 0;
+}
+
+static void notify(ODID_Geofence *fence, uint32_t uas, uint32_t zoneId, ODID_geofence_event_t event)
+{
+    if (fence->Callback)
+        fence->Callback(fence, uas, zoneId, event, fence->Context);
+}
+
+/**
+* Check the position of a UAS against the zones of a geofence
+*
+* Calls the callback for each zone the UAS exited, entered, or has been in
+* for the Dwell time of the zone. The altitude is AltitudeGeo, or
+* AltitudeBaro if that is not valid. Without a valid position, the UAS is
+* considered to stay in the zones it is in.
+*
+* @param fence      The geofence
+* @param reader     Index of the calling thread in the reader epochs
+* @param uas        Index of the UAS in the states of the geofence
+* @param now        Current time, in the unit of the Dwell times
+* @param location   Position of the UAS
+* @return           Number of zones the UAS is inside
+*/
+uint32_t odid_geofence_check(ODID_Geofence *fence, uint32_t reader, uint32_t uas, uint64_t now,
+                             const ODID_Location_data *location)
+{
+    if (!fence || !location || reader >= fence->ReaderCount || uas >= fence->Count)
+        return 0;
+    ODID_Geofence_state *state = &fence->States[uas];
+    if (!validPosition(location->Latitude, location->Longitude))
+        return state->Inside;
+
+    const ODID_Geofence_zones *set = readLock(fence, reader);
+    uint32_t found[ODID_GEOFENCE_MAX_INSIDE];
+    uint32_t count = 0;
+    if (set) {
+        float altitude = location->AltitudeGeo != INV_ALT ? location->AltitudeGeo : location->AltitudeBaro;
+        count = odid_geofence_zones_find(set, location->Latitude, location->Longitude,
+                                         altitude, found, ODID_GEOFENCE_MAX_INSIDE);
+        if (count > ODID_GEOFENCE_MAX_INSIDE)
+            count = ODID_GEOFENCE_MAX_INSIDE;
+    }
+
+    // Exits, keeping the remaining zones in order
+    uint32_t kept = 0;
+    uint8_t dwelled = 0;
+    for (uint32_t i = 0; i < state->Inside; i++) {
+        uint32_t j = 0;
+        while (j < count && set->Zones[found[j]].Id != state->Zones[i])
+            j++;
+        if (j == count) {
+            notify(fence, uas, state->Zones[i], ODID_GEOFENCE_EXIT);
+            continue;
+        }
+        state->Zones[kept] = state->Zones[i];
+        state->Entered[kept] = state->Entered[i];
+        dwelled |= (uint8_t) (((state->Dwelled >> i) & 1) << kept);
+        kept++;
+    }
+    state->Inside = (uint8_t) kept;
+    state->Dwelled = dwelled;
+
+    for (uint32_t j = 0; j < count; j++) {
+        const ODID_Geofence_zone *zone = &set->Zones[found[j]];
+        uint32_t i = 0;
+        while (i < state->Inside && state->Zones[i] != zone->Id)
+            i++;
+        if (i == state->Inside) {
+            state->Zones[i] = zone->Id;
+            state->Entered[i] = now;
+            state->Inside++;
+            notify(fence, uas, zone->Id, ODID_GEOFENCE_ENTER);
+        }
+        if (zone->Dwell != 0 && !(state->Dwelled & (1 << i)) && now - state->Entered[i] >= zone->Dwell) {
+            state->Dwelled |= (uint8_t) (1 << i);
+            notify(fence, uas, zone->Id, ODID_GEOFENCE_DWELL);
+        }
+    }
+    readUnlock(fence, reader);
+    return state->Inside;
+}
+
+// Distance from the origin to the segment from a to b, in the unit of the coordinates
+static double segmentDistance(double ax, double ay, double bx, double by)
+{
+    double dx = bx - ax, dy = by - ay;
+    double length = dx * dx + dy * dy;
+    double t = length > 0 ? -(ax * dx + ay * dy) / length : 0;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    double x = ax + t * dx, y = ay + t * dy;
+    return sqrt(x * x + y * y);
+}
+
+// Whether a zone intersects a circle, in a local plane around its center
+static int zoneIntersects(const ODID_Geofence_zones *set, const ODID_Geofence_zone *zone,
+                          double latitude, double longitude, double radius)
+{
+    if (zoneContains(set, zone, latitude, longitude))
+        return 1;
+    double xScale = METERS_PER_DEGREE * cos(latitude * DEG2RAD);
+    const ODID_Geofence_vertex *v = &set->Vertices[zone->FirstVertex];
+    const ODID_Geofence_vertex *prev = &v[zone->VertexCount - 1];
+    double ax = wrapLongitude(prev->Longitude - longitude) * xScale;
+    double ay = (prev->Latitude - latitude) * METERS_PER_DEGREE;
+    for (uint32_t i = 0; i < zone->VertexCount; i++) {
+        double bx = wrapLongitude(v[i].Longitude - longitude) * xScale;
+        double by = (v[i].Latitude - latitude) * METERS_PER_DEGREE;
+        if (segmentDistance(ax, ay, bx, by) <= radius)
+            return 1;
+        ax = bx;
+        ay = by;
+    }
+    return 0;
+}
+
+/**
+* Find the zones that intersect the area of operation declared in a System message
+*
+* The area is the circle of AreaRadius around the operator position, from
+* AreaFloor to AreaCeiling, which are unbounded when not valid. AreaCount is
+* not used: the area is the same for any number of UAS in it.
+*
+* @param fence      The geofence
+* @param reader     Index of the calling thread in the reader epochs
+* @param system     The System message data
+* @param out        Array receiving the Ids of at most maxOut zones
+* @param maxOut     Size of out
+* @return           Number of zones intersecting the area, which can exceed maxOut
+*/
+uint32_t odid_geofence_check_area(ODID_Geofence *fence, uint32_t reader, const ODID_System_data *system,
+                                  uint32_t *out, uint32_t maxOut)
+{
+    if (!fence || !system || (!out && maxOut > 0) || reader >= fence->ReaderCount ||
+        !validPosition(system->OperatorLatitude, system->OperatorLongitude))
+        return 0;
+
+    const ODID_Geofence_zones *set = readLock(fence, reader);
+    if (!set) {
+        readUnlock(fence, reader);
+        return 0;
+    }
+
+    // Visit the cells of the bounding box of the area, once per zone
+    double latitude = system->OperatorLatitude, longitude = system->OperatorLongitude;
+    double radius = system->AreaRadius;
+    double dLat = radius / METERS_PER_DEGREE;
+    double dLon = 180;
+    if (fabs(latitude) + dLat < 89)
+        dLon = dLat / cos(latitude * DEG2RAD);
+    int32_t x0 = cellX(set, dLon < 180 ? wrapLongitude(longitude - dLon) : -180);
+    int32_t x1 = cellX(set, dLon < 180 ? wrapLongitude(longitude + dLon) : 180);
+    int32_t y0 = cellY(set, latitude - dLat > -90 ? latitude - dLat : -90);
+    int32_t y1 = cellY(set, latitude + dLat < 90 ? latitude + dLat : 90);
+    int32_t columns = dLon < 180 ? cellColumns(set, x0, x1, x1 < x0) : set->Columns;
+
+    uint32_t found = 0;
+    for (int32_t y = y0; y <= y1; y++) {
+        for (int32_t c = 0; c < columns; c++) {
+            int32_t x = (x0 + c) % set->Columns;
+            uint32_t bucket = cellBucket(set, x, y);
+            for (uint32_t r = set->Buckets[bucket]; r < set->Buckets[bucket + 1]; r++) {
+                const ODID_Geofence_ref *ref = &set->Refs[r];
+                if (ref->CellX != x || ref->CellY != y)
+                    continue;
+                // Only in the first visited cell of the zone
+                const ODID_Geofence_zone *zone = &set->Zones[ref->Zone];
+                int32_t first = (zone->CellX - x0 + set->Columns) % set->Columns;
+                if (c != (first < columns ? first : 0) || y != (zone->CellY > y0 ? zone->CellY : y0))
+                    continue;
+                if (!zoneOverlaps(zone, system->AreaFloor, system->AreaCeiling) ||
+                    !zoneIntersects(set, zone, latitude, longitude, radius))
+                    continue;
+                if (found < maxOut)
+                    out[found] = zone->Id;
+                found++;
+            }
+        }
+    }
+    readUnlock(fence, reader);
+    return found;
+}
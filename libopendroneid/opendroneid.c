@@ -12,19 +12,190 @@ gabriel.c.cox@intel.com
 
 #include "opendroneid.h"
 #include <math.h>
+#include <stddef.h>
 #include <stdio.h>
 #define ENABLE_DEBUG 1
 
-const float SPEED_DIV[2] = {0.25f, 0.75f};
-const float VSPEED_DIV = 0.5f;
+#define SPEED_DIV_LOW   0.25f
+#define SPEED_DIV_HIGH  0.75f
+#define VSPEED_DIV_VAL  0.5f
+#define ALT_DIV_VAL     0.5f
+#define ALT_ADDER_VAL   1000
+
+const float SPEED_DIV[2] = {SPEED_DIV_LOW, SPEED_DIV_HIGH};
+const float VSPEED_DIV = VSPEED_DIV_VAL;
 const int32_t LATLON_MULT = 10000000;
-const float ALT_DIV = 0.5f;
-const int ALT_ADDER = 1000;
+const float ALT_DIV = ALT_DIV_VAL;
+const int ALT_ADDER = ALT_ADDER_VAL;
 
 static char *safe_dec_copyfill(char *dstStr, const char *srcStr, int dstSize);
 static int intRangeMax(int64_t inValue, int startRange, int endRange);
 static int intInRange(int inValue, int startRange, int endRange);
 
+/*
+ * Quantization tables
+ *
+ * All scaled numeric fields of the messages are mapped linearly between the
+ * physical value and the encoded integer: value = encoded * scale + offset.
+ * Fields using more than one scale (speed and direction) have one table entry
+ * per segment, selected by the corresponding flag bit in the message.
+ *
+ * Encoding computes (value - offset) / scale, adds the rounding term,
+ * truncates and clamps the result to [min, max].
+ */
+typedef struct {
+    float scale;
+    float offset;
+    float round;
+    int32_t min;
+    int32_t max;
+} odid_linear_codec_t;
+
+static const odid_linear_codec_t altitudeCodec =
+    { ALT_DIV_VAL, -(float) ALT_ADDER_VAL, 0.0f, 0, UINT16_MAX };
+
+static const odid_linear_codec_t speedHorizontalCodec[2] = {
+    { SPEED_DIV_LOW, 0.0f, 0.5f, 0, UINT8_MAX },
+    { SPEED_DIV_HIGH, UINT8_MAX * SPEED_DIV_LOW, 0.5f, 0, UINT8_MAX },
+};
+
+static const odid_linear_codec_t speedVerticalCodec =
+    { VSPEED_DIV_VAL, 0.0f, 0.0f, INT8_MIN, INT8_MAX };
+
+// Indexed by the EWDirection flag
+static const odid_linear_codec_t directionCodec[2] = {
+    { 1.0f, 0.0f, 0.0f, 0, UINT8_MAX },
+    { 1.0f, 180.0f, 0.0f, 0, UINT8_MAX },
+};
+
+/*
+ * Accuracy enums are defined as buckets of the physical value. Each table
+ * lists the enum values in order of increasing physical value, together with
+ * the upper bound of the bucket. This one list generates the compares of the
+ * encoder and the lookup table of the decoder, which returns the upper bound
+ * of the bucket.
+ *
+ * Values above the last bound, zero, negative values and NaN map to the
+ * unknown enum.
+ */
+#define HOR_ACC_BUCKETS(X) \
+    X(ODID_HOR_ACC_1_METER,   1)      \
+    X(ODID_HOR_ACC_3_METER,   3)      \
+    X(ODID_HOR_ACC_10_METER,  10)     \
+    X(ODID_HOR_ACC_30_METER,  30)     \
+    X(ODID_HOR_ACC_0_05NM,    92.6f)  \
+    X(ODID_HOR_ACC_0_1NM,     185.2f) \
+    X(ODID_HOR_ACC_0_3NM,     555.6f) \
+    X(ODID_HOR_ACC_0_5NM,     926)    \
+    X(ODID_HOR_ACC_1NM,       1852)   \
+    X(ODID_HOR_ACC_2NM,       3704)   \
+    X(ODID_HOR_ACC_4NM,       7408)   \
+    X(ODID_HOR_ACC_10NM,      18520)
+
+#define VER_ACC_BUCKETS(X) \
+    X(ODID_VER_ACC_1_METER,   1)      \
+    X(ODID_VER_ACC_3_METER,   3)      \
+    X(ODID_VER_ACC_10_METER,  10)     \
+    X(ODID_VER_ACC_25_METER,  25)     \
+    X(ODID_VER_ACC_45_METER,  45)     \
+    X(ODID_VER_ACC_150_METER, 150)
+
+#define SPEED_ACC_BUCKETS(X) \
+    X(ODID_SPEED_ACC_0_3_METERS_PER_SECOND, 0.3f) \
+    X(ODID_SPEED_ACC_1_METERS_PER_SECOND,   1)    \
+    X(ODID_SPEED_ACC_3_METERS_PER_SECOND,   3)    \
+    X(ODID_SPEED_ACC_10_METERS_PER_SECOND,  10)
+
+#define TIME_ACC_BUCKETS(X) \
+    X(ODID_TIME_ACC_0_1_SECOND, 0.1f) \
+    X(ODID_TIME_ACC_0_2_SECOND, 0.2f) \
+    X(ODID_TIME_ACC_0_3_SECOND, 0.3f) \
+    X(ODID_TIME_ACC_0_4_SECOND, 0.4f) \
+    X(ODID_TIME_ACC_0_5_SECOND, 0.5f) \
+    X(ODID_TIME_ACC_0_6_SECOND, 0.6f) \
+    X(ODID_TIME_ACC_0_7_SECOND, 0.7f) \
+    X(ODID_TIME_ACC_0_8_SECOND, 0.8f) \
+    X(ODID_TIME_ACC_0_9_SECOND, 0.9f) \
+    X(ODID_TIME_ACC_1_0_SECOND, 1.0f) \
+    X(ODID_TIME_ACC_1_1_SECOND, 1.1f) \
+    X(ODID_TIME_ACC_1_2_SECOND, 1.2f) \
+    X(ODID_TIME_ACC_1_3_SECOND, 1.3f) \
+    X(ODID_TIME_ACC_1_4_SECOND, 1.4f) \
+    X(ODID_TIME_ACC_1_5_SECOND, 1.5f)
+
+#define BUCKET_DECODE(e, bound) [e] = bound,
+#define BUCKET_GE(e, bound)     if (value < (bound)) return e;
+#define BUCKET_GT(e, bound)     if (value <= (bound)) return e;
+
+typedef struct {
+    const float *decoded;   // Decoded value, indexed by enum
+    uint8_t decodedCount;   // Number of entries in decoded
+    uint8_t unknown;        // The unknown enum
+} odid_enum_codec_t;
+
+/*
+ * Besides the decoder table, each codec gets its own encoder name##Quantize(),
+ * a chain of compares against the constant bounds of the table, in order of
+ * increasing value. COMPARE is BUCKET_GE for buckets [lower, upper),
+ * BUCKET_GT for (lower, upper].
+ */
+#define ENUM_CODEC(name, BUCKETS, unknownEnum, unknownValue, COMPARE) \
+    static const float name##Decoded[] = { [unknownEnum] = unknownValue, BUCKETS(BUCKET_DECODE) }; \
+    static const odid_enum_codec_t name = { \
+        name##Decoded, sizeof(name##Decoded) / sizeof(name##Decoded[0]), unknownEnum }; \
+    static inline uint8_t name##Quantize(float value) \
+    { \
+        if (!(value > 0)) \
+            return unknownEnum; \
+        BUCKETS(COMPARE) \
+        return unknownEnum; \
+    }
+
+ENUM_CODEC(horAccCodec, HOR_ACC_BUCKETS, ODID_HOR_ACC_UNKNOWN, 18520, BUCKET_GE)
+ENUM_CODEC(verAccCodec, VER_ACC_BUCKETS, ODID_VER_ACC_UNKNOWN, 150, BUCKET_GE)
+ENUM_CODEC(speedAccCodec, SPEED_ACC_BUCKETS, ODID_SPEED_ACC_UNKNOWN, 10, BUCKET_GE)
+ENUM_CODEC(timeAccCodec, TIME_ACC_BUCKETS, ODID_TIME_ACC_UNKNOWN, 0.0f, BUCKET_GT)
+
+/**
+* Quantize a physical value with a linear codec
+*
+* @param codec  The codec (segment) to use
+* @param value  The physical value
+* @return       The encoded value, clamped to the range of the codec
+*/
+static int32_t quantizeLinear(const odid_linear_codec_t *codec, float value)
+{
+    return intRangeMax((int64_t) ((value - codec->offset) / codec->scale + codec->round),
+                       codec->min, codec->max);
+}
+
+/**
+* Dequantize an encoded value with a linear codec
+*
+* @param codec  The codec (segment) to use
+* @param enc    The encoded value
+* @return       The physical value
+*/
+static float dequantizeLinear(const odid_linear_codec_t *codec, int32_t enc)
+{
+    return (float) enc * codec->scale + codec->offset;
+}
+
+/**
+* Look up the decoded value of an accuracy enum
+*
+* @param codec  The enum codec to use
+* @param enc    The enum value
+* @return       The physical value. The value of the unknown enum for
+*               undefined enum values
+*/
+static float dequantizeEnum(const odid_enum_codec_t *codec, int enc)
+{
+    if ((unsigned int) enc >= codec->decodedCount)
+        enc = codec->unknown;
+    return codec->decoded[enc];
+}
+
 /**
 * Initialize basic ID data fields to their default values
 *
@@ -151,6 +322,18 @@ void odid_initUasData(ODID_UAS_Data *data)
     odid_initOperatorIDData(&data->OperatorID);
 }
 
+/**
+* Initialize all message receive timestamps to 0, i.e. never received
+*
+* @param timestamps The timestamps of an ODID_UAS_Data structure
+*/
+void odid_initUasTimestamps(ODID_UAS_Timestamps *timestamps)
+{
+    if (!timestamps)
+        return;
+    memset(timestamps, 0, sizeof(ODID_UAS_Timestamps));
+}
+
 /**
 * Encode direction as defined by Open Drone ID
 *
@@ -167,13 +350,8 @@ static uint8_t encodeDirection(float Direction, uint8_t *EWDirection)
     unsigned int direction_int = (unsigned int) roundf(Direction);
     if (direction_int == 360)
         direction_int = 0;
-    if (direction_int < 180) {
-        *EWDirection = 0;
-    } else {
-        *EWDirection = 1;
-        direction_int -= 180;
-    }
-    return (uint8_t) intRangeMax(direction_int, 0, UINT8_MAX);
+    *EWDirection = direction_int >= 180;
+    return (uint8_t) quantizeLinear(&directionCodec[*EWDirection], (float) direction_int);
 }
 
 /**
@@ -190,14 +368,8 @@ static uint8_t encodeDirection(float Direction, uint8_t *EWDirection)
 */
 static uint8_t encodeSpeedHorizontal(float Speed_data, uint8_t *mult)
 {
-    if (Speed_data <= UINT8_MAX * SPEED_DIV[0]) {
-        *mult = 0;
-        return (uint8_t) ((Speed_data / SPEED_DIV[0]) + 0.5f);
-    } else {
-        *mult = 1;
-        int big_value = (int) (((Speed_data - (UINT8_MAX * SPEED_DIV[0])) / SPEED_DIV[1]) + 0.5f);
-        return (uint8_t) intRangeMax(big_value, 0, UINT8_MAX);
-    }
+    *mult = Speed_data > speedHorizontalCodec[1].offset;
+    return (uint8_t) quantizeLinear(&speedHorizontalCodec[*mult], Speed_data);
 }
 
 /**
@@ -208,8 +380,7 @@ static uint8_t encodeSpeedHorizontal(float Speed_data, uint8_t *mult)
 */
 static int8_t encodeSpeedVertical(float SpeedVertical_data)
 {
-    int encValue = (int) (SpeedVertical_data / VSPEED_DIV);
-    return (int8_t) intRangeMax(encValue, INT8_MIN, INT8_MAX);
+    return (int8_t) quantizeLinear(&speedVerticalCodec, SpeedVertical_data);
 }
 
 /**
@@ -238,7 +409,7 @@ static int32_t encodeLatLon(double LatLon_data)
 */
 static uint16_t encodeAltitude(float Alt_data)
 {
-    return (uint16_t) intRangeMax( (int) ((Alt_data + (float) ALT_ADDER) / ALT_DIV), 0, UINT16_MAX);
+    return (uint16_t) quantizeLinear(&altitudeCodec, Alt_data);
 }
 
 /**
@@ -272,50 +443,29 @@ static uint8_t encodeAreaRadius(uint16_t Radius)
 }
 
 /**
-* Encode Basic ID message (packed, ready for broadcast)
+* Check whether the fields of a Basic ID data structure can be encoded
 *
-* @param outEncoded Output (encoded/packed) structure
-* @param inData     Input data (non encoded/packed) structure
-* @return           ODID_SUCCESS or ODID_FAIL;
+* @param inData Input data (non encoded/packed) structure
+* @return       ODID_SUCCESS or ODID_FAIL;
 */
-int encodeBasicIDMessage(ODID_BasicID_encoded *outEncoded, const ODID_BasicID_data *inData)
+static int checkBasicIDData(const ODID_BasicID_data *inData)
 {
-    if (!outEncoded || !inData ||
-        !intInRange(inData->IDType, 0, 15) ||
+    if (!intInRange(inData->IDType, 0, 15) ||
         !intInRange(inData->UAType, 0, 15))
         return ODID_FAIL;
 
-    outEncoded->MessageType = ODID_MESSAGETYPE_BASIC_ID;
-    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
-    outEncoded->IDType = inData->IDType;
-    outEncoded->UAType = inData->UAType;
-    switch (inData->IDType)
-    {
-    case ODID_IDTYPE_SERIAL_NUMBER:
-    case ODID_IDTYPE_CAA_REGISTRATION_ID:
-        memset(outEncoded->UASID, 0, sizeof(outEncoded->UASID));
-        strncpy(outEncoded->UASID, inData->UASID, sizeof(outEncoded->UASID));
-        break;
-    default:
-        memcpy(outEncoded->UASID, inData->UASID, sizeof(outEncoded->UASID));
-        break;
-    }
-    memset(outEncoded->Reserved, 0, sizeof(outEncoded->Reserved));
     return ODID_SUCCESS;
 }
 
 /**
-* Encode Location message (packed, ready for broadcast)
+* Check whether the fields of a Location data structure can be encoded
 *
-* @param outEncoded Output (encoded/packed) structure
-* @param inData     Input data (non encoded/packed) structure
-* @return           ODID_SUCCESS or ODID_FAIL;
+* @param inData Input data (non encoded/packed) structure
+* @return       ODID_SUCCESS or ODID_FAIL;
 */
-int encodeLocationMessage(ODID_Location_encoded *outEncoded, const ODID_Location_data *inData)
+static int checkLocationData(const ODID_Location_data *inData)
 {
-    uint8_t bitflag;
-    if (!outEncoded || !inData ||
-        !intInRange(inData->Status, 0, 15) ||
+    if (!intInRange(inData->Status, 0, 15) ||
         !intInRange(inData->HeightType, 0, 1) ||
         !intInRange(inData->HorizAccuracy, 0, 15) ||
         !intInRange(inData->VertAccuracy, 0, 15) ||
@@ -349,6 +499,141 @@ int encodeLocationMessage(ODID_Location_encoded *outEncoded, const ODID_Location
         (inData->TimeStamp > MAX_TIMESTAMP && inData->TimeStamp != INV_TIMESTAMP))
         return ODID_FAIL;
 
+    return ODID_SUCCESS;
+}
+
+/**
+* Check whether the header fields of an Authentication page are valid
+*
+* Used both when encoding and decoding. LastPageIndex and Length are only
+* checked for page zero.
+*
+* @param authType       The authentication type
+* @param dataPage       The page number
+* @param lastPageIndex  The index of the last page (page zero only)
+* @param length         The total length of the authentication data (page zero only)
+* @return               ODID_SUCCESS or ODID_FAIL;
+*/
+static int checkAuthPage(int authType, int dataPage, int lastPageIndex, int length)
+{
+    if (!intInRange(authType, 0, 15) ||
+        !intInRange(dataPage, 0, ODID_AUTH_MAX_PAGES - 1))
+        return ODID_FAIL;
+
+    if (dataPage == 0) {
+        if (lastPageIndex >= ODID_AUTH_MAX_PAGES)
+            return ODID_FAIL;
+
+#if (MAX_AUTH_LENGTH < UINT8_MAX)
+        if (length > MAX_AUTH_LENGTH)
+            return ODID_FAIL;
+#endif
+
+        int len = ODID_AUTH_PAGE_ZERO_DATA_SIZE +
+                  lastPageIndex * ODID_AUTH_PAGE_NONZERO_DATA_SIZE;
+        if (len < length)
+            return ODID_FAIL;
+    }
+
+    return ODID_SUCCESS;
+}
+
+/**
+* Check whether the fields of a System data structure can be encoded
+*
+* @param inData Input data (non encoded/packed) structure
+* @return       ODID_SUCCESS or ODID_FAIL;
+*/
+static int checkSystemData(const ODID_System_data *inData)
+{
+    if (!intInRange(inData->OperatorLocationType, 0, 3) ||
+        !intInRange(inData->ClassificationType, 0, 7) ||
+        !intInRange(inData->CategoryEU, 0, 15) ||
+        !intInRange(inData->ClassEU, 0, 15))
+        return ODID_FAIL;
+
+    if (inData->OperatorLatitude < MIN_LAT || inData->OperatorLatitude > MAX_LAT ||
+        inData->OperatorLongitude < MIN_LON || inData->OperatorLongitude > MAX_LON)
+        return ODID_FAIL;
+
+    if (inData->AreaRadius > MAX_AREA_RADIUS)
+        return ODID_FAIL;
+
+    if (inData->AreaCeiling < MIN_ALT || inData->AreaCeiling > MAX_ALT ||
+        inData->AreaFloor < MIN_ALT || inData->AreaFloor > MAX_ALT ||
+        inData->OperatorAltitudeGeo < MIN_ALT || inData->OperatorAltitudeGeo > MAX_ALT)
+        return ODID_FAIL;
+
+    return ODID_SUCCESS;
+}
+
+/**
+* Copy a string to an encoded field and null pad the rest of the field (when encoding)
+*
+* Like strncpy(), the field is not null terminated when the string fills it.
+* Used by both the bitfield and the shift-and-mask encoders.
+*
+* @param dst    Destination field
+* @param src    Source string
+* @param size   Size of the destination field
+*/
+static void safe_enc_copyfill(void *dst, const char *src, size_t size)
+{
+    size_t len = strnlen(src, size);
+    memcpy(dst, src, len);
+    memset((uint8_t *) dst + len, 0, size - len);
+}
+
+/**
+* Encode Basic ID message (packed, ready for broadcast)
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeBasicIDMessage(ODID_BasicID_encoded *outEncoded, const ODID_BasicID_data *inData)
+{
+#ifdef ODID_CODEC_SHIFT_MASK
+    return encodeBasicIDMessageBytes(outEncoded, inData);
+#else
+    if (!outEncoded || !inData || checkBasicIDData(inData) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    outEncoded->MessageType = ODID_MESSAGETYPE_BASIC_ID;
+    outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
+    outEncoded->IDType = inData->IDType;
+    outEncoded->UAType = inData->UAType;
+    switch (inData->IDType)
+    {
+    case ODID_IDTYPE_SERIAL_NUMBER:
+    case ODID_IDTYPE_CAA_REGISTRATION_ID:
+        safe_enc_copyfill(outEncoded->UASID, inData->UASID, sizeof(outEncoded->UASID));
+        break;
+    default:
+        memcpy(outEncoded->UASID, inData->UASID, sizeof(outEncoded->UASID));
+        break;
+    }
+    memset(outEncoded->Reserved, 0, sizeof(outEncoded->Reserved));
+    return ODID_SUCCESS;
+#endif
+}
+
+/**
+* Encode Location message (packed, ready for broadcast)
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeLocationMessage(ODID_Location_encoded *outEncoded, const ODID_Location_data *inData)
+{
+#ifdef ODID_CODEC_SHIFT_MASK
+    return encodeLocationMessageBytes(outEncoded, inData);
+#else
+    uint8_t bitflag;
+    if (!outEncoded || !inData || checkLocationData(inData) != ODID_SUCCESS)
+        return ODID_FAIL;
+
     outEncoded->MessageType = ODID_MESSAGETYPE_LOCATION;
     outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
     outEncoded->Status = inData->Status;
@@ -373,6 +658,7 @@ int encodeLocationMessage(ODID_Location_encoded *outEncoded, const ODID_Location
     outEncoded->TimeStamp = encodeTimeStamp(inData->TimeStamp);
     outEncoded->Reserved3 = 0;
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -384,27 +670,14 @@ int encodeLocationMessage(ODID_Location_encoded *outEncoded, const ODID_Location
 */
 int encodeAuthMessage(ODID_Auth_encoded *outEncoded, const ODID_Auth_data *inData)
 {
-    if (!outEncoded || !inData || !intInRange(inData->AuthType, 0, 15))
-        return ODID_FAIL;
-
-    if (inData->DataPage >= ODID_AUTH_MAX_PAGES)
+#ifdef ODID_CODEC_SHIFT_MASK
+    return encodeAuthMessageBytes(outEncoded, inData);
+#else
+    if (!outEncoded || !inData ||
+        checkAuthPage(inData->AuthType, inData->DataPage,
+                      inData->LastPageIndex, inData->Length) != ODID_SUCCESS)
         return ODID_FAIL;
 
-    if (inData->DataPage == 0) {
-        if (inData->LastPageIndex >= ODID_AUTH_MAX_PAGES)
-            return ODID_FAIL;
-
-#if (MAX_AUTH_LENGTH < UINT8_MAX)
-        if (inData->Length > MAX_AUTH_LENGTH)
-            return ODID_FAIL;
-#endif
-
-        int len = ODID_AUTH_PAGE_ZERO_DATA_SIZE +
-                  inData->LastPageIndex * ODID_AUTH_PAGE_NONZERO_DATA_SIZE;
-        if (len < inData->Length)
-            return ODID_FAIL;
-    }
-
     outEncoded->page_zero.MessageType = ODID_MESSAGETYPE_AUTH;
     outEncoded->page_zero.ProtoVersion = ODID_PROTOCOL_VERSION;
     outEncoded->page_zero.AuthType = inData->AuthType;
@@ -421,6 +694,7 @@ int encodeAuthMessage(ODID_Auth_encoded *outEncoded, const ODID_Auth_data *inDat
                sizeof(outEncoded->page_non_zero.AuthData));
     }
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -432,14 +706,18 @@ int encodeAuthMessage(ODID_Auth_encoded *outEncoded, const ODID_Auth_data *inDat
 */
 int encodeSelfIDMessage(ODID_SelfID_encoded *outEncoded, const ODID_SelfID_data *inData)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return encodeSelfIDMessageBytes(outEncoded, inData);
+#else
     if (!outEncoded || !inData || !intInRange(inData->DescType, 0, 255))
         return ODID_FAIL;
 
     outEncoded->MessageType = ODID_MESSAGETYPE_SELF_ID;
     outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
     outEncoded->DescType = inData->DescType;
-    strncpy(outEncoded->Desc, inData->Desc, sizeof(outEncoded->Desc));
+    safe_enc_copyfill(outEncoded->Desc, inData->Desc, sizeof(outEncoded->Desc));
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -451,23 +729,10 @@ int encodeSelfIDMessage(ODID_SelfID_encoded *outEncoded, const ODID_SelfID_data
 */
 int encodeSystemMessage(ODID_System_encoded *outEncoded, const ODID_System_data *inData)
 {
-    if (!outEncoded || !inData ||
-        !intInRange(inData->OperatorLocationType, 0, 3) ||
-        !intInRange(inData->ClassificationType, 0, 7) ||
-        !intInRange(inData->CategoryEU, 0, 15) ||
-        !intInRange(inData->ClassEU, 0, 15))
-        return ODID_FAIL;
-
-    if (inData->OperatorLatitude < MIN_LAT || inData->OperatorLatitude > MAX_LAT ||
-        inData->OperatorLongitude < MIN_LON || inData->OperatorLongitude > MAX_LON)
-        return ODID_FAIL;
-
-    if (inData->AreaRadius > MAX_AREA_RADIUS)
-        return ODID_FAIL;
-
-    if (inData->AreaCeiling < MIN_ALT || inData->AreaCeiling > MAX_ALT ||
-        inData->AreaFloor < MIN_ALT || inData->AreaFloor > MAX_ALT ||
-        inData->OperatorAltitudeGeo < MIN_ALT || inData->OperatorAltitudeGeo > MAX_ALT)
+#ifdef ODID_CODEC_SHIFT_MASK
+    return encodeSystemMessageBytes(outEncoded, inData);
+#else
+    if (!outEncoded || !inData || checkSystemData(inData) != ODID_SUCCESS)
         return ODID_FAIL;
 
     outEncoded->MessageType = ODID_MESSAGETYPE_SYSTEM;
@@ -487,6 +752,7 @@ int encodeSystemMessage(ODID_System_encoded *outEncoded, const ODID_System_data
     outEncoded->Timestamp = inData->Timestamp;
     outEncoded->Reserved2 = 0;
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -498,15 +764,19 @@ int encodeSystemMessage(ODID_System_encoded *outEncoded, const ODID_System_data
 */
 int encodeOperatorIDMessage(ODID_OperatorID_encoded *outEncoded, const ODID_OperatorID_data *inData)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return encodeOperatorIDMessageBytes(outEncoded, inData);
+#else
     if (!outEncoded || !inData || !intInRange(inData->OperatorIdType, 0, 255))
         return ODID_FAIL;
 
     outEncoded->MessageType = ODID_MESSAGETYPE_OPERATOR_ID;
     outEncoded->ProtoVersion = ODID_PROTOCOL_VERSION;
     outEncoded->OperatorIdType = inData->OperatorIdType;
-    strncpy(outEncoded->OperatorId, inData->OperatorId, sizeof(outEncoded->OperatorId));
+    safe_enc_copyfill(outEncoded->OperatorId, inData->OperatorId, sizeof(outEncoded->OperatorId));
     memset(outEncoded->Reserved, 0, sizeof(outEncoded->Reserved));
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -581,10 +851,7 @@ int encodeMessagePack(ODID_MessagePack_encoded *outEncoded, const ODID_MessagePa
 */
 static float decodeDirection(uint8_t Direction_enc, uint8_t EWDirection)
 {
-    if (EWDirection)
-        return (float) Direction_enc + 180;
-    else
-        return (float) Direction_enc;
+    return dequantizeLinear(&directionCodec[EWDirection & 1], Direction_enc);
 }
 
 /**
@@ -596,10 +863,7 @@ static float decodeDirection(uint8_t Direction_enc, uint8_t EWDirection)
 */
 static float decodeSpeedHorizontal(uint8_t Speed_enc, uint8_t mult)
 {
-    if (mult)
-        return ((float) Speed_enc * SPEED_DIV[1]) + (UINT8_MAX * SPEED_DIV[0]);
-    else
-        return (float) Speed_enc * SPEED_DIV[0];
+    return dequantizeLinear(&speedHorizontalCodec[mult & 1], Speed_enc);
 }
 
 /**
@@ -610,7 +874,7 @@ static float decodeSpeedHorizontal(uint8_t Speed_enc, uint8_t mult)
 */
 static float decodeSpeedVertical(int8_t SpeedVertical_enc)
 {
-    return (float) SpeedVertical_enc * VSPEED_DIV;
+    return dequantizeLinear(&speedVerticalCodec, SpeedVertical_enc);
 }
 
 /**
@@ -632,7 +896,7 @@ static double decodeLatLon(int32_t LatLon_enc)
 */
 static float decodeAltitude(uint16_t Alt_enc)
 {
-    return (float) Alt_enc * ALT_DIV - (float) ALT_ADDER;
+    return dequantizeLinear(&altitudeCodec, Alt_enc);
 }
 
 /**
@@ -687,6 +951,9 @@ int getBasicIDType(ODID_BasicID_encoded *inEncoded, enum ODID_idtype *idType)
 */
 int decodeBasicIDMessage(ODID_BasicID_data *outData, const ODID_BasicID_encoded *inEncoded)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return decodeBasicIDMessageBytes(outData, inEncoded);
+#else
     if (!outData || !inEncoded ||
         inEncoded->MessageType != ODID_MESSAGETYPE_BASIC_ID ||
         !intInRange(inEncoded->IDType, 0, 15) ||
@@ -706,6 +973,7 @@ int decodeBasicIDMessage(ODID_BasicID_data *outData, const ODID_BasicID_encoded
         break;
     }
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -717,6 +985,9 @@ int decodeBasicIDMessage(ODID_BasicID_data *outData, const ODID_BasicID_encoded
 */
 int decodeLocationMessage(ODID_Location_data *outData, const ODID_Location_encoded *inEncoded)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return decodeLocationMessageBytes(outData, inEncoded);
+#else
     if (!outData || !inEncoded ||
         inEncoded->MessageType != ODID_MESSAGETYPE_LOCATION ||
         !intInRange(inEncoded->Status, 0, 15))
@@ -739,6 +1010,7 @@ int decodeLocationMessage(ODID_Location_data *outData, const ODID_Location_encod
     outData->TSAccuracy = (ODID_Timestamp_accuracy_t) inEncoded->TSAccuracy;
     outData->TimeStamp = decodeTimeStamp(inEncoded->TimeStamp);
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -769,27 +1041,16 @@ int getAuthPageNum(ODID_Auth_encoded *inEncoded, int *pageNum)
 */
 int decodeAuthMessage(ODID_Auth_data *outData, const ODID_Auth_encoded *inEncoded)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return decodeAuthMessageBytes(outData, inEncoded);
+#else
     if (!outData || !inEncoded ||
         inEncoded->page_zero.MessageType != ODID_MESSAGETYPE_AUTH ||
-        !intInRange(inEncoded->page_zero.AuthType, 0, 15) ||
-        !intInRange(inEncoded->page_zero.DataPage, 0, ODID_AUTH_MAX_PAGES - 1))
+        checkAuthPage(inEncoded->page_zero.AuthType, inEncoded->page_zero.DataPage,
+                      inEncoded->page_zero.LastPageIndex,
+                      inEncoded->page_zero.Length) != ODID_SUCCESS)
         return ODID_FAIL;
 
-    if (inEncoded->page_zero.DataPage == 0) {
-        if (inEncoded->page_zero.LastPageIndex >= ODID_AUTH_MAX_PAGES)
-            return ODID_FAIL;
-
-#if (MAX_AUTH_LENGTH < UINT8_MAX)
-        if (inEncoded->page_zero.Length > MAX_AUTH_LENGTH)
-            return ODID_FAIL;
-#endif
-
-        int len = ODID_AUTH_PAGE_ZERO_DATA_SIZE +
-                  inEncoded->page_zero.LastPageIndex * ODID_AUTH_PAGE_NONZERO_DATA_SIZE;
-        if (len < inEncoded->page_zero.Length)
-            return ODID_FAIL;
-    }
-
     outData->AuthType = (ODID_authtype_t) inEncoded->page_zero.AuthType;
     outData->DataPage = inEncoded->page_zero.DataPage;
     if (inEncoded->page_zero.DataPage == 0) {
@@ -806,6 +1067,7 @@ int decodeAuthMessage(ODID_Auth_data *outData, const ODID_Auth_encoded *inEncode
     }
 
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -817,6 +1079,9 @@ int decodeAuthMessage(ODID_Auth_data *outData, const ODID_Auth_encoded *inEncode
 */
 int decodeSelfIDMessage(ODID_SelfID_data *outData, const ODID_SelfID_encoded *inEncoded)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return decodeSelfIDMessageBytes(outData, inEncoded);
+#else
     if (!outData || !inEncoded ||
         inEncoded->MessageType != ODID_MESSAGETYPE_SELF_ID)
         return ODID_FAIL;
@@ -824,6 +1089,7 @@ int decodeSelfIDMessage(ODID_SelfID_data *outData, const ODID_SelfID_encoded *in
     outData->DescType = (ODID_desctype_t) inEncoded->DescType;
     safe_dec_copyfill(outData->Desc, inEncoded->Desc, sizeof(outData->Desc));
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -835,6 +1101,9 @@ int decodeSelfIDMessage(ODID_SelfID_data *outData, const ODID_SelfID_encoded *in
 */
 int decodeSystemMessage(ODID_System_data *outData, const ODID_System_encoded *inEncoded)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return decodeSystemMessageBytes(outData, inEncoded);
+#else
     if (!outData || !inEncoded ||
         inEncoded->MessageType != ODID_MESSAGETYPE_SYSTEM)
         return ODID_FAIL;
@@ -854,6 +1123,7 @@ int decodeSystemMessage(ODID_System_data *outData, const ODID_System_encoded *in
     outData->OperatorAltitudeGeo = decodeAltitude(inEncoded->OperatorAltitudeGeo);
     outData->Timestamp = inEncoded->Timestamp;
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -865,6 +1135,9 @@ int decodeSystemMessage(ODID_System_data *outData, const ODID_System_encoded *in
 */
 int decodeOperatorIDMessage(ODID_OperatorID_data *outData, const ODID_OperatorID_encoded *inEncoded)
 {
+#ifdef ODID_CODEC_SHIFT_MASK
+    return decodeOperatorIDMessageBytes(outData, inEncoded);
+#else
     if (!outData || !inEncoded ||
         inEncoded->MessageType != ODID_MESSAGETYPE_OPERATOR_ID)
         return ODID_FAIL;
@@ -872,6 +1145,7 @@ int decodeOperatorIDMessage(ODID_OperatorID_data *outData, const ODID_OperatorID
     outData->OperatorIdType = (ODID_operatorIdType_t) inEncoded->OperatorIdType;
     safe_dec_copyfill(outData->OperatorId, inEncoded->OperatorId, sizeof(outData->OperatorId));
     return ODID_SUCCESS;
+#endif
 }
 
 /**
@@ -902,130 +1176,1878 @@ int decodeMessagePack(ODID_UAS_Data *uasData, const ODID_MessagePack_encoded *pa
     return ODID_SUCCESS;
 }
 
-/**
-* Decodes the message type of a packed Open Drone ID message
-*
-* @param byte   The first byte of the message
-* @return       The message type: ODID_messagetype_t
-*/
-ODID_messagetype_t decodeMessageType(uint8_t byte)
+/*
+ * Shift-and-mask codec
+ *
+ * The *Bytes() functions below read and write the 25 byte wire format with
+ * explicit byte loads, shifts and masks instead of through the packed
+ * bitfield structures. They produce and accept exactly the same bytes as the
+ * bitfield based functions, independent of the bitfield layout and the byte
+ * order used by the compiler. They are always available; building with
+ * ODID_CODEC_SHIFT_MASK makes the encode*Message() and decode*Message()
+ * functions use them.
+ *
+ * Byte offsets of the fields within the messages. Multi-byte fields are
+ * little endian. Byte 0 is [MessageType][ProtoVersion] in all messages.
+ */
+#define MSG_HEADER              0
+#define MSG_TYPE_SHIFT          4
+
+#define BASICID_TYPES           1   // [IDType][UAType]
+#define BASICID_UASID           2
+#define BASICID_RESERVED        22
+
+#define LOC_FLAGS               1   // [Status][Reserved][HeightType][EWDirection][SpeedMult]
+#define LOC_DIRECTION           2
+#define LOC_SPEED_H             3
+#define LOC_SPEED_V             4
+#define LOC_LATITUDE            5
+#define LOC_LONGITUDE           9
+#define LOC_ALT_BARO            13
+#define LOC_ALT_GEO             15
+#define LOC_HEIGHT              17
+#define LOC_HV_ACCURACY         19  // [VertAccuracy][HorizAccuracy]
+#define LOC_BS_ACCURACY         20  // [BaroAccuracy][SpeedAccuracy]
+#define LOC_TIMESTAMP           21
+#define LOC_TS_ACCURACY         23  // [Reserved2][TSAccuracy]
+#define LOC_RESERVED            24
+
+#define AUTH_PAGE               1   // [AuthType][DataPage]
+#define AUTH_LAST_PAGE_INDEX    2
+#define AUTH_LENGTH             3
+#define AUTH_TIMESTAMP          4
+#define AUTH_DATA_PAGE_ZERO     8
+#define AUTH_DATA_PAGE_NONZERO  2
+
+#define SELFID_DESC_TYPE        1
+#define SELFID_DESC             2
+
+#define SYSTEM_FLAGS            1   // [Reserved][ClassificationType][OperatorLocationType]
+#define SYSTEM_OPERATOR_LAT     2
+#define SYSTEM_OPERATOR_LON     6
+#define SYSTEM_AREA_COUNT       10
+#define SYSTEM_AREA_RADIUS      12
+#define SYSTEM_AREA_CEILING     13
+#define SYSTEM_AREA_FLOOR       15
+#define SYSTEM_EU               17  // [CategoryEU][ClassEU]
+#define SYSTEM_OPERATOR_ALT     18
+#define SYSTEM_TIMESTAMP        20
+#define SYSTEM_RESERVED         24
+
+#define OPERATORID_TYPE         1
+#define OPERATORID_ID           2
+#define OPERATORID_RESERVED     22
+
+static uint16_t get_le16(const uint8_t *p)
 {
-    switch (byte >> 4)
-    {
-    case ODID_MESSAGETYPE_BASIC_ID:
-        return ODID_MESSAGETYPE_BASIC_ID;
-    case ODID_MESSAGETYPE_LOCATION:
-        return ODID_MESSAGETYPE_LOCATION;
-    case ODID_MESSAGETYPE_AUTH:
-        return ODID_MESSAGETYPE_AUTH;
-    case ODID_MESSAGETYPE_SELF_ID:
-        return ODID_MESSAGETYPE_SELF_ID;
-    case ODID_MESSAGETYPE_SYSTEM:
-        return ODID_MESSAGETYPE_SYSTEM;
-    case ODID_MESSAGETYPE_OPERATOR_ID:
-        return ODID_MESSAGETYPE_OPERATOR_ID;
-    case ODID_MESSAGETYPE_PACKED:
-        return ODID_MESSAGETYPE_PACKED;
-    default:
-        return ODID_MESSAGETYPE_INVALID;
-    }
+    return (uint16_t) (p[0] | (p[1] << 8));
 }
 
-/**
-* Parse encoded Open Drone ID data to identify the message type. Then decode
-* from Open Drone ID packed format into the appropriate Open Drone ID structure
+static uint32_t get_le32(const uint8_t *p)
+{
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) |
+           ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void put_le16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t) value;
+    p[1] = (uint8_t) (value >> 8);
+    p[2] = (uint8_t) (value >> 16);
+    p[3] = (uint8_t) (value >> 24);
+}
+
+// Combine two 4 bit fields into one byte
+static uint8_t nibbles(int high, int low)
+{
+    return (uint8_t) (((high & 0x0F) << 4) | (low & 0x0F));
+}
+
+static uint8_t msgHeader(ODID_messagetype_t type)
+{
+    return nibbles(type, ODID_PROTOCOL_VERSION);
+}
+
+static int msgIsType(const uint8_t *msg, ODID_messagetype_t type)
+{
+    return (msg[MSG_HEADER] >> MSG_TYPE_SHIFT) == type;
+}
+
+/**
+* Encode Basic ID message with explicit byte access
+*
+* Wire compatible alternative to encodeBasicIDMessage()
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeBasicIDMessageBytes(ODID_BasicID_encoded *outEncoded, const ODID_BasicID_data *inData)
+{
+    if (!outEncoded || !inData || checkBasicIDData(inData) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    uint8_t *out = (uint8_t *) outEncoded;
+    out[MSG_HEADER] = msgHeader(ODID_MESSAGETYPE_BASIC_ID);
+    out[BASICID_TYPES] = nibbles(inData->IDType, inData->UAType);
+    switch (inData->IDType)
+    {
+    case ODID_IDTYPE_SERIAL_NUMBER:
+    case ODID_IDTYPE_CAA_REGISTRATION_ID:
+        safe_enc_copyfill(&out[BASICID_UASID], inData->UASID, ODID_ID_SIZE);
+        break;
+    default:
+        memcpy(&out[BASICID_UASID], inData->UASID, ODID_ID_SIZE);
+        break;
+    }
+    memset(&out[BASICID_RESERVED], 0, ODID_MESSAGE_SIZE - BASICID_RESERVED);
+    return ODID_SUCCESS;
+}
+
+/**
+* Encode Location message with explicit byte access
+*
+* Wire compatible alternative to encodeLocationMessage()
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeLocationMessageBytes(ODID_Location_encoded *outEncoded, const ODID_Location_data *inData)
+{
+    uint8_t ewDirection, speedMult;
+    if (!outEncoded || !inData || checkLocationData(inData) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    uint8_t *out = (uint8_t *) outEncoded;
+    out[MSG_HEADER] = msgHeader(ODID_MESSAGETYPE_LOCATION);
+    out[LOC_DIRECTION] = encodeDirection(inData->Direction, &ewDirection);
+    out[LOC_SPEED_H] = encodeSpeedHorizontal(inData->SpeedHorizontal, &speedMult);
+    out[LOC_FLAGS] = (uint8_t) (((inData->Status & 0x0F) << 4) | ((inData->HeightType & 1) << 2) |
+                                (ewDirection << 1) | speedMult);
+    out[LOC_SPEED_V] = (uint8_t) encodeSpeedVertical(inData->SpeedVertical);
+    put_le32(&out[LOC_LATITUDE], (uint32_t) encodeLatLon(inData->Latitude));
+    put_le32(&out[LOC_LONGITUDE], (uint32_t) encodeLatLon(inData->Longitude));
+    put_le16(&out[LOC_ALT_BARO], encodeAltitude(inData->AltitudeBaro));
+    put_le16(&out[LOC_ALT_GEO], encodeAltitude(inData->AltitudeGeo));
+    put_le16(&out[LOC_HEIGHT], encodeAltitude(inData->Height));
+    out[LOC_HV_ACCURACY] = nibbles(inData->VertAccuracy, inData->HorizAccuracy);
+    out[LOC_BS_ACCURACY] = nibbles(inData->BaroAccuracy, inData->SpeedAccuracy);
+    put_le16(&out[LOC_TIMESTAMP], encodeTimeStamp(inData->TimeStamp));
+    out[LOC_TS_ACCURACY] = nibbles(0, inData->TSAccuracy);
+    out[LOC_RESERVED] = 0;
+    return ODID_SUCCESS;
+}
+
+/**
+* Encode Auth message with explicit byte access
+*
+* Wire compatible alternative to encodeAuthMessage()
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeAuthMessageBytes(ODID_Auth_encoded *outEncoded, const ODID_Auth_data *inData)
+{
+    if (!outEncoded || !inData ||
+        checkAuthPage(inData->AuthType, inData->DataPage,
+                      inData->LastPageIndex, inData->Length) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    uint8_t *out = (uint8_t *) outEncoded;
+    out[MSG_HEADER] = msgHeader(ODID_MESSAGETYPE_AUTH);
+    out[AUTH_PAGE] = nibbles(inData->AuthType, inData->DataPage);
+    if (inData->DataPage == 0) {
+        out[AUTH_LAST_PAGE_INDEX] = inData->LastPageIndex;
+        out[AUTH_LENGTH] = inData->Length;
+        put_le32(&out[AUTH_TIMESTAMP], inData->Timestamp);
+        memcpy(&out[AUTH_DATA_PAGE_ZERO], inData->AuthData, ODID_AUTH_PAGE_ZERO_DATA_SIZE);
+    } else {
+        memcpy(&out[AUTH_DATA_PAGE_NONZERO], inData->AuthData, ODID_AUTH_PAGE_NONZERO_DATA_SIZE);
+    }
+    return ODID_SUCCESS;
+}
+
+/**
+* Encode Self ID message with explicit byte access
+*
+* Wire compatible alternative to encodeSelfIDMessage()
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeSelfIDMessageBytes(ODID_SelfID_encoded *outEncoded, const ODID_SelfID_data *inData)
+{
+    if (!outEncoded || !inData || !intInRange(inData->DescType, 0, 255))
+        return ODID_FAIL;
+
+    uint8_t *out = (uint8_t *) outEncoded;
+    out[MSG_HEADER] = msgHeader(ODID_MESSAGETYPE_SELF_ID);
+    out[SELFID_DESC_TYPE] = (uint8_t) inData->DescType;
+    safe_enc_copyfill(&out[SELFID_DESC], inData->Desc, ODID_STR_SIZE);
+    return ODID_SUCCESS;
+}
+
+/**
+* Encode System message with explicit byte access
+*
+* Wire compatible alternative to encodeSystemMessage()
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeSystemMessageBytes(ODID_System_encoded *outEncoded, const ODID_System_data *inData)
+{
+    if (!outEncoded || !inData || checkSystemData(inData) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    uint8_t *out = (uint8_t *) outEncoded;
+    out[MSG_HEADER] = msgHeader(ODID_MESSAGETYPE_SYSTEM);
+    out[SYSTEM_FLAGS] = (uint8_t) (((inData->ClassificationType & 0x07) << 2) |
+                                   (inData->OperatorLocationType & 0x03));
+    put_le32(&out[SYSTEM_OPERATOR_LAT], (uint32_t) encodeLatLon(inData->OperatorLatitude));
+    put_le32(&out[SYSTEM_OPERATOR_LON], (uint32_t) encodeLatLon(inData->OperatorLongitude));
+    put_le16(&out[SYSTEM_AREA_COUNT], inData->AreaCount);
+    out[SYSTEM_AREA_RADIUS] = encodeAreaRadius(inData->AreaRadius);
+    put_le16(&out[SYSTEM_AREA_CEILING], encodeAltitude(inData->AreaCeiling));
+    put_le16(&out[SYSTEM_AREA_FLOOR], encodeAltitude(inData->AreaFloor));
+    out[SYSTEM_EU] = nibbles(inData->CategoryEU, inData->ClassEU);
+    put_le16(&out[SYSTEM_OPERATOR_ALT], encodeAltitude(inData->OperatorAltitudeGeo));
+    put_le32(&out[SYSTEM_TIMESTAMP], inData->Timestamp);
+    out[SYSTEM_RESERVED] = 0;
+    return ODID_SUCCESS;
+}
+
+/**
+* Encode Operator ID message with explicit byte access
+*
+* Wire compatible alternative to encodeOperatorIDMessage()
+*
+* @param outEncoded Output (encoded/packed) structure
+* @param inData     Input data (non encoded/packed) structure
+* @return           ODID_SUCCESS or ODID_FAIL;
+*/
+int encodeOperatorIDMessageBytes(ODID_OperatorID_encoded *outEncoded, const ODID_OperatorID_data *inData)
+{
+    if (!outEncoded || !inData || !intInRange(inData->OperatorIdType, 0, 255))
+        return ODID_FAIL;
+
+    uint8_t *out = (uint8_t *) outEncoded;
+    out[MSG_HEADER] = msgHeader(ODID_MESSAGETYPE_OPERATOR_ID);
+    out[OPERATORID_TYPE] = (uint8_t) inData->OperatorIdType;
+    safe_enc_copyfill(&out[OPERATORID_ID], inData->OperatorId, ODID_ID_SIZE);
+    memset(&out[OPERATORID_RESERVED], 0, ODID_MESSAGE_SIZE - OPERATORID_RESERVED);
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode Basic ID message with explicit byte access
+*
+* Alternative to decodeBasicIDMessage() with identical results
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeBasicIDMessageBytes(ODID_BasicID_data *outData, const ODID_BasicID_encoded *inEncoded)
+{
+    const uint8_t *in = (const uint8_t *) inEncoded;
+    if (!outData || !inEncoded || !msgIsType(in, ODID_MESSAGETYPE_BASIC_ID))
+        return ODID_FAIL;
+
+    outData->IDType = (ODID_idtype_t) (in[BASICID_TYPES] >> 4);
+    outData->UAType = (ODID_uatype_t) (in[BASICID_TYPES] & 0x0F);
+    switch (outData->IDType)
+    {
+    case ODID_IDTYPE_SERIAL_NUMBER:
+    case ODID_IDTYPE_CAA_REGISTRATION_ID:
+        safe_dec_copyfill(outData->UASID, (const char *) &in[BASICID_UASID], sizeof(outData->UASID));
+        break;
+    default:
+        memcpy(outData->UASID, &in[BASICID_UASID], sizeof(outData->UASID));
+        break;
+    }
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode Location message with explicit byte access
+*
+* Alternative to decodeLocationMessage() with identical results
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeLocationMessageBytes(ODID_Location_data *outData, const ODID_Location_encoded *inEncoded)
+{
+    const uint8_t *in = (const uint8_t *) inEncoded;
+    if (!outData || !inEncoded || !msgIsType(in, ODID_MESSAGETYPE_LOCATION))
+        return ODID_FAIL;
+
+    uint8_t flags = in[LOC_FLAGS];
+    outData->Status = (ODID_status_t) (flags >> 4);
+    outData->Direction = decodeDirection(in[LOC_DIRECTION], (flags >> 1) & 1);
+    outData->SpeedHorizontal = decodeSpeedHorizontal(in[LOC_SPEED_H], flags & 1);
+    outData->SpeedVertical = decodeSpeedVertical((int8_t) in[LOC_SPEED_V]);
+    outData->Latitude = decodeLatLon((int32_t) get_le32(&in[LOC_LATITUDE]));
+    outData->Longitude = decodeLatLon((int32_t) get_le32(&in[LOC_LONGITUDE]));
+    outData->AltitudeBaro = decodeAltitude(get_le16(&in[LOC_ALT_BARO]));
+    outData->AltitudeGeo = decodeAltitude(get_le16(&in[LOC_ALT_GEO]));
+    outData->HeightType = (ODID_Height_reference_t) ((flags >> 2) & 1);
+    outData->Height = decodeAltitude(get_le16(&in[LOC_HEIGHT]));
+    outData->HorizAccuracy = (ODID_Horizontal_accuracy_t) (in[LOC_HV_ACCURACY] & 0x0F);
+    outData->VertAccuracy = (ODID_Vertical_accuracy_t) (in[LOC_HV_ACCURACY] >> 4);
+    outData->BaroAccuracy = (ODID_Vertical_accuracy_t) (in[LOC_BS_ACCURACY] >> 4);
+    outData->SpeedAccuracy = (ODID_Speed_accuracy_t) (in[LOC_BS_ACCURACY] & 0x0F);
+    outData->TSAccuracy = (ODID_Timestamp_accuracy_t) (in[LOC_TS_ACCURACY] & 0x0F);
+    outData->TimeStamp = decodeTimeStamp(get_le16(&in[LOC_TIMESTAMP]));
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode Auth message with explicit byte access
+*
+* Alternative to decodeAuthMessage() with identical results
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeAuthMessageBytes(ODID_Auth_data *outData, const ODID_Auth_encoded *inEncoded)
+{
+    const uint8_t *in = (const uint8_t *) inEncoded;
+    if (!outData || !inEncoded || !msgIsType(in, ODID_MESSAGETYPE_AUTH))
+        return ODID_FAIL;
+
+    int authType = in[AUTH_PAGE] >> 4;
+    int dataPage = in[AUTH_PAGE] & 0x0F;
+    if (checkAuthPage(authType, dataPage, in[AUTH_LAST_PAGE_INDEX], in[AUTH_LENGTH]) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    outData->AuthType = (ODID_authtype_t) authType;
+    outData->DataPage = (uint8_t) dataPage;
+    memset(outData->AuthData, 0, sizeof(outData->AuthData));
+    if (dataPage == 0) {
+        outData->LastPageIndex = in[AUTH_LAST_PAGE_INDEX];
+        outData->Length = in[AUTH_LENGTH];
+        outData->Timestamp = get_le32(&in[AUTH_TIMESTAMP]);
+        memcpy(outData->AuthData, &in[AUTH_DATA_PAGE_ZERO], ODID_AUTH_PAGE_ZERO_DATA_SIZE);
+    } else {
+        memcpy(outData->AuthData, &in[AUTH_DATA_PAGE_NONZERO], ODID_AUTH_PAGE_NONZERO_DATA_SIZE);
+    }
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode Self ID message with explicit byte access
+*
+* Alternative to decodeSelfIDMessage() with identical results
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeSelfIDMessageBytes(ODID_SelfID_data *outData, const ODID_SelfID_encoded *inEncoded)
+{
+    const uint8_t *in = (const uint8_t *) inEncoded;
+    if (!outData || !inEncoded || !msgIsType(in, ODID_MESSAGETYPE_SELF_ID))
+        return ODID_FAIL;
+
+    outData->DescType = (ODID_desctype_t) in[SELFID_DESC_TYPE];
+    safe_dec_copyfill(outData->Desc, (const char *) &in[SELFID_DESC], sizeof(outData->Desc));
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode System message with explicit byte access
+*
+* Alternative to decodeSystemMessage() with identical results
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeSystemMessageBytes(ODID_System_data *outData, const ODID_System_encoded *inEncoded)
+{
+    const uint8_t *in = (const uint8_t *) inEncoded;
+    if (!outData || !inEncoded || !msgIsType(in, ODID_MESSAGETYPE_SYSTEM))
+        return ODID_FAIL;
+
+    outData->OperatorLocationType =
+        (ODID_operator_location_type_t) (in[SYSTEM_FLAGS] & 0x03);
+    outData->ClassificationType =
+        (ODID_classification_type_t) ((in[SYSTEM_FLAGS] >> 2) & 0x07);
+    outData->OperatorLatitude = decodeLatLon((int32_t) get_le32(&in[SYSTEM_OPERATOR_LAT]));
+    outData->OperatorLongitude = decodeLatLon((int32_t) get_le32(&in[SYSTEM_OPERATOR_LON]));
+    outData->AreaCount = get_le16(&in[SYSTEM_AREA_COUNT]);
+    outData->AreaRadius = decodeAreaRadius(in[SYSTEM_AREA_RADIUS]);
+    outData->AreaCeiling = decodeAltitude(get_le16(&in[SYSTEM_AREA_CEILING]));
+    outData->AreaFloor = decodeAltitude(get_le16(&in[SYSTEM_AREA_FLOOR]));
+    outData->CategoryEU = (ODID_category_EU_t) (in[SYSTEM_EU] >> 4);
+    outData->ClassEU = (ODID_class_EU_t) (in[SYSTEM_EU] & 0x0F);
+    outData->OperatorAltitudeGeo = decodeAltitude(get_le16(&in[SYSTEM_OPERATOR_ALT]));
+    outData->Timestamp = get_le32(&in[SYSTEM_TIMESTAMP]);
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode Operator ID message with explicit byte access
+*
+* Alternative to decodeOperatorIDMessage() with identical results
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeOperatorIDMessageBytes(ODID_OperatorID_data *outData, const ODID_OperatorID_encoded *inEncoded)
+{
+    const uint8_t *in = (const uint8_t *) inEncoded;
+    if (!outData || !inEncoded || !msgIsType(in, ODID_MESSAGETYPE_OPERATOR_ID))
+        return ODID_FAIL;
+
+    outData->OperatorIdType = (ODID_operatorIdType_t) in[OPERATORID_TYPE];
+    safe_dec_copyfill(outData->OperatorId, (const char *) &in[OPERATORID_ID], sizeof(outData->OperatorId));
+    return ODID_SUCCESS;
+}
+
+/*
+ * Fixed-point decoding
+ *
+ * Steps of the scaled fields in the units of ODID_Location_fixed and
+ * ODID_System_fixed. These are the linear codecs above, scaled to integers.
+ */
+#define FIXED_DIR_SCALE         100     // Centidegrees per degree
+#define FIXED_SPEED_H_LOW       25      // cm/s per step, SPEED_DIV_LOW
+#define FIXED_SPEED_H_HIGH      75      // cm/s per step, SPEED_DIV_HIGH
+#define FIXED_SPEED_SCALE       100     // cm/s per m/s
+#define FIXED_SPEED_V           50      // cm/s per step, VSPEED_DIV_VAL
+#define FIXED_ALT_STEP          5       // Decimeters per step, ALT_DIV_VAL
+#define FIXED_ALT_SCALE         10      // Decimeters per meter
+#define FIXED_TIMESTAMP_SCALE   10      // Tenths of seconds per second
+
+static uint16_t decodeDirectionFixed(uint8_t Direction_enc, uint8_t EWDirection)
+{
+    return (uint16_t) ((Direction_enc + (EWDirection ? 180 : 0)) * FIXED_DIR_SCALE);
+}
+
+static uint16_t decodeSpeedHorizontalFixed(uint8_t Speed_enc, uint8_t mult)
+{
+    if (mult)
+        return (uint16_t) (Speed_enc * FIXED_SPEED_H_HIGH + UINT8_MAX * FIXED_SPEED_H_LOW);
+    return (uint16_t) (Speed_enc * FIXED_SPEED_H_LOW);
+}
+
+static int32_t decodeAltitudeFixed(uint16_t Alt_enc)
+{
+    return (int32_t) Alt_enc * FIXED_ALT_STEP - ALT_ADDER_VAL * FIXED_ALT_SCALE;
+}
+
+/**
+* Decode Location data from packed message into the fixed-point structure
+*
+* No floating point operations are used. odid_location_fixed_to_data() of
+* the result gives the same values as decodeLocationMessage().
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeLocationMessageFixed(ODID_Location_fixed *outData, const ODID_Location_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_LOCATION)
+        return ODID_FAIL;
+
+    outData->Status = (ODID_status_t) inEncoded->Status;
+    outData->Direction = decodeDirectionFixed(inEncoded->Direction, inEncoded->EWDirection);
+    outData->SpeedHorizontal = decodeSpeedHorizontalFixed(inEncoded->SpeedHorizontal, inEncoded->SpeedMult);
+    outData->SpeedVertical = (int16_t) (inEncoded->SpeedVertical * FIXED_SPEED_V);
+    outData->Latitude = inEncoded->Latitude;
+    outData->Longitude = inEncoded->Longitude;
+    outData->AltitudeBaro = decodeAltitudeFixed(inEncoded->AltitudeBaro);
+    outData->AltitudeGeo = decodeAltitudeFixed(inEncoded->AltitudeGeo);
+    outData->HeightType = (ODID_Height_reference_t) inEncoded->HeightType;
+    outData->Height = decodeAltitudeFixed(inEncoded->Height);
+    outData->HorizAccuracy = (ODID_Horizontal_accuracy_t) inEncoded->HorizAccuracy;
+    outData->VertAccuracy = (ODID_Vertical_accuracy_t) inEncoded->VertAccuracy;
+    outData->BaroAccuracy = (ODID_Vertical_accuracy_t) inEncoded->BaroAccuracy;
+    outData->SpeedAccuracy = (ODID_Speed_accuracy_t) inEncoded->SpeedAccuracy;
+    outData->TSAccuracy = (ODID_Timestamp_accuracy_t) inEncoded->TSAccuracy;
+    outData->TimeStamp = inEncoded->TimeStamp;
+    return ODID_SUCCESS;
+}
+
+/**
+* Decode System data from packed message into the fixed-point structure
+*
+* No floating point operations are used. odid_system_fixed_to_data() of the
+* result gives the same values as decodeSystemMessage().
+*
+* @param outData   Output: decoded message
+* @param inEncoded Input message (encoded/packed) structure
+* @return          ODID_SUCCESS or ODID_FAIL;
+*/
+int decodeSystemMessageFixed(ODID_System_fixed *outData, const ODID_System_encoded *inEncoded)
+{
+    if (!outData || !inEncoded ||
+        inEncoded->MessageType != ODID_MESSAGETYPE_SYSTEM)
+        return ODID_FAIL;
+
+    outData->OperatorLocationType =
+        (ODID_operator_location_type_t) inEncoded->OperatorLocationType;
+    outData->ClassificationType =
+        (ODID_classification_type_t) inEncoded->ClassificationType;
+    outData->OperatorLatitude = inEncoded->OperatorLatitude;
+    outData->OperatorLongitude = inEncoded->OperatorLongitude;
+    outData->AreaCount = inEncoded->AreaCount;
+    outData->AreaRadius = decodeAreaRadius(inEncoded->AreaRadius);
+    outData->AreaCeiling = decodeAltitudeFixed(inEncoded->AreaCeiling);
+    outData->AreaFloor = decodeAltitudeFixed(inEncoded->AreaFloor);
+    outData->CategoryEU = (ODID_category_EU_t) inEncoded->CategoryEU;
+    outData->ClassEU = (ODID_class_EU_t) inEncoded->ClassEU;
+    outData->OperatorAltitudeGeo = decodeAltitudeFixed(inEncoded->OperatorAltitudeGeo);
+    outData->Timestamp = inEncoded->Timestamp;
+    return ODID_SUCCESS;
+}
+
+// Convert a float value to fixed-point with the given scale, rounding to nearest
+static int32_t floatToFixed(float value, int scale, int32_t min, int32_t max)
+{
+    return intRangeMax((int64_t) lroundf(value * (float) scale), min, max);
+}
+
+static int32_t latLonToFixed(double value)
+{
+    return (int32_t) intRangeMax((int64_t) llround(value * LATLON_MULT), INT32_MIN, INT32_MAX);
+}
+
+/**
+* Convert fixed-point Location data to the floating point structure
+*
+* @param outData Output: floating point data
+* @param inFixed Input: fixed-point data
+*/
+void odid_location_fixed_to_data(ODID_Location_data *outData, const ODID_Location_fixed *inFixed)
+{
+    outData->Status = inFixed->Status;
+    outData->Direction = (float) inFixed->Direction / FIXED_DIR_SCALE;
+    outData->SpeedHorizontal = (float) inFixed->SpeedHorizontal / FIXED_SPEED_SCALE;
+    outData->SpeedVertical = (float) inFixed->SpeedVertical / FIXED_SPEED_SCALE;
+    outData->Latitude = decodeLatLon(inFixed->Latitude);
+    outData->Longitude = decodeLatLon(inFixed->Longitude);
+    outData->AltitudeBaro = (float) inFixed->AltitudeBaro / FIXED_ALT_SCALE;
+    outData->AltitudeGeo = (float) inFixed->AltitudeGeo / FIXED_ALT_SCALE;
+    outData->HeightType = inFixed->HeightType;
+    outData->Height = (float) inFixed->Height / FIXED_ALT_SCALE;
+    outData->HorizAccuracy = inFixed->HorizAccuracy;
+    outData->VertAccuracy = inFixed->VertAccuracy;
+    outData->BaroAccuracy = inFixed->BaroAccuracy;
+    outData->SpeedAccuracy = inFixed->SpeedAccuracy;
+    outData->TSAccuracy = inFixed->TSAccuracy;
+    outData->TimeStamp = decodeTimeStamp(inFixed->TimeStamp);
+}
+
+/**
+* Convert floating point Location data to the fixed-point structure
+*
+* Values are rounded to the nearest fixed-point step and limited to the range
+* of the fixed-point fields.
+*
+* @param outFixed Output: fixed-point data
+* @param inData   Input: floating point data
+*/
+void odid_location_data_to_fixed(ODID_Location_fixed *outFixed, const ODID_Location_data *inData)
+{
+    outFixed->Status = inData->Status;
+    outFixed->Direction = (uint16_t) floatToFixed(inData->Direction, FIXED_DIR_SCALE, 0, UINT16_MAX);
+    outFixed->SpeedHorizontal =
+        (uint16_t) floatToFixed(inData->SpeedHorizontal, FIXED_SPEED_SCALE, 0, UINT16_MAX);
+    outFixed->SpeedVertical =
+        (int16_t) floatToFixed(inData->SpeedVertical, FIXED_SPEED_SCALE, INT16_MIN, INT16_MAX);
+    outFixed->Latitude = latLonToFixed(inData->Latitude);
+    outFixed->Longitude = latLonToFixed(inData->Longitude);
+    outFixed->AltitudeBaro = floatToFixed(inData->AltitudeBaro, FIXED_ALT_SCALE, INT32_MIN, INT32_MAX);
+    outFixed->AltitudeGeo = floatToFixed(inData->AltitudeGeo, FIXED_ALT_SCALE, INT32_MIN, INT32_MAX);
+    outFixed->HeightType = inData->HeightType;
+    outFixed->Height = floatToFixed(inData->Height, FIXED_ALT_SCALE, INT32_MIN, INT32_MAX);
+    outFixed->HorizAccuracy = inData->HorizAccuracy;
+    outFixed->VertAccuracy = inData->VertAccuracy;
+    outFixed->BaroAccuracy = inData->BaroAccuracy;
+    outFixed->SpeedAccuracy = inData->SpeedAccuracy;
+    outFixed->TSAccuracy = inData->TSAccuracy;
+    if (inData->TimeStamp == INV_TIMESTAMP)
+        outFixed->TimeStamp = ODID_FIXED_INV_TIMESTAMP;
+    else
+        outFixed->TimeStamp =
+            (uint16_t) floatToFixed(inData->TimeStamp, FIXED_TIMESTAMP_SCALE, 0, UINT16_MAX);
+}
+
+/**
+* Convert fixed-point System data to the floating point structure
+*
+* @param outData Output: floating point data
+* @param inFixed Input: fixed-point data
+*/
+void odid_system_fixed_to_data(ODID_System_data *outData, const ODID_System_fixed *inFixed)
+{
+    outData->OperatorLocationType = inFixed->OperatorLocationType;
+    outData->ClassificationType = inFixed->ClassificationType;
+    outData->OperatorLatitude = decodeLatLon(inFixed->OperatorLatitude);
+    outData->OperatorLongitude = decodeLatLon(inFixed->OperatorLongitude);
+    outData->AreaCount = inFixed->AreaCount;
+    outData->AreaRadius = inFixed->AreaRadius;
+    outData->AreaCeiling = (float) inFixed->AreaCeiling / FIXED_ALT_SCALE;
+    outData->AreaFloor = (float) inFixed->AreaFloor / FIXED_ALT_SCALE;
+    outData->CategoryEU = inFixed->CategoryEU;
+    outData->ClassEU = inFixed->ClassEU;
+    outData->OperatorAltitudeGeo = (float) inFixed->OperatorAltitudeGeo / FIXED_ALT_SCALE;
+    outData->Timestamp = inFixed->Timestamp;
+}
+
+/**
+* Convert floating point System data to the fixed-point structure
+*
+* Values are rounded to the nearest fixed-point step and limited to the range
+* of the fixed-point fields.
+*
+* @param outFixed Output: fixed-point data
+* @param inData   Input: floating point data
+*/
+void odid_system_data_to_fixed(ODID_System_fixed *outFixed, const ODID_System_data *inData)
+{
+    outFixed->OperatorLocationType = inData->OperatorLocationType;
+    outFixed->ClassificationType = inData->ClassificationType;
+    outFixed->OperatorLatitude = latLonToFixed(inData->OperatorLatitude);
+    outFixed->OperatorLongitude = latLonToFixed(inData->OperatorLongitude);
+    outFixed->AreaCount = inData->AreaCount;
+    outFixed->AreaRadius = inData->AreaRadius;
+    outFixed->AreaCeiling = floatToFixed(inData->AreaCeiling, FIXED_ALT_SCALE, INT32_MIN, INT32_MAX);
+    outFixed->AreaFloor = floatToFixed(inData->AreaFloor, FIXED_ALT_SCALE, INT32_MIN, INT32_MAX);
+    outFixed->CategoryEU = inData->CategoryEU;
+    outFixed->ClassEU = inData->ClassEU;
+    outFixed->OperatorAltitudeGeo =
+        floatToFixed(inData->OperatorAltitudeGeo, FIXED_ALT_SCALE, INT32_MIN, INT32_MAX);
+    outFixed->Timestamp = inData->Timestamp;
+}
+
+/*
+ * Encoded-space Location filters
+ *
+ * The predicates are compiled into thresholds on the encoded fields, chosen
+ * so that a record matches exactly when the values decoded by
+ * decodeLocationMessage() would satisfy the predicate in real units. The
+ * latitude and longitude ranges are stored as a start and a number of
+ * values, with the offset from the start taken in wrapping 32-bit
+ * arithmetic. This covers boxes that cross the antimeridian without a
+ * branch, and a count of 0 the boxes without any encoded value.
+ */
+
+// Smallest encoded latitude or longitude that decodes to at least value
+static int32_t latLonLowerBound(double value)
+{
+    int64_t encoded = (int64_t) ceil(value * LATLON_MULT);
+    while (decodeLatLon((int32_t) (encoded - 1)) >= value)
+        encoded--;
+    while (decodeLatLon((int32_t) encoded) < value)
+        encoded++;
+    return (int32_t) encoded;
+}
+
+// Largest encoded latitude or longitude that decodes to at most value
+static int32_t latLonUpperBound(double value)
+{
+    int64_t encoded = (int64_t) floor(value * LATLON_MULT);
+    while (decodeLatLon((int32_t) (encoded + 1)) <= value)
+        encoded++;
+    while (decodeLatLon((int32_t) encoded) > value)
+        encoded--;
+    return (int32_t) encoded;
+}
+
+// Smallest encoded altitude that decodes to at least value, UINT16_MAX + 1 if none
+static uint32_t altitudeLowerBound(float value)
+{
+    uint32_t low = 0, high = UINT16_MAX + 1;
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (decodeAltitude((uint16_t) mid) >= value)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+    return low;
+}
+
+/**
+* Initialize a Location filter without predicates, which matches every
+* Location message
+*
+* @param filter The filter to initialize
+*/
+void odid_location_filter_init(ODID_Location_filter *filter)
+{
+    if (!filter)
+        return;
+    filter->LatitudeStart = INT32_MIN;
+    filter->LatitudeCount = (uint64_t) UINT32_MAX + 1;
+    filter->LongitudeStart = INT32_MIN;
+    filter->LongitudeCount = (uint64_t) UINT32_MAX + 1;
+    filter->AltitudeOffset = (uint8_t) offsetof(ODID_Location_encoded, AltitudeGeo);
+    filter->AltitudeMin = 0;
+    filter->AltitudeMax = UINT16_MAX;
+    filter->StatusMask = UINT16_MAX;
+}
+
+/**
+* Restrict a Location filter to a latitude/longitude box
+*
+* @param filter     The filter
+* @param latMin     Southern edge of the box in degrees
+* @param lonMin     Western edge of the box in degrees
+* @param latMax     Northern edge of the box in degrees
+* @param lonMax     Eastern edge of the box in degrees. A box crossing the
+*                   antimeridian has lonMax < lonMin
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_location_filter_box(ODID_Location_filter *filter, double latMin, double lonMin,
+                             double latMax, double lonMax)
+{
+    if (!filter || !(latMin <= latMax) || !(latMin >= MIN_LAT && latMax <= MAX_LAT) ||
+        !(lonMin >= MIN_LON && lonMin <= MAX_LON && lonMax >= MIN_LON && lonMax <= MAX_LON))
+        return ODID_FAIL;
+
+    int32_t latLow = latLonLowerBound(latMin);
+    int32_t latHigh = latLonUpperBound(latMax);
+    int32_t lonLow = latLonLowerBound(lonMin);
+    int32_t lonHigh = latLonUpperBound(lonMax);
+    filter->LatitudeStart = latLow;
+    filter->LongitudeStart = lonLow;
+    if (latLow > latHigh || (lonMin <= lonMax && lonLow > lonHigh)) {
+        // No encoded value falls in the box, which is narrower than one step
+        filter->LatitudeCount = 0;
+        filter->LongitudeCount = 0;
+    } else {
+        // Only a box crossing the antimeridian wraps around
+        filter->LatitudeCount = (uint64_t) ((uint32_t) latHigh - (uint32_t) latLow) + 1;
+        filter->LongitudeCount = (uint64_t) ((uint32_t) lonHigh - (uint32_t) lonLow) + 1;
+    }
+    return ODID_SUCCESS;
+}
+
+/**
+* Restrict a Location filter to an altitude band
+*
+* The invalid altitude INV_ALT (-1000 m) only matches bands that include it.
+*
+* @param filter     The filter
+* @param field      The altitude to check
+* @param min        Lowest altitude in meters
+* @param max        Highest altitude in meters
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_location_filter_altitude(ODID_Location_filter *filter, ODID_filter_altitude_t field,
+                                  float min, float max)
+{
+    if (!filter || !(min <= max))
+        return ODID_FAIL;
+
+    switch (field) {
+    case ODID_FILTER_ALTITUDE_GEO:
+        filter->AltitudeOffset = (uint8_t) offsetof(ODID_Location_encoded, AltitudeGeo);
+        break;
+    case ODID_FILTER_ALTITUDE_BARO:
+        filter->AltitudeOffset = (uint8_t) offsetof(ODID_Location_encoded, AltitudeBaro);
+        break;
+    case ODID_FILTER_HEIGHT:
+        filter->AltitudeOffset = (uint8_t) offsetof(ODID_Location_encoded, Height);
+        break;
+    default:
+        return ODID_FAIL;
+    }
+
+    uint32_t low = altitudeLowerBound(min);
+    uint32_t high = altitudeLowerBound(nextafterf(max, INFINITY));
+    if (low >= high) {
+        // No encoded value falls in the band
+        filter->AltitudeMin = 1;
+        filter->AltitudeMax = 0;
+    } else {
+        filter->AltitudeMin = (uint16_t) low;
+        filter->AltitudeMax = (uint16_t) (high - 1);
+    }
+    return ODID_SUCCESS;
+}
+
+/**
+* Restrict a Location filter to a set of operational statuses
+*
+* @param filter     The filter
+* @param statusMask Bit n set: ODID_status_t n matches, e.g.
+*                   1 << ODID_STATUS_EMERGENCY
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_location_filter_status(ODID_Location_filter *filter, uint16_t statusMask)
+{
+    if (!filter)
+        return ODID_FAIL;
+    filter->StatusMask = statusMask;
+    return ODID_SUCCESS;
+}
+
+static int filterMatch(const ODID_Location_filter *filter, const ODID_Location_encoded *in)
+{
+    uint16_t altitude;
+    memcpy(&altitude, (const uint8_t *) in + filter->AltitudeOffset, sizeof(altitude));
+    return (in->MessageType == ODID_MESSAGETYPE_LOCATION) &
+           ((uint32_t) in->Latitude - (uint32_t) filter->LatitudeStart < filter->LatitudeCount) &
+           ((uint32_t) in->Longitude - (uint32_t) filter->LongitudeStart < filter->LongitudeCount) &
+           (altitude >= filter->AltitudeMin) & (altitude <= filter->AltitudeMax) &
+           ((filter->StatusMask >> in->Status) & 1);
+}
+
+/**
+* Check whether an encoded Location message matches a filter, without
+* decoding it
+*
+* @param filter     The filter
+* @param inEncoded  The encoded message. Other message types never match
+* @return           1 if the message matches, 0 otherwise
+*/
+int odid_location_filter_match(const ODID_Location_filter *filter, const ODID_Location_encoded *inEncoded)
+{
+    if (!filter || !inEncoded)
+        return 0;
+    return filterMatch(filter, inEncoded);
+}
+
+/**
+* Find the encoded Location messages of an array that match a filter
+*
+* @param filter     The filter
+* @param inEncoded  Array of count encoded messages
+* @param count      Number of messages
+* @param out        Array receiving the indexes of the matching messages,
+*                   with room for count entries
+* @return           Number of matching messages
+*/
+size_t odid_location_filter_batch(const ODID_Location_filter *filter, const ODID_Location_encoded *inEncoded,
+                                  size_t count, uint32_t *out)
+{
+    if (!filter || !inEncoded || !out)
+        return 0;
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        out[found] = (uint32_t) i;
+        found += filterMatch(filter, &inEncoded[i]);
+    }
+    return found;
+}
+
+/**
+* Decodes the message type of a packed Open Drone ID message
+*
+* @param byte   The first byte of the message
+* @return       The message type: ODID_messagetype_t
+*/
+ODID_messagetype_t decodeMessageType(uint8_t byte)
+{
+    static const uint8_t messageTypes[16] = {
+        ODID_MESSAGETYPE_BASIC_ID, ODID_MESSAGETYPE_LOCATION, ODID_MESSAGETYPE_AUTH,
+        ODID_MESSAGETYPE_SELF_ID, ODID_MESSAGETYPE_SYSTEM, ODID_MESSAGETYPE_OPERATOR_ID,
+        ODID_MESSAGETYPE_INVALID, ODID_MESSAGETYPE_INVALID, ODID_MESSAGETYPE_INVALID,
+        ODID_MESSAGETYPE_INVALID, ODID_MESSAGETYPE_INVALID, ODID_MESSAGETYPE_INVALID,
+        ODID_MESSAGETYPE_INVALID, ODID_MESSAGETYPE_INVALID, ODID_MESSAGETYPE_INVALID,
+        ODID_MESSAGETYPE_PACKED,
+    };
+    return (ODID_messagetype_t) messageTypes[byte >> 4];
+}
+
+/**
+* Find the slot of uasData for a Basic ID message: the first one that is free
+* or holds data of the same ID type, so that old data of that type is replaced
+*
+* @param uasData    Structure containing buffers for all message data
+* @param basicId    The encoded Basic ID message
+* @return           Index into uasData->BasicID or -1 if there is no slot
+*/
+static int findBasicIDSlot(const ODID_UAS_Data *uasData, ODID_BasicID_encoded *basicId)
+{
+    enum ODID_idtype idType;
+    if (getBasicIDType(basicId, &idType) != ODID_SUCCESS)
+        return -1;
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+        enum ODID_idtype storedType = uasData->BasicID[i].IDType;
+        if (storedType == ODID_IDTYPE_NONE || storedType == idType)
+            return i;
+    }
+    return -1;
+}
+
+/**
+* Decode a Basic ID message into the first free (or same ID type) slot of uasData
+*
+* @param uasData    Structure containing buffers for all message data
+* @param msgData    Pointer to a buffer containing a full encoded message
+* @param context    Not used
+* @return           ODID_MESSAGETYPE_BASIC_ID or ODID_MESSAGETYPE_INVALID
+*/
+static ODID_messagetype_t decodeBasicIDIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                               void *context)
+{
+    (void) context;
+    ODID_BasicID_encoded *basicId = (ODID_BasicID_encoded *) msgData;
+    int i = findBasicIDSlot(uasData, basicId);
+    if (i >= 0 && decodeBasicIDMessage(&uasData->BasicID[i], basicId) == ODID_SUCCESS) {
+        uasData->BasicIDValid[i] = 1;
+        return ODID_MESSAGETYPE_BASIC_ID;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static ODID_messagetype_t decodeLocationIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                                void *context)
+{
+    (void) context;
+    ODID_Location_encoded *location = (ODID_Location_encoded *) msgData;
+    if (decodeLocationMessage(&uasData->Location, location) == ODID_SUCCESS) {
+        uasData->LocationValid = 1;
+        return ODID_MESSAGETYPE_LOCATION;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static ODID_messagetype_t decodeAuthIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                            void *context)
+{
+    (void) context;
+    ODID_Auth_encoded *auth = (ODID_Auth_encoded *) msgData;
+    int pageNum;
+    if (getAuthPageNum(auth, &pageNum) == ODID_SUCCESS) {
+        ODID_Auth_data *authData = &uasData->Auth[pageNum];
+        if (decodeAuthMessage(authData, auth) == ODID_SUCCESS) {
+            uasData->AuthValid[pageNum] = 1;
+            return ODID_MESSAGETYPE_AUTH;
+        }
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static ODID_messagetype_t decodeSelfIDIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                              void *context)
+{
+    (void) context;
+    ODID_SelfID_encoded *selfId = (ODID_SelfID_encoded *) msgData;
+    if (decodeSelfIDMessage(&uasData->SelfID, selfId) == ODID_SUCCESS) {
+        uasData->SelfIDValid = 1;
+        return ODID_MESSAGETYPE_SELF_ID;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static ODID_messagetype_t decodeSystemIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                              void *context)
+{
+    (void) context;
+    ODID_System_encoded *system = (ODID_System_encoded *) msgData;
+    if (decodeSystemMessage(&uasData->System, system) == ODID_SUCCESS) {
+        uasData->SystemValid = 1;
+        return ODID_MESSAGETYPE_SYSTEM;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static ODID_messagetype_t decodeOperatorIDIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                                  void *context)
+{
+    (void) context;
+    ODID_OperatorID_encoded *operatorId = (ODID_OperatorID_encoded *) msgData;
+    if (decodeOperatorIDMessage(&uasData->OperatorID, operatorId) == ODID_SUCCESS) {
+        uasData->OperatorIDValid = 1;
+        return ODID_MESSAGETYPE_OPERATOR_ID;
+    }
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+static ODID_messagetype_t decodePackIntoUas(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                            void *context)
+{
+    (void) context;
+    ODID_MessagePack_encoded *pack = (ODID_MessagePack_encoded *) msgData;
+    if (decodeMessagePack(uasData, pack) == ODID_SUCCESS)
+        return ODID_MESSAGETYPE_PACKED;
+    return ODID_MESSAGETYPE_INVALID;
+}
+
+// Decoders indexed by the message type nibble. Empty entries are invalid types
+static struct {
+    ODID_decoder_fn decoder;
+    void *context;
+} messageDecoders[16] = {
+    [ODID_MESSAGETYPE_BASIC_ID] = { decodeBasicIDIntoUas, NULL },
+    [ODID_MESSAGETYPE_LOCATION] = { decodeLocationIntoUas, NULL },
+    [ODID_MESSAGETYPE_AUTH] = { decodeAuthIntoUas, NULL },
+    [ODID_MESSAGETYPE_SELF_ID] = { decodeSelfIDIntoUas, NULL },
+    [ODID_MESSAGETYPE_SYSTEM] = { decodeSystemIntoUas, NULL },
+    [ODID_MESSAGETYPE_OPERATOR_ID] = { decodeOperatorIDIntoUas, NULL },
+    [ODID_MESSAGETYPE_PACKED] = { decodePackIntoUas, NULL },
+};
+
+/**
+* Register a decoder for a message type that is reserved by the specification
+*
+* decodeOpenDroneID() and odid_decode_batch() call the decoder for each
+* message of that type, e.g. for private message types used during development. Message packs can not
+* contain these message types. Registering is not thread safe and should be
+* done before any messages are decoded.
+*
+* @param messageType    Message type (upper nibble of the first message byte)
+* @param decoder        The decoder or NULL to remove a registered decoder
+* @param context        Passed to the decoder on each call
+* @return               ODID_SUCCESS or ODID_FAIL if the message type is not
+*                       reserved
+*/
+int odid_register_decoder(uint8_t messageType, ODID_decoder_fn decoder, void *context)
+{
+    if (messageType >= 16 || decodeMessageType((uint8_t) (messageType << 4)) != ODID_MESSAGETYPE_INVALID)
+        return ODID_FAIL;
+
+    messageDecoders[messageType].decoder = decoder;
+    messageDecoders[messageType].context = context;
+    return ODID_SUCCESS;
+}
+
+/**
+* Parse encoded Open Drone ID data to identify the message type. Then decode
+* from Open Drone ID packed format into the appropriate Open Drone ID structure
+*
+* This function assumes that msgData points to a buffer containing all
+* ODID_MESSAGE_SIZE bytes of an Open Drone ID message.
+*
+* The various Valid flags in uasData are set true whenever a message has been
+* decoded and the corresponding data structure has been filled. The caller must
+* clear these flags before calling decodeOpenDroneID().
+*
+* The decoder is selected by indexing a table with the message type, so that
+* there is a single indirect branch instead of a chain of compares. Decoders
+* for reserved message types can be added with odid_register_decoder().
+*
+* @param uasData    Structure containing buffers for all message data
+* @param msgData    Pointer to a buffer containing a full encoded Open Drone ID
+*                   message
+* @return           The message type: ODID_messagetype_t
+*/
+ODID_messagetype_t decodeOpenDroneID(ODID_UAS_Data *uasData, const uint8_t *msgData)
+{
+    if (!uasData || !msgData)
+        return ODID_MESSAGETYPE_INVALID;
+
+    uint8_t type = msgData[0] >> 4;
+    if (!messageDecoders[type].decoder)
+        return ODID_MESSAGETYPE_INVALID;
+    return messageDecoders[type].decoder(uasData, msgData, messageDecoders[type].context);
+}
+
+static uint32_t basicIDChanges(const ODID_BasicID_data *a, const ODID_BasicID_data *b)
+{
+    if (a->IDType != b->IDType || a->UAType != b->UAType ||
+        memcmp(a->UASID, b->UASID, sizeof(a->UASID)) != 0)
+        return ODID_CHANGED_BASIC_ID;
+    return 0;
+}
+
+static uint32_t locationChanges(const ODID_Location_data *a, const ODID_Location_data *b)
+{
+    uint32_t changed = 0;
+    if (a->Status != b->Status)
+        changed |= ODID_CHANGED_STATUS;
+    if (a->Latitude != b->Latitude || a->Longitude != b->Longitude)
+        changed |= ODID_CHANGED_POSITION;
+    if (a->AltitudeBaro != b->AltitudeBaro || a->AltitudeGeo != b->AltitudeGeo ||
+        a->HeightType != b->HeightType || a->Height != b->Height)
+        changed |= ODID_CHANGED_ALTITUDE;
+    if (a->Direction != b->Direction || a->SpeedHorizontal != b->SpeedHorizontal ||
+        a->SpeedVertical != b->SpeedVertical)
+        changed |= ODID_CHANGED_SPEED;
+    if (a->HorizAccuracy != b->HorizAccuracy || a->VertAccuracy != b->VertAccuracy ||
+        a->BaroAccuracy != b->BaroAccuracy || a->SpeedAccuracy != b->SpeedAccuracy ||
+        a->TSAccuracy != b->TSAccuracy)
+        changed |= ODID_CHANGED_ACCURACY;
+    if (a->TimeStamp != b->TimeStamp)
+        changed |= ODID_CHANGED_LOCATION_TIME;
+    return changed;
+}
+
+static uint32_t authChanges(const ODID_Auth_data *a, const ODID_Auth_data *b)
+{
+    if (a->DataPage != b->DataPage || a->AuthType != b->AuthType ||
+        a->LastPageIndex != b->LastPageIndex || a->Length != b->Length ||
+        a->Timestamp != b->Timestamp || memcmp(a->AuthData, b->AuthData, sizeof(a->AuthData)) != 0)
+        return ODID_CHANGED_AUTH;
+    return 0;
+}
+
+static uint32_t selfIDChanges(const ODID_SelfID_data *a, const ODID_SelfID_data *b)
+{
+    if (a->DescType != b->DescType || memcmp(a->Desc, b->Desc, sizeof(a->Desc)) != 0)
+        return ODID_CHANGED_SELF_ID;
+    return 0;
+}
+
+static uint32_t systemChanges(const ODID_System_data *a, const ODID_System_data *b)
+{
+    uint32_t changed = 0;
+    if (a->OperatorLocationType != b->OperatorLocationType ||
+        a->OperatorLatitude != b->OperatorLatitude || a->OperatorLongitude != b->OperatorLongitude ||
+        a->OperatorAltitudeGeo != b->OperatorAltitudeGeo)
+        changed |= ODID_CHANGED_OPERATOR_LOCATION;
+    if (a->AreaCount != b->AreaCount || a->AreaRadius != b->AreaRadius ||
+        a->AreaCeiling != b->AreaCeiling || a->AreaFloor != b->AreaFloor)
+        changed |= ODID_CHANGED_AREA;
+    if (a->ClassificationType != b->ClassificationType ||
+        a->CategoryEU != b->CategoryEU || a->ClassEU != b->ClassEU)
+        changed |= ODID_CHANGED_CLASSIFICATION;
+    if (a->Timestamp != b->Timestamp)
+        changed |= ODID_CHANGED_SYSTEM_TIME;
+    return changed;
+}
+
+static uint32_t operatorIDChanges(const ODID_OperatorID_data *a, const ODID_OperatorID_data *b)
+{
+    if (a->OperatorIdType != b->OperatorIdType ||
+        memcmp(a->OperatorId, b->OperatorId, sizeof(a->OperatorId)) != 0)
+        return ODID_CHANGED_OPERATOR_ID;
+    return 0;
+}
+
+/*
+ * Encoded bits of the fields of each ODID_CHANGED_* bit, to find the changes
+ * between a message and the memoized one without decoding either of them.
+ * The header and the reserved bits are not part of any field.
+ */
+typedef struct {
+    uint8_t offset;             // First byte of the field
+    uint8_t size;               // Number of bytes
+    uint8_t mask;               // Bits of the field in each of its bytes
+    uint32_t changed;           // ODID_CHANGED_* bit of the field
+} encoded_field_t;
+
+#define ENCODED_FIELDS(fields) fields, sizeof(fields) / sizeof(fields[0])
+
+static const encoded_field_t basicIDFields[] = {
+    { 1, 1 + ODID_ID_SIZE, 0xFF, ODID_CHANGED_BASIC_ID } };
+
+static const encoded_field_t locationFields[] = {
+    { 1, 1, 0xF0, ODID_CHANGED_STATUS },
+    { 5, 8, 0xFF, ODID_CHANGED_POSITION },      // Latitude, Longitude
+    { 1, 1, 0x04, ODID_CHANGED_ALTITUDE },      // HeightType
+    { 13, 6, 0xFF, ODID_CHANGED_ALTITUDE },     // AltitudeBaro, AltitudeGeo, Height
+    { 1, 1, 0x03, ODID_CHANGED_SPEED },         // SpeedMult, EWDirection
+    { 2, 3, 0xFF, ODID_CHANGED_SPEED },         // Direction, SpeedHorizontal, SpeedVertical
+    { 19, 2, 0xFF, ODID_CHANGED_ACCURACY },
+    { 23, 1, 0x0F, ODID_CHANGED_ACCURACY },     // TSAccuracy
+    { 21, 2, 0xFF, ODID_CHANGED_LOCATION_TIME } };
+
+static const encoded_field_t authFields[] = {
+    { 1, ODID_MESSAGE_SIZE - 1, 0xFF, ODID_CHANGED_AUTH } };
+
+static const encoded_field_t selfIDFields[] = {
+    { 1, 1 + ODID_STR_SIZE, 0xFF, ODID_CHANGED_SELF_ID } };
+
+static const encoded_field_t systemFields[] = {
+    { 1, 1, 0x03, ODID_CHANGED_OPERATOR_LOCATION },     // OperatorLocationType
+    { 2, 8, 0xFF, ODID_CHANGED_OPERATOR_LOCATION },     // OperatorLatitude, OperatorLongitude
+    { 18, 2, 0xFF, ODID_CHANGED_OPERATOR_LOCATION },    // OperatorAltitudeGeo
+    { 10, 7, 0xFF, ODID_CHANGED_AREA },
+    { 1, 1, 0x1C, ODID_CHANGED_CLASSIFICATION },        // ClassificationType
+    { 17, 1, 0xFF, ODID_CHANGED_CLASSIFICATION },       // CategoryEU, ClassEU
+    { 20, 4, 0xFF, ODID_CHANGED_SYSTEM_TIME } };
+
+static const encoded_field_t operatorIDFields[] = {
+    { 1, 1 + ODID_ID_SIZE, 0xFF, ODID_CHANGED_OPERATOR_ID } };
+
+static uint32_t encodedChanges(const encoded_field_t *fields, size_t count,
+                               const uint8_t *a, const uint8_t *b)
+{
+    uint32_t changed = 0;
+    for (size_t i = 0; i < count; i++) {
+        const encoded_field_t *field = &fields[i];
+        if (changed & field->changed)
+            continue;
+        for (int j = field->offset; j < field->offset + field->size; j++) {
+            if ((a[j] ^ b[j]) & field->mask) {
+                changed |= field->changed;
+                break;
+            }
+        }
+    }
+    return changed;
+}
+
+/**
+* Return the slot of uasData that a message is stored in
+*
+* @param uasData    Structure containing buffers for all message data
+* @param type       The message type of msgData
+* @param msgData    Pointer to a buffer containing a full encoded message
+* @return           Index into the Basic ID or Auth arrays of uasData, 0 for
+*                   the other message types or -1 if there is no slot
+*/
+static int messageSlot(const ODID_UAS_Data *uasData, ODID_messagetype_t type, const uint8_t *msgData)
+{
+    int slot = 0;
+    if (type == ODID_MESSAGETYPE_BASIC_ID)
+        slot = findBasicIDSlot(uasData, (ODID_BasicID_encoded *) msgData);
+    else if (type == ODID_MESSAGETYPE_AUTH && getAuthPageNum((ODID_Auth_encoded *) msgData, &slot) != ODID_SUCCESS)
+        slot = -1;
+    return slot;
+}
+
+static uint8_t *validFlag(ODID_UAS_Data *uasData, ODID_messagetype_t type, int slot)
+{
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID: return &uasData->BasicIDValid[slot];
+    case ODID_MESSAGETYPE_LOCATION: return &uasData->LocationValid;
+    case ODID_MESSAGETYPE_AUTH: return &uasData->AuthValid[slot];
+    case ODID_MESSAGETYPE_SELF_ID: return &uasData->SelfIDValid;
+    case ODID_MESSAGETYPE_SYSTEM: return &uasData->SystemValid;
+    default: return &uasData->OperatorIDValid;
+    }
+}
+
+static uint64_t *timestamp(ODID_UAS_Timestamps *timestamps, ODID_messagetype_t type, int slot)
+{
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID: return &timestamps->BasicID[slot];
+    case ODID_MESSAGETYPE_LOCATION: return &timestamps->Location;
+    case ODID_MESSAGETYPE_AUTH: return &timestamps->Auth[slot];
+    case ODID_MESSAGETYPE_SELF_ID: return &timestamps->SelfID;
+    case ODID_MESSAGETYPE_SYSTEM: return &timestamps->System;
+    default: return &timestamps->OperatorID;
+    }
+}
+
+static uint8_t *memoEntry(ODID_Message_memo *memo, ODID_messagetype_t type, int slot)
+{
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID: return memo->BasicID[slot];
+    case ODID_MESSAGETYPE_LOCATION: return memo->Location;
+    case ODID_MESSAGETYPE_AUTH: return memo->Auth[slot];
+    case ODID_MESSAGETYPE_SELF_ID: return memo->SelfID;
+    case ODID_MESSAGETYPE_SYSTEM: return memo->System;
+    default: return memo->OperatorID;
+    }
+}
+
+/**
+* Initialize a raw message memo, so that no message matches it
 *
-* This function assumes that msgData points to a buffer containing all
-* ODID_MESSAGE_SIZE bytes of an Open Drone ID message.
+* @param memo   The memo of one UAS
+*/
+void odid_initMessageMemo(ODID_Message_memo *memo)
+{
+    if (!memo)
+        return;
+    // 0xFF is the first byte of a message pack, which is never memoized
+    memset(memo, 0xFF, sizeof(*memo));
+    memo->Hits = 0;
+    memo->Misses = 0;
+}
+
+/*
+ * Check whether a message is byte identical to the one last decoded into
+ * its (still valid) slot. Misses are counted by memoStore().
+ */
+static int memoHit(ODID_Message_memo *memo, const uint8_t *entry, uint8_t valid, const uint8_t *msgData)
+{
+    if (!valid || memcmp(entry, msgData, ODID_MESSAGE_SIZE) != 0)
+        return 0;
+    memo->Hits++;
+    return 1;
+}
+
+static void memoStore(ODID_Message_memo *memo, uint8_t *entry, const uint8_t *msgData)
+{
+    memo->Misses++;
+    memcpy(entry, msgData, ODID_MESSAGE_SIZE);
+}
+
+/*
+ * Decode a message into the stored data. When changes must be reported, they
+ * are found from the encoded bits if the message that was decoded into the
+ * stored data is memoized, otherwise by decoding into a temporary structure
+ * and comparing it with the stored data. Data that was not valid before
+ * counts as changed in all its fields.
+ */
+#define MERGE_DECODE(dataType, decodeFn, encodedType, stored, changesFn, fields, allChanged) \
+    do {                                                                            \
+        if (!changed)                                                               \
+            return decodeFn(&(stored), (encodedType *) msgData);                    \
+        if (memoized) {                                                             \
+            uint32_t fieldChanges = encodedChanges(ENCODED_FIELDS(fields), memoized, msgData); \
+            if (decodeFn(&(stored), (encodedType *) msgData) != ODID_SUCCESS)       \
+                return ODID_FAIL;                                                   \
+            *changed |= fieldChanges;                                               \
+            return ODID_SUCCESS;                                                    \
+        }                                                                           \
+        dataType decoded;                                                           \
+        if (decodeFn(&decoded, (encodedType *) msgData) != ODID_SUCCESS)            \
+            return ODID_FAIL;                                                       \
+        *changed |= valid ? changesFn(&(stored), &decoded) : (allChanged);         \
+        (stored) = decoded;                                                         \
+        return ODID_SUCCESS;                                                        \
+    } while (0)
+
+/*
+ * memoized is the message last decoded into the (valid) slot, or NULL if it
+ * is not known.
+ */
+static int mergeDecode(ODID_UAS_Data *uasData, ODID_messagetype_t type, int slot, uint8_t valid,
+                       const uint8_t *msgData, const uint8_t *memoized, uint32_t *changed)
+{
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID:
+        MERGE_DECODE(ODID_BasicID_data, decodeBasicIDMessage, ODID_BasicID_encoded,
+                     uasData->BasicID[slot], basicIDChanges, basicIDFields, ODID_CHANGED_BASIC_ID);
+    case ODID_MESSAGETYPE_LOCATION:
+        MERGE_DECODE(ODID_Location_data, decodeLocationMessage, ODID_Location_encoded,
+                     uasData->Location, locationChanges, locationFields, ODID_CHANGED_LOCATION);
+    case ODID_MESSAGETYPE_AUTH:
+        MERGE_DECODE(ODID_Auth_data, decodeAuthMessage, ODID_Auth_encoded,
+                     uasData->Auth[slot], authChanges, authFields, ODID_CHANGED_AUTH);
+    case ODID_MESSAGETYPE_SELF_ID:
+        MERGE_DECODE(ODID_SelfID_data, decodeSelfIDMessage, ODID_SelfID_encoded,
+                     uasData->SelfID, selfIDChanges, selfIDFields, ODID_CHANGED_SELF_ID);
+    case ODID_MESSAGETYPE_SYSTEM:
+        MERGE_DECODE(ODID_System_data, decodeSystemMessage, ODID_System_encoded,
+                     uasData->System, systemChanges, systemFields, ODID_CHANGED_SYSTEM);
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+        MERGE_DECODE(ODID_OperatorID_data, decodeOperatorIDMessage, ODID_OperatorID_encoded,
+                     uasData->OperatorID, operatorIDChanges, operatorIDFields, ODID_CHANGED_OPERATOR_ID);
+    default:
+        return ODID_FAIL;
+    }
+}
+
+/**
+* Decode a message or message pack into existing UAS data, recording the
+* receive time of each decoded message
 *
-* The various Valid flags in uasData are set true whenever a message has been
-* decoded and the corresponding data structure has been filled. The caller must
-* clear these flags before calling decodeOpenDroneID().
+* The data is updated in place, like decodeOpenDroneID() does: messages that
+* are not received keep their data, valid flag and timestamp, so the UAS data
+* collects everything a UAS has sent over multiple frames.
+*
+* Optionally, the ODID_CHANGED_* bits of the fields whose value differs from
+* the stored data are added to changed. The first reception of a message sets
+* the bits of all its fields. This lets applications skip frames that only
+* repeat what they already know, without comparing UAS data themselves.
+*
+* With a memo, a message that is byte identical to the one last decoded into
+* the same slot is not decoded again; only its timestamp is updated. The
+* changes of other messages are then found by comparing their encoded fields
+* with the memoized message, so changes made to uasData by the application
+* are not reported.
 *
 * @param uasData    Structure containing buffers for all message data
+* @param timestamps Receive time of each message in uasData
+* @param now        Time of reception of msgData, must not be 0
 * @param msgData    Pointer to a buffer containing a full encoded Open Drone ID
-*                   message
+*                   message or message pack
+* @param changed    Optional (can be NULL): bitmask to which the ODID_CHANGED_*
+*                   bits of the changed fields are added
+* @param memo       Optional (can be NULL): raw messages last decoded into
+*                   uasData, see odid_initMessageMemo()
 * @return           The message type: ODID_messagetype_t
 */
-ODID_messagetype_t decodeOpenDroneID(ODID_UAS_Data *uasData, const uint8_t *msgData)
+ODID_messagetype_t odid_decode_merge(ODID_UAS_Data *uasData, ODID_UAS_Timestamps *timestamps,
+                                     uint64_t now, const uint8_t *msgData, uint32_t *changed,
+                                     ODID_Message_memo *memo)
 {
-    if (!uasData || !msgData)
+    if (!uasData || !timestamps || !msgData)
         return ODID_MESSAGETYPE_INVALID;
 
-    switch (decodeMessageType(msgData[0]))
-    {
-    case ODID_MESSAGETYPE_BASIC_ID: {
-        ODID_BasicID_encoded *basicId = (ODID_BasicID_encoded *) msgData;
-        enum ODID_idtype idType;
-        if (getBasicIDType(basicId, &idType) == ODID_SUCCESS) {
-            // Find a free slot to store the current message in or overwrite old data of the same type.
-            for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
-                enum ODID_idtype storedType = uasData->BasicID[i].IDType;
-                if (storedType == ODID_IDTYPE_NONE || storedType == idType) {
-                    if (decodeBasicIDMessage(&uasData->BasicID[i], basicId) == ODID_SUCCESS) {
-                        uasData->BasicIDValid[i] = 1;
-                        return ODID_MESSAGETYPE_BASIC_ID;
-                    }
-                }
-            }
-        }
-        break;
+    ODID_messagetype_t type = decodeMessageType(msgData[0]);
+    if (type == ODID_MESSAGETYPE_PACKED) {
+        ODID_MessagePack_encoded *pack = (ODID_MessagePack_encoded *) msgData;
+        if (pack->SingleMessageSize != ODID_MESSAGE_SIZE ||
+            checkPackContent(pack->Messages, pack->MsgPackSize) != ODID_SUCCESS)
+            return ODID_MESSAGETYPE_INVALID;
+        for (int i = 0; i < pack->MsgPackSize; i++)
+            odid_decode_merge(uasData, timestamps, now, pack->Messages[i].rawData, changed, memo);
+        return ODID_MESSAGETYPE_PACKED;
     }
-    case ODID_MESSAGETYPE_LOCATION: {
-        ODID_Location_encoded *location = (ODID_Location_encoded *) msgData;
-        if (decodeLocationMessage(&uasData->Location, location) == ODID_SUCCESS) {
-            uasData->LocationValid = 1;
-            return ODID_MESSAGETYPE_LOCATION;
-        }
-        break;
+    if (type == ODID_MESSAGETYPE_INVALID) {
+        // Message types with a decoder registered by the application
+        return decodeOpenDroneID(uasData, msgData);
     }
-    case ODID_MESSAGETYPE_AUTH: {
-        ODID_Auth_encoded *auth = (ODID_Auth_encoded *) msgData;
-        int pageNum;
-        if (getAuthPageNum(auth, &pageNum) == ODID_SUCCESS) {
-            ODID_Auth_data *authData = &uasData->Auth[pageNum];
-            if (decodeAuthMessage(authData, auth) == ODID_SUCCESS) {
-                uasData->AuthValid[pageNum] = 1;
-                return ODID_MESSAGETYPE_AUTH;
-            }
-        }
-        break;
+
+    int slot = messageSlot(uasData, type, msgData);
+    if (slot < 0)
+        return ODID_MESSAGETYPE_INVALID;
+    uint8_t *valid = validFlag(uasData, type, slot);
+    uint8_t *entry = memo ? memoEntry(memo, type, slot) : NULL;
+
+    if (!entry || !memoHit(memo, entry, *valid, msgData)) {
+        // The memo holds a message of this type once one was decoded into the slot
+        const uint8_t *memoized = NULL;
+        if (entry && *valid && decodeMessageType(entry[0]) == type)
+            memoized = entry;
+        if (mergeDecode(uasData, type, slot, *valid, msgData, memoized, changed) != ODID_SUCCESS)
+            return ODID_MESSAGETYPE_INVALID;
+        if (entry)
+            memoStore(memo, entry, msgData);
+        *valid = 1;
     }
-    case ODID_MESSAGETYPE_SELF_ID: {
-        ODID_SelfID_encoded *selfId = (ODID_SelfID_encoded *) msgData;
-        if (decodeSelfIDMessage(&uasData->SelfID, selfId) == ODID_SUCCESS) {
-            uasData->SelfIDValid = 1;
-            return ODID_MESSAGETYPE_SELF_ID;
-        }
-        break;
+    *timestamp(timestamps, type, slot) = now;
+    return type;
+}
+
+/**
+* Decode a message or message pack with decodeOpenDroneID(), unless it is byte
+* identical to the message last decoded into the same slot of uasData
+*
+* Messages such as Basic ID, Self ID, System and Operator ID are usually sent
+* unchanged during a whole flight. The memo holds the raw bytes of the last
+* message decoded into each slot, so that these repeats cost a 25 byte compare
+* instead of a decode. Hits and misses are counted in the memo. A slot whose
+* valid flag was cleared is always decoded again.
+*
+* @param uasData    Structure containing buffers for all message data
+* @param memo       Raw messages last decoded into uasData
+* @param msgData    Pointer to a buffer containing a full encoded Open Drone ID
+*                   message or message pack
+* @return           The message type: ODID_messagetype_t
+*/
+ODID_messagetype_t odid_decode_memo(ODID_UAS_Data *uasData, ODID_Message_memo *memo,
+                                    const uint8_t *msgData)
+{
+    if (!uasData || !memo || !msgData)
+        return ODID_MESSAGETYPE_INVALID;
+
+    ODID_messagetype_t type = decodeMessageType(msgData[0]);
+    if (type == ODID_MESSAGETYPE_PACKED) {
+        ODID_MessagePack_encoded *pack = (ODID_MessagePack_encoded *) msgData;
+        if (pack->SingleMessageSize != ODID_MESSAGE_SIZE ||
+            checkPackContent(pack->Messages, pack->MsgPackSize) != ODID_SUCCESS)
+            return ODID_MESSAGETYPE_INVALID;
+        for (int i = 0; i < pack->MsgPackSize; i++)
+            odid_decode_memo(uasData, memo, pack->Messages[i].rawData);
+        return ODID_MESSAGETYPE_PACKED;
     }
-    case ODID_MESSAGETYPE_SYSTEM: {
-        ODID_System_encoded *system = (ODID_System_encoded *) msgData;
-        if (decodeSystemMessage(&uasData->System, system) == ODID_SUCCESS) {
-            uasData->SystemValid = 1;
-            return ODID_MESSAGETYPE_SYSTEM;
-        }
-        break;
+
+    int slot = -1;
+    if (type != ODID_MESSAGETYPE_INVALID)
+        slot = messageSlot(uasData, type, msgData);
+    if (slot < 0)
+        return decodeOpenDroneID(uasData, msgData);
+
+    uint8_t *entry = memoEntry(memo, type, slot);
+    if (memoHit(memo, entry, *validFlag(uasData, type, slot), msgData))
+        return type;
+    if (decodeOpenDroneID(uasData, msgData) != type)
+        return ODID_MESSAGETYPE_INVALID;
+    memoStore(memo, entry, msgData);
+    return type;
+}
+
+/**
+* Decode all messages of one message type from a batch
+*
+* @param decodeFn   Type specific decoder storing a message into a UAS structure,
+*                   or NULL if the messages are invalid
+* @param context    Passed to decodeFn
+* @param uasData    Array of structures receiving the decoded data
+* @param uasCount   Number of entries in uasData
+* @param msgs       The encoded messages of the batch
+* @param sourceTags Optional per message index into uasData
+* @param order      Indices into msgs of the messages to decode
+* @param count      Number of entries in order
+* @param outTypes   Optional per message output of the decoded message type
+* @return           Number of successfully decoded messages
+*/
+static size_t decodeBatchGroup(ODID_decoder_fn decodeFn, void *context,
+                               ODID_UAS_Data *uasData, size_t uasCount,
+                               const ODID_Message_encoded *msgs, const uint16_t *sourceTags,
+                               const uint16_t *order, size_t count,
+                               ODID_messagetype_t *outTypes)
+{
+    size_t decoded = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t idx = order[i];
+        size_t tag = sourceTags ? sourceTags[idx] : 0;
+        ODID_messagetype_t type = ODID_MESSAGETYPE_INVALID;
+        if (decodeFn && tag < uasCount)
+            type = decodeFn(&uasData[tag], msgs[idx].rawData, context);
+        if (type != ODID_MESSAGETYPE_INVALID)
+            decoded++;
+        if (outTypes)
+            outTypes[idx] = type;
     }
-    case ODID_MESSAGETYPE_OPERATOR_ID: {
-        ODID_OperatorID_encoded *operatorId = (ODID_OperatorID_encoded *) msgData;
-        if (decodeOperatorIDMessage(&uasData->OperatorID, operatorId) == ODID_SUCCESS) {
-            uasData->OperatorIDValid = 1;
-            return ODID_MESSAGETYPE_OPERATOR_ID;
+    return decoded;
+}
+
+/**
+* Decode an array of individual encoded Open Drone ID messages in one call
+*
+* The messages are processed in chunks of ODID_BATCH_CHUNK_SIZE. Each chunk is
+* first sorted by message type (a stable counting sort on the type nibble),
+* after which all messages of one type are decoded in a single loop. This
+* avoids the per-message type dispatch of decodeOpenDroneID() and keeps the
+* decoder of each message type hot while it runs.
+*
+* Since the sort is stable, messages of the same type are decoded in the order
+* they appear in msgs. The result for each UAS structure is thus the same as
+* calling decodeOpenDroneID() for each message in turn. Messages of reserved
+* types go through the decoders registered with odid_register_decoder(), in
+* order, after the other messages of their chunk. Message packs cannot be
+* stored in an ODID_Message_encoded and are reported as invalid.
+*
+* As for decodeOpenDroneID(), the caller must clear the Valid flags of the UAS
+* structures before the call, if that is required.
+*
+* @param uasData    Array of uasCount structures receiving the decoded data
+* @param uasCount   Number of entries in uasData
+* @param msgs       Array of msgCount encoded messages
+* @param sourceTags Optional (can be NULL): for each message, the index into
+*                   uasData of the UAS the message was received from. If NULL,
+*                   all messages are decoded into uasData[0]
+* @param msgCount   Number of messages in msgs
+* @param outTypes   Optional (can be NULL): for each message, the decoded message
+*                   type or ODID_MESSAGETYPE_INVALID if decoding failed
+* @return           Number of successfully decoded messages
+*/
+size_t odid_decode_batch(ODID_UAS_Data *uasData, size_t uasCount,
+                         const ODID_Message_encoded *msgs, const uint16_t *sourceTags,
+                         size_t msgCount, ODID_messagetype_t *outTypes)
+{
+    // One group per decodable message type plus one for everything else
+    enum { GROUPS = ODID_MESSAGETYPE_OPERATOR_ID + 2, INVALID_GROUP = GROUPS - 1 };
+    uint8_t group[ODID_BATCH_CHUNK_SIZE];
+    uint16_t order[ODID_BATCH_CHUNK_SIZE];
+    size_t decoded = 0;
+
+    if (!uasData || uasCount == 0 || !msgs)
+        return 0;
+
+    for (size_t base = 0; base < msgCount; base += ODID_BATCH_CHUNK_SIZE) {
+        size_t chunk = msgCount - base;
+        if (chunk > ODID_BATCH_CHUNK_SIZE)
+            chunk = ODID_BATCH_CHUNK_SIZE;
+        const ODID_Message_encoded *chunkMsgs = &msgs[base];
+        const uint16_t *chunkTags = sourceTags ? &sourceTags[base] : NULL;
+        ODID_messagetype_t *chunkTypes = outTypes ? &outTypes[base] : NULL;
+
+        size_t start[GROUPS + 1] = { 0 };
+        for (size_t i = 0; i < chunk; i++) {
+            uint8_t type = (uint8_t) (chunkMsgs[i].rawData[0] >> 4);
+            group[i] = type <= ODID_MESSAGETYPE_OPERATOR_ID ? type : INVALID_GROUP;
+            start[group[i] + 1]++;
+        }
+        for (int g = 0; g < GROUPS; g++)
+            start[g + 1] += start[g];
+
+        size_t fill[GROUPS];
+        memcpy(fill, start, sizeof(fill));
+        for (size_t i = 0; i < chunk; i++)
+            order[fill[group[i]]++] = (uint16_t) i;
+
+        for (int g = 0; g < INVALID_GROUP; g++)
+            decoded += decodeBatchGroup(messageDecoders[g].decoder, messageDecoders[g].context,
+                                        uasData, uasCount, chunkMsgs, chunkTags,
+                                        &order[start[g]], start[g + 1] - start[g], chunkTypes);
+
+        // Reserved types may have a registered decoder, message packs don't fit
+        for (size_t i = start[INVALID_GROUP]; i < start[GROUPS]; i++) {
+            uint8_t type = (uint8_t) (chunkMsgs[order[i]].rawData[0] >> 4);
+            ODID_decoder_fn decoder = type != ODID_MESSAGETYPE_PACKED ? messageDecoders[type].decoder : NULL;
+            decoded += decodeBatchGroup(decoder, messageDecoders[type].context, uasData, uasCount,
+                                        chunkMsgs, chunkTags, &order[i], 1, chunkTypes);
         }
-        break;
-    }
-    case ODID_MESSAGETYPE_PACKED: {
-        ODID_MessagePack_encoded *pack = (ODID_MessagePack_encoded *) msgData;
-        if (decodeMessagePack(uasData, pack) == ODID_SUCCESS)
-            return ODID_MESSAGETYPE_PACKED;
-        break;
     }
+    return decoded;
+}
+
+/**
+* Initialize a read-only view of a single encoded message
+*
+* The view keeps a pointer to data and decodes fields on demand through the
+* odid_view_* getters. The getters do not check the message type; callers must
+* check odid_view_type() before using the getters of a message type.
+*
+* @param view   Output: the view
+* @param data   Pointer to a buffer containing an encoded message
+* @param len    Size of the buffer
+* @return       ODID_SUCCESS or ODID_FAIL;
+*/
+int odid_view_init(ODID_Message_view *view, const uint8_t *data, size_t len)
+{
+    if (!view || !data || len < ODID_MESSAGE_SIZE)
+        return ODID_FAIL;
+
+    view->data = data;
+    return ODID_SUCCESS;
+}
+
+/**
+* Initialize a read-only view of an encoded message pack
+*
+* The pack header and the message types are validated the same way as by
+* decodeMessagePack(). The messages themselves are not decoded.
+*
+* @param view   Output: the view
+* @param data   Pointer to a buffer containing an encoded message pack
+* @param len    Size of the buffer
+* @return       ODID_SUCCESS or ODID_FAIL;
+*/
+int odid_view_pack_init(ODID_MessagePack_view *view, const uint8_t *data, size_t len)
+{
+    const ODID_MessagePack_encoded *pack = (const ODID_MessagePack_encoded *) data;
+    size_t headerLen = offsetof(ODID_MessagePack_encoded, Messages);
+
+    if (!view || !data || len < headerLen ||
+        pack->MessageType != ODID_MESSAGETYPE_PACKED ||
+        pack->SingleMessageSize != ODID_MESSAGE_SIZE ||
+        len < headerLen + (size_t) pack->MsgPackSize * ODID_MESSAGE_SIZE ||
+        checkPackContent(pack->Messages, pack->MsgPackSize) != ODID_SUCCESS)
+        return ODID_FAIL;
+
+    view->data = data;
+    view->count = pack->MsgPackSize;
+    return ODID_SUCCESS;
+}
+
+/**
+* Get a view of one of the messages in a message pack
+*
+* @param view   View of the message pack
+* @param index  Index of the message, 0 to view.count - 1
+* @return       View of the message. Its data is NULL if the pack view is
+*               empty or the index is out of range.
+*/
+ODID_Message_view odid_view_pack_message(ODID_MessagePack_view view, int index)
+{
+    const ODID_MessagePack_encoded *pack = (const ODID_MessagePack_encoded *) view.data;
+    ODID_Message_view msg = { NULL };
+
+    if (!pack || index < 0 || index >= view.count)
+        return msg;
+
+    msg.data = pack->Messages[index].rawData;
+    return msg;
+}
+
+/**
+* Get the message type of a viewed message
+*
+* @param view   View of the message
+* @return       The message type: ODID_messagetype_t
+*/
+ODID_messagetype_t odid_view_type(ODID_Message_view view)
+{
+    return decodeMessageType(view.data[0]);
+}
+
+/**
+* Get the protocol version of a viewed message
+*
+* @param view   View of the message
+* @return       The protocol version
+*/
+uint8_t odid_view_proto_version(ODID_Message_view view)
+{
+    return view.data[0] & 0x0F;
+}
+
+/**
+* Get the length of a possibly not null terminated string field
+*
+* @param str    Pointer to the string field in the encoded message
+* @param size   Size of the string field
+* @return       Length of the string, excluding any null termination
+*/
+static size_t viewStringLength(const char *str, size_t size)
+{
+    const char *end = memchr(str, 0, size);
+    return end ? (size_t) (end - str) : size;
+}
+
+/*
+ * Field getters of the message views. Values are decoded exactly like the
+ * corresponding fields of the decode*Message() functions, in the units of the
+ * ODID_*_data structures.
+ */
+ODID_idtype_t odid_view_basicid_idtype(ODID_Message_view view)
+{
+    return (ODID_idtype_t) ((const ODID_BasicID_encoded *) view.data)->IDType;
+}
+
+ODID_uatype_t odid_view_basicid_uatype(ODID_Message_view view)
+{
+    return (ODID_uatype_t) ((const ODID_BasicID_encoded *) view.data)->UAType;
+}
+
+/**
+* Get the UAS ID of a viewed Basic ID message
+*
+* Serial numbers and CAA registration IDs are text and their length ends at
+* the first null character. Other ID types are binary and always have the
+* full ODID_ID_SIZE length. This matches decodeBasicIDMessage().
+*
+* @param view   View of a Basic ID message
+* @param uasId  Output: pointer to the ID inside the encoded message
+* @return       Length of the ID in bytes
+*/
+size_t odid_view_basicid_uasid(ODID_Message_view view, const char **uasId)
+{
+    const ODID_BasicID_encoded *msg = (const ODID_BasicID_encoded *) view.data;
+
+    *uasId = msg->UASID;
+    switch (msg->IDType)
+    {
+    case ODID_IDTYPE_SERIAL_NUMBER:
+    case ODID_IDTYPE_CAA_REGISTRATION_ID:
+        return viewStringLength(msg->UASID, sizeof(msg->UASID));
     default:
-        break;
+        return sizeof(msg->UASID);
     }
+}
 
-    return ODID_MESSAGETYPE_INVALID;
+ODID_status_t odid_view_location_status(ODID_Message_view view)
+{
+    return (ODID_status_t) ((const ODID_Location_encoded *) view.data)->Status;
+}
+
+float odid_view_location_direction(ODID_Message_view view)
+{
+    const ODID_Location_encoded *msg = (const ODID_Location_encoded *) view.data;
+    return decodeDirection(msg->Direction, msg->EWDirection);
+}
+
+float odid_view_location_speed_horizontal(ODID_Message_view view)
+{
+    const ODID_Location_encoded *msg = (const ODID_Location_encoded *) view.data;
+    return decodeSpeedHorizontal(msg->SpeedHorizontal, msg->SpeedMult);
+}
+
+float odid_view_location_speed_vertical(ODID_Message_view view)
+{
+    return decodeSpeedVertical(((const ODID_Location_encoded *) view.data)->SpeedVertical);
+}
+
+double odid_view_location_lat(ODID_Message_view view)
+{
+    return decodeLatLon(((const ODID_Location_encoded *) view.data)->Latitude);
+}
+
+double odid_view_location_lon(ODID_Message_view view)
+{
+    return decodeLatLon(((const ODID_Location_encoded *) view.data)->Longitude);
+}
+
+float odid_view_location_altitude_baro(ODID_Message_view view)
+{
+    return decodeAltitude(((const ODID_Location_encoded *) view.data)->AltitudeBaro);
+}
+
+float odid_view_location_altitude_geo(ODID_Message_view view)
+{
+    return decodeAltitude(((const ODID_Location_encoded *) view.data)->AltitudeGeo);
+}
+
+ODID_Height_reference_t odid_view_location_height_type(ODID_Message_view view)
+{
+    return (ODID_Height_reference_t) ((const ODID_Location_encoded *) view.data)->HeightType;
+}
+
+float odid_view_location_height(ODID_Message_view view)
+{
+    return decodeAltitude(((const ODID_Location_encoded *) view.data)->Height);
+}
+
+float odid_view_location_timestamp(ODID_Message_view view)
+{
+    return decodeTimeStamp(((const ODID_Location_encoded *) view.data)->TimeStamp);
+}
+
+int odid_view_auth_page(ODID_Message_view view)
+{
+    return ((const ODID_Auth_encoded *) view.data)->page_zero.DataPage;
+}
+
+ODID_authtype_t odid_view_auth_type(ODID_Message_view view)
+{
+    return (ODID_authtype_t) ((const ODID_Auth_encoded *) view.data)->page_zero.AuthType;
+}
+
+ODID_desctype_t odid_view_selfid_desctype(ODID_Message_view view)
+{
+    return (ODID_desctype_t) ((const ODID_SelfID_encoded *) view.data)->DescType;
+}
+
+/**
+* Get the description text of a viewed Self ID message
+*
+* @param view   View of a Self ID message
+* @param desc   Output: pointer to the (not null terminated) text inside the
+*               encoded message
+* @return       Length of the text
+*/
+size_t odid_view_selfid_desc(ODID_Message_view view, const char **desc)
+{
+    const ODID_SelfID_encoded *msg = (const ODID_SelfID_encoded *) view.data;
+
+    *desc = msg->Desc;
+    return viewStringLength(msg->Desc, sizeof(msg->Desc));
+}
+
+double odid_view_system_operator_lat(ODID_Message_view view)
+{
+    return decodeLatLon(((const ODID_System_encoded *) view.data)->OperatorLatitude);
+}
+
+double odid_view_system_operator_lon(ODID_Message_view view)
+{
+    return decodeLatLon(((const ODID_System_encoded *) view.data)->OperatorLongitude);
+}
+
+float odid_view_system_operator_altitude_geo(ODID_Message_view view)
+{
+    return decodeAltitude(((const ODID_System_encoded *) view.data)->OperatorAltitudeGeo);
+}
+
+uint32_t odid_view_system_timestamp(ODID_Message_view view)
+{
+    return ((const ODID_System_encoded *) view.data)->Timestamp;
+}
+
+ODID_operatorIdType_t odid_view_operatorid_type(ODID_Message_view view)
+{
+    return (ODID_operatorIdType_t) ((const ODID_OperatorID_encoded *) view.data)->OperatorIdType;
+}
+
+/**
+* Get the operator ID of a viewed Operator ID message
+*
+* @param view       View of an Operator ID message
+* @param operatorId Output: pointer to the (not null terminated) ID inside the
+*                   encoded message
+* @return           Length of the ID
+*/
+size_t odid_view_operatorid(ODID_Message_view view, const char **operatorId)
+{
+    const ODID_OperatorID_encoded *msg = (const ODID_OperatorID_encoded *) view.data;
+
+    *operatorId = msg->OperatorId;
+    return viewStringLength(msg->OperatorId, sizeof(msg->OperatorId));
 }
 
 /**
@@ -1090,34 +3112,7 @@ static int intInRange(int inValue, int startRange, int endRange)
 */
 ODID_Horizontal_accuracy_t createEnumHorizontalAccuracy(float Accuracy)
 {
-    if (Accuracy >= 18520)
-        return ODID_HOR_ACC_UNKNOWN;
-    else if (Accuracy >= 7408)
-        return ODID_HOR_ACC_10NM;
-    else if (Accuracy >= 3704)
-        return ODID_HOR_ACC_4NM;
-    else if (Accuracy >= 1852)
-        return ODID_HOR_ACC_2NM;
-    else if (Accuracy >= 926)
-        return ODID_HOR_ACC_1NM;
-    else if (Accuracy >= 555.6f)
-        return ODID_HOR_ACC_0_5NM;
-    else if (Accuracy >= 185.2f)
-        return ODID_HOR_ACC_0_3NM;
-    else if (Accuracy >= 92.6f)
-        return ODID_HOR_ACC_0_1NM;
-    else if (Accuracy >= 30)
-        return ODID_HOR_ACC_0_05NM;
-    else if (Accuracy >= 10)
-        return ODID_HOR_ACC_30_METER;
-    else if (Accuracy >= 3)
-        return ODID_HOR_ACC_10_METER;
-    else if (Accuracy >= 1)
-        return ODID_HOR_ACC_3_METER;
-    else if (Accuracy > 0)
-        return ODID_HOR_ACC_1_METER;
-    else
-        return ODID_HOR_ACC_UNKNOWN;
+    return (ODID_Horizontal_accuracy_t) horAccCodecQuantize(Accuracy);
 }
 
 /**
@@ -1128,22 +3123,7 @@ ODID_Horizontal_accuracy_t createEnumHorizontalAccuracy(float Accuracy)
 */
 ODID_Vertical_accuracy_t createEnumVerticalAccuracy(float Accuracy)
 {
-    if (Accuracy >= 150)
-        return ODID_VER_ACC_UNKNOWN;
-    else if (Accuracy >= 45)
-        return ODID_VER_ACC_150_METER;
-    else if (Accuracy >= 25)
-        return ODID_VER_ACC_45_METER;
-    else if (Accuracy >= 10)
-        return ODID_VER_ACC_25_METER;
-    else if (Accuracy >= 3)
-        return ODID_VER_ACC_10_METER;
-    else if (Accuracy >= 1)
-        return ODID_VER_ACC_3_METER;
-    else if (Accuracy > 0)
-        return ODID_VER_ACC_1_METER;
-    else
-        return ODID_VER_ACC_UNKNOWN;
+    return (ODID_Vertical_accuracy_t) verAccCodecQuantize(Accuracy);
 }
 
 /**
@@ -1154,18 +3134,7 @@ ODID_Vertical_accuracy_t createEnumVerticalAccuracy(float Accuracy)
 */
 ODID_Speed_accuracy_t createEnumSpeedAccuracy(float Accuracy)
 {
-    if (Accuracy >= 10)
-        return ODID_SPEED_ACC_UNKNOWN;
-    else if (Accuracy >= 3)
-        return ODID_SPEED_ACC_10_METERS_PER_SECOND;
-    else if (Accuracy >= 1)
-        return ODID_SPEED_ACC_3_METERS_PER_SECOND;
-    else if (Accuracy >= 0.3f)
-        return ODID_SPEED_ACC_1_METERS_PER_SECOND;
-    else if (Accuracy > 0)
-        return ODID_SPEED_ACC_0_3_METERS_PER_SECOND;
-    else
-        return ODID_SPEED_ACC_UNKNOWN;
+    return (ODID_Speed_accuracy_t) speedAccCodecQuantize(Accuracy);
 }
 
 /**
@@ -1176,40 +3145,7 @@ ODID_Speed_accuracy_t createEnumSpeedAccuracy(float Accuracy)
 */
 ODID_Timestamp_accuracy_t createEnumTimestampAccuracy(float Accuracy)
 {
-    if (Accuracy > 1.5f)
-        return ODID_TIME_ACC_UNKNOWN;
-    else if (Accuracy > 1.4f)
-        return ODID_TIME_ACC_1_5_SECOND;
-    else if (Accuracy > 1.3f)
-        return ODID_TIME_ACC_1_4_SECOND;
-    else if (Accuracy > 1.2f)
-        return ODID_TIME_ACC_1_3_SECOND;
-    else if (Accuracy > 1.1f)
-        return ODID_TIME_ACC_1_2_SECOND;
-    else if (Accuracy > 1.0f)
-        return ODID_TIME_ACC_1_1_SECOND;
-    else if (Accuracy > 0.9f)
-        return ODID_TIME_ACC_1_0_SECOND;
-    else if (Accuracy > 0.8f)
-        return ODID_TIME_ACC_0_9_SECOND;
-    else if (Accuracy > 0.7f)
-        return ODID_TIME_ACC_0_8_SECOND;
-    else if (Accuracy > 0.6f)
-        return ODID_TIME_ACC_0_7_SECOND;
-    else if (Accuracy > 0.5f)
-        return ODID_TIME_ACC_0_6_SECOND;
-    else if (Accuracy > 0.4f)
-        return ODID_TIME_ACC_0_5_SECOND;
-    else if (Accuracy > 0.3f)
-        return ODID_TIME_ACC_0_4_SECOND;
-    else if (Accuracy > 0.2f)
-        return ODID_TIME_ACC_0_3_SECOND;
-    else if (Accuracy > 0.1f)
-        return ODID_TIME_ACC_0_2_SECOND;
-    else if (Accuracy > 0.0f)
-        return ODID_TIME_ACC_0_1_SECOND;
-    else
-        return ODID_TIME_ACC_UNKNOWN;
+    return (ODID_Timestamp_accuracy_t) timeAccCodecQuantize(Accuracy);
 }
 
 /**
@@ -1220,37 +3156,7 @@ ODID_Timestamp_accuracy_t createEnumTimestampAccuracy(float Accuracy)
 */
 float decodeHorizontalAccuracy(ODID_Horizontal_accuracy_t Accuracy)
 {
-    switch (Accuracy)
-    {
-    case ODID_HOR_ACC_UNKNOWN:
-        return 18520;
-    case ODID_HOR_ACC_10NM:
-        return 18520;
-    case ODID_HOR_ACC_4NM:
-        return 7808;
-    case ODID_HOR_ACC_2NM:
-        return 3704;
-    case ODID_HOR_ACC_1NM:
-        return 1852;
-    case ODID_HOR_ACC_0_5NM:
-        return 926;
-    case ODID_HOR_ACC_0_3NM:
-        return 555.6f;
-    case ODID_HOR_ACC_0_1NM:
-        return 185.2f;
-    case ODID_HOR_ACC_0_05NM:
-        return 92.6f;
-    case ODID_HOR_ACC_30_METER:
-        return 30;
-    case ODID_HOR_ACC_10_METER:
-        return 10;
-    case ODID_HOR_ACC_3_METER:
-        return 3;
-    case ODID_HOR_ACC_1_METER:
-        return 1;
-    default:
-        return 18520;
-    }
+    return dequantizeEnum(&horAccCodec, Accuracy);
 }
 
 /**
@@ -1261,25 +3167,7 @@ float decodeHorizontalAccuracy(ODID_Horizontal_accuracy_t Accuracy)
 */
 float decodeVerticalAccuracy(ODID_Vertical_accuracy_t Accuracy)
 {
-    switch (Accuracy)
-    {
-    case ODID_VER_ACC_UNKNOWN:
-        return 150;
-    case ODID_VER_ACC_150_METER:
-        return 150;
-    case ODID_VER_ACC_45_METER:
-        return 45;
-    case ODID_VER_ACC_25_METER:
-        return 25;
-    case ODID_VER_ACC_10_METER:
-        return 10;
-    case ODID_VER_ACC_3_METER:
-        return 3;
-    case ODID_VER_ACC_1_METER:
-        return 1;
-    default:
-        return 150;
-    }
+    return dequantizeEnum(&verAccCodec, Accuracy);
 }
 
 /**
@@ -1290,21 +3178,7 @@ float decodeVerticalAccuracy(ODID_Vertical_accuracy_t Accuracy)
 */
 float decodeSpeedAccuracy(ODID_Speed_accuracy_t Accuracy)
 {
-    switch (Accuracy)
-    {
-    case ODID_SPEED_ACC_UNKNOWN:
-        return 10;
-    case ODID_SPEED_ACC_10_METERS_PER_SECOND:
-        return 10;
-    case ODID_SPEED_ACC_3_METERS_PER_SECOND:
-        return 3;
-    case ODID_SPEED_ACC_1_METERS_PER_SECOND:
-        return 1;
-    case ODID_SPEED_ACC_0_3_METERS_PER_SECOND:
-        return 0.3f;
-    default:
-        return 10;
-    }
+    return dequantizeEnum(&speedAccCodec, Accuracy);
 }
 
 /**
@@ -1315,43 +3189,7 @@ float decodeSpeedAccuracy(ODID_Speed_accuracy_t Accuracy)
 */
 float decodeTimestampAccuracy(ODID_Timestamp_accuracy_t Accuracy)
 {
-    switch (Accuracy)
-    {
-    case ODID_TIME_ACC_UNKNOWN:
-        return 0.0f;
-    case ODID_TIME_ACC_0_1_SECOND:
-        return 0.1f;
-    case ODID_TIME_ACC_0_2_SECOND:
-        return 0.2f;
-    case ODID_TIME_ACC_0_3_SECOND:
-        return 0.3f;
-    case ODID_TIME_ACC_0_4_SECOND:
-        return 0.4f;
-    case ODID_TIME_ACC_0_5_SECOND:
-        return 0.5f;
-    case ODID_TIME_ACC_0_6_SECOND:
-        return 0.6f;
-    case ODID_TIME_ACC_0_7_SECOND:
-        return 0.7f;
-    case ODID_TIME_ACC_0_8_SECOND:
-        return 0.8f;
-    case ODID_TIME_ACC_0_9_SECOND:
-        return 0.9f;
-    case ODID_TIME_ACC_1_0_SECOND:
-        return 1.0f;
-    case ODID_TIME_ACC_1_1_SECOND:
-        return 1.1f;
-    case ODID_TIME_ACC_1_2_SECOND:
-        return 1.2f;
-    case ODID_TIME_ACC_1_3_SECOND:
-        return 1.3f;
-    case ODID_TIME_ACC_1_4_SECOND:
-        return 1.4f;
-    case ODID_TIME_ACC_1_5_SECOND:
-        return 1.5f;
-    default:
-        return 0.0f;
-    }
+    return dequantizeEnum(&timeAccCodec, Accuracy);
 }
 
 #ifndef ODID_DISABLE_PRINTF
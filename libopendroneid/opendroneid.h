@@ -72,6 +72,14 @@ extern "C" {
 
 #define ODID_PACK_MAX_MESSAGES 9
 
+// Number of messages odid_decode_batch() sorts and decodes per iteration
+#ifndef ODID_BATCH_CHUNK_SIZE
+#define ODID_BATCH_CHUNK_SIZE 64
+#endif
+#if (ODID_BATCH_CHUNK_SIZE < 1) || (ODID_BATCH_CHUNK_SIZE > 65535)
+#error "ODID_BATCH_CHUNK_SIZE must be between 1 and 65535."
+#endif
+
 #define ODID_SUCCESS    0
 #define ODID_FAIL       1
 
@@ -414,6 +422,496 @@ typedef struct ODID_UAS_Data {
     uint8_t OperatorIDValid;
 } ODID_UAS_Data;
 
+// Receive time of each message of an ODID_UAS_Data, 0 if never received
+typedef struct ODID_UAS_Timestamps {
+    uint64_t BasicID[ODID_BASIC_ID_MAX_MESSAGES];
+    uint64_t Location;
+    uint64_t Auth[ODID_AUTH_MAX_PAGES];
+    uint64_t SelfID;
+    uint64_t System;
+    uint64_t OperatorID;
+} ODID_UAS_Timestamps;
+
+/*
+ * Raw bytes of the messages last decoded into each slot of an ODID_UAS_Data,
+ * see odid_decode_memo(). Messages that are byte identical to the memoized
+ * one are not decoded again.
+ */
+typedef struct ODID_Message_memo {
+    uint8_t BasicID[ODID_BASIC_ID_MAX_MESSAGES][ODID_MESSAGE_SIZE];
+    uint8_t Location[ODID_MESSAGE_SIZE];
+    uint8_t Auth[ODID_AUTH_MAX_PAGES][ODID_MESSAGE_SIZE];
+    uint8_t SelfID[ODID_MESSAGE_SIZE];
+    uint8_t System[ODID_MESSAGE_SIZE];
+    uint8_t OperatorID[ODID_MESSAGE_SIZE];
+    uint32_t Hits;            // Messages for which the decode was skipped
+    uint32_t Misses;          // Messages that were decoded and memoized
+} ODID_Message_memo;
+
+// Fields of an ODID_UAS_Data that changed in odid_decode_merge()
+#define ODID_CHANGED_BASIC_ID           0x0001  // Any Basic ID
+#define ODID_CHANGED_STATUS             0x0002  // Location: Status
+#define ODID_CHANGED_POSITION           0x0004  // Location: Latitude, Longitude
+#define ODID_CHANGED_ALTITUDE           0x0008  // Location: altitudes, height
+#define ODID_CHANGED_SPEED              0x0010  // Location: direction, speeds
+#define ODID_CHANGED_ACCURACY           0x0020  // Location: accuracies
+#define ODID_CHANGED_LOCATION_TIME      0x0040  // Location: TimeStamp
+#define ODID_CHANGED_AUTH               0x0080  // Any Authentication page
+#define ODID_CHANGED_SELF_ID            0x0100
+#define ODID_CHANGED_OPERATOR_LOCATION  0x0200  // System: operator location
+#define ODID_CHANGED_AREA               0x0400  // System: area count, radius, ceiling, floor
+#define ODID_CHANGED_CLASSIFICATION     0x0800  // System: classification, EU category, class
+#define ODID_CHANGED_SYSTEM_TIME        0x1000  // System: Timestamp
+#define ODID_CHANGED_OPERATOR_ID        0x2000
+
+#define ODID_CHANGED_LOCATION (ODID_CHANGED_STATUS | ODID_CHANGED_POSITION | \
+    ODID_CHANGED_ALTITUDE | ODID_CHANGED_SPEED | ODID_CHANGED_ACCURACY | ODID_CHANGED_LOCATION_TIME)
+#define ODID_CHANGED_SYSTEM (ODID_CHANGED_OPERATOR_LOCATION | ODID_CHANGED_AREA | \
+    ODID_CHANGED_CLASSIFICATION | ODID_CHANGED_SYSTEM_TIME)
+
+/*
+ * Fixed-point versions of the Location and System data, for targets without
+ * fast floating point. All values are integers in units that represent the
+ * quantization steps of the messages exactly. Latitude/longitude, direction
+ * and speeds use the same units as the MAVLink OPEN_DRONE_ID_LOCATION and
+ * OPEN_DRONE_ID_SYSTEM messages. Invalid values are those of the float
+ * structures, converted to these units.
+ */
+#define ODID_FIXED_INV_DIR        (INV_DIR * 100)
+#define ODID_FIXED_INV_SPEED_H    (INV_SPEED_H * 100)
+#define ODID_FIXED_INV_SPEED_V    (INV_SPEED_V * 100)
+#define ODID_FIXED_INV_ALT        (INV_ALT * 10)
+#define ODID_FIXED_INV_TIMESTAMP  INV_TIMESTAMP
+
+typedef struct ODID_Location_fixed {
+    ODID_status_t Status;
+    uint16_t Direction;       // Centidegrees. 0 <= x < 36000. Invalid: ODID_FIXED_INV_DIR
+    uint16_t SpeedHorizontal; // cm/s. Invalid: ODID_FIXED_INV_SPEED_H
+    int16_t SpeedVertical;    // cm/s. Invalid: ODID_FIXED_INV_SPEED_V
+    int32_t Latitude;         // degE7
+    int32_t Longitude;        // degE7
+    int32_t AltitudeBaro;     // Decimeters. Invalid: ODID_FIXED_INV_ALT
+    int32_t AltitudeGeo;      // Decimeters. Invalid: ODID_FIXED_INV_ALT
+    ODID_Height_reference_t HeightType;
+    int32_t Height;           // Decimeters. Invalid: ODID_FIXED_INV_ALT
+    ODID_Horizontal_accuracy_t HorizAccuracy;
+    ODID_Vertical_accuracy_t VertAccuracy;
+    ODID_Vertical_accuracy_t BaroAccuracy;
+    ODID_Speed_accuracy_t SpeedAccuracy;
+    ODID_Timestamp_accuracy_t TSAccuracy;
+    uint16_t TimeStamp;       // 1/10 seconds after the full hour. Invalid: ODID_FIXED_INV_TIMESTAMP
+} ODID_Location_fixed;
+
+typedef struct ODID_System_fixed {
+    ODID_operator_location_type_t OperatorLocationType;
+    ODID_classification_type_t ClassificationType;
+    int32_t OperatorLatitude;  // degE7
+    int32_t OperatorLongitude; // degE7
+    uint16_t AreaCount;
+    uint16_t AreaRadius;       // meter
+    int32_t AreaCeiling;       // Decimeters. Invalid: ODID_FIXED_INV_ALT
+    int32_t AreaFloor;         // Decimeters. Invalid: ODID_FIXED_INV_ALT
+    ODID_category_EU_t CategoryEU;
+    ODID_class_EU_t ClassEU;
+    int32_t OperatorAltitudeGeo; // Decimeters. Invalid: ODID_FIXED_INV_ALT
+    uint32_t Timestamp;        // Relative to 00:00:00 01/01/2019 UTC/Unix Time
+} ODID_System_fixed;
+
+// Altitude fields that a Location filter can check
+typedef enum ODID_filter_altitude {
+    ODID_FILTER_ALTITUDE_GEO = 0,
+    ODID_FILTER_ALTITUDE_BARO = 1,
+    ODID_FILTER_HEIGHT = 2,
+} ODID_filter_altitude_t;
+
+/*
+ * Predicates on Location messages compiled into thresholds on the encoded
+ * fields, so that ODID_Location_encoded records can be filtered without
+ * decoding them, see odid_location_filter_init(). The fields are set by
+ * odid_location_filter_box(), odid_location_filter_altitude() and
+ * odid_location_filter_status().
+ */
+typedef struct ODID_Location_filter {
+    int32_t LatitudeStart;      // degE7
+    int32_t LongitudeStart;     // degE7
+    uint64_t LatitudeCount;     // Matching values: LatitudeStart + [0, LatitudeCount)
+    uint64_t LongitudeCount;    // Wraps around to cross the antimeridian. 0 matches nothing
+    uint8_t AltitudeOffset;     // Byte offset of the checked altitude field
+    uint16_t AltitudeMin;       // Encoded altitudes. Min > Max matches nothing
+    uint16_t AltitudeMax;
+    uint16_t StatusMask;        // Bit n set: ODID_status_t n matches
+} ODID_Location_filter;
+
+/*
+ * Compact version of ODID_UAS_Data for receivers that keep a record per
+ * tracked UAS. Enums are stored as uint8_t, the validity flags as bitmasks
+ * and the Authentication pages, which most UAS don't send, out of line in an
+ * ODID_Auth_pool shared by all records. Conversion to and from ODID_UAS_Data
+ * is lossless for all values that fit in the fields of the messages.
+ */
+typedef struct ODID_BasicID_compact {
+    uint8_t UAType;
+    uint8_t IDType;
+    char UASID[ODID_ID_SIZE+1];
+} ODID_BasicID_compact;
+
+typedef struct ODID_Location_compact {
+    double Latitude;
+    double Longitude;
+    float Direction;
+    float SpeedHorizontal;
+    float SpeedVertical;
+    float AltitudeBaro;
+    float AltitudeGeo;
+    float Height;
+    float TimeStamp;
+    uint8_t Status;
+    uint8_t HeightType;
+    uint8_t HorizAccuracy;
+    uint8_t VertAccuracy;
+    uint8_t BaroAccuracy;
+    uint8_t SpeedAccuracy;
+    uint8_t TSAccuracy;
+} ODID_Location_compact;
+
+typedef struct ODID_Auth_compact {
+    uint32_t Timestamp;
+    uint8_t DataPage;
+    uint8_t AuthType;
+    uint8_t LastPageIndex;
+    uint8_t Length;
+    uint8_t AuthData[ODID_AUTH_PAGE_NONZERO_DATA_SIZE+1];
+} ODID_Auth_compact;
+
+typedef struct ODID_SelfID_compact {
+    uint8_t DescType;
+    char Desc[ODID_STR_SIZE+1];
+} ODID_SelfID_compact;
+
+typedef struct ODID_System_compact {
+    double OperatorLatitude;
+    double OperatorLongitude;
+    float AreaCeiling;
+    float AreaFloor;
+    float OperatorAltitudeGeo;
+    uint32_t Timestamp;
+    uint16_t AreaCount;
+    uint16_t AreaRadius;
+    uint8_t OperatorLocationType;
+    uint8_t ClassificationType;
+    uint8_t CategoryEU;
+    uint8_t ClassEU;
+} ODID_System_compact;
+
+typedef struct ODID_OperatorID_compact {
+    uint8_t OperatorIdType;
+    char OperatorId[ODID_ID_SIZE+1];
+} ODID_OperatorID_compact;
+
+// Bits of ODID_UAS_compact.Valid
+#define ODID_COMPACT_LOCATION_VALID     0x01
+#define ODID_COMPACT_SELF_ID_VALID      0x02
+#define ODID_COMPACT_SYSTEM_VALID       0x04
+#define ODID_COMPACT_OPERATOR_ID_VALID  0x08
+
+// Value of ODID_UAS_compact.AuthBlock when no pool block is used
+#define ODID_COMPACT_NO_AUTH            UINT32_MAX
+
+typedef struct ODID_UAS_compact {
+    ODID_Location_compact Location;
+    ODID_System_compact System;
+    ODID_BasicID_compact BasicID[ODID_BASIC_ID_MAX_MESSAGES];
+    ODID_SelfID_compact SelfID;
+    ODID_OperatorID_compact OperatorID;
+    uint32_t AuthBlock;       // Index of the Authentication pages in the pool
+    uint16_t AuthValid;       // Bit n set: Authentication page n valid
+    uint8_t BasicIDValid;     // Bit n set: BasicID[n] valid
+    uint8_t Valid;            // ODID_COMPACT_*_VALID bits
+} ODID_UAS_compact;
+
+// The Authentication pages of one record in an ODID_Auth_pool
+typedef struct ODID_Auth_block {
+    ODID_Auth_compact Pages[ODID_AUTH_MAX_PAGES];
+    uint32_t NextFree;        // Used by the pool while the block is free
+} ODID_Auth_block;
+
+typedef struct ODID_Auth_pool {
+    ODID_Auth_block *Blocks;  // Storage provided by the caller
+    uint32_t Count;           // Number of blocks
+    uint32_t FreeHead;        // First free block, ODID_COMPACT_NO_AUTH if none
+} ODID_Auth_pool;
+
+/*
+ * Spatial index of positions, see odid_spatial_init(). Entities are
+ * identified by their index into a caller provided array of entries and
+ * are kept in a latitude/longitude grid, whose occupied cells are hashed
+ * into a fixed number of lists. Entities are moved in O(1) as their
+ * position changes.
+ */
+// Link and bucket value meaning none
+#define ODID_SPATIAL_NONE       UINT32_MAX
+
+typedef struct ODID_Spatial_entry {
+    double Latitude;
+    double Longitude;
+    int32_t CellX;              // Grid cell of the position
+    int32_t CellY;
+    uint32_t Bucket;            // Hash list or ODID_SPATIAL_NONE if not indexed
+    uint32_t Next;              // Neighbours in the hash list
+    uint32_t Prev;
+} ODID_Spatial_entry;
+
+typedef struct ODID_Spatial_index {
+    ODID_Spatial_entry *Entries;    // Count entries, provided by the caller
+    uint32_t *Buckets;          // BucketMask + 1 hash list heads
+    uint32_t Count;
+    uint32_t BucketMask;
+    uint32_t Size;              // Number of indexed entities
+    int32_t Columns;            // Number of grid cells around a parallel
+    int32_t Rows;               // Number of grid cells from pole to pole
+    double CellSize;            // Size of the grid cells in degrees
+} ODID_Spatial_index;
+
+/*
+ * Geofence, see odid_geofence_init(). Restricted zones are polygons with a
+ * floor and a ceiling, grouped in a zone set in which they are referenced
+ * from each grid cell their bounding box covers. The zone set in use can be
+ * replaced while other threads check positions against it: a reader
+ * announces the epoch in which it took the set, and odid_geofence_swap()
+ * returns the old set only once no reader can still use it.
+ */
+// Value meaning no zone, and number of zones a UAS is tracked inside at once
+#define ODID_GEOFENCE_NONE          UINT32_MAX
+#define ODID_GEOFENCE_MAX_INSIDE    8
+
+typedef struct ODID_Geofence_vertex {
+    double Latitude;
+    double Longitude;
+} ODID_Geofence_vertex;
+
+typedef struct ODID_Geofence_zone {
+    uint32_t Id;                // Chosen by the application, kept across zone sets
+    uint32_t FirstVertex;       // Index into the vertices of the zone set
+    uint32_t VertexCount;       // At least 3
+    float Floor;                // meter, geodetic. INV_ALT: no floor
+    float Ceiling;              // meter, geodetic. INV_ALT: no ceiling
+    uint64_t Dwell;             // Time inside before a dwell event, 0 for none
+    // Set by odid_geofence_zones_init()
+    double LatMin, LonMin, LatMax, LonMax;  // Bounding box, LonMin > LonMax across the antimeridian
+    int32_t CellX;              // First grid cell of the bounding box
+    int32_t CellY;
+} ODID_Geofence_zone;
+
+typedef struct ODID_Geofence_ref {
+    int32_t CellX;
+    int32_t CellY;
+    uint32_t Zone;              // Index into the zones of the zone set
+} ODID_Geofence_ref;
+
+typedef struct ODID_Geofence_zones {
+    ODID_Geofence_zone *Zones;  // Provided by the caller
+    const ODID_Geofence_vertex *Vertices;
+    ODID_Geofence_ref *Refs;    // References of each bucket, see odid_geofence_zones_build()
+    uint32_t *Buckets;          // BucketMask + 2 offsets into Refs
+    uint32_t ZoneCount;
+    uint32_t VertexCount;
+    uint32_t RefCount;          // Number of references needed by the zones
+    uint32_t BucketMask;
+    int32_t Columns;            // Number of grid cells around a parallel
+    int32_t Rows;               // Number of grid cells from pole to pole
+    double CellSize;            // Size of the grid cells in degrees
+} ODID_Geofence_zones;
+
+typedef enum ODID_geofence_event {
+    ODID_GEOFENCE_ENTER = 0,
+    ODID_GEOFENCE_EXIT = 1,
+    ODID_GEOFENCE_DWELL = 2,    // Inside for the Dwell time of the zone
+} ODID_geofence_event_t;
+
+// Zones a UAS is inside, by zone Id
+typedef struct ODID_Geofence_state {
+    uint32_t Zones[ODID_GEOFENCE_MAX_INSIDE];
+    uint64_t Entered[ODID_GEOFENCE_MAX_INSIDE];
+    uint8_t Inside;             // Number of zones
+    uint8_t Dwelled;            // Bit n set: dwell event sent for Zones[n]
+} ODID_Geofence_state;
+
+struct ODID_Geofence;
+
+// Called by odid_geofence_check() for each zone a UAS enters, exits or dwells in
+typedef void (*ODID_geofence_fn)(struct ODID_Geofence *fence, uint32_t uas, uint32_t zoneId,
+                                 ODID_geofence_event_t event, void *context);
+
+typedef struct ODID_Geofence {
+    ODID_Geofence_zones *Zones; // Zone set in use, see odid_geofence_swap()
+    ODID_Geofence_state *States;    // Count entries, one per UAS, provided by the caller
+    uint64_t *ReaderEpochs;     // ReaderCount entries, one per checking thread
+    uint32_t Count;
+    uint32_t ReaderCount;
+    uint64_t Epoch;
+    ODID_geofence_fn Callback;  // Optional
+    void *Context;              // Passed to Callback
+} ODID_Geofence;
+
+/*
+ * Conflict detection between UAS, see odid_conflict_init(). Each UAS is
+ * identified by its index into a caller provided array and is kept in a
+ * spatial index, so that a new Location of a UAS is only compared with the
+ * UAS that are close enough to come into conflict within the look ahead time.
+ */
+#define ODID_CONFLICT_NOW        0  // Closer than the separation thresholds
+#define ODID_CONFLICT_PREDICTED  1  // Will be within the look ahead time
+
+typedef struct ODID_Conflict_state {
+    double Latitude;            // Degrees
+    double Longitude;
+    float Altitude;             // meter, geodetic or barometric. INV_ALT: unknown
+    float VelocityEast;         // m/s, 0 if unknown
+    float VelocityNorth;
+    float VelocityUp;
+    uint64_t Time;              // Time of the position, as given to odid_conflict_update()
+} ODID_Conflict_state;
+
+typedef struct ODID_Conflict {
+    uint32_t Other;             // Index of the other UAS
+    uint8_t Type;               // ODID_CONFLICT_*
+    float Time;                 // Seconds until the separation is lost, 0 if it is
+    float Horizontal;           // Separation in meters at the closest approach
+    float Vertical;
+} ODID_Conflict;
+
+typedef struct ODID_Conflict_detector {
+    ODID_Spatial_index *Index;  // Count entries, provided by the caller
+    ODID_Conflict_state *States;    // Count entries, provided by the caller
+    uint32_t *Candidates;       // Scratch space for the UAS near the updated one
+    uint32_t Count;
+    uint32_t CandidateCount;
+    uint64_t TimeUnit;          // Time units per second, e.g. 1000 for ms
+    float Horizontal;           // Separation thresholds in meters
+    float Vertical;
+    float LookAhead;            // Seconds, 0 to only report current conflicts
+    float MaxSpeed;             // m/s, bounds the approach speed of other UAS
+    float MaxAge;               // Seconds, older reports of other UAS are ignored
+} ODID_Conflict_detector;
+
+/*
+ * Hierarchical timing wheel, see odid_timer_wheel_init(). Timers are
+ * identified by their index into a caller provided array. Scheduling,
+ * rescheduling and cancelling a timer are O(1). Times are in the unit chosen
+ * by the caller, e.g. ms, and are rounded up to the resolution of the wheel.
+ */
+#define ODID_WHEEL_LEVELS       4
+#define ODID_WHEEL_SLOT_BITS    6
+#define ODID_WHEEL_SLOTS        (1 << ODID_WHEEL_SLOT_BITS)
+
+// Link value meaning no timer, and slot of a timer that is not scheduled
+#define ODID_TIMER_NONE         UINT32_MAX
+#define ODID_TIMER_IDLE         UINT16_MAX
+
+typedef struct ODID_Timer {
+    uint64_t Expires;           // Tick at which the timer fires
+    uint32_t Next;              // Neighbours in the list of the slot
+    uint32_t Prev;
+    uint16_t Slot;              // Level * ODID_WHEEL_SLOTS + slot or ODID_TIMER_IDLE
+} ODID_Timer;
+
+typedef struct ODID_Timer_wheel {
+    ODID_Timer *Timers;         // Count entries, provided by the caller
+    uint32_t Count;
+    uint32_t Pending;           // Number of scheduled timers
+    uint64_t Resolution;        // Duration of one tick
+    uint64_t Tick;              // Current tick
+    uint64_t Occupied[ODID_WHEEL_LEVELS];   // Bit n set: slot n is not empty
+    uint32_t Heads[ODID_WHEEL_LEVELS][ODID_WHEEL_SLOTS];
+} ODID_Timer_wheel;
+
+// Called by odid_timer_wheel_advance() for each expired timer
+typedef void (*ODID_timer_fn)(ODID_Timer_wheel *wheel, uint32_t timer, void *context);
+
+/*
+ * Table of the UAS seen by a receiver, in which each received message is
+ * decoded into the track of the UAS that sent it. Tracks are found through
+ * an open addressing hash table on their key, which is the source MAC
+ * address or the UAS ID. The table has a fixed capacity and keeps the tracks
+ * ordered by the time they were last seen, so that the oldest track can be
+ * evicted when a new UAS shows up in a full table. All storage is provided
+ * by the caller.
+ */
+#define ODID_TRACK_KEY_MAC      0
+#define ODID_TRACK_KEY_UASID    1
+
+// Track and index entry value meaning none
+#define ODID_TRACK_NONE         UINT32_MAX
+
+typedef struct ODID_Track_key {
+    uint8_t Type;               // ODID_TRACK_KEY_*
+    uint8_t Id[ODID_ID_SIZE];   // MAC address or UAS ID, zero padded
+} ODID_Track_key;
+
+typedef struct ODID_Track {
+    ODID_Track_key Key;
+    uint32_t Hash;
+    uint32_t Newer;             // Neighbours in the last seen order
+    uint32_t Older;
+    uint64_t FirstSeen;         // Time as given by the caller, e.g. in ms
+    uint64_t LastSeen;
+    uint32_t Changed;           // ODID_CHANGED_* bits, cleared by the application
+    ODID_UAS_Data Data;
+    ODID_UAS_Timestamps Timestamps;
+} ODID_Track;
+
+typedef struct ODID_Track_slot {
+    uint32_t Hash;
+    uint32_t Track;             // Index into the tracks or ODID_TRACK_NONE
+} ODID_Track_slot;
+
+typedef struct ODID_Track_table {
+    ODID_Track *Tracks;         // Capacity entries, provided by the caller
+    ODID_Track_slot *Slots;     // Hash index, see odid_track_slot_count()
+    ODID_Message_memo *Memos;   // Optional, see odid_track_enable_memo()
+    struct ODID_Track_timeouts *Timeouts;   // Optional, see odid_track_enable_timeouts()
+    ODID_Spatial_index *Spatial;    // Optional, see odid_track_enable_spatial()
+    uint32_t Capacity;
+    uint32_t SlotMask;
+    uint32_t Count;             // Number of live tracks
+    uint32_t Free;              // Unused tracks, linked through Older
+    uint32_t Newest;            // Most and least recently seen tracks
+    uint32_t Oldest;
+    uint32_t Evictions;         // Tracks evicted to make room for a new one
+} ODID_Track_table;
+
+/*
+ * Timers of each track: the UAS went silent, or a message type was not
+ * received again in time. Timer i of track n is timer
+ * n * ODID_TRACK_TIMERS + i of the wheel.
+ */
+#define ODID_TRACK_TIMER_LOST   0
+#define ODID_TRACK_TIMER_STALE  1   // Plus the message type
+#define ODID_TRACK_TIMERS       (ODID_TRACK_TIMER_STALE + ODID_MESSAGETYPE_OPERATOR_ID + 1)
+
+/*
+ * Entities of each track in the spatial index: the UAS and its operator.
+ * Entity i of track n is entry n * ODID_TRACK_POSITIONS + i of the index.
+ */
+#define ODID_TRACK_POSITION_UAS         0
+#define ODID_TRACK_POSITION_OPERATOR    1
+#define ODID_TRACK_POSITIONS            2
+
+/*
+ * Called when a track times out, with type ODID_MESSAGETYPE_INVALID, after
+ * which the track is removed, or when a message type of a track goes stale
+ */
+typedef void (*ODID_track_timeout_fn)(ODID_Track_table *table, ODID_Track *track,
+                                      ODID_messagetype_t type, void *context);
+
+typedef struct ODID_Track_timeouts {
+    ODID_Timer_wheel Wheel;
+    uint64_t Lost;              // Silence after which a track is removed, 0 for never
+    uint64_t Stale[ODID_MESSAGETYPE_OPERATOR_ID + 1];  // Per message type, 0 for never
+    ODID_track_timeout_fn Callback;     // Optional
+    void *Context;              // Passed to Callback
+} ODID_Track_timeouts;
+
 /**
 * @Name ODID_PackedStructs
 * Packed Data Structures prepared for broadcast
@@ -616,6 +1114,72 @@ typedef struct ODID_MessagePack_data {
     ODID_Message_encoded Messages[ODID_PACK_MAX_MESSAGES];
 } ODID_MessagePack_data;
 
+/*
+ * Structure-of-arrays output of odid_decode_location_soa(). Each member points
+ * to an array with one entry per decoded message. Members can be NULL to skip
+ * decoding that field. The units are those of ODID_Location_data.
+ */
+typedef struct ODID_Location_soa {
+    uint8_t *Valid;           // 1 if the record is a Location message, else 0
+    uint8_t *Status;          // ODID_status_t
+    float *Direction;
+    float *SpeedHorizontal;
+    float *SpeedVertical;
+    double *Latitude;
+    double *Longitude;
+    float *AltitudeBaro;
+    float *AltitudeGeo;
+    float *Height;
+    float *TimeStamp;
+} ODID_Location_soa;
+
+// Instruction sets that can be used by the batch decoders
+typedef enum ODID_simd {
+    ODID_SIMD_AUTO = 0,   // Detect the best supported instruction set at runtime
+    ODID_SIMD_SCALAR = 1,
+    ODID_SIMD_SSE2 = 2,
+    ODID_SIMD_AVX2 = 3,
+} ODID_simd_t;
+
+/*
+ * Positions processed by the batch geodesy functions, e.g. odid_geo_distance().
+ * Either Latitude and Longitude in degrees or LatitudeE7 and LongitudeE7 in
+ * degrees * 10^7 (the unit of the encoded Location message) must be set; the
+ * former take precedence. Altitude is optional and only used by the ECEF and
+ * ENU conversions, in meters above the WGS84 ellipsoid.
+ */
+typedef struct ODID_Geo_points {
+    const double *Latitude;
+    const double *Longitude;
+    const int32_t *LatitudeE7;
+    const int32_t *LongitudeE7;
+    const float *Altitude;
+} ODID_Geo_points;
+
+/*
+ * Read-only views over encoded data, see odid_view_init() and
+ * odid_view_pack_init(). A view only holds a pointer to the caller's buffer,
+ * which must stay valid for as long as the view is used. Nothing is copied;
+ * each getter decodes only the field it returns.
+ */
+typedef struct ODID_Message_view {
+    const uint8_t *data;      // ODID_MESSAGE_SIZE bytes of an encoded message
+} ODID_Message_view;
+
+typedef struct ODID_MessagePack_view {
+    const uint8_t *data;      // Start of the encoded message pack
+    uint8_t count;            // Number of messages in the pack
+} ODID_MessagePack_view;
+
+/*
+ * Decoder for one message type, as called by decodeOpenDroneID() with the
+ * context given at registration. Returns the decoded message type or
+ * ODID_MESSAGETYPE_INVALID. Decoders for the message types that are not
+ * defined by the specification can be added with odid_register_decoder().
+ */
+typedef ODID_messagetype_t (*ODID_decoder_fn)(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                              void *context);
+
 // API Calls
 void odid_initBasicIDData(ODID_BasicID_data *data);
 void odid_initLocationData(ODID_Location_data *data);
@@ -625,6 +1189,8 @@ void odid_initSystemData(ODID_System_data *data);
 void odid_initOperatorIDData(ODID_OperatorID_data *data);
 void odid_initMessagePackData(ODID_MessagePack_data *data);
 void odid_initUasData(ODID_UAS_Data *data);
+void odid_initUasTimestamps(ODID_UAS_Timestamps *timestamps);
+void odid_initMessageMemo(ODID_Message_memo *memo);
 
 int encodeBasicIDMessage(ODID_BasicID_encoded *outEncoded, const ODID_BasicID_data *inData);
 int encodeLocationMessage(ODID_Location_encoded *outEncoded, const ODID_Location_data *inData);
@@ -642,10 +1208,169 @@ int decodeSystemMessage(ODID_System_data *outData, const ODID_System_encoded *in
 int decodeOperatorIDMessage(ODID_OperatorID_data *outData, const ODID_OperatorID_encoded *inEncoded);
 int decodeMessagePack(ODID_UAS_Data *uasData, const ODID_MessagePack_encoded *pack);
 
+int encodeBasicIDMessageBytes(ODID_BasicID_encoded *outEncoded, const ODID_BasicID_data *inData);
+int encodeLocationMessageBytes(ODID_Location_encoded *outEncoded, const ODID_Location_data *inData);
+int encodeAuthMessageBytes(ODID_Auth_encoded *outEncoded, const ODID_Auth_data *inData);
+int encodeSelfIDMessageBytes(ODID_SelfID_encoded *outEncoded, const ODID_SelfID_data *inData);
+int encodeSystemMessageBytes(ODID_System_encoded *outEncoded, const ODID_System_data *inData);
+int encodeOperatorIDMessageBytes(ODID_OperatorID_encoded *outEncoded, const ODID_OperatorID_data *inData);
+
+int decodeBasicIDMessageBytes(ODID_BasicID_data *outData, const ODID_BasicID_encoded *inEncoded);
+int decodeLocationMessageBytes(ODID_Location_data *outData, const ODID_Location_encoded *inEncoded);
+int decodeAuthMessageBytes(ODID_Auth_data *outData, const ODID_Auth_encoded *inEncoded);
+int decodeSelfIDMessageBytes(ODID_SelfID_data *outData, const ODID_SelfID_encoded *inEncoded);
+int decodeSystemMessageBytes(ODID_System_data *outData, const ODID_System_encoded *inEncoded);
+int decodeOperatorIDMessageBytes(ODID_OperatorID_data *outData, const ODID_OperatorID_encoded *inEncoded);
+
+int decodeLocationMessageFixed(ODID_Location_fixed *outData, const ODID_Location_encoded *inEncoded);
+int decodeSystemMessageFixed(ODID_System_fixed *outData, const ODID_System_encoded *inEncoded);
+void odid_location_fixed_to_data(ODID_Location_data *outData, const ODID_Location_fixed *inFixed);
+void odid_location_data_to_fixed(ODID_Location_fixed *outFixed, const ODID_Location_data *inData);
+void odid_system_fixed_to_data(ODID_System_data *outData, const ODID_System_fixed *inFixed);
+void odid_system_data_to_fixed(ODID_System_fixed *outFixed, const ODID_System_data *inData);
+
+void odid_location_filter_init(ODID_Location_filter *filter);
+int odid_location_filter_box(ODID_Location_filter *filter, double latMin, double lonMin,
+                             double latMax, double lonMax);
+int odid_location_filter_altitude(ODID_Location_filter *filter, ODID_filter_altitude_t field,
+                                  float min, float max);
+int odid_location_filter_status(ODID_Location_filter *filter, uint16_t statusMask);
+int odid_location_filter_match(const ODID_Location_filter *filter, const ODID_Location_encoded *inEncoded);
+size_t odid_location_filter_batch(const ODID_Location_filter *filter, const ODID_Location_encoded *inEncoded,
+                                  size_t count, uint32_t *out);
+
+void odid_auth_pool_init(ODID_Auth_pool *pool, ODID_Auth_block *blocks, uint32_t count);
+void odid_compact_init(ODID_UAS_compact *compact);
+int odid_compact_release(ODID_UAS_compact *compact, ODID_Auth_pool *pool);
+int odid_uas_to_compact(ODID_UAS_compact *outCompact, const ODID_UAS_Data *inData, ODID_Auth_pool *pool);
+int odid_compact_to_uas(ODID_UAS_Data *outData, const ODID_UAS_compact *inCompact, const ODID_Auth_pool *pool);
+
+uint32_t odid_track_slot_count(uint32_t capacity);
+int odid_track_table_init(ODID_Track_table *table, ODID_Track *tracks, uint32_t capacity,
+                          ODID_Track_slot *slots, uint32_t slotCount);
+void odid_track_enable_memo(ODID_Track_table *table, ODID_Message_memo *memos);
+ODID_Message_memo *odid_track_memo(const ODID_Track_table *table, const ODID_Track *track);
+int odid_track_enable_timeouts(ODID_Track_table *table, ODID_Track_timeouts *timeouts,
+                               ODID_Timer *timers, uint64_t now, uint64_t resolution);
+int odid_track_enable_spatial(ODID_Track_table *table, ODID_Spatial_index *index);
+void odid_track_key_mac(ODID_Track_key *key, const uint8_t *mac);
+void odid_track_key_uasid(ODID_Track_key *key, const char *uasId);
+ODID_Track *odid_track_find(const ODID_Track_table *table, const ODID_Track_key *key);
+ODID_Track *odid_track_update(ODID_Track_table *table, const ODID_Track_key *key, uint64_t now);
+void odid_track_remove(ODID_Track_table *table, ODID_Track *track);
+uint32_t odid_track_expire(ODID_Track_table *table, uint64_t now, uint64_t maxAge);
+ODID_messagetype_t odid_track_decode(ODID_Track_table *table, const ODID_Track_key *key,
+                                     uint64_t now, const uint8_t *msgData);
+ODID_messagetype_t odid_track_merge(ODID_Track_table *table, ODID_Track *track,
+                                    uint64_t now, const uint8_t *msgData);
+uint32_t odid_track_advance(ODID_Track_table *table, uint64_t now);
+
+int odid_timer_wheel_init(ODID_Timer_wheel *wheel, ODID_Timer *timers, uint32_t count,
+                          uint64_t now, uint64_t resolution);
+void odid_timer_schedule(ODID_Timer_wheel *wheel, uint32_t timer, uint64_t expires);
+void odid_timer_cancel(ODID_Timer_wheel *wheel, uint32_t timer);
+uint32_t odid_timer_wheel_advance(ODID_Timer_wheel *wheel, uint64_t now,
+                                  ODID_timer_fn callback, void *context);
+
+int odid_spatial_init(ODID_Spatial_index *index, ODID_Spatial_entry *entries, uint32_t count,
+                      uint32_t *buckets, uint32_t bucketCount, double cellSize);
+void odid_spatial_update(ODID_Spatial_index *index, uint32_t id, double latitude, double longitude);
+void odid_spatial_remove(ODID_Spatial_index *index, uint32_t id);
+uint32_t odid_spatial_box(const ODID_Spatial_index *index, double latMin, double lonMin,
+                          double latMax, double lonMax, uint32_t *out, uint32_t maxOut);
+uint32_t odid_spatial_radius(const ODID_Spatial_index *index, double latitude, double longitude,
+                             double radius, uint32_t *out, uint32_t maxOut);
+uint32_t odid_spatial_nearest(const ODID_Spatial_index *index, double latitude, double longitude,
+                              uint32_t k, uint32_t *out, double *distances);
+double odid_distance(double latitude1, double longitude1, double latitude2, double longitude2);
+
+int odid_geofence_zones_init(ODID_Geofence_zones *set, ODID_Geofence_zone *zones, uint32_t zoneCount,
+                             const ODID_Geofence_vertex *vertices, uint32_t vertexCount, double cellSize);
+int odid_geofence_zones_build(ODID_Geofence_zones *set, uint32_t *buckets, uint32_t bucketCount,
+                              ODID_Geofence_ref *refs, uint32_t refCount);
+uint32_t odid_geofence_zones_find(const ODID_Geofence_zones *set, double latitude, double longitude,
+                                  float altitude, uint32_t *out, uint32_t maxOut);
+int odid_geofence_init(ODID_Geofence *fence, ODID_Geofence_state *states, uint32_t count,
+                       uint64_t *readerEpochs, uint32_t readerCount,
+                       ODID_geofence_fn callback, void *context);
+ODID_Geofence_zones *odid_geofence_swap(ODID_Geofence *fence, ODID_Geofence_zones *set);
+void odid_geofence_forget(ODID_Geofence *fence, uint32_t uas);
+uint32_t odid_geofence_check(ODID_Geofence *fence, uint32_t reader, uint32_t uas, uint64_t now,
+                             const ODID_Location_data *location);
+uint32_t odid_geofence_check_area(ODID_Geofence *fence, uint32_t reader, const ODID_System_data *system,
+                                  uint32_t *out, uint32_t maxOut);
+
+int odid_conflict_init(ODID_Conflict_detector *detector, ODID_Conflict_state *states, uint32_t count,
+                       ODID_Spatial_index *index, uint32_t *candidates, uint32_t candidateCount,
+                       uint64_t timeUnit);
+uint32_t odid_conflict_update(ODID_Conflict_detector *detector, uint32_t id, uint64_t now,
+                              const ODID_Location_data *location, ODID_Conflict *out, uint32_t maxOut);
+void odid_conflict_remove(ODID_Conflict_detector *detector, uint32_t id);
+
+int odid_geo_distance(const ODID_Geo_points *points, size_t count,
+                      double latitude, double longitude, double *distance);
+int odid_geo_distance_fast(const ODID_Geo_points *points, size_t count,
+                           double latitude, double longitude, double *distance);
+int odid_geo_bearing(const ODID_Geo_points *points, size_t count,
+                     double latitude, double longitude, double *bearing);
+int odid_geo_to_ecef(const ODID_Geo_points *points, size_t count, double *x, double *y, double *z);
+int odid_geo_to_enu(const ODID_Geo_points *points, size_t count,
+                    double latitude, double longitude, double altitude,
+                    double *east, double *north, double *up);
+
 int getBasicIDType(ODID_BasicID_encoded *inEncoded, enum ODID_idtype *idType);
 int getAuthPageNum(ODID_Auth_encoded *inEncoded, int *pageNum);
 ODID_messagetype_t decodeMessageType(uint8_t byte);
 ODID_messagetype_t decodeOpenDroneID(ODID_UAS_Data *uas_data, const uint8_t *msg_data);
+int odid_register_decoder(uint8_t messageType, ODID_decoder_fn decoder, void *context);
+ODID_messagetype_t odid_decode_merge(ODID_UAS_Data *uasData, ODID_UAS_Timestamps *timestamps,
+                                     uint64_t now, const uint8_t *msgData, uint32_t *changed,
+                                     ODID_Message_memo *memo);
+ODID_messagetype_t odid_decode_memo(ODID_UAS_Data *uasData, ODID_Message_memo *memo,
+                                    const uint8_t *msgData);
+size_t odid_decode_batch(ODID_UAS_Data *uasData, size_t uasCount,
+                         const ODID_Message_encoded *msgs, const uint16_t *sourceTags,
+                         size_t msgCount, ODID_messagetype_t *outTypes);
+int odid_decode_location_soa(const ODID_Location_soa *out, const ODID_Location_encoded *in,
+                             size_t count);
+ODID_simd_t odid_simd_select(ODID_simd_t simd);
+ODID_simd_t odid_simd_selected(void);
+
+int odid_view_init(ODID_Message_view *view, const uint8_t *data, size_t len);
+int odid_view_pack_init(ODID_MessagePack_view *view, const uint8_t *data, size_t len);
+ODID_Message_view odid_view_pack_message(ODID_MessagePack_view view, int index);
+ODID_messagetype_t odid_view_type(ODID_Message_view view);
+uint8_t odid_view_proto_version(ODID_Message_view view);
+
+ODID_idtype_t odid_view_basicid_idtype(ODID_Message_view view);
+ODID_uatype_t odid_view_basicid_uatype(ODID_Message_view view);
+size_t odid_view_basicid_uasid(ODID_Message_view view, const char **uasId);
+
+ODID_status_t odid_view_location_status(ODID_Message_view view);
+float odid_view_location_direction(ODID_Message_view view);
+float odid_view_location_speed_horizontal(ODID_Message_view view);
+float odid_view_location_speed_vertical(ODID_Message_view view);
+double odid_view_location_lat(ODID_Message_view view);
+double odid_view_location_lon(ODID_Message_view view);
+float odid_view_location_altitude_baro(ODID_Message_view view);
+float odid_view_location_altitude_geo(ODID_Message_view view);
+ODID_Height_reference_t odid_view_location_height_type(ODID_Message_view view);
+float odid_view_location_height(ODID_Message_view view);
+float odid_view_location_timestamp(ODID_Message_view view);
+
+int odid_view_auth_page(ODID_Message_view view);
+ODID_authtype_t odid_view_auth_type(ODID_Message_view view);
+
+ODID_desctype_t odid_view_selfid_desctype(ODID_Message_view view);
+size_t odid_view_selfid_desc(ODID_Message_view view, const char **desc);
+
+double odid_view_system_operator_lat(ODID_Message_view view);
+double odid_view_system_operator_lon(ODID_Message_view view);
+float odid_view_system_operator_altitude_geo(ODID_Message_view view);
+uint32_t odid_view_system_timestamp(ODID_Message_view view);
+
+ODID_operatorIdType_t odid_view_operatorid_type(ODID_Message_view view);
+size_t odid_view_operatorid(ODID_Message_view view, const char **operatorId);
 
 // Helper Functions
 ODID_Horizontal_accuracy_t createEnumHorizontalAccuracy(float Accuracy);
@@ -682,6 +1407,48 @@ void drone_export_gps_data(const ODID_UAS_Data *UAS_Data, char *buf, size_t buf_
  */
 int odid_message_build_pack(const ODID_UAS_Data *UAS_Data, void *pack, size_t buflen);
 
+/*
+ * Encoder context for odid_message_build_pack_cached(). It keeps a copy of
+ * the data each message was last encoded from, and the encoded message.
+ * Messages whose data did not change since the previous call are copied from
+ * the cache instead of being encoded again. One slot per message that can be
+ * part of a pack, in pack order.
+ */
+#define ODID_ENCODER_SLOTS (ODID_BASIC_ID_MAX_MESSAGES + 1 + ODID_AUTH_MAX_PAGES + 3)
+
+typedef struct ODID_Encoder_context {
+    ODID_UAS_Data source;                          // Data of the cached messages
+    ODID_Message_encoded encoded[ODID_ENCODER_SLOTS];
+    int8_t state[ODID_ENCODER_SLOTS];              // Empty, encoded or failed to encode
+    uint32_t encodes;                              // Statistics: messages encoded
+    uint32_t hits;                                 // Statistics: messages taken from the cache
+} ODID_Encoder_context;
+
+/**
+ * odid_encoder_init - initializes an empty encoder context
+ * @ctx: encoder context
+ *
+ * Also use this to force all messages to be encoded again by the next call of
+ * odid_message_build_pack_cached().
+ */
+void odid_encoder_init(ODID_Encoder_context *ctx);
+
+/**
+ * odid_message_build_pack_cached - like odid_message_build_pack(), but only
+ * encodes the messages whose data changed since the previous call
+ * @ctx: encoder context, see odid_encoder_init()
+ * @UAS_Data: general drone status information
+ * @pack: buffer space to write to
+ * @buflen: maximum length of buffer space
+ *
+ * The result is identical to that of odid_message_build_pack().
+ *
+ * Returns length on success, < 0 on failure. @buf only contains a valid message
+ * if the return code is >0
+ */
+int odid_message_build_pack_cached(ODID_Encoder_context *ctx, const ODID_UAS_Data *UAS_Data,
+                                   void *pack, size_t buflen);
+
 /* odid_wifi_build_nan_sync_beacon_frame - creates a NAN sync beacon frame
  * that shall be send just before the NAN action frame.
  * @mac: mac address of the wifi adapter where the NAN frame will be sent
@@ -724,6 +1491,55 @@ int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, con
                                               uint16_t interval_tu, uint8_t send_counter,
                                               uint8_t *buf, size_t buf_size);
 
+/*
+ * Prepared Wi-Fi frame: the parts of a frame that do not change from one
+ * transmission to the next are built once into the buffer, and only the
+ * send counter, the beacon timestamp, the message pack and the lengths that
+ * depend on it are written for each transmission. The offsets are into the
+ * buffer, 0 when the frame has no such field.
+ */
+#define ODID_WIFI_NAN_ACTION    0   // Message pack NAN action frame
+#define ODID_WIFI_NAN_SYNC      1   // NAN sync beacon frame, without message pack
+#define ODID_WIFI_BEACON        2   // Message pack beacon frame
+
+typedef struct ODID_Wifi_frame {
+    uint8_t *Buf;
+    size_t BufSize;
+    uint8_t Transport;              // ODID_WIFI_*
+    uint16_t TimestampOffset;       // Beacon timestamp
+    uint16_t LengthOffset;          // Service descriptor attribute or vendor element
+    uint16_t CounterOffset;         // Message counter of the service info
+    uint16_t PackOffset;            // Message pack, or end of the frame without one
+} ODID_Wifi_frame;
+
+/* odid_wifi_prepare_frame - builds the parts of a frame that stay the same
+ * for each transmission from a given adapter
+ * @frame: the prepared frame to initialize
+ * @transport: ODID_WIFI_NAN_ACTION, ODID_WIFI_NAN_SYNC or ODID_WIFI_BEACON
+ * @mac: mac address of the wifi adapter where the frame will be sent
+ * @SSID: SSID of the wifi network to be sent, beacon frames only
+ * @SSID_len: length in bytes of the SSID string, beacon frames only
+ * @interval_tu: beacon interval in wifi Time Units, beacon frames only
+ * @buf: buffer space where the frame is prepared and then sent from
+ * @buf_size: maximum size of the buffer
+ *
+ * Returns 0 on success, or < 0 on error.
+ */
+int odid_wifi_prepare_frame(ODID_Wifi_frame *frame, uint8_t transport, const char *mac,
+                            const char *SSID, size_t SSID_len, uint16_t interval_tu,
+                            uint8_t *buf, size_t buf_size);
+
+/* odid_wifi_build_prepared_frame - completes a prepared frame for one
+ * transmission, giving the same frame as the odid_wifi_build_*() functions
+ * @frame: a frame prepared by odid_wifi_prepare_frame()
+ * @UAS_Data: general drone status information, unused for NAN sync frames
+ * @send_counter: sequence number, to be increased for each call of this function
+ *
+ * Returns the packet length on success, or < 0 on error.
+ */
+int odid_wifi_build_prepared_frame(const ODID_Wifi_frame *frame, const ODID_UAS_Data *UAS_Data,
+                                   uint8_t send_counter);
+
 /* odid_message_process_pack - decodes the messages from the odid message pack
  * @UAS_Data: general drone status information
  * @pack: buffer space to read from
@@ -733,6 +1549,64 @@ int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, con
  */
 int odid_message_process_pack(ODID_UAS_Data *UAS_Data, const uint8_t *pack, size_t buflen);
 
+/* odid_message_merge_pack - decodes the messages from the odid message pack
+ * into existing drone information
+ * @UAS_Data: general drone status information, updated in place
+ * @timestamps: receive time of each message of @UAS_Data
+ * @now: time of reception of the pack
+ * @pack: buffer space to read from
+ * @buflen: length of buffer space
+ * @changed: optional, ODID_CHANGED_* bits of the changed fields are added to it
+ * @memo: optional, messages identical to the memoized ones are not decoded
+ *
+ * Unlike odid_message_process_pack(), @UAS_Data is not initialized first.
+ * Only the messages in the pack are updated and get @now as timestamp, all
+ * other messages received earlier are kept.
+ *
+ * Returns message pack length on success, or < 0 on error.
+ */
+int odid_message_merge_pack(ODID_UAS_Data *UAS_Data, ODID_UAS_Timestamps *timestamps,
+                            uint64_t now, const uint8_t *pack, size_t buflen,
+                            uint32_t *changed, ODID_Message_memo *memo);
+
+/*
+ * Iterator over the NAN attributes of a received NAN action frame, see
+ * odid_wifi_nan_action_frame_attributes() and odid_wifi_nan_next_message_pack().
+ */
+typedef struct ODID_Wifi_nan_attributes {
+    const uint8_t *Next;            // Next NAN attribute of the frame
+    const uint8_t *End;             // End of the frame
+} ODID_Wifi_nan_attributes;
+
+/* odid_wifi_nan_action_frame_attributes - checks the headers of a received
+ * NAN service discovery action frame, to iterate over its NAN attributes
+ * @attrs: the attribute iterator to initialize
+ * @buf: pointer to buffer space where the NAN is stored
+ * @buf_size: size of the frame
+ * @mac: optional, filled with the 6 bytes of the source address
+ *
+ * Returns 0 on success, or < 0 on error.
+ */
+int odid_wifi_nan_action_frame_attributes(ODID_Wifi_nan_attributes *attrs, const uint8_t *buf,
+                                          size_t buf_size, char *mac);
+
+/* odid_wifi_nan_next_message_pack - finds the next ODID service descriptor
+ * attribute of a NAN frame and the message pack in its service info
+ * @attrs: attribute iterator, see odid_wifi_nan_action_frame_attributes()
+ * @descriptor: optional, set to the service descriptor attribute
+ * @pack: set to the message pack, which points into the frame
+ * @send_counter: optional, set to the message counter of the service info
+ *
+ * Other attributes, and service descriptors of other services, are skipped.
+ * The lengths of the attributes and of the optional fields of the service
+ * descriptors are checked, nothing is copied.
+ *
+ * Returns the length of the message pack, 0 when there are no more ODID
+ * service descriptors, or < 0 on error.
+ */
+int odid_wifi_nan_next_message_pack(ODID_Wifi_nan_attributes *attrs, const uint8_t **descriptor,
+                                    const uint8_t **pack, uint8_t *send_counter);
+
 /* odid_wifi_receive_message_pack_nan_action_frame - processes a received message pack
  * with each type of message from the drone information into an NAN action frame
  * @UAS_Data: general drone status information
@@ -740,11 +1614,61 @@ int odid_message_process_pack(ODID_UAS_Data *UAS_Data, const uint8_t *pack, size
  * @buf: pointer to buffer space where the NAN is stored
  * @buf_size: maximum size of the buffer
  *
+ * The messages of all ODID service descriptors of the frame are decoded.
+ *
  * Returns 0 on success, or < 0 on error. Will fill 6 bytes into @mac.
  */
 int odid_wifi_receive_message_pack_nan_action_frame(ODID_UAS_Data *UAS_Data,
                                                     char *mac, const uint8_t *buf, size_t buf_size);
 
+/* odid_wifi_track_message_pack_nan_action_frame - processes a received message pack
+ * NAN action frame into the track of the sending UAS
+ * @table: track table, see odid_track_table_init()
+ * @now: time of reception, in the unit used for the track table
+ * @buf: pointer to buffer space where the NAN is stored
+ * @buf_size: maximum size of the buffer
+ * @track: optional, set to the updated track
+ *
+ * The track is keyed by the source MAC address of the frame. The messages of
+ * the pack are merged into the data of the track, which is created, possibly
+ * by evicting the least recently seen track, if it does not exist yet. The
+ * fields that changed are added to the Changed bits of the track. If the
+ * table has memos, messages repeated unchanged by the UAS are not decoded.
+ *
+ * Returns 0 on success, or < 0 on error.
+ */
+int odid_wifi_track_message_pack_nan_action_frame(ODID_Track_table *table, uint64_t now,
+                                                  const uint8_t *buf, size_t buf_size,
+                                                  ODID_Track **track);
+
+/* odid_wifi_find_message_pack_beacon_frame - locates the message pack in a
+ * received beacon frame, without copying or decoding it
+ * @buf: pointer to buffer space where the beacon frame is stored
+ * @buf_size: size of the frame
+ * @mac: optional, filled with the 6 bytes of the source address
+ * @pack: set to the message pack, which points into @buf
+ * @send_counter: optional, set to the message counter of the frame
+ *
+ * The information elements are walked once, skipping the other elements
+ * that access points add to their beacons.
+ *
+ * Returns the length of the message pack on success, or < 0 on error.
+ */
+int odid_wifi_find_message_pack_beacon_frame(const uint8_t *buf, size_t buf_size, char *mac,
+                                             const uint8_t **pack, uint8_t *send_counter);
+
+/* odid_wifi_receive_message_pack_beacon_frame - processes a received message pack
+ * with each type of message from the drone information into a beacon frame
+ * @UAS_Data: general drone status information
+ * @mac: optional, filled with the 6 bytes of the source address
+ * @buf: pointer to buffer space where the beacon frame is stored
+ * @buf_size: size of the frame
+ *
+ * Returns 0 on success, or < 0 on error.
+ */
+int odid_wifi_receive_message_pack_beacon_frame(ODID_UAS_Data *UAS_Data,
+                                                char *mac, const uint8_t *buf, size_t buf_size);
+
 #ifndef ODID_DISABLE_PRINTF
 void printByteArray(const uint8_t *byteArray, uint16_t asize, int spaced);
 void printBasicID_data(ODID_BasicID_data *BasicID);
@@ -755,6 +1679,8 @@ void printOperatorID_data(ODID_OperatorID_data *OperatorID);
 void printSystem_data(ODID_System_data *System_data);
 #endif // ODID_DISABLE_PRINTF
 
+#define FRDID_ID_SIZE 30
+
 typedef struct FRDID_UAS_Data {
   const char* Identifier;
   const char* ANSICTA2063Identifier;
@@ -773,6 +1699,52 @@ int frdid_wifi_build_beacon_frame(const FRDID_UAS_Data* UAS_Data, const char* ma
 
 int frdid_build(const FRDID_UAS_Data* UAS_Data, uint8_t* buf, size_t buf_size);
 
+/* frdid_decode - decodes the TLVs built by frdid_build(). The identifiers are
+ * copied to identifier, of FRDID_ID_SIZE + 1 bytes, and to
+ * ansi_cta_2063_identifier, of ODID_ID_SIZE + 1 bytes, which UAS_Data points
+ * to. Either can be NULL to skip that identifier. Longer identifiers are
+ * truncated. Missing fields are set to the values that frdid_build() leaves
+ * out.
+ *
+ * Returns the decoded length on success, or < 0 on error.
+ */
+int frdid_decode(FRDID_UAS_Data* UAS_Data, char* identifier, char* ansi_cta_2063_identifier,
+                 const uint8_t* buf, size_t buf_size);
+
+typedef enum ODID_wifi_protocol {
+    ODID_WIFI_PROTOCOL_NONE = 0,
+    ODID_WIFI_PROTOCOL_NAN = 1,     // ASTM F3411 / ASD-STAN NAN action frame
+    ODID_WIFI_PROTOCOL_BEACON = 2,  // ASTM F3411 / ASD-STAN beacon frame
+    ODID_WIFI_PROTOCOL_FRDID = 3,   // French remote ID beacon frame
+} ODID_wifi_protocol_t;
+
+typedef struct ODID_Wifi_received {
+    uint8_t Protocol;               // ODID_WIFI_PROTOCOL_*
+    char Mac[6];                    // Source address
+    uint8_t Counter;                // Message counter, not sent by FRDID
+    ODID_UAS_Data UAS_Data;         // Messages, or the FRDID fields with an ODID equivalent
+    FRDID_UAS_Data FRDID;           // FRDID frames only
+    char FRDIDIdentifier[FRDID_ID_SIZE + 1];
+    char FRDIDANSICTA2063Identifier[ODID_ID_SIZE + 1];
+} ODID_Wifi_received;
+
+/* odid_wifi_receive_frame - classifies a received frame by its remote ID
+ * protocol and decodes it
+ * @rx: the decoded frame
+ * @buf: pointer to buffer space where the frame is stored
+ * @buf_size: size of the frame
+ *
+ * The frame control field selects between NAN action frames and beacon
+ * frames, the elements of which are walked once to find either an ODID or
+ * an FRDID vendor specific element. For FRDID frames, the serial number,
+ * position, speed and course and the takeoff position are also filled in
+ * rx->UAS_Data as Basic ID, Location and System data.
+ *
+ * Returns the ODID_WIFI_PROTOCOL_* of the frame, ODID_WIFI_PROTOCOL_NONE
+ * for frames of no remote ID protocol, or < 0 on error.
+ */
+int odid_wifi_receive_frame(ODID_Wifi_received *rx, const uint8_t *buf, size_t buf_size);
+
 #ifdef __cplusplus
 }
 #endif
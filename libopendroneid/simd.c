@@ -0,0 +1,392 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include "opendroneid.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define ODID_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * The Location message fields are read directly from the wire format, which
+ * is little endian. Byte offsets are those of ODID_Location_encoded.
+ */
+#define LOC_FLAGS         1
+#define LOC_DIRECTION     2
+#define LOC_SPEED_H       3
+#define LOC_SPEED_V       4
+#define LOC_LATITUDE      5
+#define LOC_LONGITUDE     9
+#define LOC_ALT_BARO      13
+#define LOC_ALT_GEO       15
+#define LOC_HEIGHT        17
+#define LOC_TIMESTAMP     21
+
+#define LOC_BLOCK         8
+
+/*
+ * The integer fields of a block of Location messages, gathered from the
+ * encoded records before they are converted to floating point.
+ */
+typedef struct {
+    int32_t latitude[LOC_BLOCK];
+    int32_t longitude[LOC_BLOCK];
+    int32_t altitudeBaro[LOC_BLOCK];
+    int32_t altitudeGeo[LOC_BLOCK];
+    int32_t height[LOC_BLOCK];
+    int32_t direction[LOC_BLOCK];   // EW flag already applied
+    int32_t speedH[LOC_BLOCK];
+    int32_t speedMult[LOC_BLOCK];   // 0 or -1, used as a lane mask
+    int32_t speedV[LOC_BLOCK];
+    int32_t timeStamp[LOC_BLOCK];
+} location_block_t;
+
+typedef void (*location_kernel_t)(const ODID_Location_soa *out, size_t offset,
+                                  const location_block_t *blk);
+
+static uint16_t get_le16(const uint8_t *p)
+{
+    return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static int32_t get_le32(const uint8_t *p)
+{
+    return (int32_t) ((uint32_t) p[0] | ((uint32_t) p[1] << 8) |
+                      ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24));
+}
+
+/**
+* Gather the integer fields of up to LOC_BLOCK Location messages
+*
+* Lanes beyond count are zero filled, so the kernels can always process full
+* blocks.
+*/
+static void gatherLocationBlock(location_block_t *blk, const ODID_Location_soa *out,
+                                size_t offset, const ODID_Location_encoded *in, size_t count)
+{
+    memset(blk, 0, sizeof(*blk));
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *raw = (const uint8_t *) &in[i];
+        uint8_t flags = raw[LOC_FLAGS];
+        blk->latitude[i] = get_le32(&raw[LOC_LATITUDE]);
+        blk->longitude[i] = get_le32(&raw[LOC_LONGITUDE]);
+        blk->altitudeBaro[i] = get_le16(&raw[LOC_ALT_BARO]);
+        blk->altitudeGeo[i] = get_le16(&raw[LOC_ALT_GEO]);
+        blk->height[i] = get_le16(&raw[LOC_HEIGHT]);
+        blk->direction[i] = raw[LOC_DIRECTION] + ((flags & 0x02) ? 180 : 0);
+        blk->speedH[i] = raw[LOC_SPEED_H];
+        blk->speedMult[i] = (flags & 0x01) ? -1 : 0;
+        blk->speedV[i] = (int8_t) raw[LOC_SPEED_V];
+        blk->timeStamp[i] = get_le16(&raw[LOC_TIMESTAMP]);
+        if (out->Status)
+            out->Status[offset + i] = (uint8_t) (flags >> 4);
+        if (out->Valid)
+            out->Valid[offset + i] = (uint8_t) ((raw[0] >> 4) == ODID_MESSAGETYPE_LOCATION);
+    }
+}
+
+/*
+ * All kernels must produce results that are bit-identical to
+ * decodeLocationMessage(). The scalar expressions below are the reference:
+ * every SIMD variant performs the same single precision (or for latitude and
+ * longitude double precision) operations in the same order.
+ */
+static float scalarSpeedH(int32_t speed, int32_t mult)
+{
+    if (mult)
+        return (float) speed * 0.75f + 63.75f;
+    return (float) speed * 0.25f;
+}
+
+static float scalarTimeStamp(int32_t timeStamp)
+{
+    if (timeStamp == INV_TIMESTAMP)
+        return INV_TIMESTAMP;
+    return (float) timeStamp / 10;
+}
+
+static void locationKernelScalar(const ODID_Location_soa *out, size_t offset,
+                                 const location_block_t *blk, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        size_t o = offset + i;
+        if (out->Latitude)
+            out->Latitude[o] = (double) blk->latitude[i] / 10000000;
+        if (out->Longitude)
+            out->Longitude[o] = (double) blk->longitude[i] / 10000000;
+        if (out->AltitudeBaro)
+            out->AltitudeBaro[o] = (float) blk->altitudeBaro[i] * 0.5f - 1000.0f;
+        if (out->AltitudeGeo)
+            out->AltitudeGeo[o] = (float) blk->altitudeGeo[i] * 0.5f - 1000.0f;
+        if (out->Height)
+            out->Height[o] = (float) blk->height[i] * 0.5f - 1000.0f;
+        if (out->Direction)
+            out->Direction[o] = (float) blk->direction[i];
+        if (out->SpeedHorizontal)
+            out->SpeedHorizontal[o] = scalarSpeedH(blk->speedH[i], blk->speedMult[i]);
+        if (out->SpeedVertical)
+            out->SpeedVertical[o] = (float) blk->speedV[i] * 0.5f;
+        if (out->TimeStamp)
+            out->TimeStamp[o] = scalarTimeStamp(blk->timeStamp[i]);
+    }
+}
+
+static void locationKernelScalarBlock(const ODID_Location_soa *out, size_t offset,
+                                      const location_block_t *blk)
+{
+    locationKernelScalar(out, offset, blk, LOC_BLOCK);
+}
+
+#ifdef ODID_SIMD_X86
+
+__attribute__((target("sse2")))
+static __m128 altitude_sse2(const int32_t *enc)
+{
+    __m128 v = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) enc));
+    return _mm_sub_ps(_mm_mul_ps(v, _mm_set1_ps(0.5f)), _mm_set1_ps(1000.0f));
+}
+
+__attribute__((target("sse2")))
+static void locationKernelSSE2(const ODID_Location_soa *out, size_t offset,
+                               const location_block_t *blk)
+{
+    const __m128d latlonDiv = _mm_set1_pd(10000000.0);
+    for (int i = 0; i < LOC_BLOCK; i += 4) {
+        size_t o = offset + (size_t) i;
+        for (int j = 0; j < 4; j += 2) {
+            if (out->Latitude) {
+                __m128i lat = _mm_loadl_epi64((const __m128i *) &blk->latitude[i + j]);
+                _mm_storeu_pd(&out->Latitude[o + j], _mm_div_pd(_mm_cvtepi32_pd(lat), latlonDiv));
+            }
+            if (out->Longitude) {
+                __m128i lon = _mm_loadl_epi64((const __m128i *) &blk->longitude[i + j]);
+                _mm_storeu_pd(&out->Longitude[o + j], _mm_div_pd(_mm_cvtepi32_pd(lon), latlonDiv));
+            }
+        }
+        if (out->AltitudeBaro)
+            _mm_storeu_ps(&out->AltitudeBaro[o], altitude_sse2(&blk->altitudeBaro[i]));
+        if (out->AltitudeGeo)
+            _mm_storeu_ps(&out->AltitudeGeo[o], altitude_sse2(&blk->altitudeGeo[i]));
+        if (out->Height)
+            _mm_storeu_ps(&out->Height[o], altitude_sse2(&blk->height[i]));
+        if (out->Direction) {
+            __m128i dir = _mm_loadu_si128((const __m128i *) &blk->direction[i]);
+            _mm_storeu_ps(&out->Direction[o], _mm_cvtepi32_ps(dir));
+        }
+        if (out->SpeedHorizontal) {
+            __m128 speed = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) &blk->speedH[i]));
+            __m128 mult = _mm_castsi128_ps(_mm_loadu_si128((const __m128i *) &blk->speedMult[i]));
+            __m128 low = _mm_mul_ps(speed, _mm_set1_ps(0.25f));
+            __m128 high = _mm_add_ps(_mm_mul_ps(speed, _mm_set1_ps(0.75f)), _mm_set1_ps(63.75f));
+            _mm_storeu_ps(&out->SpeedHorizontal[o],
+                          _mm_or_ps(_mm_and_ps(mult, high), _mm_andnot_ps(mult, low)));
+        }
+        if (out->SpeedVertical) {
+            __m128 speed = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *) &blk->speedV[i]));
+            _mm_storeu_ps(&out->SpeedVertical[o], _mm_mul_ps(speed, _mm_set1_ps(0.5f)));
+        }
+        if (out->TimeStamp) {
+            __m128i ts = _mm_loadu_si128((const __m128i *) &blk->timeStamp[i]);
+            __m128 inv = _mm_castsi128_ps(_mm_cmpeq_epi32(ts, _mm_set1_epi32(INV_TIMESTAMP)));
+            __m128 secs = _mm_div_ps(_mm_cvtepi32_ps(ts), _mm_set1_ps(10.0f));
+            _mm_storeu_ps(&out->TimeStamp[o],
+                          _mm_or_ps(_mm_and_ps(inv, _mm_set1_ps((float) INV_TIMESTAMP)),
+                                    _mm_andnot_ps(inv, secs)));
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static __m256 altitude_avx2(const int32_t *enc)
+{
+    __m256 v = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *) enc));
+    return _mm256_sub_ps(_mm256_mul_ps(v, _mm256_set1_ps(0.5f)), _mm256_set1_ps(1000.0f));
+}
+
+__attribute__((target("avx2")))
+static void locationKernelAVX2(const ODID_Location_soa *out, size_t offset,
+                               const location_block_t *blk)
+{
+    const __m256d latlonDiv = _mm256_set1_pd(10000000.0);
+    for (int j = 0; j < LOC_BLOCK; j += 4) {
+        if (out->Latitude) {
+            __m128i lat = _mm_loadu_si128((const __m128i *) &blk->latitude[j]);
+            _mm256_storeu_pd(&out->Latitude[offset + j],
+                             _mm256_div_pd(_mm256_cvtepi32_pd(lat), latlonDiv));
+        }
+        if (out->Longitude) {
+            __m128i lon = _mm_loadu_si128((const __m128i *) &blk->longitude[j]);
+            _mm256_storeu_pd(&out->Longitude[offset + j],
+                             _mm256_div_pd(_mm256_cvtepi32_pd(lon), latlonDiv));
+        }
+    }
+    if (out->AltitudeBaro)
+        _mm256_storeu_ps(&out->AltitudeBaro[offset], altitude_avx2(blk->altitudeBaro));
+    if (out->AltitudeGeo)
+        _mm256_storeu_ps(&out->AltitudeGeo[offset], altitude_avx2(blk->altitudeGeo));
+    if (out->Height)
+        _mm256_storeu_ps(&out->Height[offset], altitude_avx2(blk->height));
+    if (out->Direction) {
+        __m256i dir = _mm256_loadu_si256((const __m256i *) blk->direction);
+        _mm256_storeu_ps(&out->Direction[offset], _mm256_cvtepi32_ps(dir));
+    }
+    if (out->SpeedHorizontal) {
+        __m256 speed = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *) blk->speedH));
+        __m256 mult = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i *) blk->speedMult));
+        __m256 low = _mm256_mul_ps(speed, _mm256_set1_ps(0.25f));
+        __m256 high = _mm256_add_ps(_mm256_mul_ps(speed, _mm256_set1_ps(0.75f)), _mm256_set1_ps(63.75f));
+        _mm256_storeu_ps(&out->SpeedHorizontal[offset], _mm256_blendv_ps(low, high, mult));
+    }
+    if (out->SpeedVertical) {
+        __m256 speed = _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i *) blk->speedV));
+        _mm256_storeu_ps(&out->SpeedVertical[offset], _mm256_mul_ps(speed, _mm256_set1_ps(0.5f)));
+    }
+    if (out->TimeStamp) {
+        __m256i ts = _mm256_loadu_si256((const __m256i *) blk->timeStamp);
+        __m256 inv = _mm256_castsi256_ps(_mm256_cmpeq_epi32(ts, _mm256_set1_epi32(INV_TIMESTAMP)));
+        __m256 secs = _mm256_div_ps(_mm256_cvtepi32_ps(ts), _mm256_set1_ps(10.0f));
+        _mm256_storeu_ps(&out->TimeStamp[offset],
+                         _mm256_blendv_ps(secs, _mm256_set1_ps((float) INV_TIMESTAMP), inv));
+    }
+}
+
+#endif // ODID_SIMD_X86
+
+/*
+ * The selected instruction set is the only state and is accessed
+ * atomically, so that the batch functions of other threads see either the
+ * previous or the new selection. Threads that detect the instruction set at
+ * the same time on first use all store the same value.
+ */
+static int selectedSimd = ODID_SIMD_AUTO;
+
+static location_kernel_t locationKernelOf(ODID_simd_t simd)
+{
+    switch (simd)
+    {
+#ifdef ODID_SIMD_X86
+    case ODID_SIMD_AVX2:
+        return locationKernelAVX2;
+    case ODID_SIMD_SSE2:
+        return locationKernelSSE2;
+#endif
+    default:
+        return locationKernelScalarBlock;
+    }
+}
+
+/**
+* Check whether the CPU running the code supports a given instruction set
+*
+* @param simd   The instruction set to check
+* @return       1 = yes, 0 = no
+*/
+static int simdSupported(ODID_simd_t simd)
+{
+    switch (simd)
+    {
+    case ODID_SIMD_SCALAR:
+        return 1;
+#ifdef ODID_SIMD_X86
+    case ODID_SIMD_SSE2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2");
+    case ODID_SIMD_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return 0;
+    }
+}
+
+/**
+* Select the instruction set used by the batch decoders
+*
+* With ODID_SIMD_AUTO, the best instruction set supported by the CPU is
+* detected at runtime. This is also what happens if the batch decoders are
+* used without calling this function first. If the requested instruction set
+* is not supported by the CPU or the build, the best supported one below it
+* is selected instead.
+*
+* @param simd   The requested instruction set
+* @return       The instruction set that has been selected
+*/
+ODID_simd_t odid_simd_select(ODID_simd_t simd)
+{
+    if (simd == ODID_SIMD_AUTO || simd > ODID_SIMD_AVX2)
+        simd = ODID_SIMD_AVX2;
+    while (simd > ODID_SIMD_SCALAR && !simdSupported(simd))
+        simd = (ODID_simd_t) (simd - 1);
+    if (simd < ODID_SIMD_SCALAR)
+        simd = ODID_SIMD_SCALAR;
+
+    __atomic_store_n(&selectedSimd, (int) simd, __ATOMIC_RELAXED);
+    return simd;
+}
+
+/**
+* Return the instruction set used by the batch functions, detecting the best
+* supported one first if none has been selected yet
+*
+* @return   The selected instruction set, never ODID_SIMD_AUTO
+*/
+ODID_simd_t odid_simd_selected(void)
+{
+    ODID_simd_t simd = (ODID_simd_t) __atomic_load_n(&selectedSimd, __ATOMIC_RELAXED);
+    if (simd == ODID_SIMD_AUTO)
+        simd = odid_simd_select(ODID_SIMD_AUTO);
+    return simd;
+}
+
+/**
+* Decode an array of Location messages into structure-of-arrays form
+*
+* The records are processed in blocks of eight. The integer fields of each
+* block are first gathered from the wire format, after which they are
+* dequantized with the SSE2 or AVX2 instructions selected by
+* odid_simd_select(), or with scalar code on other CPUs. The results are
+* bit-identical to those of decodeLocationMessage().
+*
+* Any of the output arrays in out can be NULL, in which case that field is
+* skipped. All non-NULL arrays must have room for count entries. If out->Valid
+* is set, it receives 1 for each record carrying a Location message and 0
+* otherwise. The fields of the latter are decoded regardless and must be
+* ignored.
+*
+* @param out    Output arrays
+* @param in     Array of encoded Location messages
+* @param count  Number of messages in the array
+* @return       ODID_SUCCESS or ODID_FAIL
+*/
+int odid_decode_location_soa(const ODID_Location_soa *out, const ODID_Location_encoded *in,
+                             size_t count)
+{
+    location_block_t blk;
+
+    if (!out || (!in && count))
+        return ODID_FAIL;
+
+    location_kernel_t locationKernel = locationKernelOf(odid_simd_selected());
+    size_t i = 0;
+    for (; i + LOC_BLOCK <= count; i += LOC_BLOCK) {
+        gatherLocationBlock(&blk, out, i, &in[i], LOC_BLOCK);
+        locationKernel(out, i, &blk);
+    }
+    if (i < count) {
+        // Remaining records do not fill a full vector block
+        gatherLocationBlock(&blk, out, i, &in[i], count - i);
+        locationKernelScalar(out, i, &blk, count - i);
+    }
+    return ODID_SUCCESS;
+}
@@ -0,0 +1,376 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include <math.h>
+#include "opendroneid.h"
+
+#ifndef M_PI
+#define M_PI                3.14159265358979323846
+#endif
+
+#define EARTH_RADIUS        6371008.8   // Mean radius in meters
+#define DEG2RAD             (M_PI / 180)
+#define METERS_PER_DEGREE   (EARTH_RADIUS * DEG2RAD)
+
+/**
+* Initialize an empty spatial index on top of caller provided storage
+*
+* Positions are indexed in a grid of cellSize by cellSize degrees, of which
+* only the occupied cells use memory: the cells are hashed into bucketCount
+* lists. A cell size in the order of the radius of typical queries works
+* best, e.g. 0.01 degrees (about 1 km).
+*
+* @param index          The index to initialize
+* @param entries        Array of count entries, one per indexed entity
+* @param count          Number of entities
+* @param buckets        Array of bucketCount list heads
+* @param bucketCount    Power of two, e.g. the smallest one not below count
+* @param cellSize       Size of the grid cells in degrees
+* @return               ODID_SUCCESS or ODID_FAIL
+*/
+int odid_spatial_init(ODID_Spatial_index *index, ODID_Spatial_entry *entries, uint32_t count,
+                      uint32_t *buckets, uint32_t bucketCount, double cellSize)
+{
+    if (!index || !entries || !buckets || count == 0 || count == ODID_SPATIAL_NONE ||
+        bucketCount == 0 || (bucketCount & (bucketCount - 1)) != 0 ||
+        !(cellSize >= 1E-5 && cellSize <= 180))
+        return ODID_FAIL;
+
+    index->Entries = entries;
+    index->Buckets = buckets;
+    index->Count = count;
+    index->BucketMask = bucketCount - 1;
+    index->Size = 0;
+    index->CellSize = cellSize;
+    index->Columns = (int32_t) ceil(360 / cellSize);
+    index->Rows = (int32_t) ceil(180 / cellSize);
+    for (uint32_t i = 0; i < bucketCount; i++)
+        buckets[i] = ODID_SPATIAL_NONE;
+    for (uint32_t i = 0; i < count; i++)
+        entries[i].Bucket = ODID_SPATIAL_NONE;
+    return ODID_SUCCESS;
+}
+
+static int32_t cellX(const ODID_Spatial_index *index, double longitude)
+{
+    int32_t x = (int32_t) floor((longitude + 180) / index->CellSize);
+    return x < index->Columns ? x : index->Columns - 1;
+}
+
+static int32_t cellY(const ODID_Spatial_index *index, double latitude)
+{
+    int32_t y = (int32_t) floor((latitude + 90) / index->CellSize);
+    return y < index->Rows ? y : index->Rows - 1;
+}
+
+static uint32_t cellBucket(const ODID_Spatial_index *index, int32_t x, int32_t y)
+{
+    return (((uint32_t) x * 73856093u) ^ ((uint32_t) y * 19349663u)) & index->BucketMask;
+}
+
+static void unlinkEntry(ODID_Spatial_index *index, uint32_t id)
+{
+    ODID_Spatial_entry *entry = &index->Entries[id];
+    if (entry->Prev != ODID_SPATIAL_NONE)
+        index->Entries[entry->Prev].Next = entry->Next;
+    else
+        index->Buckets[entry->Bucket] = entry->Next;
+    if (entry->Next != ODID_SPATIAL_NONE)
+        index->Entries[entry->Next].Prev = entry->Prev;
+}
+
+/**
+* Remove an entity from the index. Nothing is done if it is not indexed
+*
+* @param index  The spatial index
+* @param id     Index of the entity in the entries of the index
+*/
+void odid_spatial_remove(ODID_Spatial_index *index, uint32_t id)
+{
+    if (!index || id >= index->Count || index->Entries[id].Bucket == ODID_SPATIAL_NONE)
+        return;
+    unlinkEntry(index, id);
+    index->Entries[id].Bucket = ODID_SPATIAL_NONE;
+    index->Size--;
+}
+
+/**
+* Add an entity to the index or move it to a new position
+*
+* Moving within a grid cell only updates the position. An invalid position
+* removes the entity from the index.
+*
+* @param index      The spatial index
+* @param id         Index of the entity in the entries of the index
+* @param latitude   Latitude in degrees
+* @param longitude  Longitude in degrees
+*/
+void odid_spatial_update(ODID_Spatial_index *index, uint32_t id, double latitude, double longitude)
+{
+    if (!index || id >= index->Count)
+        return;
+    if (!(latitude >= -90 && latitude <= 90 && longitude >= -180 && longitude <= 180)) {
+        odid_spatial_remove(index, id);
+        return;
+    }
+
+    ODID_Spatial_entry *entry = &index->Entries[id];
+    int32_t x = cellX(index, longitude);
+    int32_t y = cellY(index, latitude);
+    entry->Latitude = latitude;
+    entry->Longitude = longitude;
+    if (entry->Bucket != ODID_SPATIAL_NONE) {
+        if (entry->CellX == x && entry->CellY == y)
+            return;
+        unlinkEntry(index, id);
+    } else {
+        index->Size++;
+    }
+
+    entry->CellX = x;
+    entry->CellY = y;
+    entry->Bucket = cellBucket(index, x, y);
+    entry->Prev = ODID_SPATIAL_NONE;
+    entry->Next = index->Buckets[entry->Bucket];
+    if (entry->Next != ODID_SPATIAL_NONE)
+        index->Entries[entry->Next].Prev = id;
+    index->Buckets[entry->Bucket] = id;
+}
+
+/**
+* Return the great circle distance between two positions
+*
+* @param latitude1  Latitude of the first position in degrees
+* @param longitude1 Longitude of the first position in degrees
+* @param latitude2  Latitude of the second position in degrees
+* @param longitude2 Longitude of the second position in degrees
+* @return           Distance in meters, on a spherical earth
+*/
+double odid_distance(double latitude1, double longitude1, double latitude2, double longitude2)
+{
+    double sinLat = sin((latitude2 - latitude1) * DEG2RAD / 2);
+    double sinLon = sin((longitude2 - longitude1) * DEG2RAD / 2);
+    double a = sinLat * sinLat +
+               cos(latitude1 * DEG2RAD) * cos(latitude2 * DEG2RAD) * sinLon * sinLon;
+    return 2 * EARTH_RADIUS * asin(sqrt(a < 1 ? a : 1));
+}
+
+/*
+ * A box, radius or nearest neighbour query. The box bounds the area to
+ * visit; lonMin > lonMax means that it crosses the antimeridian. Radius and
+ * nearest neighbour queries also check the distance of each entity.
+ */
+typedef struct SpatialQuery {
+    double LatMin, LonMin, LatMax, LonMax;
+    double Latitude, Longitude, Radius;
+    int CheckRadius;
+    uint32_t *Out;
+    double *Distances;          // Nearest neighbour queries only, sorted
+    uint32_t MaxOut;
+    uint32_t Found;
+} SpatialQuery;
+
+static void matchEntry(const ODID_Spatial_index *index, SpatialQuery *query, uint32_t id)
+{
+    const ODID_Spatial_entry *entry = &index->Entries[id];
+    if (entry->Latitude < query->LatMin || entry->Latitude > query->LatMax)
+        return;
+    if (query->LonMin <= query->LonMax ?
+        (entry->Longitude < query->LonMin || entry->Longitude > query->LonMax) :
+        (entry->Longitude < query->LonMin && entry->Longitude > query->LonMax))
+        return;
+    if (!query->CheckRadius) {
+        if (query->Found < query->MaxOut)
+            query->Out[query->Found] = id;
+        query->Found++;
+        return;
+    }
+
+    double distance = odid_distance(query->Latitude, query->Longitude,
+                                    entry->Latitude, entry->Longitude);
+    if (distance > query->Radius)
+        return;
+    if (!query->Distances) {
+        if (query->Found < query->MaxOut)
+            query->Out[query->Found] = id;
+        query->Found++;
+        return;
+    }
+
+    // Insert into the sorted k nearest, dropping the farthest when full
+    uint32_t i;
+    if (query->Found < query->MaxOut)
+        i = query->Found++;
+    else if (distance < query->Distances[query->MaxOut - 1])
+        i = query->MaxOut - 1;
+    else
+        return;
+    while (i > 0 && query->Distances[i - 1] > distance) {
+        query->Distances[i] = query->Distances[i - 1];
+        query->Out[i] = query->Out[i - 1];
+        i--;
+    }
+    query->Distances[i] = distance;
+    query->Out[i] = id;
+}
+
+static void runQuery(const ODID_Spatial_index *index, SpatialQuery *query)
+{
+    int32_t x0 = cellX(index, query->LonMin), x1 = cellX(index, query->LonMax);
+    int32_t y0 = cellY(index, query->LatMin), y1 = cellY(index, query->LatMax);
+    int64_t columns = x1 - x0 + 1;
+    if (query->LonMin > query->LonMax)
+        columns = x1 + index->Columns - x0 + 1;
+    if (columns > index->Columns)
+        columns = index->Columns;
+    query->Found = 0;
+
+    // Large areas: visiting each bucket once is cheaper than each cell
+    if (columns * (y1 - y0 + 1) > (int64_t) index->BucketMask + 1) {
+        for (uint32_t b = 0; b <= index->BucketMask; b++) {
+            for (uint32_t id = index->Buckets[b]; id != ODID_SPATIAL_NONE; id = index->Entries[id].Next)
+                matchEntry(index, query, id);
+        }
+        return;
+    }
+
+    for (int32_t y = y0; y <= y1; y++) {
+        for (int64_t c = 0; c < columns; c++) {
+            int32_t x = (int32_t) ((x0 + c) % index->Columns);
+            uint32_t id = index->Buckets[cellBucket(index, x, y)];
+            for (; id != ODID_SPATIAL_NONE; id = index->Entries[id].Next) {
+                // Other cells may share the bucket
+                if (index->Entries[id].CellX == x && index->Entries[id].CellY == y)
+                    matchEntry(index, query, id);
+            }
+        }
+    }
+}
+
+/**
+* Find the entities inside a latitude/longitude box
+*
+* @param index      The spatial index
+* @param latMin     Southern edge of the box in degrees
+* @param lonMin     Western edge of the box in degrees
+* @param latMax     Northern edge of the box in degrees
+* @param lonMax     Eastern edge of the box in degrees. A box crossing the
+*                   antimeridian has lonMax < lonMin
+* @param out        Array receiving the ids of at most maxOut entities
+* @param maxOut     Size of out
+* @return           Number of entities in the box, which can exceed maxOut
+*/
+uint32_t odid_spatial_box(const ODID_Spatial_index *index, double latMin, double lonMin,
+                          double latMax, double lonMax, uint32_t *out, uint32_t maxOut)
+{
+    if (!index || (!out && maxOut > 0) || !(latMin <= latMax))
+        return 0;
+    SpatialQuery query = { 0 };
+    query.LatMin = latMin > -90 ? latMin : -90;
+    query.LatMax = latMax < 90 ? latMax : 90;
+    query.LonMin = lonMin > -180 ? lonMin : -180;
+    query.LonMax = lonMax < 180 ? lonMax : 180;
+    query.Out = out;
+    query.MaxOut = maxOut;
+    runQuery(index, &query);
+    return query.Found;
+}
+
+// Set the box of a query to the bounding box of a circle
+static void radiusBox(SpatialQuery *query, double latitude, double longitude, double radius)
+{
+    double angle = radius / EARTH_RADIUS;
+    double dLat = angle / DEG2RAD;
+    query->Latitude = latitude;
+    query->Longitude = longitude;
+    query->Radius = radius;
+    query->CheckRadius = 1;
+    query->LatMin = latitude - dLat;
+    query->LatMax = latitude + dLat;
+    query->LonMin = -180;
+    query->LonMax = 180;
+    if (query->LatMin <= -90 || query->LatMax >= 90 || angle >= M_PI / 2) {
+        // The circle contains a pole
+        if (query->LatMin < -90)
+            query->LatMin = -90;
+        if (query->LatMax > 90)
+            query->LatMax = 90;
+        return;
+    }
+
+    double ratio = sin(angle) / cos(latitude * DEG2RAD);
+    if (ratio >= 1)
+        return;
+    double dLon = asin(ratio) / DEG2RAD;
+    query->LonMin = longitude - dLon;
+    if (query->LonMin < -180)
+        query->LonMin += 360;
+    query->LonMax = longitude + dLon;
+    if (query->LonMax > 180)
+        query->LonMax -= 360;
+}
+
+/**
+* Find the entities within a distance of a position
+*
+* @param index      The spatial index
+* @param latitude   Latitude of the center in degrees
+* @param longitude  Longitude of the center in degrees
+* @param radius     Distance in meters
+* @param out        Array receiving the ids of at most maxOut entities
+* @param maxOut     Size of out
+* @return           Number of entities within the distance, which can exceed maxOut
+*/
+uint32_t odid_spatial_radius(const ODID_Spatial_index *index, double latitude, double longitude,
+                             double radius, uint32_t *out, uint32_t maxOut)
+{
+    if (!index || (!out && maxOut > 0) || !(radius >= 0))
+        return 0;
+    SpatialQuery query = { 0 };
+    radiusBox(&query, latitude, longitude, radius);
+    query.Out = out;
+    query.MaxOut = maxOut;
+    runQuery(index, &query);
+    return query.Found;
+}
+
+/**
+* Find the k entities nearest to a position
+*
+* The search starts with the entities within one grid cell and widens the
+* radius until k entities are found or the whole earth is covered.
+*
+* @param index      The spatial index
+* @param latitude   Latitude in degrees
+* @param longitude  Longitude in degrees
+* @param k          Number of entities to find
+* @param out        Array receiving the ids of at most k entities, nearest first
+* @param distances  Array receiving the distances in meters of the k entities
+* @return           Number of entities found, less than k if the index holds fewer
+*/
+uint32_t odid_spatial_nearest(const ODID_Spatial_index *index, double latitude, double longitude,
+                              uint32_t k, uint32_t *out, double *distances)
+{
+    if (!index || !out || !distances || k == 0)
+        return 0;
+    SpatialQuery query = { 0 };
+    query.Out = out;
+    query.Distances = distances;
+    query.MaxOut = k;
+    for (double radius = index->CellSize * METERS_PER_DEGREE; ; radius *= 4) {
+        radiusBox(&query, latitude, longitude, radius);
+        runQuery(index, &query);
+        if (query.Found >= k || query.Found == index->Size || radius >= M_PI * EARTH_RADIUS)
+            break;
+    }
+    return query.Found;
+}
@@ -0,0 +1,223 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include "opendroneid.h"
+
+#define WHEEL_MASK (ODID_WHEEL_SLOTS - 1)
+
+/**
+* Initialize a timing wheel with no scheduled timers
+*
+* The wheel has ODID_WHEEL_LEVELS levels of ODID_WHEEL_SLOTS slots. Level 0
+* holds the timers that expire within the current ODID_WHEEL_SLOTS ticks,
+* each next level covers ODID_WHEEL_SLOTS times the range of the previous
+* one. Timers move down a level when the wheel gets close to their expiry.
+*
+* @param wheel      The wheel to initialize
+* @param timers     Array of count timers
+* @param count      Number of timers
+* @param now        Current time
+* @param resolution Duration of one tick, in the unit of now
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_timer_wheel_init(ODID_Timer_wheel *wheel, ODID_Timer *timers, uint32_t count,
+                          uint64_t now, uint64_t resolution)
+{
+    if (!wheel || !timers || count == 0 || count == ODID_TIMER_NONE || resolution == 0)
+        return ODID_FAIL;
+
+    wheel->Timers = timers;
+    wheel->Count = count;
+    wheel->Pending = 0;
+    wheel->Resolution = resolution;
+    wheel->Tick = now / resolution;
+    for (int level = 0; level < ODID_WHEEL_LEVELS; level++) {
+        wheel->Occupied[level] = 0;
+        for (int slot = 0; slot < ODID_WHEEL_SLOTS; slot++)
+            wheel->Heads[level][slot] = ODID_TIMER_NONE;
+    }
+    for (uint32_t i = 0; i < count; i++)
+        timers[i].Slot = ODID_TIMER_IDLE;
+    return ODID_SUCCESS;
+}
+
+/*
+ * Put a timer in the lowest level in which its expiry tick and the current
+ * tick only differ in the bits of that level, so that the slot is reached
+ * before the timer expires. Timers that expire before earliest are treated
+ * as expiring at earliest.
+ */
+static void linkTimer(ODID_Timer_wheel *wheel, uint32_t index, uint64_t earliest)
+{
+    ODID_Timer *timer = &wheel->Timers[index];
+    uint64_t expires = timer->Expires < earliest ? earliest : timer->Expires;
+    int level = 0;
+    while (level < ODID_WHEEL_LEVELS - 1 &&
+           (expires >> (ODID_WHEEL_SLOT_BITS * (level + 1))) !=
+           (wheel->Tick >> (ODID_WHEEL_SLOT_BITS * (level + 1))))
+        level++;
+    int slot = (int) (expires >> (ODID_WHEEL_SLOT_BITS * level)) & WHEEL_MASK;
+
+    timer->Prev = ODID_TIMER_NONE;
+    timer->Next = wheel->Heads[level][slot];
+    if (timer->Next != ODID_TIMER_NONE)
+        wheel->Timers[timer->Next].Prev = index;
+    wheel->Heads[level][slot] = index;
+    wheel->Occupied[level] |= (uint64_t) 1 << slot;
+    timer->Slot = (uint16_t) (level * ODID_WHEEL_SLOTS + slot);
+}
+
+static void unlinkTimer(ODID_Timer_wheel *wheel, uint32_t index)
+{
+    ODID_Timer *timer = &wheel->Timers[index];
+    int level = timer->Slot / ODID_WHEEL_SLOTS;
+    int slot = timer->Slot % ODID_WHEEL_SLOTS;
+    if (timer->Prev != ODID_TIMER_NONE)
+        wheel->Timers[timer->Prev].Next = timer->Next;
+    else
+        wheel->Heads[level][slot] = timer->Next;
+    if (timer->Next != ODID_TIMER_NONE)
+        wheel->Timers[timer->Next].Prev = timer->Prev;
+    if (wheel->Heads[level][slot] == ODID_TIMER_NONE)
+        wheel->Occupied[level] &= ~((uint64_t) 1 << slot);
+    timer->Slot = ODID_TIMER_IDLE;
+}
+
+/**
+* Schedule a timer, or reschedule it if it is already scheduled
+*
+* @param wheel      The timing wheel
+* @param timer      Index of the timer
+* @param expires    Time at which the timer fires, rounded up to the resolution
+*                   of the wheel. Timers scheduled in the past fire at the
+*                   next tick
+*/
+void odid_timer_schedule(ODID_Timer_wheel *wheel, uint32_t timer, uint64_t expires)
+{
+    if (!wheel || timer >= wheel->Count)
+        return;
+    if (wheel->Timers[timer].Slot != ODID_TIMER_IDLE)
+        unlinkTimer(wheel, timer);
+    else
+        wheel->Pending++;
+    wheel->Timers[timer].Expires = expires / wheel->Resolution +
+                                   (expires % wheel->Resolution != 0);
+    linkTimer(wheel, timer, wheel->Tick + 1);
+}
+
+/**
+* Cancel a timer. Nothing is done if the timer is not scheduled
+*
+* @param wheel  The timing wheel
+* @param timer  Index of the timer
+*/
+void odid_timer_cancel(ODID_Timer_wheel *wheel, uint32_t timer)
+{
+    if (!wheel || timer >= wheel->Count || wheel->Timers[timer].Slot == ODID_TIMER_IDLE)
+        return;
+    unlinkTimer(wheel, timer);
+    wheel->Pending--;
+}
+
+// Move the timers of the current slot of a level to the lower levels
+static void cascade(ODID_Timer_wheel *wheel, int level)
+{
+    if (level >= ODID_WHEEL_LEVELS)
+        return;
+    int slot = (int) (wheel->Tick >> (ODID_WHEEL_SLOT_BITS * level)) & WHEEL_MASK;
+    if (slot == 0)
+        cascade(wheel, level + 1);
+
+    uint32_t index = wheel->Heads[level][slot];
+    wheel->Heads[level][slot] = ODID_TIMER_NONE;
+    wheel->Occupied[level] &= ~((uint64_t) 1 << slot);
+    while (index != ODID_TIMER_NONE) {
+        uint32_t next = wheel->Timers[index].Next;
+        linkTimer(wheel, index, wheel->Tick);
+        index = next;
+    }
+}
+
+/*
+ * First tick after the current one at which a level 0 slot with timers is
+ * reached, or at which the timers of a slot of a higher level move down.
+ * Each level is searched in its occupied bitmask, so the ticks and rounds
+ * in between are skipped without visiting them. UINT64_MAX without timers.
+ */
+static uint64_t nextEvent(const ODID_Timer_wheel *wheel)
+{
+    uint64_t next = UINT64_MAX;
+    for (int level = 0; level < ODID_WHEEL_LEVELS; level++) {
+        uint64_t occupied = wheel->Occupied[level];
+        if (!occupied)
+            continue;
+
+        // Next occupied slot in this round of the level, or else in the next one
+        int shift = ODID_WHEEL_SLOT_BITS * level;
+        uint64_t index = wheel->Tick >> shift;
+        int slot = (int) (index & WHEEL_MASK);
+        uint64_t later = slot == WHEEL_MASK ? 0 : occupied & (~(uint64_t) 0 << (slot + 1));
+        index &= ~(uint64_t) WHEEL_MASK;
+        if (later)
+            index += (uint64_t) __builtin_ctzll(later);
+        else
+            index += ODID_WHEEL_SLOTS + (uint64_t) __builtin_ctzll(occupied);
+        if (index << shift < next)
+            next = index << shift;
+    }
+    return next;
+}
+
+/**
+* Advance the wheel to the current time and fire the timers that expired
+*
+* Only the slots that hold timers and the slots at which timers move down a
+* level are visited, so the cost does not depend on the number of ticks
+* that elapsed while no timer was due. A timer is idle when its callback is
+* called; the callback may schedule or cancel any timer.
+*
+* @param wheel      The timing wheel
+* @param now        Current time. Must not be earlier than in previous calls
+* @param callback   Optional (can be NULL): called for each expired timer
+* @param context    Passed to callback
+* @return           Number of expired timers
+*/
+uint32_t odid_timer_wheel_advance(ODID_Timer_wheel *wheel, uint64_t now,
+                                  ODID_timer_fn callback, void *context)
+{
+    if (!wheel)
+        return 0;
+
+    uint64_t target = now / wheel->Resolution;
+    uint32_t fired = 0;
+    while (wheel->Tick < target) {
+        uint64_t next = nextEvent(wheel);
+        if (next > target) {
+            wheel->Tick = target;
+            break;
+        }
+        wheel->Tick = next;
+        if ((next & WHEEL_MASK) == 0)
+            cascade(wheel, 1);
+
+        uint32_t *head = &wheel->Heads[0][next & WHEEL_MASK];
+        while (*head != ODID_TIMER_NONE) {
+            uint32_t index = *head;
+            unlinkTimer(wheel, index);
+            wheel->Pending--;
+            fired++;
+            if (callback)
+                callback(wheel, index, context);
+        }
+    }
+    return fired;
+}
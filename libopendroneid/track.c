@@ -0,0 +1,520 @@
+/*
+Copyright (C) 2026 The Open Drone ID contributors
+
+SPDX-License-Identifier: Apache-2.0
+
+Open Drone ID C Library
+
+Maintainer:
+Open Drone ID project
+https://github.com/opendroneid/opendroneid-core-c
+*/
+
+#include <string.h>
+#include "opendroneid.h"
+
+/**
+* Return the number of index slots needed for a track table
+*
+* This is the smallest power of two that keeps the index at most half full.
+*
+* @param capacity   Maximum number of tracks in the table
+* @return           Number of ODID_Track_slot entries to provide to
+*                   odid_track_table_init() or 0 if capacity is too large
+*/
+uint32_t odid_track_slot_count(uint32_t capacity)
+{
+    if (capacity == 0 || capacity > (UINT32_MAX >> 2))
+        return 0;
+    uint32_t count = 2;
+    while (count < 2 * capacity)
+        count <<= 1;
+    return count;
+}
+
+/**
+* Initialize an empty track table on top of caller provided storage
+*
+* @param table      The table to initialize
+* @param tracks     Array of capacity tracks
+* @param capacity   Maximum number of tracks in the table
+* @param slots      Array of slotCount index entries
+* @param slotCount  Must be odid_track_slot_count(capacity)
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_track_table_init(ODID_Track_table *table, ODID_Track *tracks, uint32_t capacity,
+                          ODID_Track_slot *slots, uint32_t slotCount)
+{
+    if (!table || !tracks || !slots || capacity == 0 ||
+        slotCount != odid_track_slot_count(capacity))
+        return ODID_FAIL;
+
+    table->Tracks = tracks;
+    table->Slots = slots;
+    table->Memos = NULL;
+    table->Timeouts = NULL;
+    table->Spatial = NULL;
+    table->Capacity = capacity;
+    table->SlotMask = slotCount - 1;
+    table->Count = 0;
+    table->Newest = ODID_TRACK_NONE;
+    table->Oldest = ODID_TRACK_NONE;
+    table->Evictions = 0;
+    for (uint32_t i = 0; i < slotCount; i++)
+        slots[i].Track = ODID_TRACK_NONE;
+    for (uint32_t i = 0; i < capacity; i++)
+        tracks[i].Older = (i + 1 < capacity) ? i + 1 : ODID_TRACK_NONE;
+    table->Free = 0;
+    return ODID_SUCCESS;
+}
+
+/**
+* Memoize the raw messages of each track, so that messages that a UAS repeats
+* unchanged are not decoded again by odid_track_decode()
+*
+* Must be called while the table is empty.
+*
+* @param table  The track table
+* @param memos  Array of one memo per track, i.e. the capacity of the table,
+*               or NULL to disable memoization
+*/
+void odid_track_enable_memo(ODID_Track_table *table, ODID_Message_memo *memos)
+{
+    if (!table || table->Count != 0)
+        return;
+    table->Memos = memos;
+}
+
+/**
+* Return the memo of a track
+*
+* @param table  The track table
+* @param track  The track
+* @return       The memo or NULL if the table has no memos
+*/
+ODID_Message_memo *odid_track_memo(const ODID_Track_table *table, const ODID_Track *track)
+{
+    if (!table || !track || !table->Memos)
+        return NULL;
+    return &table->Memos[track - table->Tracks];
+}
+
+/**
+* Time out tracks and their messages through a timing wheel
+*
+* The Lost, Stale, Callback and Context fields of timeouts must be set by the
+* caller, this function initializes the wheel. Each received message
+* reschedules the timers of its track, and odid_track_advance() fires the
+* timers that expired, at a cost that does not depend on the number of
+* tracks. Must be called while the table is empty.
+*
+* @param table      The track table
+* @param timeouts   The timeout configuration and the timing wheel
+* @param timers     Array of ODID_TRACK_TIMERS timers per track, i.e.
+*                   ODID_TRACK_TIMERS times the capacity of the table
+* @param now        Current time
+* @param resolution Precision of the timeouts, in the unit of now
+* @return           ODID_SUCCESS or ODID_FAIL
+*/
+int odid_track_enable_timeouts(ODID_Track_table *table, ODID_Track_timeouts *timeouts,
+                               ODID_Timer *timers, uint64_t now, uint64_t resolution)
+{
+    if (!table || !timeouts || table->Count != 0 ||
+        table->Capacity > ODID_TIMER_NONE / ODID_TRACK_TIMERS)
+        return ODID_FAIL;
+    if (odid_timer_wheel_init(&timeouts->Wheel, timers, table->Capacity * ODID_TRACK_TIMERS,
+                              now, resolution) != ODID_SUCCESS)
+        return ODID_FAIL;
+    table->Timeouts = timeouts;
+    return ODID_SUCCESS;
+}
+
+/**
+* Keep the positions of the UAS and their operators in a spatial index
+*
+* The index is updated by odid_track_merge() when a Location or System
+* message is received. Its entries are the ODID_TRACK_POSITIONS positions of
+* each track, see ODID_TRACK_POSITION_UAS. Must be called while the table is
+* empty.
+*
+* @param table  The track table
+* @param index  Spatial index with at least ODID_TRACK_POSITIONS entries per
+*               track, or NULL to stop indexing
+* @return       ODID_SUCCESS or ODID_FAIL
+*/
+int odid_track_enable_spatial(ODID_Track_table *table, ODID_Spatial_index *index)
+{
+    if (!table || table->Count != 0 ||
+        (index && index->Count / ODID_TRACK_POSITIONS < table->Capacity))
+        return ODID_FAIL;
+    table->Spatial = index;
+    return ODID_SUCCESS;
+}
+
+/**
+* Make a track key from a MAC address
+*
+* @param key    The key
+* @param mac    6 byte MAC address, e.g. the source address of a Wi-Fi frame
+*/
+void odid_track_key_mac(ODID_Track_key *key, const uint8_t *mac)
+{
+    memset(key, 0, sizeof(*key));
+    key->Type = ODID_TRACK_KEY_MAC;
+    memcpy(key->Id, mac, 6);
+}
+
+/**
+* Make a track key from a UAS ID
+*
+* @param key    The key
+* @param uasId  The UAS ID of a Basic ID message, at most ODID_ID_SIZE characters
+*/
+void odid_track_key_uasid(ODID_Track_key *key, const char *uasId)
+{
+    memset(key, 0, sizeof(*key));
+    key->Type = ODID_TRACK_KEY_UASID;
+    memcpy(key->Id, uasId, strnlen(uasId, sizeof(key->Id)));
+}
+
+// 32 bit FNV-1a
+static uint32_t trackHash(const ODID_Track_key *key)
+{
+    const uint8_t *bytes = (const uint8_t *) key;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(*key); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Return the index slot holding the key, or the empty slot where it belongs
+static uint32_t trackSlot(const ODID_Track_table *table, const ODID_Track_key *key, uint32_t hash)
+{
+    uint32_t i = hash & table->SlotMask;
+    while (table->Slots[i].Track != ODID_TRACK_NONE) {
+        if (table->Slots[i].Hash == hash &&
+            memcmp(&table->Tracks[table->Slots[i].Track].Key, key, sizeof(*key)) == 0)
+            break;
+        i = (i + 1) & table->SlotMask;
+    }
+    return i;
+}
+
+// (Re)start one of the ODID_TRACK_TIMERS timers of a track, if enabled
+static void scheduleTimeout(ODID_Track_table *table, uint32_t index, int timer, uint64_t now)
+{
+    ODID_Track_timeouts *timeouts = table->Timeouts;
+    if (!timeouts)
+        return;
+    uint64_t timeout = timer == ODID_TRACK_TIMER_LOST ? timeouts->Lost :
+                       timeouts->Stale[timer - ODID_TRACK_TIMER_STALE];
+    if (timeout)
+        odid_timer_schedule(&timeouts->Wheel, index * ODID_TRACK_TIMERS + timer, now + timeout);
+}
+
+static void unlinkTrack(ODID_Track_table *table, uint32_t index)
+{
+    ODID_Track *track = &table->Tracks[index];
+    if (track->Newer != ODID_TRACK_NONE)
+        table->Tracks[track->Newer].Older = track->Older;
+    else
+        table->Newest = track->Older;
+    if (track->Older != ODID_TRACK_NONE)
+        table->Tracks[track->Older].Newer = track->Newer;
+    else
+        table->Oldest = track->Newer;
+}
+
+static void linkTrackNewest(ODID_Track_table *table, uint32_t index)
+{
+    ODID_Track *track = &table->Tracks[index];
+    track->Newer = ODID_TRACK_NONE;
+    track->Older = table->Newest;
+    if (table->Newest != ODID_TRACK_NONE)
+        table->Tracks[table->Newest].Newer = index;
+    else
+        table->Oldest = index;
+    table->Newest = index;
+}
+
+// Remove a slot from the index, shifting back later entries of its probe run
+static void removeSlot(ODID_Track_table *table, uint32_t hole)
+{
+    uint32_t mask = table->SlotMask;
+    uint32_t i = (hole + 1) & mask;
+    while (table->Slots[i].Track != ODID_TRACK_NONE) {
+        uint32_t home = table->Slots[i].Hash & mask;
+        // Move the entry unless its home lies cyclically in (hole, i]
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            table->Slots[hole] = table->Slots[i];
+            hole = i;
+        }
+        i = (i + 1) & mask;
+    }
+    table->Slots[hole].Track = ODID_TRACK_NONE;
+}
+
+/**
+* Find the track of a UAS
+*
+* @param table  The track table
+* @param key    The key of the track
+* @return       The track or NULL if there is none for the key
+*/
+ODID_Track *odid_track_find(const ODID_Track_table *table, const ODID_Track_key *key)
+{
+    if (!table || !key)
+        return NULL;
+    uint32_t slot = trackSlot(table, key, trackHash(key));
+    uint32_t index = table->Slots[slot].Track;
+    return index == ODID_TRACK_NONE ? NULL : &table->Tracks[index];
+}
+
+/**
+* Find or create the track of a UAS and mark it as seen
+*
+* A new track has all its data initialized with odid_initUasData() and its
+* message timestamps cleared. If the table is full, the least recently seen
+* track is evicted to make room.
+*
+* @param table  The track table
+* @param key    The key of the track
+* @param now    Current time. Must not be earlier than in previous calls
+* @return       The track or NULL on invalid arguments
+*/
+ODID_Track *odid_track_update(ODID_Track_table *table, const ODID_Track_key *key, uint64_t now)
+{
+    if (!table || !key)
+        return NULL;
+
+    uint32_t hash = trackHash(key);
+    uint32_t slot = trackSlot(table, key, hash);
+    uint32_t index = table->Slots[slot].Track;
+    if (index != ODID_TRACK_NONE) {
+        ODID_Track *track = &table->Tracks[index];
+        track->LastSeen = now;
+        if (table->Newest != index) {
+            unlinkTrack(table, index);
+            linkTrackNewest(table, index);
+        }
+        scheduleTimeout(table, index, ODID_TRACK_TIMER_LOST, now);
+        return track;
+    }
+
+    if (table->Free == ODID_TRACK_NONE) {
+        odid_track_remove(table, &table->Tracks[table->Oldest]);
+        table->Evictions++;
+        // The removal may have shifted the free index slot back
+        slot = trackSlot(table, key, hash);
+    }
+    index = table->Free;
+    ODID_Track *track = &table->Tracks[index];
+    table->Free = track->Older;
+
+    track->Key = *key;
+    track->Hash = hash;
+    track->FirstSeen = now;
+    track->LastSeen = now;
+    odid_initUasData(&track->Data);
+    odid_initUasTimestamps(&track->Timestamps);
+    track->Changed = 0;
+    odid_initMessageMemo(odid_track_memo(table, track));
+    linkTrackNewest(table, index);
+    table->Slots[slot].Hash = hash;
+    table->Slots[slot].Track = index;
+    table->Count++;
+    scheduleTimeout(table, index, ODID_TRACK_TIMER_LOST, now);
+    return track;
+}
+
+/**
+* Remove a track from the table
+*
+* @param table  The track table
+* @param track  The track, as returned by odid_track_find() or odid_track_update()
+*/
+void odid_track_remove(ODID_Track_table *table, ODID_Track *track)
+{
+    if (!table || !track)
+        return;
+    uint32_t index = (uint32_t) (track - table->Tracks);
+    uint32_t slot = trackSlot(table, &track->Key, track->Hash);
+    if (index >= table->Capacity || table->Slots[slot].Track != index)
+        return;
+
+    removeSlot(table, slot);
+    unlinkTrack(table, index);
+    if (table->Timeouts) {
+        for (int i = 0; i < ODID_TRACK_TIMERS; i++)
+            odid_timer_cancel(&table->Timeouts->Wheel, index * ODID_TRACK_TIMERS + i);
+    }
+    if (table->Spatial) {
+        for (int i = 0; i < ODID_TRACK_POSITIONS; i++)
+            odid_spatial_remove(table->Spatial, index * ODID_TRACK_POSITIONS + i);
+    }
+    track->Older = table->Free;
+    table->Free = index;
+    table->Count--;
+}
+
+/**
+* Remove all tracks that have not been seen for longer than maxAge
+*
+* @param table  The track table
+* @param now    Current time
+* @param maxAge Maximum time since a track was last seen
+* @return       Number of removed tracks
+*/
+uint32_t odid_track_expire(ODID_Track_table *table, uint64_t now, uint64_t maxAge)
+{
+    if (!table)
+        return 0;
+    uint32_t removed = 0;
+    while (table->Oldest != ODID_TRACK_NONE) {
+        ODID_Track *track = &table->Tracks[table->Oldest];
+        if (now - track->LastSeen <= maxAge)
+            break;
+        odid_track_remove(table, track);
+        removed++;
+    }
+    return removed;
+}
+
+/**
+* Decode a received message into the track of the UAS that sent it
+*
+* The track is created if it doesn't exist yet and marked as seen. The data
+* of the message is merged into the data of the track by odid_decode_merge(),
+* which records now as the receive time of the message and adds the fields
+* that changed to the Changed bits of the track. With memos enabled, see
+* odid_track_enable_memo(), unchanged messages are not decoded again.
+*
+* @param table      The track table
+* @param key        The key of the track, e.g. the source MAC address
+* @param now        Time of reception
+* @param msgData    A full encoded message or message pack
+* @return           The message type as returned by decodeOpenDroneID()
+*/
+ODID_messagetype_t odid_track_decode(ODID_Track_table *table, const ODID_Track_key *key,
+                                     uint64_t now, const uint8_t *msgData)
+{
+    if (!msgData)
+        return ODID_MESSAGETYPE_INVALID;
+    ODID_Track *track = odid_track_update(table, key, now);
+    if (!track)
+        return ODID_MESSAGETYPE_INVALID;
+    return odid_track_merge(table, track, now, msgData);
+}
+
+// Check whether a message type was received at the given time
+static int receivedAt(const ODID_UAS_Timestamps *timestamps, int type, uint64_t now)
+{
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID:
+        for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+            if (timestamps->BasicID[i] == now)
+                return 1;
+        }
+        return 0;
+    case ODID_MESSAGETYPE_LOCATION: return timestamps->Location == now;
+    case ODID_MESSAGETYPE_AUTH:
+        for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+            if (timestamps->Auth[i] == now)
+                return 1;
+        }
+        return 0;
+    case ODID_MESSAGETYPE_SELF_ID: return timestamps->SelfID == now;
+    case ODID_MESSAGETYPE_SYSTEM: return timestamps->System == now;
+    case ODID_MESSAGETYPE_OPERATOR_ID: return timestamps->OperatorID == now;
+    default: return 0;
+    }
+}
+
+// Latitude and longitude 0 mean that the position is unknown
+static void indexPosition(ODID_Spatial_index *index, uint32_t id, double latitude, double longitude)
+{
+    if (latitude == 0 && longitude == 0)
+        odid_spatial_remove(index, id);
+    else
+        odid_spatial_update(index, id, latitude, longitude);
+}
+
+/**
+* Decode a received message into a track, as returned by odid_track_update()
+*
+* See odid_track_decode(). With timeouts enabled, the stale timers of the
+* received message types are restarted. With a spatial index, the received
+* UAS and operator positions are indexed.
+*
+* @param table      The track table
+* @param track      The track of the UAS that sent the message
+* @param now        Time of reception, as given to odid_track_update()
+* @param msgData    A full encoded message or message pack
+* @return           The message type as returned by decodeOpenDroneID()
+*/
+ODID_messagetype_t odid_track_merge(ODID_Track_table *table, ODID_Track *track,
+                                    uint64_t now, const uint8_t *msgData)
+{
+    if (!table || !track || !msgData)
+        return ODID_MESSAGETYPE_INVALID;
+    ODID_messagetype_t type = odid_decode_merge(&track->Data, &track->Timestamps, now, msgData,
+                                                &track->Changed, odid_track_memo(table, track));
+    if (type == ODID_MESSAGETYPE_INVALID)
+        return type;
+
+    uint32_t index = (uint32_t) (track - table->Tracks);
+    if (table->Timeouts) {
+        for (int i = 0; i <= ODID_MESSAGETYPE_OPERATOR_ID; i++) {
+            if (table->Timeouts->Stale[i] && receivedAt(&track->Timestamps, i, now))
+                scheduleTimeout(table, index, ODID_TRACK_TIMER_STALE + i, now);
+        }
+    }
+    if (table->Spatial) {
+        if (track->Timestamps.Location == now)
+            indexPosition(table->Spatial, index * ODID_TRACK_POSITIONS + ODID_TRACK_POSITION_UAS,
+                          track->Data.Location.Latitude, track->Data.Location.Longitude);
+        if (track->Timestamps.System == now)
+            indexPosition(table->Spatial, index * ODID_TRACK_POSITIONS + ODID_TRACK_POSITION_OPERATOR,
+                          track->Data.System.OperatorLatitude, track->Data.System.OperatorLongitude);
+    }
+    return type;
+}
+
+static void trackTimeout(ODID_Timer_wheel *wheel, uint32_t timer, void *context)
+{
+    (void) wheel;
+    ODID_Track_table *table = (ODID_Track_table *) context;
+    ODID_Track_timeouts *timeouts = table->Timeouts;
+    ODID_Track *track = &table->Tracks[timer / ODID_TRACK_TIMERS];
+    int kind = (int) (timer % ODID_TRACK_TIMERS);
+
+    if (kind == ODID_TRACK_TIMER_LOST) {
+        if (timeouts->Callback)
+            timeouts->Callback(table, track, ODID_MESSAGETYPE_INVALID, timeouts->Context);
+        odid_track_remove(table, track);
+    } else if (timeouts->Callback) {
+        timeouts->Callback(table, track, (ODID_messagetype_t) (kind - ODID_TRACK_TIMER_STALE),
+                           timeouts->Context);
+    }
+}
+
+/**
+* Fire the timeouts of the tracks that expired, see odid_track_enable_timeouts()
+*
+* For each message type that was not received for longer than its Stale
+* timeout, the callback is called once. For each track that was not seen for
+* longer than the Lost timeout, the callback is called and the track is
+* removed. The callback may remove tracks itself.
+*
+* @param table  The track table
+* @param now    Current time. Must not be earlier than in previous calls
+* @return       Number of expired timeouts
+*/
+uint32_t odid_track_advance(ODID_Track_table *table, uint64_t now)
+{
+    if (!table || !table->Timeouts)
+        return 0;
+    return odid_timer_wheel_advance(&table->Timeouts->Wheel, now, trackTimeout, table);
+}
@@ -38,11 +38,17 @@ int clock_gettime(clockid_t, struct timespec *);
 #endif
 #define cpu_to_le16(x)  (x)
 #define cpu_to_le64(x)  (x)
+#define le16_to_cpu(x)  (x)
+#define be16_to_cpu(x)  cpu_to_be16(x)
+#define be32_to_cpu(x)  cpu_to_be32(x)
 #else
 #define cpu_to_be16(x)      (x)
 #define cpu_to_be32(x)      (x)
 #define cpu_to_le16(x)      (bswap_16(x))
 #define cpu_to_le64(x)      (bswap_64(x))
+#define le16_to_cpu(x)      (bswap_16(x))
+#define be16_to_cpu(x)      (x)
+#define be32_to_cpu(x)      (x)
 #endif
 
 #define IEEE80211_FCTL_FTYPE          0x000c
@@ -74,6 +80,13 @@ int clock_gettime(clockid_t, struct timespec *);
 #define IEEE80211_ELEMID_RATES		0x01
 #define IEEE80211_ELEMID_VENDOR		0xDD
 
+/* NAN attribute IDs and service descriptor service control bits */
+#define NAN_ATTRIBUTE_SERVICE_DESCRIPTOR        0x03
+#define NAN_SERVICE_CONTROL_MATCHING_FILTER     0x04
+#define NAN_SERVICE_CONTROL_RESPONSE_FILTER     0x08
+#define NAN_SERVICE_CONTROL_SERVICE_INFO        0x10
+#define NAN_SERVICE_CONTROL_BINDING_BITMAP      0x40
+
 /* Neighbor Awareness Networking Specification v3.1 in section 2.8.2
  * The NAN Cluster ID is a MAC address that takes a value from
  * 50-6F-9A-01-00-00 to 50-6F-9A-01-FF-FF and is carried in the A3 field of
@@ -109,19 +122,15 @@ static int buf_fill_ieee80211_mgmt(uint8_t *buf, size_t *len, size_t buf_size,
     return 0;
 }
 
-static int buf_fill_ieee80211_beacon(uint8_t *buf, size_t *len, size_t buf_size, uint16_t interval_tu)
+static uint64_t wifi_timestamp_us(void)
 {
-    if (*len + sizeof(struct ieee80211_beacon) > buf_size)
-        return -ENOMEM;
-
-    struct ieee80211_beacon *beacon = (struct ieee80211_beacon *)(buf + *len);
-    struct timespec ts;
     uint64_t mono_us = 0;
-
 #if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
     mono_us = (uint64_t)((double) ts.tv_sec * 1e6 + (double) ts.tv_nsec * 1e-3);
 #elif defined(CLOCK_REALTIME)
+    struct timespec ts;
     clock_gettime(CLOCK_REALTIME, &ts);
     mono_us = (uint64_t)((double) ts.tv_sec * 1e6 + (double) ts.tv_nsec * 1e-3);
 #elif defined(ARDUINO)
@@ -130,7 +139,16 @@ static int buf_fill_ieee80211_beacon(uint8_t *buf, size_t *len, size_t buf_size,
 #else
 #warning "Unable to set wifi timestamp."
 #endif
-    beacon->timestamp = cpu_to_le64(mono_us);
+    return mono_us;
+}
+
+static int buf_fill_ieee80211_beacon(uint8_t *buf, size_t *len, size_t buf_size, uint16_t interval_tu)
+{
+    if (*len + sizeof(struct ieee80211_beacon) > buf_size)
+        return -ENOMEM;
+
+    struct ieee80211_beacon *beacon = (struct ieee80211_beacon *)(buf + *len);
+    beacon->timestamp = cpu_to_le64(wifi_timestamp_us());
     beacon->beacon_interval = cpu_to_le16(interval_tu);
     beacon->capability = cpu_to_le16(IEEE80211_CAPINFO_SHORT_SLOTTIME | IEEE80211_CAPINFO_SHORT_PREAMBLE);
     *len += sizeof(*beacon);
@@ -217,76 +235,229 @@ void drone_export_gps_data(const ODID_UAS_Data *UAS_Data, char *buf, size_t buf_
     mprintf("\t}\n}");
 }
 
-int odid_message_build_pack(const ODID_UAS_Data *UAS_Data, void *pack, size_t buflen)
+/* Encodes a message straight into the next slot of the pack in the caller's
+ * buffer. Data that fails to encode is left out, without using the slot. */
+static int pack_add_message(ODID_MessagePack_encoded *pack, size_t buflen, int *count,
+                            ODID_messagetype_t type, const void *data)
 {
-    ODID_MessagePack_data msg_pack;
-    ODID_MessagePack_encoded *msg_pack_enc;
-    size_t len;
+    ODID_Message_encoded scratch;
+    ODID_Message_encoded *msg = &scratch;
+    int ret = ODID_FAIL;
 
-    /* create a complete message pack */
-    msg_pack.SingleMessageSize = ODID_MESSAGE_SIZE;
-    msg_pack.MsgPackSize = 0;
-    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
-        if (UAS_Data->BasicIDValid[i]) {
-            if (msg_pack.MsgPackSize >= ODID_PACK_MAX_MESSAGES)
-                return -EINVAL;
-            if (encodeBasicIDMessage((void *)&msg_pack.Messages[msg_pack.MsgPackSize], &UAS_Data->BasicID[i]) == ODID_SUCCESS)
-                msg_pack.MsgPackSize++;
-        }
+    if (*count >= ODID_PACK_MAX_MESSAGES)
+        return -EINVAL;
+
+    /* without room for the slot, encode anyway to know if it would be used */
+    if (offsetof(ODID_MessagePack_encoded, Messages) + (size_t) (*count + 1) * ODID_MESSAGE_SIZE <= buflen)
+        msg = &pack->Messages[*count];
+
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID:
+        ret = encodeBasicIDMessage(&msg->basicId, data);
+        break;
+    case ODID_MESSAGETYPE_LOCATION:
+        ret = encodeLocationMessage(&msg->location, data);
+        break;
+    case ODID_MESSAGETYPE_AUTH:
+        ret = encodeAuthMessage(&msg->auth, data);
+        break;
+    case ODID_MESSAGETYPE_SELF_ID:
+        ret = encodeSelfIDMessage(&msg->selfId, data);
+        break;
+    case ODID_MESSAGETYPE_SYSTEM:
+        ret = encodeSystemMessage(&msg->system, data);
+        break;
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+        ret = encodeOperatorIDMessage(&msg->operatorId, data);
+        break;
+    default:
+        break;
     }
-    if (UAS_Data->LocationValid) {
-        if (msg_pack.MsgPackSize >= ODID_PACK_MAX_MESSAGES)
-            return -EINVAL;
-        if (encodeLocationMessage((void *)&msg_pack.Messages[msg_pack.MsgPackSize], &UAS_Data->Location) == ODID_SUCCESS)
-            msg_pack.MsgPackSize++;
+    if (ret != ODID_SUCCESS)
+        return 0;
+    if (msg == &scratch)
+        return -ENOMEM;
+    (*count)++;
+    return 0;
+}
+
+int odid_message_build_pack(const ODID_UAS_Data *UAS_Data, void *pack, size_t buflen)
+{
+    ODID_MessagePack_encoded *msg_pack_enc = (ODID_MessagePack_encoded *) pack;
+    int count = 0;
+    int ret = 0;
+
+    /* The message types are added in a fixed order, and at most
+     * ODID_BASIC_ID_MAX_MESSAGES Basic ID and ODID_AUTH_MAX_PAGES Auth
+     * messages, so only the total needs to be checked for a valid pack. */
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES && ret == 0; i++) {
+        if (UAS_Data->BasicIDValid[i])
+            ret = pack_add_message(msg_pack_enc, buflen, &count, ODID_MESSAGETYPE_BASIC_ID,
+                                   &UAS_Data->BasicID[i]);
     }
-    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++)
-    {
-        if (UAS_Data->AuthValid[i]) {
-            if (msg_pack.MsgPackSize >= ODID_PACK_MAX_MESSAGES)
-                return -EINVAL;
-            if (encodeAuthMessage((void *)&msg_pack.Messages[msg_pack.MsgPackSize], &UAS_Data->Auth[i]) == ODID_SUCCESS)
-                msg_pack.MsgPackSize++;
-        }
+    if (UAS_Data->LocationValid && ret == 0)
+        ret = pack_add_message(msg_pack_enc, buflen, &count, ODID_MESSAGETYPE_LOCATION,
+                               &UAS_Data->Location);
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES && ret == 0; i++) {
+        if (UAS_Data->AuthValid[i])
+            ret = pack_add_message(msg_pack_enc, buflen, &count, ODID_MESSAGETYPE_AUTH,
+                                   &UAS_Data->Auth[i]);
     }
-    if (UAS_Data->SelfIDValid) {
-        if (msg_pack.MsgPackSize >= ODID_PACK_MAX_MESSAGES)
-            return -EINVAL;
-        if (encodeSelfIDMessage((void *)&msg_pack.Messages[msg_pack.MsgPackSize], &UAS_Data->SelfID) == ODID_SUCCESS)
-            msg_pack.MsgPackSize++;
+    if (UAS_Data->SelfIDValid && ret == 0)
+        ret = pack_add_message(msg_pack_enc, buflen, &count, ODID_MESSAGETYPE_SELF_ID,
+                               &UAS_Data->SelfID);
+    if (UAS_Data->SystemValid && ret == 0)
+        ret = pack_add_message(msg_pack_enc, buflen, &count, ODID_MESSAGETYPE_SYSTEM,
+                               &UAS_Data->System);
+    if (UAS_Data->OperatorIDValid && ret == 0)
+        ret = pack_add_message(msg_pack_enc, buflen, &count, ODID_MESSAGETYPE_OPERATOR_ID,
+                               &UAS_Data->OperatorID);
+    if (ret < 0)
+        return ret;
+
+    /* check that there is at least one message to send. */
+    if (count == 0)
+        return -EINVAL;
+
+    /* the header is written last, once the messages are in place */
+    msg_pack_enc->MessageType = ODID_MESSAGETYPE_PACKED;
+    msg_pack_enc->ProtoVersion = ODID_PROTOCOL_VERSION;
+    msg_pack_enc->SingleMessageSize = ODID_MESSAGE_SIZE;
+    msg_pack_enc->MsgPackSize = (uint8_t) count;
+
+    return (int) (offsetof(ODID_MessagePack_encoded, Messages) + (size_t) count * ODID_MESSAGE_SIZE);
+}
+
+#define ENCODER_SLOT_EMPTY      0
+#define ENCODER_SLOT_ENCODED    1
+#define ENCODER_SLOT_FAILED     (-1)
+
+void odid_encoder_init(ODID_Encoder_context *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+/* Encodes the message of a slot, unless its data is unchanged since it was
+ * last encoded. Returns the encoded message, or NULL if the data is invalid. */
+static const ODID_Message_encoded *encoder_update_slot(ODID_Encoder_context *ctx, int slot,
+                                                       ODID_messagetype_t type, const void *data,
+                                                       void *cached, size_t size)
+{
+    ODID_Message_encoded *msg = &ctx->encoded[slot];
+    int ret = ODID_FAIL;
+
+    if (ctx->state[slot] != ENCODER_SLOT_EMPTY && memcmp(cached, data, size) == 0) {
+        ctx->hits++;
+        return ctx->state[slot] == ENCODER_SLOT_ENCODED ? msg : NULL;
     }
-    if (UAS_Data->SystemValid) {
-        if (msg_pack.MsgPackSize >= ODID_PACK_MAX_MESSAGES)
-            return -EINVAL;
-        if (encodeSystemMessage((void *)&msg_pack.Messages[msg_pack.MsgPackSize], &UAS_Data->System) == ODID_SUCCESS)
-            msg_pack.MsgPackSize++;
+
+    memcpy(cached, data, size);
+    switch (type) {
+    case ODID_MESSAGETYPE_BASIC_ID:
+        ret = encodeBasicIDMessage(&msg->basicId, cached);
+        break;
+    case ODID_MESSAGETYPE_LOCATION:
+        ret = encodeLocationMessage(&msg->location, cached);
+        break;
+    case ODID_MESSAGETYPE_AUTH:
+        ret = encodeAuthMessage(&msg->auth, cached);
+        break;
+    case ODID_MESSAGETYPE_SELF_ID:
+        ret = encodeSelfIDMessage(&msg->selfId, cached);
+        break;
+    case ODID_MESSAGETYPE_SYSTEM:
+        ret = encodeSystemMessage(&msg->system, cached);
+        break;
+    case ODID_MESSAGETYPE_OPERATOR_ID:
+        ret = encodeOperatorIDMessage(&msg->operatorId, cached);
+        break;
+    default:
+        break;
     }
-    if (UAS_Data->OperatorIDValid) {
-        if (msg_pack.MsgPackSize >= ODID_PACK_MAX_MESSAGES)
-            return -EINVAL;
-        if (encodeOperatorIDMessage((void *)&msg_pack.Messages[msg_pack.MsgPackSize], &UAS_Data->OperatorID) == ODID_SUCCESS)
-            msg_pack.MsgPackSize++;
+    ctx->encodes++;
+    ctx->state[slot] = ret == ODID_SUCCESS ? ENCODER_SLOT_ENCODED : ENCODER_SLOT_FAILED;
+    return ret == ODID_SUCCESS ? msg : NULL;
+}
+
+/* Adds the message of a slot to the list of messages of the pack */
+static int encoder_add_slot(ODID_Encoder_context *ctx, const ODID_Message_encoded **msgs,
+                            int *count, int slot, ODID_messagetype_t type, const void *data,
+                            void *cached, size_t size)
+{
+    const ODID_Message_encoded *msg;
+
+    if (*count >= ODID_PACK_MAX_MESSAGES)
+        return -EINVAL;
+
+    msg = encoder_update_slot(ctx, slot, type, data, cached, size);
+    if (msg)
+        msgs[(*count)++] = msg;
+    return 0;
+}
+
+int odid_message_build_pack_cached(ODID_Encoder_context *ctx, const ODID_UAS_Data *UAS_Data,
+                                   void *pack, size_t buflen)
+{
+    const ODID_Message_encoded *msgs[ODID_PACK_MAX_MESSAGES];
+    ODID_MessagePack_encoded *msg_pack_enc;
+    ODID_UAS_Data *src = &ctx->source;
+    int count = 0;
+    int slot = 0;
+    int ret = 0;
+    size_t len;
+
+    /* collect the messages in the same order as odid_message_build_pack() */
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES && ret == 0; i++, slot++) {
+        if (UAS_Data->BasicIDValid[i])
+            ret = encoder_add_slot(ctx, msgs, &count, slot, ODID_MESSAGETYPE_BASIC_ID,
+                                   &UAS_Data->BasicID[i], &src->BasicID[i], sizeof(src->BasicID[i]));
+    }
+    if (UAS_Data->LocationValid && ret == 0)
+        ret = encoder_add_slot(ctx, msgs, &count, slot, ODID_MESSAGETYPE_LOCATION,
+                               &UAS_Data->Location, &src->Location, sizeof(src->Location));
+    slot++;
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES && ret == 0; i++, slot++) {
+        if (UAS_Data->AuthValid[i])
+            ret = encoder_add_slot(ctx, msgs, &count, slot, ODID_MESSAGETYPE_AUTH,
+                                   &UAS_Data->Auth[i], &src->Auth[i], sizeof(src->Auth[i]));
     }
+    if (UAS_Data->SelfIDValid && ret == 0)
+        ret = encoder_add_slot(ctx, msgs, &count, slot, ODID_MESSAGETYPE_SELF_ID,
+                               &UAS_Data->SelfID, &src->SelfID, sizeof(src->SelfID));
+    slot++;
+    if (UAS_Data->SystemValid && ret == 0)
+        ret = encoder_add_slot(ctx, msgs, &count, slot, ODID_MESSAGETYPE_SYSTEM,
+                               &UAS_Data->System, &src->System, sizeof(src->System));
+    slot++;
+    if (UAS_Data->OperatorIDValid && ret == 0)
+        ret = encoder_add_slot(ctx, msgs, &count, slot, ODID_MESSAGETYPE_OPERATOR_ID,
+                               &UAS_Data->OperatorID, &src->OperatorID, sizeof(src->OperatorID));
+    if (ret < 0)
+        return ret;
 
     /* check that there is at least one message to send. */
-    if (msg_pack.MsgPackSize == 0)
+    if (count == 0)
         return -EINVAL;
 
     /* calculate the exact encoded message pack size. */
-    len = sizeof(*msg_pack_enc) - (ODID_PACK_MAX_MESSAGES - msg_pack.MsgPackSize) * ODID_MESSAGE_SIZE;
+    len = sizeof(*msg_pack_enc) - (ODID_PACK_MAX_MESSAGES - count) * ODID_MESSAGE_SIZE;
 
     /* check if there is enough space for the message pack. */
     if (len > buflen)
         return -ENOMEM;
 
     msg_pack_enc = (ODID_MessagePack_encoded *) pack;
-    if (encodeMessagePack(msg_pack_enc, &msg_pack) != ODID_SUCCESS)
-        return -1;
+    msg_pack_enc->MessageType = ODID_MESSAGETYPE_PACKED;
+    msg_pack_enc->ProtoVersion = ODID_PROTOCOL_VERSION;
+    msg_pack_enc->SingleMessageSize = ODID_MESSAGE_SIZE;
+    msg_pack_enc->MsgPackSize = (uint8_t) count;
+    for (int i = 0; i < count; i++)
+        memcpy(&msg_pack_enc->Messages[i], msgs[i], ODID_MESSAGE_SIZE);
 
     return (int) len;
 }
 
-int odid_wifi_build_nan_sync_beacon_frame(const char *mac, uint8_t *buf, size_t buf_size)
+static int prepare_nan_sync_beacon_frame(ODID_Wifi_frame *frame, const char *mac, uint16_t interval_tu)
 {
     /* Broadcast address */
     uint8_t target_addr[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
@@ -298,6 +469,8 @@ int odid_wifi_build_nan_sync_beacon_frame(const char *mac, uint8_t *buf, size_t
     struct nan_master_indication_attribute *master_indication_attr;
     struct nan_cluster_attribute *cluster_attr;
     struct nan_service_id_list_attribute *nsila;
+    uint8_t *buf = frame->Buf;
+    size_t buf_size = frame->BufSize;
     int ret;
     size_t len = 0;
 
@@ -307,7 +480,8 @@ int odid_wifi_build_nan_sync_beacon_frame(const char *mac, uint8_t *buf, size_t
         return ret;
 
     /* Beacon */
-    ret = buf_fill_ieee80211_beacon(buf, &len, buf_size, 0x0200);
+    frame->TimestampOffset = (uint16_t) len;
+    ret = buf_fill_ieee80211_beacon(buf, &len, buf_size, interval_tu);
     if (ret <0)
         return ret;
 
@@ -366,12 +540,11 @@ int odid_wifi_build_nan_sync_beacon_frame(const char *mac, uint8_t *buf, size_t
     memcpy(nsila->service_id, service_id, sizeof(service_id));
     len += sizeof(*nsila);
 
-    return (int) len;
+    frame->PackOffset = (uint16_t) len;
+    return 0;
 }
 
-int odid_wifi_build_message_pack_nan_action_frame(const ODID_UAS_Data *UAS_Data, const char *mac,
-                                                  uint8_t send_counter,
-                                                  uint8_t *buf, size_t buf_size)
+static int prepare_nan_action_frame(ODID_Wifi_frame *frame, const char *mac)
 {
     /* Neighbor Awareness Networking Specification v3.0 in section 2.8.1
      * NAN Network ID calls for the destination mac to be 51-6F-9A-01-00-00 */
@@ -382,8 +555,9 @@ int odid_wifi_build_message_pack_nan_action_frame(const ODID_UAS_Data *UAS_Data,
     const uint8_t *cluster_id = get_nan_cluster_id();
     struct nan_service_discovery *nsd;
     struct nan_service_descriptor_attribute *nsda;
-    struct nan_service_descriptor_extension_attribute *nsdea;
     struct ODID_service_info *si;
+    uint8_t *buf = frame->Buf;
+    size_t buf_size = frame->BufSize;
     int ret;
     size_t len = 0;
 
@@ -404,10 +578,11 @@ int odid_wifi_build_message_pack_nan_action_frame(const ODID_UAS_Data *UAS_Data,
     nsd->oui_type = 0x13;               /* Identify Type and version of the NAN */
     len += sizeof(*nsd);
 
-    /* NAN Attribute for Service Descriptor header */
+    /* NAN Attribute for Service Descriptor header, lengths set per frame */
     if (len + sizeof(*nsda) > buf_size)
         return -ENOMEM;
 
+    frame->LengthOffset = (uint16_t) len;
     nsda = (struct nan_service_descriptor_attribute *)(buf + len);
     nsda->header.attribute_id = 0x3;    /* Service Descriptor Attribute type */
     memcpy(nsda->service_id, service_id, sizeof(service_id));
@@ -421,39 +596,17 @@ int odid_wifi_build_message_pack_nan_action_frame(const ODID_UAS_Data *UAS_Data,
     if (len + sizeof(*si) > buf_size)
         return -ENOMEM;
 
+    frame->CounterOffset = (uint16_t) len;
     si = (struct ODID_service_info *)(buf + len);
     memset(si, 0, sizeof(*si));
-    si->message_counter = send_counter;
     len += sizeof(*si);
 
-    ret = odid_message_build_pack(UAS_Data, buf + len, buf_size - len);
-    if (ret < 0)
-        return ret;
-    len += ret;
-
-    /* set the lengths according to the message pack lengths */
-    nsda->service_info_length = sizeof(*si) + ret;
-    nsda->header.length = cpu_to_le16(sizeof(*nsda) - sizeof(struct nan_attribute_header) + nsda->service_info_length);
-
-    /* NAN Attribute for Service Descriptor extension header */
-    if (len + sizeof(*nsdea) > buf_size)
-        return -ENOMEM;
-
-    nsdea = (struct nan_service_descriptor_extension_attribute *)(buf + len);
-    nsdea->header.attribute_id = 0xE;
-    nsdea->header.length = cpu_to_le16(0x0004);
-    nsdea->instance_id = 0x01;
-    nsdea->control = cpu_to_le16(0x0200);
-    nsdea->service_update_indicator = send_counter;
-    len += sizeof(*nsdea);
-
-    return (int) len;
+    frame->PackOffset = (uint16_t) len;
+    return 0;
 }
 
-int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, const char *mac,
-                                              const char *SSID, size_t SSID_len,
-                                              uint16_t interval_tu, uint8_t send_counter,
-                                              uint8_t *buf, size_t buf_size)
+static int prepare_beacon_frame(ODID_Wifi_frame *frame, const char *mac,
+                                const char *SSID, size_t SSID_len, uint16_t interval_tu)
 {
     /* Broadcast address */
     uint8_t target_addr[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
@@ -466,6 +619,8 @@ int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, con
     /* Message Pack */
     struct ODID_service_info *si;
 
+    uint8_t *buf = frame->Buf;
+    size_t buf_size = frame->BufSize;
     int ret;
     size_t len = 0;
 
@@ -475,6 +630,7 @@ int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, con
         return ret;
 
     /* Mandatory Beacon as of 802.11-2016 Part 11 */
+    frame->TimestampOffset = (uint16_t) len;
     ret = buf_fill_ieee80211_beacon(buf, &len, buf_size, interval_tu);
     if (ret <0)
         return ret;
@@ -505,9 +661,10 @@ int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, con
     if (len + sizeof(*vendor) > buf_size)
         return -ENOMEM;
 
+    frame->LengthOffset = (uint16_t) len;
     vendor = (struct ieee80211_vendor_specific *)(buf + len);
     vendor->element_id = IEEE80211_ELEMID_VENDOR;
-    vendor->length = 0x00;  // Length updated at end of function
+    vendor->length = 0x00;  // Length set per frame
     memcpy(vendor->oui, asd_stan_oui, sizeof(vendor->oui));
     vendor->oui_type = 0x0D;
     len += sizeof(*vendor);
@@ -516,22 +673,142 @@ int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, con
     if (len + sizeof(*si) > buf_size)
         return -ENOMEM;
 
+    frame->CounterOffset = (uint16_t) len;
     si = (struct ODID_service_info *)(buf + len);
     memset(si, 0, sizeof(*si));
-    si->message_counter = send_counter;
     len += sizeof(*si);
 
-    ret = odid_message_build_pack(UAS_Data, buf + len, buf_size - len);
+    frame->PackOffset = (uint16_t) len;
+    return 0;
+}
+
+int odid_wifi_prepare_frame(ODID_Wifi_frame *frame, uint8_t transport, const char *mac,
+                            const char *SSID, size_t SSID_len, uint16_t interval_tu,
+                            uint8_t *buf, size_t buf_size)
+{
+    if (!frame || !mac || !buf)
+        return -EINVAL;
+
+    /* the offsets of the fields are kept in 16 bits */
+    if (buf_size > UINT16_MAX)
+        buf_size = UINT16_MAX;
+
+    memset(frame, 0, sizeof(*frame));
+    frame->Buf = buf;
+    frame->BufSize = buf_size;
+    frame->Transport = transport;
+
+    switch (transport) {
+    case ODID_WIFI_NAN_ACTION:
+        return prepare_nan_action_frame(frame, mac);
+    case ODID_WIFI_NAN_SYNC:
+        return prepare_nan_sync_beacon_frame(frame, mac, interval_tu);
+    case ODID_WIFI_BEACON:
+        return prepare_beacon_frame(frame, mac, SSID, SSID_len, interval_tu);
+    default:
+        return -EINVAL;
+    }
+}
+
+int odid_wifi_build_prepared_frame(const ODID_Wifi_frame *frame, const ODID_UAS_Data *UAS_Data,
+                                   uint8_t send_counter)
+{
+    struct ieee80211_beacon *beacon;
+    struct nan_service_descriptor_attribute *nsda;
+    struct nan_service_descriptor_extension_attribute *nsdea;
+    struct ieee80211_vendor_specific *vendor;
+    struct ODID_service_info *si;
+    uint8_t *buf;
+    size_t len;
+    int ret;
+
+    if (!frame || !frame->Buf || frame->PackOffset == 0)
+        return -EINVAL;
+    buf = frame->Buf;
+    len = frame->PackOffset;
+
+    if (frame->TimestampOffset) {
+        beacon = (struct ieee80211_beacon *)(buf + frame->TimestampOffset);
+        beacon->timestamp = cpu_to_le64(wifi_timestamp_us());
+    }
+    if (frame->Transport == ODID_WIFI_NAN_SYNC)
+        return (int) len;
+
+    if (!UAS_Data)
+        return -EINVAL;
+    si = (struct ODID_service_info *)(buf + frame->CounterOffset);
+    si->message_counter = send_counter;
+
+    ret = odid_message_build_pack(UAS_Data, buf + len, frame->BufSize - len);
     if (ret < 0)
         return ret;
     len += ret;
 
     /* set the lengths according to the message pack lengths */
-    vendor->length = sizeof(vendor->oui) + sizeof(vendor->oui_type) + sizeof(*si) + ret;
+    if (frame->Transport == ODID_WIFI_BEACON) {
+        vendor = (struct ieee80211_vendor_specific *)(buf + frame->LengthOffset);
+        vendor->length = sizeof(vendor->oui) + sizeof(vendor->oui_type) + sizeof(*si) + ret;
+        return (int) len;
+    }
+
+    nsda = (struct nan_service_descriptor_attribute *)(buf + frame->LengthOffset);
+    nsda->service_info_length = sizeof(*si) + ret;
+    nsda->header.length = cpu_to_le16(sizeof(*nsda) - sizeof(struct nan_attribute_header) + nsda->service_info_length);
+
+    /* NAN Attribute for Service Descriptor extension header */
+    if (len + sizeof(*nsdea) > frame->BufSize)
+        return -ENOMEM;
+
+    nsdea = (struct nan_service_descriptor_extension_attribute *)(buf + len);
+    nsdea->header.attribute_id = 0xE;
+    nsdea->header.length = cpu_to_le16(0x0004);
+    nsdea->instance_id = 0x01;
+    nsdea->control = cpu_to_le16(0x0200);
+    nsdea->service_update_indicator = send_counter;
+    len += sizeof(*nsdea);
 
     return (int) len;
 }
 
+int odid_wifi_build_nan_sync_beacon_frame(const char *mac, uint8_t *buf, size_t buf_size)
+{
+    ODID_Wifi_frame frame;
+    int ret;
+
+    ret = odid_wifi_prepare_frame(&frame, ODID_WIFI_NAN_SYNC, mac, NULL, 0, 0x0200, buf, buf_size);
+    if (ret < 0)
+        return ret;
+    return (int) frame.PackOffset;
+}
+
+int odid_wifi_build_message_pack_nan_action_frame(const ODID_UAS_Data *UAS_Data, const char *mac,
+                                                  uint8_t send_counter,
+                                                  uint8_t *buf, size_t buf_size)
+{
+    ODID_Wifi_frame frame;
+    int ret;
+
+    ret = odid_wifi_prepare_frame(&frame, ODID_WIFI_NAN_ACTION, mac, NULL, 0, 0, buf, buf_size);
+    if (ret < 0)
+        return ret;
+    return odid_wifi_build_prepared_frame(&frame, UAS_Data, send_counter);
+}
+
+int odid_wifi_build_message_pack_beacon_frame(const ODID_UAS_Data *UAS_Data, const char *mac,
+                                              const char *SSID, size_t SSID_len,
+                                              uint16_t interval_tu, uint8_t send_counter,
+                                              uint8_t *buf, size_t buf_size)
+{
+    ODID_Wifi_frame frame;
+    int ret;
+
+    ret = odid_wifi_prepare_frame(&frame, ODID_WIFI_BEACON, mac, SSID, SSID_len, interval_tu,
+                                  buf, buf_size);
+    if (ret < 0)
+        return ret;
+    return odid_wifi_build_prepared_frame(&frame, UAS_Data, send_counter);
+}
+
 int odid_message_process_pack(ODID_UAS_Data *UAS_Data, const uint8_t *pack, size_t buflen)
 {
     const ODID_MessagePack_encoded *msg_pack_enc = (const ODID_MessagePack_encoded *) pack;
@@ -547,37 +824,40 @@ int odid_message_process_pack(ODID_UAS_Data *UAS_Data, const uint8_t *pack, size
     return (int) size;
 }
 
-int odid_wifi_receive_message_pack_nan_action_frame(ODID_UAS_Data *UAS_Data,
-                                                    char *mac, const uint8_t *buf, size_t buf_size)
+int odid_message_merge_pack(ODID_UAS_Data *UAS_Data, ODID_UAS_Timestamps *timestamps,
+                            uint64_t now, const uint8_t *pack, size_t buflen,
+                            uint32_t *changed, ODID_Message_memo *memo)
 {
-    struct ieee80211_mgmt *mgmt;
-    struct nan_service_discovery *nsd;
-    struct nan_service_descriptor_attribute *nsda;
-    struct nan_service_descriptor_extension_attribute *nsdea;
-    struct ODID_service_info *si;
-    uint8_t target_addr[6] = { 0x51, 0x6F, 0x9A, 0x01, 0x00, 0x00 };
+    const ODID_MessagePack_encoded *msg_pack_enc = (const ODID_MessagePack_encoded *) pack;
+    size_t size = sizeof(*msg_pack_enc) - ODID_MESSAGE_SIZE * (ODID_PACK_MAX_MESSAGES - msg_pack_enc->MsgPackSize);
+    if (size > buflen)
+        return -ENOMEM;
+
+    if (odid_decode_merge(UAS_Data, timestamps, now, pack, changed, memo) != ODID_MESSAGETYPE_PACKED)
+        return -1;
+
+    return (int) size;
+}
+
+int odid_wifi_nan_action_frame_attributes(ODID_Wifi_nan_attributes *attrs, const uint8_t *buf,
+                                          size_t buf_size, char *mac)
+{
+    const struct ieee80211_mgmt *mgmt = (const struct ieee80211_mgmt *) buf;
+    const struct nan_service_discovery *nsd;
     uint8_t wifi_alliance_oui[3] = { 0x50, 0x6F, 0x9A };
-    uint8_t service_id[6] = { 0x88, 0x69, 0x19, 0x9D, 0x92, 0x09 };
-    int ret;
-    size_t len = 0;
+
+    if (!attrs || !buf)
+        return -EINVAL;
 
     /* IEEE 802.11 Management Header */
-    if (len + sizeof(*mgmt) > buf_size)
+    if (sizeof(*mgmt) + sizeof(*nsd) > buf_size)
         return -EINVAL;
-    mgmt = (struct ieee80211_mgmt *)(buf + len);
     if ((mgmt->frame_control & cpu_to_le16(IEEE80211_FCTL_FTYPE | IEEE80211_FCTL_STYPE)) !=
         cpu_to_le16(IEEE80211_FTYPE_MGMT | IEEE80211_STYPE_ACTION))
         return -EINVAL;
-    if (memcmp(mgmt->da, target_addr, sizeof(mgmt->da)) != 0)
-        return -EINVAL;
-    memcpy(mac, mgmt->sa, sizeof(mgmt->sa));
-
-    len += sizeof(*mgmt);
 
     /* NAN Service Discovery header */
-    if (len + sizeof(*nsd) > buf_size)
-        return -EINVAL;
-    nsd = (struct nan_service_discovery *)(buf + len);
+    nsd = (const struct nan_service_discovery *)(buf + sizeof(*mgmt));
     if (nsd->category != 0x04)
         return -EINVAL;
     if (nsd->action_code != 0x09)
@@ -586,43 +866,284 @@ int odid_wifi_receive_message_pack_nan_action_frame(ODID_UAS_Data *UAS_Data,
         return -EINVAL;
     if (nsd->oui_type != 0x13)
         return -EINVAL;
-    len += sizeof(*nsd);
 
-    /* NAN Attribute for Service Descriptor header */
-    if (len + sizeof(*nsda) > buf_size)
-        return -EINVAL;
-    nsda = (struct nan_service_descriptor_attribute *)(buf + len);
-    if (nsda->header.attribute_id != 0x3)
+    if (mac)
+        memcpy(mac, mgmt->sa, sizeof(mgmt->sa));
+    attrs->Next = buf + sizeof(*mgmt) + sizeof(*nsd);
+    attrs->End = buf + buf_size;
+    return 0;
+}
+
+/* Returns the message pack in the service info of a NAN Service Descriptor
+ * attribute, 0 if it is not an ODID one, or < 0 if it is malformed. The
+ * optional fields in front of the service info are skipped as indicated by
+ * the service control.
+ */
+static int nan_sda_find_pack(const uint8_t *attr, size_t attr_len,
+                             const uint8_t **pack, uint8_t *send_counter)
+{
+    /* "org.opendroneid.remoteid" hash */
+    uint8_t service_id[6] = { 0x88, 0x69, 0x19, 0x9D, 0x92, 0x09 };
+    const struct nan_service_descriptor_attribute *nsda = (const struct nan_service_descriptor_attribute *) attr;
+    const ODID_MessagePack_encoded *msg_pack_enc;
+    const uint8_t *info;
+    size_t len = offsetof(struct nan_service_descriptor_attribute, service_info_length);
+    size_t info_len, pack_size;
+
+    if (len > attr_len)
         return -EINVAL;
     if (memcmp(nsda->service_id, service_id, sizeof(service_id)) != 0)
+        return 0;
+
+    if (nsda->service_control & NAN_SERVICE_CONTROL_BINDING_BITMAP)
+        len += 2;
+    if (nsda->service_control & NAN_SERVICE_CONTROL_MATCHING_FILTER) {
+        if (len >= attr_len)
+            return -EINVAL;
+        len += 1 + attr[len];
+    }
+    if (nsda->service_control & NAN_SERVICE_CONTROL_RESPONSE_FILTER) {
+        if (len >= attr_len)
+            return -EINVAL;
+        len += 1 + attr[len];
+    }
+    if (!(nsda->service_control & NAN_SERVICE_CONTROL_SERVICE_INFO))
+        return 0;
+    if (len >= attr_len)
         return -EINVAL;
-    if (nsda->instance_id != 0x01)
+    info_len = attr[len];
+    info = attr + len + 1;
+    if (len + 1 + info_len > attr_len)
         return -EINVAL;
-    if (nsda->service_control != 0x10)
+
+    /* Message pack, of which only the used messages are sent */
+    if (sizeof(struct ODID_service_info) + offsetof(ODID_MessagePack_encoded, Messages) > info_len)
+        return -EINVAL;
+    msg_pack_enc = (const ODID_MessagePack_encoded *)(info + sizeof(struct ODID_service_info));
+    if (msg_pack_enc->MsgPackSize > ODID_PACK_MAX_MESSAGES)
+        return -EINVAL;
+    pack_size = offsetof(ODID_MessagePack_encoded, Messages) + ODID_MESSAGE_SIZE * msg_pack_enc->MsgPackSize;
+    if (sizeof(struct ODID_service_info) + pack_size > info_len)
         return -EINVAL;
-    len += sizeof(*nsda);
 
-    si = (struct ODID_service_info *)(buf + len);
-    ret = odid_message_process_pack(UAS_Data, buf + len + sizeof(*si), buf_size - len - sizeof(*nsdea));
+    if (send_counter)
+        *send_counter = ((const struct ODID_service_info *) info)->message_counter;
+    *pack = (const uint8_t *) msg_pack_enc;
+    return (int) pack_size;
+}
+
+int odid_wifi_nan_next_message_pack(ODID_Wifi_nan_attributes *attrs, const uint8_t **descriptor,
+                                    const uint8_t **pack, uint8_t *send_counter)
+{
+    const struct nan_attribute_header *header;
+    const uint8_t *attr;
+    size_t attr_len;
+    int ret;
+
+    if (!attrs || !pack)
+        return -EINVAL;
+
+    while (attrs->End - attrs->Next >= (ptrdiff_t) sizeof(*header)) {
+        attr = attrs->Next;
+        header = (const struct nan_attribute_header *) attr;
+        attr_len = sizeof(*header) + le16_to_cpu(header->length);
+        if (attr_len > (size_t) (attrs->End - attr))
+            return -EINVAL;
+        attrs->Next = attr + attr_len;
+
+        if (header->attribute_id != NAN_ATTRIBUTE_SERVICE_DESCRIPTOR)
+            continue;
+        ret = nan_sda_find_pack(attr, attr_len, pack, send_counter);
+        if (ret == 0)
+            continue;
+        if (ret > 0 && descriptor)
+            *descriptor = attr;
+        return ret;
+    }
+
+    return 0;
+}
+
+int odid_wifi_receive_message_pack_nan_action_frame(ODID_UAS_Data *UAS_Data,
+                                                    char *mac, const uint8_t *buf, size_t buf_size)
+{
+    ODID_Wifi_nan_attributes attrs;
+    const uint8_t *pack;
+    int found = 0;
+    int ret;
+
+    ret = odid_wifi_nan_action_frame_attributes(&attrs, buf, buf_size, mac);
     if (ret < 0)
+        return ret;
+
+    odid_initUasData(UAS_Data);
+    while ((ret = odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, NULL)) > 0) {
+        if (decodeMessagePack(UAS_Data, (const ODID_MessagePack_encoded *) pack) != ODID_SUCCESS)
+            return -EINVAL;
+        found++;
+    }
+    if (ret < 0)
+        return ret;
+
+    return found ? 0 : -EINVAL;
+}
+
+int odid_wifi_track_message_pack_nan_action_frame(ODID_Track_table *table, uint64_t now,
+                                                  const uint8_t *buf, size_t buf_size,
+                                                  ODID_Track **track)
+{
+    ODID_Wifi_nan_attributes attrs;
+    const uint8_t *pack;
+    ODID_Track_key key;
+    ODID_Track *updated;
+    char mac[6];
+    int ret;
+
+    if (!table)
         return -EINVAL;
-    if (nsda->service_info_length != (sizeof(*si) + ret))
+
+    ret = odid_wifi_nan_action_frame_attributes(&attrs, buf, buf_size, mac);
+    if (ret < 0)
+        return ret;
+    ret = odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, NULL);
+    if (ret <= 0)
+        return ret < 0 ? ret : -EINVAL;
+
+    odid_track_key_mac(&key, (const uint8_t *) mac);
+    updated = odid_track_update(table, &key, now);
+    if (!updated)
         return -EINVAL;
-    if (nsda->header.length != (cpu_to_le16(sizeof(*nsda) - sizeof(struct nan_attribute_header) + nsda->service_info_length)))
+    if (track)
+        *track = updated;
+
+    do {
+        if (odid_track_merge(table, updated, now, pack) != ODID_MESSAGETYPE_PACKED)
+            return -EINVAL;
+    } while ((ret = odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, NULL)) > 0);
+
+    return ret < 0 ? ret : 0;
+}
+
+/* Returns the next information element of a management frame body in @ie and
+ * moves @pos past it. Returns 1 for an element, 0 at the end of the body, or
+ * < 0 if the element does not fit in the body.
+ */
+static int ie_next(const uint8_t **pos, const uint8_t *end, const uint8_t **ie)
+{
+    const uint8_t *p = *pos;
+
+    if (end - p < 2)
+        return 0;
+    if (p[1] > end - p - 2)
         return -EINVAL;
-    len += sizeof(*si) + ret;
+    *ie = p;
+    *pos = p + 2 + p[1];
+    return 1;
+}
 
-    /* NAN Attribute for Service Descriptor extension header */
-    if (len + sizeof(*nsdea) > buf_size)
-        return -ENOMEM;
-    nsdea = (struct nan_service_descriptor_extension_attribute *)(buf + len);
-    if (nsdea->header.attribute_id != 0xE)
+/* Checks the message pack in the ODID vendor specific element of a beacon
+ * frame and returns it, without decoding the messages
+ */
+static int beacon_ie_find_pack(const uint8_t *ie, const uint8_t **pack, uint8_t *send_counter)
+{
+    const struct ieee80211_vendor_specific *vendor = (const struct ieee80211_vendor_specific *) ie;
+    const struct ODID_service_info *si = (const struct ODID_service_info *)(ie + sizeof(*vendor));
+    const ODID_MessagePack_encoded *msg_pack_enc;
+    size_t len = vendor->length - sizeof(vendor->oui) - sizeof(vendor->oui_type);
+    size_t pack_size;
+
+    if (len < sizeof(*si) + offsetof(ODID_MessagePack_encoded, Messages))
         return -EINVAL;
-    if (nsdea->header.length != cpu_to_le16(0x0004))
+    msg_pack_enc = (const ODID_MessagePack_encoded *)(ie + sizeof(*vendor) + sizeof(*si));
+    if (msg_pack_enc->MsgPackSize > ODID_PACK_MAX_MESSAGES)
         return -EINVAL;
-    if (nsdea->instance_id != 0x01)
+    pack_size = offsetof(ODID_MessagePack_encoded, Messages) + ODID_MESSAGE_SIZE * msg_pack_enc->MsgPackSize;
+    if (sizeof(*si) + pack_size > len)
         return -EINVAL;
-    if (nsdea->control != cpu_to_le16(0x0200))
+
+    if (send_counter)
+        *send_counter = si->message_counter;
+    *pack = (const uint8_t *) msg_pack_enc;
+    return (int) pack_size;
+}
+
+/* Walks the information elements of a beacon frame once and returns the
+ * first vendor specific element of one of the @protocols, a bit mask of
+ * (1 << ODID_WIFI_PROTOCOL_*). Returns the protocol of the element, 0 if
+ * there is none, or < 0 if an element does not fit in the frame.
+ */
+static int beacon_find_rid_ie(const uint8_t *buf, size_t buf_size, unsigned protocols,
+                              const uint8_t **rid_ie)
+{
+    uint8_t asd_stan_oui[3] = { 0xFA, 0x0B, 0xBC };
+    uint8_t frdid_oui[3] = { 0x6A, 0x5C, 0x35 };
+    const uint8_t *pos, *end, *ie;
+    int ret;
+
+    /* Access points send many other elements, in any order */
+    pos = buf + sizeof(struct ieee80211_mgmt) + sizeof(struct ieee80211_beacon);
+    end = buf + buf_size;
+    while ((ret = ie_next(&pos, end, &ie)) > 0) {
+        const struct ieee80211_vendor_specific *vendor = (const struct ieee80211_vendor_specific *) ie;
+
+        if (vendor->element_id != IEEE80211_ELEMID_VENDOR ||
+            vendor->length < sizeof(vendor->oui) + sizeof(vendor->oui_type))
+            continue;
+
+        if ((protocols & (1 << ODID_WIFI_PROTOCOL_BEACON)) && vendor->oui_type == 0x0D &&
+            memcmp(vendor->oui, asd_stan_oui, sizeof(asd_stan_oui)) == 0) {
+            *rid_ie = ie;
+            return ODID_WIFI_PROTOCOL_BEACON;
+        }
+        if ((protocols & (1 << ODID_WIFI_PROTOCOL_FRDID)) && vendor->oui_type == 0x01 &&
+            memcmp(vendor->oui, frdid_oui, sizeof(frdid_oui)) == 0) {
+            *rid_ie = ie;
+            return ODID_WIFI_PROTOCOL_FRDID;
+        }
+    }
+
+    return ret;
+}
+
+int odid_wifi_find_message_pack_beacon_frame(const uint8_t *buf, size_t buf_size, char *mac,
+                                             const uint8_t **pack, uint8_t *send_counter)
+{
+    const struct ieee80211_mgmt *mgmt = (const struct ieee80211_mgmt *) buf;
+    const uint8_t *ie;
+    int ret;
+
+    if (!buf || !pack)
+        return -EINVAL;
+
+    /* IEEE 802.11 Management Header and mandatory Beacon fields */
+    if (sizeof(*mgmt) + sizeof(struct ieee80211_beacon) > buf_size)
+        return -EINVAL;
+    if ((mgmt->frame_control & cpu_to_le16(IEEE80211_FCTL_FTYPE | IEEE80211_FCTL_STYPE)) !=
+        cpu_to_le16(IEEE80211_FTYPE_MGMT | IEEE80211_STYPE_BEACON))
+        return -EINVAL;
+
+    ret = beacon_find_rid_ie(buf, buf_size, 1 << ODID_WIFI_PROTOCOL_BEACON, &ie);
+    if (ret <= 0)
+        return ret < 0 ? ret : -EINVAL;
+
+    ret = beacon_ie_find_pack(ie, pack, send_counter);
+    if (ret >= 0 && mac)
+        memcpy(mac, mgmt->sa, sizeof(mgmt->sa));
+    return ret;
+}
+
+int odid_wifi_receive_message_pack_beacon_frame(ODID_UAS_Data *UAS_Data,
+                                                char *mac, const uint8_t *buf, size_t buf_size)
+{
+    const uint8_t *pack;
+    int ret;
+
+    ret = odid_wifi_find_message_pack_beacon_frame(buf, buf_size, mac, &pack, NULL);
+    if (ret < 0)
+        return ret;
+
+    odid_initUasData(UAS_Data);
+    if (decodeMessagePack(UAS_Data, (const ODID_MessagePack_encoded *) pack) != ODID_SUCCESS)
         return -EINVAL;
 
     return 0;
@@ -726,7 +1247,7 @@ int frdid_build(const FRDID_UAS_Data* UAS_Data, uint8_t* buf, size_t buf_size) {
   p = append_tlv(p, limit, 0x01, 1, &version);
   if (UAS_Data->Identifier != NULL) {
     char identifier_value[30] = {0};
-    strncpy(identifier_value, UAS_Data->Identifier, sizeof(identifier_value));
+    memcpy(identifier_value, UAS_Data->Identifier, strnlen(UAS_Data->Identifier, sizeof(identifier_value)));
     p = append_tlv(p, limit, 0x02, 30, identifier_value);
   }
   if (UAS_Data->ANSICTA2063Identifier != NULL) {
@@ -770,3 +1291,213 @@ int frdid_build(const FRDID_UAS_Data* UAS_Data, uint8_t* buf, size_t buf_size) {
   }
   return p - buf;
 }
+
+/* read_tlv_string - copies a string value to out, which holds size + 1 bytes,
+ * and terminates it. Like frdid_build() clamps the identifiers it sends,
+ * longer values are truncated to size bytes.
+ */
+static void read_tlv_string(char* out, size_t size, const uint8_t* value, uint8_t length) {
+  if (out == NULL) {
+    return;
+  }
+  if (length > size) {
+    length = (uint8_t)size;
+  }
+  memcpy(out, value, length);
+  out[length] = '\0';
+}
+
+int frdid_decode(FRDID_UAS_Data* UAS_Data, char* identifier, char* ansi_cta_2063_identifier,
+                 const uint8_t* buf, size_t buf_size) {
+  const uint8_t* p = buf;
+  const uint8_t* limit = buf + buf_size;
+  int version = 0;
+
+  UAS_Data->Identifier = NULL;
+  UAS_Data->ANSICTA2063Identifier = NULL;
+  UAS_Data->Latitude = 0;
+  UAS_Data->Longitude = 0;
+  UAS_Data->Altitude = INV_ALT;
+  UAS_Data->Height = INV_ALT;
+  UAS_Data->TakeoffLatitude = 0;
+  UAS_Data->TakeoffLongitude = 0;
+  UAS_Data->HorizontalSpeed = INV_SPEED_H;
+  UAS_Data->TrueCourse = INV_DIR;
+
+  while (limit - p >= 2) {
+    uint8_t type = p[0];
+    uint8_t length = p[1];
+    const uint8_t* value = p + 2;
+    uint32_t u32;
+    uint16_t u16;
+    double degrees;
+
+    if (length > limit - value) {
+      return -EINVAL;
+    }
+    p = value + length;
+
+    switch (type) {
+      case 0x01:
+        if (length != 1) {
+          return -EINVAL;
+        }
+        version = value[0];
+        break;
+      case 0x02:
+        read_tlv_string(identifier, FRDID_ID_SIZE, value, length);
+        UAS_Data->Identifier = identifier;
+        break;
+      case 0x03:
+        read_tlv_string(ansi_cta_2063_identifier, ODID_ID_SIZE, value, length);
+        UAS_Data->ANSICTA2063Identifier = ansi_cta_2063_identifier;
+        break;
+      case 0x04:
+      case 0x05:
+      case 0x08:
+      case 0x09:
+        if (length != 4) {
+          return -EINVAL;
+        }
+        memcpy(&u32, value, sizeof(u32));
+        degrees = (int32_t)be32_to_cpu(u32) / 1e5;
+        if (type == 0x04) {
+          UAS_Data->Latitude = degrees;
+        } else if (type == 0x05) {
+          UAS_Data->Longitude = degrees;
+        } else if (type == 0x08) {
+          UAS_Data->TakeoffLatitude = degrees;
+        } else {
+          UAS_Data->TakeoffLongitude = degrees;
+        }
+        break;
+      case 0x06:
+      case 0x07:
+      case 0x0b:
+        if (length != 2) {
+          return -EINVAL;
+        }
+        memcpy(&u16, value, sizeof(u16));
+        if (type == 0x06) {
+          UAS_Data->Altitude = (int16_t)be16_to_cpu(u16);
+        } else if (type == 0x07) {
+          UAS_Data->Height = (int16_t)be16_to_cpu(u16);
+        } else {
+          UAS_Data->TrueCourse = (int16_t)be16_to_cpu(u16);
+        }
+        break;
+      case 0x0a:
+        if (length != 1) {
+          return -EINVAL;
+        }
+        UAS_Data->HorizontalSpeed = (int8_t)value[0];
+        break;
+      default:
+        /* Types of later versions are skipped */
+        break;
+    }
+  }
+
+  if (version != 1) {
+    return -EINVAL;
+  }
+  return p - buf;
+}
+
+/* Copies the decoded FRDID fields that have an ODID equivalent */
+static void frdid_to_uas_data(ODID_UAS_Data *UAS_Data, const FRDID_UAS_Data *frdid)
+{
+    odid_initUasData(UAS_Data);
+
+    if (frdid->ANSICTA2063Identifier) {
+        UAS_Data->BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+        strncpy(UAS_Data->BasicID[0].UASID, frdid->ANSICTA2063Identifier, ODID_ID_SIZE);
+        UAS_Data->BasicIDValid[0] = 1;
+    }
+    if (frdid->Latitude != 0 || frdid->Longitude != 0) {
+        UAS_Data->Location.Status = ODID_STATUS_AIRBORNE;
+        UAS_Data->Location.Latitude = frdid->Latitude;
+        UAS_Data->Location.Longitude = frdid->Longitude;
+        if (frdid->Altitude != INV_ALT)
+            UAS_Data->Location.AltitudeGeo = (float) frdid->Altitude;
+        if (frdid->Height != INV_ALT) {
+            UAS_Data->Location.HeightType = ODID_HEIGHT_REF_OVER_TAKEOFF;
+            UAS_Data->Location.Height = (float) frdid->Height;
+        }
+        if (frdid->HorizontalSpeed != INV_SPEED_H)
+            UAS_Data->Location.SpeedHorizontal = (float) frdid->HorizontalSpeed;
+        if (frdid->TrueCourse != INV_DIR)
+            UAS_Data->Location.Direction = (float) frdid->TrueCourse;
+        UAS_Data->LocationValid = 1;
+    }
+    if (frdid->TakeoffLatitude != 0 || frdid->TakeoffLongitude != 0) {
+        UAS_Data->System.OperatorLocationType = ODID_OPERATOR_LOCATION_TYPE_TAKEOFF;
+        UAS_Data->System.OperatorLatitude = frdid->TakeoffLatitude;
+        UAS_Data->System.OperatorLongitude = frdid->TakeoffLongitude;
+        UAS_Data->SystemValid = 1;
+    }
+}
+
+int odid_wifi_receive_frame(ODID_Wifi_received *rx, const uint8_t *buf, size_t buf_size)
+{
+    const struct ieee80211_mgmt *mgmt = (const struct ieee80211_mgmt *) buf;
+    const struct ieee80211_vendor_specific *vendor;
+    ODID_Wifi_nan_attributes attrs;
+    const uint8_t *ie, *pack;
+    uint16_t frame_control;
+    int protocol, ret;
+
+    if (!rx || !buf || buf_size < sizeof(*mgmt))
+        return -EINVAL;
+
+    rx->Protocol = ODID_WIFI_PROTOCOL_NONE;
+    memcpy(rx->Mac, mgmt->sa, sizeof(mgmt->sa));
+    rx->Counter = 0;
+
+    frame_control = mgmt->frame_control & cpu_to_le16(IEEE80211_FCTL_FTYPE | IEEE80211_FCTL_STYPE);
+    if (frame_control == cpu_to_le16(IEEE80211_FTYPE_MGMT | IEEE80211_STYPE_ACTION)) {
+        /* Other action frames are not remote ID frames */
+        if (odid_wifi_nan_action_frame_attributes(&attrs, buf, buf_size, NULL) < 0)
+            return ODID_WIFI_PROTOCOL_NONE;
+        ret = odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, &rx->Counter);
+        if (ret <= 0)
+            return ret;
+
+        odid_initUasData(&rx->UAS_Data);
+        do {
+            if (decodeMessagePack(&rx->UAS_Data, (const ODID_MessagePack_encoded *) pack) != ODID_SUCCESS)
+                return -EINVAL;
+        } while ((ret = odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, NULL)) > 0);
+        if (ret < 0)
+            return ret;
+        protocol = ODID_WIFI_PROTOCOL_NAN;
+    } else if (frame_control == cpu_to_le16(IEEE80211_FTYPE_MGMT | IEEE80211_STYPE_BEACON)) {
+        if (sizeof(*mgmt) + sizeof(struct ieee80211_beacon) > buf_size)
+            return -EINVAL;
+        protocol = beacon_find_rid_ie(buf, buf_size,
+                                      (1 << ODID_WIFI_PROTOCOL_BEACON) | (1 << ODID_WIFI_PROTOCOL_FRDID), &ie);
+        if (protocol <= 0)
+            return protocol;
+
+        if (protocol == ODID_WIFI_PROTOCOL_BEACON) {
+            ret = beacon_ie_find_pack(ie, &pack, &rx->Counter);
+            if (ret < 0)
+                return ret;
+            odid_initUasData(&rx->UAS_Data);
+            if (decodeMessagePack(&rx->UAS_Data, (const ODID_MessagePack_encoded *) pack) != ODID_SUCCESS)
+                return -EINVAL;
+        } else {
+            vendor = (const struct ieee80211_vendor_specific *) ie;
+            ret = frdid_decode(&rx->FRDID, rx->FRDIDIdentifier, rx->FRDIDANSICTA2063Identifier,
+                               ie + sizeof(*vendor), vendor->length - sizeof(vendor->oui) - sizeof(vendor->oui_type));
+            if (ret < 0)
+                return ret;
+            frdid_to_uas_data(&rx->UAS_Data, &rx->FRDID);
+        }
+    } else {
+        return ODID_WIFI_PROTOCOL_NONE;
+    }
+
+    rx->Protocol = (uint8_t) protocol;
+    return protocol;
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <random>
+
+/*
+ * Differential tests of the shift-and-mask codec (*Bytes functions) against
+ * the packed bitfield codec. Both must produce identical wire data and
+ * identical decoded structures.
+ */
+
+static const int ITERATIONS = 2000;
+
+template <typename T> static T randomEnum(std::mt19937 &gen, int max)
+{
+    return (T) std::uniform_int_distribution<int>(0, max)(gen);
+}
+
+static float randomFloat(std::mt19937 &gen, float min, float max)
+{
+    return std::uniform_real_distribution<float>(min, max)(gen);
+}
+
+static void randomString(std::mt19937 &gen, char *str, size_t size)
+{
+    std::uniform_int_distribution<int> len(0, (int) size - 1);
+    std::uniform_int_distribution<int> chr(' ', '~');
+    memset(str, 0, size);
+    int n = len(gen);
+    for (int i = 0; i < n; i++)
+        str[i] = (char) chr(gen);
+}
+
+#define EXPECT_SAME_ENCODING(encodeFn, encoded, data)                       \
+    do {                                                                    \
+        ODID_Message_encoded a, b;                                          \
+        memset(&a, 0xA5, sizeof(a));                                        \
+        memset(&b, 0xA5, sizeof(b));                                        \
+        int retA = encodeFn(&a.encoded, &data);                             \
+        int retB = encodeFn##Bytes(&b.encoded, &data);                      \
+        ASSERT_EQ(retA, retB);                                              \
+        ASSERT_EQ(memcmp(&a, &b, sizeof(a)), 0) << #encodeFn;               \
+    } while (0)
+
+TEST(ODID, codec_shift_mask_encode_matches_bitfields)
+{
+    std::mt19937 gen(1234);
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        ODID_BasicID_data basicId;
+        odid_initBasicIDData(&basicId);
+        basicId.IDType = randomEnum<ODID_idtype_t>(gen, 4);
+        basicId.UAType = randomEnum<ODID_uatype_t>(gen, 15);
+        randomString(gen, basicId.UASID, sizeof(basicId.UASID));
+        EXPECT_SAME_ENCODING(encodeBasicIDMessage, basicId, basicId);
+
+        ODID_Location_data location;
+        odid_initLocationData(&location);
+        location.Status = randomEnum<ODID_status_t>(gen, 15);
+        location.Direction = randomFloat(gen, 0, 361);
+        location.SpeedHorizontal = randomFloat(gen, 0, 260);
+        location.SpeedVertical = randomFloat(gen, -63, 64);
+        location.Latitude = randomFloat(gen, -90, 90);
+        location.Longitude = randomFloat(gen, -180, 180);
+        location.AltitudeBaro = randomFloat(gen, -1000, 31767);
+        location.AltitudeGeo = randomFloat(gen, -1000, 31767);
+        location.HeightType = randomEnum<ODID_Height_reference_t>(gen, 1);
+        location.Height = randomFloat(gen, -1000, 31767);
+        location.HorizAccuracy = randomEnum<ODID_Horizontal_accuracy_t>(gen, 15);
+        location.VertAccuracy = randomEnum<ODID_Vertical_accuracy_t>(gen, 15);
+        location.BaroAccuracy = randomEnum<ODID_Vertical_accuracy_t>(gen, 15);
+        location.SpeedAccuracy = randomEnum<ODID_Speed_accuracy_t>(gen, 15);
+        location.TSAccuracy = randomEnum<ODID_Timestamp_accuracy_t>(gen, 15);
+        location.TimeStamp = randomFloat(gen, 0, 3600);
+        EXPECT_SAME_ENCODING(encodeLocationMessage, location, location);
+
+        ODID_Auth_data auth;
+        odid_initAuthData(&auth);
+        auth.AuthType = randomEnum<ODID_authtype_t>(gen, 15);
+        auth.DataPage = (uint8_t) std::uniform_int_distribution<int>(0, 3)(gen);
+        auth.LastPageIndex = 3;
+        auth.Length = (uint8_t) std::uniform_int_distribution<int>(0, 86)(gen);
+        auth.Timestamp = gen();
+        for (auto &byte : auth.AuthData)
+            byte = (uint8_t) gen();
+        EXPECT_SAME_ENCODING(encodeAuthMessage, auth, auth);
+
+        ODID_SelfID_data selfId;
+        odid_initSelfIDData(&selfId);
+        selfId.DescType = randomEnum<ODID_desctype_t>(gen, 255);
+        randomString(gen, selfId.Desc, sizeof(selfId.Desc));
+        EXPECT_SAME_ENCODING(encodeSelfIDMessage, selfId, selfId);
+
+        ODID_System_data system;
+        odid_initSystemData(&system);
+        system.OperatorLocationType = randomEnum<ODID_operator_location_type_t>(gen, 3);
+        system.ClassificationType = randomEnum<ODID_classification_type_t>(gen, 7);
+        system.OperatorLatitude = randomFloat(gen, -90, 90);
+        system.OperatorLongitude = randomFloat(gen, -180, 180);
+        system.AreaCount = (uint16_t) gen();
+        system.AreaRadius = (uint16_t) std::uniform_int_distribution<int>(0, 2550)(gen);
+        system.AreaCeiling = randomFloat(gen, -1000, 31767);
+        system.AreaFloor = randomFloat(gen, -1000, 31767);
+        system.CategoryEU = randomEnum<ODID_category_EU_t>(gen, 15);
+        system.ClassEU = randomEnum<ODID_class_EU_t>(gen, 15);
+        system.OperatorAltitudeGeo = randomFloat(gen, -1000, 31767);
+        system.Timestamp = gen();
+        EXPECT_SAME_ENCODING(encodeSystemMessage, system, system);
+
+        ODID_OperatorID_data operatorId;
+        odid_initOperatorIDData(&operatorId);
+        operatorId.OperatorIdType = randomEnum<ODID_operatorIdType_t>(gen, 255);
+        randomString(gen, operatorId.OperatorId, sizeof(operatorId.OperatorId));
+        EXPECT_SAME_ENCODING(encodeOperatorIDMessage, operatorId, operatorId);
+    }
+}
+
+#define EXPECT_SAME_DECODING(decodeFn, dataType, encoded, msg)              \
+    do {                                                                    \
+        dataType a, b;                                                      \
+        memset(&a, 0, sizeof(a));                                           \
+        memset(&b, 0, sizeof(b));                                           \
+        int retA = decodeFn(&a, &msg.encoded);                              \
+        int retB = decodeFn##Bytes(&b, &msg.encoded);                       \
+        ASSERT_EQ(retA, retB) << #decodeFn;                                 \
+        ASSERT_EQ(memcmp(&a, &b, sizeof(a)), 0) << #decodeFn;               \
+    } while (0)
+
+TEST(ODID, codec_shift_mask_decode_matches_bitfields)
+{
+    std::mt19937 gen(5678);
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        ODID_Message_encoded msg;
+        for (auto &byte : msg.rawData)
+            byte = (uint8_t) gen();
+
+        // Mostly valid message types, with some mismatching ones
+        uint8_t type = (uint8_t) (i % 7);
+        msg.rawData[0] = (uint8_t) ((type << 4) | (msg.rawData[0] & 0x0F));
+
+        EXPECT_SAME_DECODING(decodeBasicIDMessage, ODID_BasicID_data, basicId, msg);
+        EXPECT_SAME_DECODING(decodeLocationMessage, ODID_Location_data, location, msg);
+        EXPECT_SAME_DECODING(decodeAuthMessage, ODID_Auth_data, auth, msg);
+        EXPECT_SAME_DECODING(decodeSelfIDMessage, ODID_SelfID_data, selfId, msg);
+        EXPECT_SAME_DECODING(decodeSystemMessage, ODID_System_data, system, msg);
+        EXPECT_SAME_DECODING(decodeOperatorIDMessage, ODID_OperatorID_data, operatorId, msg);
+    }
+}
+
+TEST(ODID, codec_shift_mask_wire_format)
+{
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Direction = 215;
+    location.SpeedHorizontal = 70;
+    location.SpeedVertical = -2.5f;
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    location.AltitudeBaro = 100;
+    location.AltitudeGeo = 110;
+    location.HeightType = ODID_HEIGHT_REF_OVER_GROUND;
+    location.Height = 80;
+    location.HorizAccuracy = ODID_HOR_ACC_10_METER;
+    location.VertAccuracy = ODID_VER_ACC_3_METER;
+    location.BaroAccuracy = ODID_VER_ACC_1_METER;
+    location.SpeedAccuracy = ODID_SPEED_ACC_1_METERS_PER_SECOND;
+    location.TSAccuracy = ODID_TIME_ACC_0_2_SECOND;
+    location.TimeStamp = 1234.5f;
+
+    const uint8_t expected[ODID_MESSAGE_SIZE] = {
+        0x12, 0x27, 0x23, 0x08, 0xFB,   // Header, flags, direction, speeds
+        0x58, 0x16, 0xAF, 0x1E,         // Latitude
+        0x38, 0xCD, 0xFF, 0xFF,         // Longitude
+        0x98, 0x08, 0xAC, 0x08, 0x70, 0x08, // Altitudes and height
+        0x5A, 0x63,                     // Accuracies
+        0x39, 0x30, 0x02, 0x00 };       // Timestamp and its accuracy
+
+    ODID_Location_encoded encoded;
+    ASSERT_EQ(encodeLocationMessageBytes(&encoded, &location), ODID_SUCCESS);
+    EXPECT_EQ(memcmp(&encoded, expected, sizeof(expected)), 0);
+    ASSERT_EQ(encodeLocationMessage(&encoded, &location), ODID_SUCCESS);
+    EXPECT_EQ(memcmp(&encoded, expected, sizeof(expected)), 0);
+}
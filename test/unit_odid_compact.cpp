@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <cstdio>
+#include <random>
+
+static void randomString(std::mt19937 &gen, char *str, size_t size)
+{
+    std::uniform_int_distribution<int> len(0, (int) size - 1);
+    std::uniform_int_distribution<int> chr(' ', '~');
+    int n = len(gen);
+    for (int i = 0; i < n; i++)
+        str[i] = (char) chr(gen);
+}
+
+// Random contents in all fields, including those of invalid messages
+static void buildRandomData(std::mt19937 &gen, ODID_UAS_Data *uas)
+{
+    std::uniform_real_distribution<float> real(-1000, 1000);
+    std::uniform_int_distribution<int> nibble(0, 15);
+    std::uniform_int_distribution<int> bit(0, 1);
+
+    // Zero the padding too, so that the structures can be compared with memcmp
+    memset(uas, 0, sizeof(*uas));
+    odid_initUasData(uas);
+    for (int i = 0; i < ODID_BASIC_ID_MAX_MESSAGES; i++) {
+        uas->BasicID[i].UAType = (ODID_uatype_t) nibble(gen);
+        uas->BasicID[i].IDType = (ODID_idtype_t) nibble(gen);
+        randomString(gen, uas->BasicID[i].UASID, sizeof(uas->BasicID[i].UASID));
+        uas->BasicIDValid[i] = (uint8_t) bit(gen);
+    }
+    uas->Location.Status = (ODID_status_t) nibble(gen);
+    uas->Location.Direction = real(gen);
+    uas->Location.SpeedHorizontal = real(gen);
+    uas->Location.SpeedVertical = real(gen);
+    uas->Location.Latitude = real(gen) / 11.0;
+    uas->Location.Longitude = real(gen) / 5.5;
+    uas->Location.AltitudeBaro = real(gen);
+    uas->Location.AltitudeGeo = real(gen);
+    uas->Location.HeightType = (ODID_Height_reference_t) bit(gen);
+    uas->Location.Height = real(gen);
+    uas->Location.HorizAccuracy = (ODID_Horizontal_accuracy_t) nibble(gen);
+    uas->Location.VertAccuracy = (ODID_Vertical_accuracy_t) nibble(gen);
+    uas->Location.BaroAccuracy = (ODID_Vertical_accuracy_t) nibble(gen);
+    uas->Location.SpeedAccuracy = (ODID_Speed_accuracy_t) nibble(gen);
+    uas->Location.TSAccuracy = (ODID_Timestamp_accuracy_t) nibble(gen);
+    uas->Location.TimeStamp = real(gen);
+    uas->LocationValid = (uint8_t) bit(gen);
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++) {
+        uas->AuthValid[i] = (uint8_t) bit(gen);
+        if (!uas->AuthValid[i])
+            continue;
+        uas->Auth[i].DataPage = (uint8_t) i;
+        uas->Auth[i].AuthType = (ODID_authtype_t) nibble(gen);
+        uas->Auth[i].LastPageIndex = (uint8_t) nibble(gen);
+        uas->Auth[i].Length = (uint8_t) gen();
+        uas->Auth[i].Timestamp = gen();
+        for (auto &byte : uas->Auth[i].AuthData)
+            byte = (uint8_t) gen();
+    }
+    uas->SelfID.DescType = (ODID_desctype_t) (uint8_t) gen();
+    randomString(gen, uas->SelfID.Desc, sizeof(uas->SelfID.Desc));
+    uas->SelfIDValid = (uint8_t) bit(gen);
+    uas->System.OperatorLocationType = (ODID_operator_location_type_t) nibble(gen);
+    uas->System.ClassificationType = (ODID_classification_type_t) nibble(gen);
+    uas->System.OperatorLatitude = real(gen) / 11.0;
+    uas->System.OperatorLongitude = real(gen) / 5.5;
+    uas->System.AreaCount = (uint16_t) gen();
+    uas->System.AreaRadius = (uint16_t) gen();
+    uas->System.AreaCeiling = real(gen);
+    uas->System.AreaFloor = real(gen);
+    uas->System.CategoryEU = (ODID_category_EU_t) nibble(gen);
+    uas->System.ClassEU = (ODID_class_EU_t) nibble(gen);
+    uas->System.OperatorAltitudeGeo = real(gen);
+    uas->System.Timestamp = gen();
+    uas->SystemValid = (uint8_t) bit(gen);
+    uas->OperatorID.OperatorIdType = (ODID_operatorIdType_t) (uint8_t) gen();
+    randomString(gen, uas->OperatorID.OperatorId, sizeof(uas->OperatorID.OperatorId));
+    uas->OperatorIDValid = (uint8_t) bit(gen);
+}
+
+TEST(ODID, compact_round_trip)
+{
+    std::mt19937 gen(2468);
+    ODID_Auth_block blocks[4];
+    ODID_Auth_pool pool;
+    odid_auth_pool_init(&pool, blocks, 4);
+
+    ODID_UAS_compact compact;
+    odid_compact_init(&compact);
+    for (int i = 0; i < 1000; i++) {
+        ODID_UAS_Data in, out;
+        buildRandomData(gen, &in);
+        memset(&out, 0, sizeof(out));
+        ASSERT_EQ(odid_uas_to_compact(&compact, &in, &pool), ODID_SUCCESS);
+        ASSERT_EQ(odid_compact_to_uas(&out, &compact, &pool), ODID_SUCCESS);
+        ASSERT_EQ(memcmp(&in, &out, sizeof(in)), 0) << "iteration " << i;
+    }
+
+    // The record uses at most one block, which is returned on release
+    odid_compact_release(&compact, &pool);
+    ODID_UAS_compact records[4];
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    uas.AuthValid[0] = 1;
+    for (auto &record : records) {
+        odid_compact_init(&record);
+        EXPECT_EQ(odid_uas_to_compact(&record, &uas, &pool), ODID_SUCCESS);
+    }
+    ODID_UAS_compact extra;
+    odid_compact_init(&extra);
+    EXPECT_EQ(odid_uas_to_compact(&extra, &uas, &pool), ODID_FAIL);
+    EXPECT_EQ(extra.AuthValid, 0);
+    EXPECT_EQ(odid_uas_to_compact(&extra, &uas, NULL), ODID_FAIL);
+
+    // Without valid pages no block is needed
+    uas.AuthValid[0] = 0;
+    EXPECT_EQ(odid_uas_to_compact(&records[0], &uas, &pool), ODID_SUCCESS);
+    EXPECT_EQ(records[0].AuthBlock, ODID_COMPACT_NO_AUTH);
+    uas.AuthValid[0] = 1;
+    EXPECT_EQ(odid_uas_to_compact(&extra, &uas, &pool), ODID_SUCCESS);
+}
+
+TEST(ODID, compact_keeps_block_without_pool)
+{
+    ODID_Auth_block blocks[1];
+    ODID_Auth_pool pool;
+    odid_auth_pool_init(&pool, blocks, 1);
+    ODID_UAS_compact compact;
+    odid_compact_init(&compact);
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+
+    uas.AuthValid[0] = 1;
+    ASSERT_EQ(odid_uas_to_compact(&compact, &uas, &pool), ODID_SUCCESS);
+    uint32_t held = compact.AuthBlock;
+
+    // Without the pool the block cannot be returned, the record keeps it
+    uas.AuthValid[0] = 0;
+    EXPECT_EQ(odid_uas_to_compact(&compact, &uas, NULL), ODID_FAIL);
+    EXPECT_EQ(compact.AuthValid, 0);
+    EXPECT_EQ(compact.AuthBlock, held);
+    EXPECT_EQ(odid_compact_release(&compact, NULL), ODID_FAIL);
+    EXPECT_EQ(compact.AuthBlock, held);
+
+    uas.AuthValid[0] = 1;
+    EXPECT_EQ(odid_uas_to_compact(&compact, &uas, &pool), ODID_SUCCESS);
+    EXPECT_EQ(compact.AuthBlock, held);
+    EXPECT_EQ(odid_compact_release(&compact, &pool), ODID_SUCCESS);
+    EXPECT_EQ(compact.AuthBlock, ODID_COMPACT_NO_AUTH);
+
+    // The block is back in the pool
+    ODID_UAS_compact other;
+    odid_compact_init(&other);
+    EXPECT_EQ(odid_uas_to_compact(&other, &uas, &pool), ODID_SUCCESS);
+}
+
+TEST(ODID, compact_sizes)
+{
+    const struct {
+        const char *name;
+        size_t full;
+        size_t compact;
+    } sizes[] = {
+        { "BasicID", sizeof(ODID_BasicID_data), sizeof(ODID_BasicID_compact) },
+        { "Location", sizeof(ODID_Location_data), sizeof(ODID_Location_compact) },
+        { "Auth", sizeof(ODID_Auth_data), sizeof(ODID_Auth_compact) },
+        { "SelfID", sizeof(ODID_SelfID_data), sizeof(ODID_SelfID_compact) },
+        { "System", sizeof(ODID_System_data), sizeof(ODID_System_compact) },
+        { "OperatorID", sizeof(ODID_OperatorID_data), sizeof(ODID_OperatorID_compact) },
+        { "UAS record", sizeof(ODID_UAS_Data), sizeof(ODID_UAS_compact) },
+        { "UAS record + auth", sizeof(ODID_UAS_Data),
+          sizeof(ODID_UAS_compact) + sizeof(ODID_Auth_block) },
+    };
+
+    printf("%-20s %8s %8s\n", "", "full", "compact");
+    for (const auto &size : sizes) {
+        printf("%-20s %8zu %8zu\n", size.name, size.full, size.compact);
+        EXPECT_LE(size.compact, size.full) << size.name;
+    }
+    EXPECT_LT(sizeof(ODID_UAS_compact) * 2, sizeof(ODID_UAS_Data));
+}
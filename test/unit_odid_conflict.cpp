@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+struct Detector {
+    std::vector<ODID_Conflict_state> states;
+    std::vector<ODID_Spatial_entry> entries;
+    std::vector<uint32_t> buckets;
+    std::vector<uint32_t> candidates;
+    ODID_Spatial_index index;
+    ODID_Conflict_detector detector;
+
+    Detector(uint32_t count, float horizontal, float vertical, float lookAhead, float maxSpeed,
+             float maxAge = 0)
+        : states(count), entries(count), buckets(1024), candidates(count)
+    {
+        EXPECT_EQ(odid_spatial_init(&index, entries.data(), count, buckets.data(),
+                                    (uint32_t) buckets.size(), 0.01), ODID_SUCCESS);
+        detector.Horizontal = horizontal;
+        detector.Vertical = vertical;
+        detector.LookAhead = lookAhead;
+        detector.MaxSpeed = maxSpeed;
+        detector.MaxAge = maxAge;
+        EXPECT_EQ(odid_conflict_init(&detector, states.data(), count, &index, candidates.data(),
+                                     count, 1000), ODID_SUCCESS);
+    }
+};
+
+static ODID_Location_data location(double latitude, double longitude, float altitude,
+                                   float direction = INV_DIR, float speed = INV_SPEED_H)
+{
+    ODID_Location_data l;
+    odid_initLocationData(&l);
+    l.Latitude = latitude;
+    l.Longitude = longitude;
+    l.AltitudeGeo = altitude;
+    l.Direction = direction;
+    l.SpeedHorizontal = speed;
+    return l;
+}
+
+TEST(ODID, conflict_current_matches_all_pairs)
+{
+    const uint32_t count = 1500;
+    const float horizontal = 300, vertical = 30;
+    Detector d(count, horizontal, vertical, 0, 0);
+    std::vector<ODID_Location_data> locations;
+    std::mt19937 gen(8642);
+    std::uniform_real_distribution<double> lat(47.30, 47.45), lon(8.45, 8.65);
+    std::uniform_real_distribution<float> alt(50, 200);
+    std::vector<ODID_Conflict> out(count);
+
+    for (uint32_t id = 0; id < count; id++) {
+        locations.push_back(location(lat(gen), lon(gen), alt(gen)));
+        const ODID_Location_data &l = locations.back();
+        uint32_t found = odid_conflict_update(&d.detector, id, 0, &l, out.data(), count);
+        std::vector<uint32_t> ids;
+        for (uint32_t i = 0; i < found; i++) {
+            EXPECT_EQ(out[i].Type, ODID_CONFLICT_NOW);
+            ids.push_back(out[i].Other);
+        }
+        std::sort(ids.begin(), ids.end());
+
+        // Against all previously updated UAS, leaving out those at the thresholds
+        std::vector<uint32_t> expected;
+        for (uint32_t other = 0; other < id; other++) {
+            const ODID_Location_data &o = locations[other];
+            double distance = odid_distance(l.Latitude, l.Longitude, o.Latitude, o.Longitude);
+            double height = fabs(l.AltitudeGeo - o.AltitudeGeo);
+            if (fabs(distance - horizontal) < 1 || fabs(height - vertical) < 0.01) {
+                ids.erase(std::remove(ids.begin(), ids.end(), other), ids.end());
+                continue;
+            }
+            if (distance <= horizontal && height <= vertical)
+                expected.push_back(other);
+        }
+        EXPECT_EQ(ids, expected) << id;
+    }
+}
+
+TEST(ODID, conflict_closest_point_of_approach)
+{
+    Detector d(4, 50, 20, 60, 30, 10);
+    ODID_Conflict out[4];
+
+    // Two UAS 2 km apart on parallel tracks offset by 40 m, closing at 40 m/s
+    double east = 2000 / (6371008.8 * M_PI / 180 * cos(47.4 * M_PI / 180));
+    double north = 40 / (6371008.8 * M_PI / 180);
+    ODID_Location_data a = location(47.4, 8.5, 100, 90, 20);
+    ODID_Location_data b = location(47.4 + north, 8.5 + east, 110, 270, 20);
+    EXPECT_EQ(odid_conflict_update(&d.detector, 0, 0, &a, out, 4), 0u);
+    ASSERT_EQ(odid_conflict_update(&d.detector, 1, 0, &b, out, 4), 1u);
+    EXPECT_EQ(out[0].Other, 0u);
+    EXPECT_EQ(out[0].Type, ODID_CONFLICT_PREDICTED);
+    // Within 50 m after (2000 - 30) / 40 s, closest at 50 s
+    EXPECT_NEAR(out[0].Time, (2000 - sqrt(50.0 * 50 - 40 * 40)) / 40, 0.05);
+    EXPECT_NEAR(out[0].Horizontal, 40, 0.5);
+    EXPECT_NEAR(out[0].Vertical, 10, 0.01);
+
+    // 10 s later, the first UAS is extrapolated when the second reports again
+    b = location(47.4 + north, 8.5 + east * 0.9, 110, 270, 20);
+    ASSERT_EQ(odid_conflict_update(&d.detector, 1, 10000, &b, out, 4), 1u);
+    EXPECT_NEAR(out[0].Time, (1600 - sqrt(50.0 * 50 - 40 * 40)) / 40, 0.05);
+
+    // Vertically separated
+    b.AltitudeGeo = 150;
+    EXPECT_EQ(odid_conflict_update(&d.detector, 1, 10000, &b, out, 4), 0u);
+    // Unknown altitude, from the barometric altitude
+    b.AltitudeGeo = INV_ALT;
+    b.AltitudeBaro = 95;
+    EXPECT_EQ(odid_conflict_update(&d.detector, 1, 10000, &b, out, 4), 1u);
+    // Diverging
+    b.Direction = 90;
+    EXPECT_EQ(odid_conflict_update(&d.detector, 1, 10000, &b, out, 4), 0u);
+
+    // A UAS without a position is not compared anymore
+    a = location(47.4 + north, 8.5 + east * 0.9, 110);
+    EXPECT_EQ(odid_conflict_update(&d.detector, 2, 10000, &a, out, 4), 1u);
+    b.Latitude = 0;
+    b.Longitude = 0;
+    EXPECT_EQ(odid_conflict_update(&d.detector, 1, 10000, &b, out, 4), 0u);
+    EXPECT_EQ(odid_conflict_update(&d.detector, 2, 10000, &a, out, 4), 0u);
+    odid_conflict_remove(&d.detector, 0);
+    EXPECT_EQ(d.index.Size, 1u);
+}
+
+TEST(ODID, conflict_stale_report)
+{
+    // The first UAS flew 1800 m east since its report 60 s ago, to where the
+    // second one hovers
+    Detector d(2, 50, 20, 0, 30, 60);
+    ODID_Conflict out[2];
+    double east = 1800 / (6371008.8 * M_PI / 180 * cos(47.4 * M_PI / 180));
+    ODID_Location_data a = location(47.4, 8.5, 100, 90, 30);
+    ODID_Location_data b = location(47.4, 8.5 + east, 100, 0, 0);
+    EXPECT_EQ(odid_conflict_update(&d.detector, 0, 0, &a, out, 2), 0u);
+    ASSERT_EQ(odid_conflict_update(&d.detector, 1, 60000, &b, out, 2), 1u);
+    EXPECT_EQ(out[0].Other, 0u);
+    EXPECT_EQ(out[0].Type, ODID_CONFLICT_NOW);
+
+    // Reports older than MaxAge are not compared
+    EXPECT_EQ(odid_conflict_update(&d.detector, 1, 61000, &b, out, 2), 0u);
+}
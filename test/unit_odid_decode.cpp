@@ -0,0 +1,671 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+static void buildLocation(ODID_Message_encoded *msg, double lat, double lon)
+{
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Latitude = lat;
+    location.Longitude = lon;
+    location.AltitudeGeo = 110.5f;
+    ASSERT_EQ(encodeLocationMessage(&msg->location, &location), ODID_SUCCESS);
+}
+
+static void buildBasicID(ODID_Message_encoded *msg, ODID_idtype_t idType, const char *id)
+{
+    ODID_BasicID_data basicId;
+    odid_initBasicIDData(&basicId);
+    basicId.IDType = idType;
+    basicId.UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    strncpy(basicId.UASID, id, sizeof(basicId.UASID) - 1);
+    ASSERT_EQ(encodeBasicIDMessage(&msg->basicId, &basicId), ODID_SUCCESS);
+}
+
+TEST(ODID, decode_batch_matches_single_decode)
+{
+    const int count = ODID_BATCH_CHUNK_SIZE + 11;
+    ODID_Message_encoded msgs[count];
+    uint16_t tags[count];
+
+    for (int i = 0; i < count; i++) {
+        tags[i] = (uint16_t) (i % 3);
+        switch (i % 4) {
+        case 0:
+            buildBasicID(&msgs[i], ODID_IDTYPE_SERIAL_NUMBER, "SERIAL");
+            break;
+        case 3:
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].rawData[0] = 0x72; // Reserved message type
+            break;
+        default:
+            buildLocation(&msgs[i], 45.0 + i * 0.001, -122.0 - i * 0.001);
+            break;
+        }
+    }
+
+    ODID_UAS_Data batch[3], single[3];
+    // Clear the padding too, so the structures can be compared with memcmp()
+    memset(batch, 0, sizeof(batch));
+    memset(single, 0, sizeof(single));
+    for (int i = 0; i < 3; i++) {
+        odid_initUasData(&batch[i]);
+        odid_initUasData(&single[i]);
+    }
+
+    ODID_messagetype_t types[count];
+    size_t decoded = odid_decode_batch(batch, 3, msgs, tags, count, types);
+
+    size_t expected = 0;
+    for (int i = 0; i < count; i++) {
+        ODID_messagetype_t type = decodeOpenDroneID(&single[tags[i]], msgs[i].rawData);
+        EXPECT_EQ(types[i], type) << "message " << i;
+        if (type != ODID_MESSAGETYPE_INVALID)
+            expected++;
+    }
+    EXPECT_EQ(decoded, expected);
+
+    for (int i = 0; i < 3; i++)
+        EXPECT_EQ(memcmp(&batch[i], &single[i], sizeof(ODID_UAS_Data)), 0) << "uas " << i;
+}
+
+TEST(ODID, decode_batch_rejects_out_of_range_tag)
+{
+    ODID_Message_encoded msg;
+    buildLocation(&msg, 10.0, 20.0);
+    uint16_t tag = 1;
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    ODID_messagetype_t type;
+
+    EXPECT_EQ(odid_decode_batch(&uas, 1, &msg, &tag, 1, &type), 0u);
+    EXPECT_EQ(type, ODID_MESSAGETYPE_INVALID);
+    EXPECT_EQ(uas.LocationValid, 0);
+
+    EXPECT_EQ(odid_decode_batch(&uas, 1, &msg, NULL, 1, &type), 1u);
+    EXPECT_EQ(type, ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(uas.LocationValid, 1);
+}
+
+TEST(ODID, decode_location_soa_bit_identical)
+{
+    const int count = 4 * 8 + 5;
+    ODID_Location_encoded in[count];
+    ODID_Location_data ref[count];
+
+    srand(1234);
+    for (int i = 0; i < count; i++) {
+        uint8_t *raw = (uint8_t *) &in[i];
+        for (int j = 0; j < ODID_MESSAGE_SIZE; j++)
+            raw[j] = (uint8_t) rand();
+        raw[0] = (uint8_t) ((ODID_MESSAGETYPE_LOCATION << 4) | ODID_PROTOCOL_VERSION);
+        if (i % 5 == 0)
+            in[i].TimeStamp = INV_TIMESTAMP;
+        if (i == 3)
+            raw[0] = (uint8_t) (ODID_MESSAGETYPE_SYSTEM << 4);
+        else
+            ASSERT_EQ(decodeLocationMessage(&ref[i], &in[i]), ODID_SUCCESS);
+    }
+
+    const ODID_simd_t levels[] = { ODID_SIMD_SCALAR, ODID_SIMD_SSE2, ODID_SIMD_AVX2 };
+    for (ODID_simd_t level : levels) {
+        ODID_simd_t selected = odid_simd_select(level);
+        EXPECT_LE(selected, level);
+
+        uint8_t valid[count], status[count];
+        float dir[count], speedH[count], speedV[count], altBaro[count], altGeo[count];
+        float height[count], ts[count];
+        double lat[count], lon[count];
+        ODID_Location_soa out = { valid, status, dir, speedH, speedV, lat, lon,
+                                  altBaro, altGeo, height, ts };
+        ASSERT_EQ(odid_decode_location_soa(&out, in, count), ODID_SUCCESS);
+
+        for (int i = 0; i < count; i++) {
+            EXPECT_EQ(valid[i], i == 3 ? 0 : 1);
+            if (i == 3)
+                continue;
+            // Random status values are outside of the enum, read them as int
+            int refStatus;
+            memcpy(&refStatus, &ref[i].Status, sizeof(refStatus));
+            EXPECT_EQ(status[i], refStatus) << i;
+            EXPECT_EQ(memcmp(&dir[i], &ref[i].Direction, sizeof(float)), 0) << i;
+            EXPECT_EQ(memcmp(&speedH[i], &ref[i].SpeedHorizontal, sizeof(float)), 0) << i;
+            EXPECT_EQ(memcmp(&speedV[i], &ref[i].SpeedVertical, sizeof(float)), 0) << i;
+            EXPECT_EQ(memcmp(&lat[i], &ref[i].Latitude, sizeof(double)), 0) << i;
+            EXPECT_EQ(memcmp(&lon[i], &ref[i].Longitude, sizeof(double)), 0) << i;
+            EXPECT_EQ(memcmp(&altBaro[i], &ref[i].AltitudeBaro, sizeof(float)), 0) << i;
+            EXPECT_EQ(memcmp(&altGeo[i], &ref[i].AltitudeGeo, sizeof(float)), 0) << i;
+            EXPECT_EQ(memcmp(&height[i], &ref[i].Height, sizeof(float)), 0) << i;
+            EXPECT_EQ(memcmp(&ts[i], &ref[i].TimeStamp, sizeof(float)), 0) << i;
+        }
+    }
+    odid_simd_select(ODID_SIMD_AUTO);
+}
+
+TEST(ODID, accuracy_enum_round_trip)
+{
+    // The decoded value of each enum is the upper bound of its bucket
+    for (int i = ODID_HOR_ACC_1_METER; i <= ODID_HOR_ACC_10NM; i++) {
+        float value = decodeHorizontalAccuracy((ODID_Horizontal_accuracy_t) i);
+        EXPECT_EQ(createEnumHorizontalAccuracy(value * 0.99f), i);
+    }
+    for (int i = ODID_VER_ACC_1_METER; i <= ODID_VER_ACC_150_METER; i++) {
+        float value = decodeVerticalAccuracy((ODID_Vertical_accuracy_t) i);
+        EXPECT_EQ(createEnumVerticalAccuracy(value * 0.99f), i);
+    }
+    for (int i = ODID_SPEED_ACC_10_METERS_PER_SECOND; i <= ODID_SPEED_ACC_0_3_METERS_PER_SECOND; i++) {
+        float value = decodeSpeedAccuracy((ODID_Speed_accuracy_t) i);
+        EXPECT_EQ(createEnumSpeedAccuracy(value * 0.99f), i);
+    }
+    for (int i = ODID_TIME_ACC_0_1_SECOND; i <= ODID_TIME_ACC_1_5_SECOND; i++) {
+        float value = decodeTimestampAccuracy((ODID_Timestamp_accuracy_t) i);
+        EXPECT_EQ(createEnumTimestampAccuracy(value), i);
+    }
+
+    EXPECT_EQ(decodeHorizontalAccuracy(ODID_HOR_ACC_4NM), 7408);
+    EXPECT_EQ(createEnumHorizontalAccuracy(0), ODID_HOR_ACC_UNKNOWN);
+    EXPECT_EQ(createEnumHorizontalAccuracy(-1), ODID_HOR_ACC_UNKNOWN);
+    EXPECT_EQ(createEnumHorizontalAccuracy(NAN), ODID_HOR_ACC_UNKNOWN);
+    EXPECT_EQ(createEnumVerticalAccuracy(150), ODID_VER_ACC_UNKNOWN);
+    EXPECT_EQ(createEnumTimestampAccuracy(1.6f), ODID_TIME_ACC_UNKNOWN);
+}
+
+TEST(ODID, view_matches_decode)
+{
+    ODID_MessagePack_data packData;
+    odid_initMessagePackData(&packData);
+    packData.MsgPackSize = 4;
+    buildBasicID(&packData.Messages[0], ODID_IDTYPE_SERIAL_NUMBER, "VIEW-SERIAL-1234");
+    buildLocation(&packData.Messages[1], 51.4791, -0.0013);
+
+    ODID_System_data system;
+    odid_initSystemData(&system);
+    system.OperatorLatitude = 51.48;
+    system.OperatorLongitude = -0.002;
+    system.OperatorAltitudeGeo = 20.5f;
+    system.Timestamp = 28000000;
+    ASSERT_EQ(encodeSystemMessage(&packData.Messages[2].system, &system), ODID_SUCCESS);
+
+    ODID_OperatorID_data operatorId;
+    odid_initOperatorIDData(&operatorId);
+    strcpy(operatorId.OperatorId, "OP-0042");
+    ASSERT_EQ(encodeOperatorIDMessage(&packData.Messages[3].operatorId, &operatorId), ODID_SUCCESS);
+
+    ODID_MessagePack_encoded pack;
+    ASSERT_EQ(encodeMessagePack(&pack, &packData), ODID_SUCCESS);
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    ASSERT_EQ(decodeMessagePack(&uas, &pack), ODID_SUCCESS);
+
+    ODID_MessagePack_view packView;
+    size_t packLen = offsetof(ODID_MessagePack_encoded, Messages) + 4 * ODID_MESSAGE_SIZE;
+    EXPECT_EQ(odid_view_pack_init(&packView, (const uint8_t *) &pack, packLen - 1), ODID_FAIL);
+    ASSERT_EQ(odid_view_pack_init(&packView, (const uint8_t *) &pack, packLen), ODID_SUCCESS);
+    ASSERT_EQ(packView.count, 4);
+
+    ODID_Message_view view = odid_view_pack_message(packView, 0);
+    ASSERT_EQ(odid_view_type(view), ODID_MESSAGETYPE_BASIC_ID);
+    const char *id;
+    size_t idLen = odid_view_basicid_uasid(view, &id);
+    EXPECT_EQ(std::string(id, idLen), uas.BasicID[0].UASID);
+    EXPECT_EQ(odid_view_basicid_uatype(view), uas.BasicID[0].UAType);
+
+    view = odid_view_pack_message(packView, 1);
+    ASSERT_EQ(odid_view_type(view), ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(odid_view_location_lat(view), uas.Location.Latitude);
+    EXPECT_EQ(odid_view_location_lon(view), uas.Location.Longitude);
+    EXPECT_EQ(odid_view_location_altitude_geo(view), uas.Location.AltitudeGeo);
+    EXPECT_EQ(odid_view_location_speed_horizontal(view), uas.Location.SpeedHorizontal);
+    EXPECT_EQ(odid_view_location_timestamp(view), uas.Location.TimeStamp);
+    EXPECT_EQ(odid_view_location_status(view), uas.Location.Status);
+
+    view = odid_view_pack_message(packView, 2);
+    ASSERT_EQ(odid_view_type(view), ODID_MESSAGETYPE_SYSTEM);
+    EXPECT_EQ(odid_view_system_operator_lat(view), uas.System.OperatorLatitude);
+    EXPECT_EQ(odid_view_system_operator_lon(view), uas.System.OperatorLongitude);
+    EXPECT_EQ(odid_view_system_operator_altitude_geo(view), uas.System.OperatorAltitudeGeo);
+    EXPECT_EQ(odid_view_system_timestamp(view), uas.System.Timestamp);
+
+    view = odid_view_pack_message(packView, 3);
+    ASSERT_EQ(odid_view_type(view), ODID_MESSAGETYPE_OPERATOR_ID);
+    const char *op;
+    size_t opLen = odid_view_operatorid(view, &op);
+    EXPECT_EQ(std::string(op, opLen), uas.OperatorID.OperatorId);
+
+    EXPECT_EQ(odid_view_pack_message(packView, 4).data, nullptr);
+    EXPECT_EQ(odid_view_pack_message(packView, -1).data, nullptr);
+    ODID_MessagePack_view emptyView = { nullptr, 0 };
+    EXPECT_EQ(odid_view_pack_message(emptyView, 0).data, nullptr);
+
+    ODID_Message_view single;
+    EXPECT_EQ(odid_view_init(&single, pack.Messages[1].rawData, ODID_MESSAGE_SIZE - 1), ODID_FAIL);
+    ASSERT_EQ(odid_view_init(&single, pack.Messages[1].rawData, ODID_MESSAGE_SIZE), ODID_SUCCESS);
+    EXPECT_EQ(odid_view_location_lat(single), uas.Location.Latitude);
+}
+
+TEST(ODID, decode_fixed_matches_float)
+{
+    std::mt19937 gen(42);
+
+    for (int i = 0; i < 5000; i++) {
+        ODID_Message_encoded msg;
+        for (auto &byte : msg.rawData)
+            byte = (uint8_t) gen();
+
+        msg.rawData[0] = (uint8_t) ((ODID_MESSAGETYPE_LOCATION << 4) | ODID_PROTOCOL_VERSION);
+        if (i % 8 == 0)
+            msg.location.TimeStamp = INV_TIMESTAMP;
+        ODID_Location_data location, fromFixed;
+        ODID_Location_fixed fixed, roundTrip;
+        // The structures are compared with memcmp(), padding included
+        memset(&location, 0, sizeof(location));
+        memset(&fromFixed, 0, sizeof(fromFixed));
+        memset(&fixed, 0, sizeof(fixed));
+        memset(&roundTrip, 0, sizeof(roundTrip));
+        ASSERT_EQ(decodeLocationMessage(&location, &msg.location), ODID_SUCCESS);
+        ASSERT_EQ(decodeLocationMessageFixed(&fixed, &msg.location), ODID_SUCCESS);
+        odid_location_fixed_to_data(&fromFixed, &fixed);
+        ASSERT_EQ(memcmp(&location, &fromFixed, sizeof(location)), 0) << "message " << i;
+        odid_location_data_to_fixed(&roundTrip, &location);
+        ASSERT_EQ(memcmp(&fixed, &roundTrip, sizeof(fixed)), 0) << "message " << i;
+
+        msg.rawData[0] = (uint8_t) ((ODID_MESSAGETYPE_SYSTEM << 4) | ODID_PROTOCOL_VERSION);
+        ODID_System_data system, systemFromFixed;
+        ODID_System_fixed systemFixed, systemRoundTrip;
+        memset(&system, 0, sizeof(system));
+        memset(&systemFromFixed, 0, sizeof(systemFromFixed));
+        memset(&systemFixed, 0, sizeof(systemFixed));
+        memset(&systemRoundTrip, 0, sizeof(systemRoundTrip));
+        ASSERT_EQ(decodeSystemMessage(&system, &msg.system), ODID_SUCCESS);
+        ASSERT_EQ(decodeSystemMessageFixed(&systemFixed, &msg.system), ODID_SUCCESS);
+        odid_system_fixed_to_data(&systemFromFixed, &systemFixed);
+        ASSERT_EQ(memcmp(&system, &systemFromFixed, sizeof(system)), 0) << "message " << i;
+        odid_system_data_to_fixed(&systemRoundTrip, &system);
+        ASSERT_EQ(memcmp(&systemFixed, &systemRoundTrip, sizeof(systemFixed)), 0) << "message " << i;
+    }
+
+    ODID_Location_encoded encoded;
+    ODID_Location_fixed fixed;
+    memset(&encoded, 0, sizeof(encoded));
+    EXPECT_EQ(decodeLocationMessageFixed(&fixed, &encoded), ODID_FAIL);
+}
+
+struct FilterReference {
+    double latMin, lonMin, latMax, lonMax;
+    ODID_filter_altitude_t field;
+    float altMin, altMax;
+    uint16_t statusMask;
+
+    bool match(const ODID_Location_encoded &in) const
+    {
+        ODID_Location_data l;
+        if (decodeLocationMessage(&l, &in) != ODID_SUCCESS)
+            return false;
+        float altitude = field == ODID_FILTER_ALTITUDE_GEO ? l.AltitudeGeo :
+                         field == ODID_FILTER_ALTITUDE_BARO ? l.AltitudeBaro : l.Height;
+        bool lon = lonMin <= lonMax ? (l.Longitude >= lonMin && l.Longitude <= lonMax) :
+                                      (l.Longitude >= lonMin || l.Longitude <= lonMax);
+        return l.Latitude >= latMin && l.Latitude <= latMax && lon &&
+               altitude >= altMin && altitude <= altMax && ((statusMask >> l.Status) & 1);
+    }
+};
+
+TEST(ODID, location_filter_matches_decoded_predicate)
+{
+    const size_t count = 2000;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int32_t> near(-20000, 20000);
+    std::vector<ODID_Location_encoded> msgs(count);
+    for (size_t i = 0; i < count; i++) {
+        auto *raw = (uint8_t *) &msgs[i];
+        for (size_t b = 0; b < sizeof(msgs[i]); b++)
+            raw[b] = (uint8_t) gen();
+        raw[0] = (uint8_t) (((i % 16 == 0 ? ODID_MESSAGETYPE_SYSTEM : ODID_MESSAGETYPE_LOCATION) << 4) |
+                            ODID_PROTOCOL_VERSION);
+        // Positions clustered around the box edges, a few near the antimeridian
+        msgs[i].Latitude = 473977000 + near(gen);
+        msgs[i].Longitude = (i % 4 == 0 ? 1799970000 : 85456000) + near(gen);
+        msgs[i].Status = (uint8_t) (gen() % 5);
+    }
+
+    std::vector<FilterReference> filters;
+    for (int f = 0; f < 40; f++) {
+        // Bounds exactly at decoded values of some records, and in between
+        ODID_Location_data a, b;
+        decodeLocationMessage(&a, &msgs[gen() % count]);
+        decodeLocationMessage(&b, &msgs[gen() % count]);
+        FilterReference r;
+        r.latMin = std::fmin(a.Latitude, b.Latitude) + (f % 2 ? 0 : 0.5E-7);
+        r.latMax = std::fmax(a.Latitude, b.Latitude);
+        r.lonMin = std::fmin(a.Longitude, b.Longitude);
+        r.lonMax = std::fmax(a.Longitude, b.Longitude) - (f % 3 ? 0 : 0.5E-7);
+        if (f % 5 == 0)
+            std::swap(r.lonMin, r.lonMax);
+        r.field = (ODID_filter_altitude_t) (f % 3);
+        r.altMin = std::fmin(a.AltitudeGeo, b.Height) + (f % 2 ? 0 : 0.25f);
+        r.altMax = std::fmax(a.AltitudeGeo, b.Height) + (f % 2 ? 0 : 0.25f);
+        r.statusMask = f % 4 ? (uint16_t) (1 << ODID_STATUS_EMERGENCY) : (uint16_t) gen();
+        filters.push_back(r);
+    }
+    // Bands that do not contain any encoded value
+    filters.push_back({ 47, 8, 48, 9, ODID_FILTER_ALTITUDE_GEO, 100.1f, 100.2f, 0xFFFF });
+    filters.push_back({ 47, 8, 48, 9, ODID_FILTER_HEIGHT, 40000, 50000, 0xFFFF });
+    // Boxes narrower than one encoded step, around the positions of the records
+    filters.push_back({ 47.39770001, 8, 47.39770009, 9, ODID_FILTER_ALTITUDE_GEO, -1000, 31767, 0xFFFF });
+    filters.push_back({ 47, 8.54560001, 48, 8.54560009, ODID_FILTER_ALTITUDE_GEO, -1000, 31767, 0xFFFF });
+    filters.push_back({ 45.00000001, 50, 45.00000009, 70, ODID_FILTER_ALTITUDE_GEO, -1000, 31767, 0xFFFF });
+    filters.push_back({ -90, 120.00000001, 90, 120.00000009, ODID_FILTER_ALTITUDE_GEO, -1000, 31767, 0xFFFF });
+
+    std::vector<uint32_t> out(count);
+    size_t total = 0;
+    for (const auto &r : filters) {
+        ODID_Location_filter filter;
+        odid_location_filter_init(&filter);
+        ASSERT_EQ(odid_location_filter_box(&filter, r.latMin, r.lonMin, r.latMax, r.lonMax), ODID_SUCCESS);
+        ASSERT_EQ(odid_location_filter_altitude(&filter, r.field, r.altMin, r.altMax), ODID_SUCCESS);
+        ASSERT_EQ(odid_location_filter_status(&filter, r.statusMask), ODID_SUCCESS);
+
+        size_t found = odid_location_filter_batch(&filter, msgs.data(), count, out.data());
+        size_t expected = 0;
+        for (size_t i = 0; i < count; i++) {
+            bool match = r.match(msgs[i]);
+            ASSERT_EQ(odid_location_filter_match(&filter, &msgs[i]), match ? 1 : 0) << i;
+            if (match) {
+                ASSERT_LT(expected, found);
+                EXPECT_EQ(out[expected], i);
+                expected++;
+            }
+        }
+        EXPECT_EQ(found, expected);
+        total += found;
+    }
+    EXPECT_GT(total, count / 10);
+
+    // Without predicates, every Location message matches
+    ODID_Location_filter all;
+    odid_location_filter_init(&all);
+    EXPECT_EQ(odid_location_filter_batch(&all, msgs.data(), count, out.data()), count - count / 16);
+
+    EXPECT_EQ(odid_location_filter_box(&all, 10, 0, 5, 1), ODID_FAIL);
+    EXPECT_EQ(odid_location_filter_box(&all, 0, 0, 91, 1), ODID_FAIL);
+    EXPECT_EQ(odid_location_filter_altitude(&all, ODID_FILTER_ALTITUDE_GEO, 10, 5), ODID_FAIL);
+    EXPECT_EQ(odid_location_filter_altitude(&all, (ODID_filter_altitude_t) 3, 0, 5), ODID_FAIL);
+}
+
+static ODID_messagetype_t countPrivateMessage(ODID_UAS_Data *uasData, const uint8_t *msgData,
+                                              void *context)
+{
+    (void) uasData;
+    int *count = (int *) context;
+    (*count)++;
+    return (ODID_messagetype_t) (msgData[0] >> 4);
+}
+
+TEST(ODID, decode_registered_decoder)
+{
+    const uint8_t privateType = 0xA;
+    ODID_Message_encoded msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.rawData[0] = (uint8_t) (privateType << 4) | ODID_PROTOCOL_VERSION;
+
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    EXPECT_EQ(decodeOpenDroneID(&uas, msg.rawData), ODID_MESSAGETYPE_INVALID);
+
+    int count = 0;
+    ASSERT_EQ(odid_register_decoder(privateType, countPrivateMessage, &count), ODID_SUCCESS);
+    EXPECT_EQ(decodeOpenDroneID(&uas, msg.rawData), (ODID_messagetype_t) privateType);
+    EXPECT_EQ(count, 1);
+    EXPECT_EQ(decodeMessageType(msg.rawData[0]), ODID_MESSAGETYPE_INVALID);
+
+    // The message types defined by the specification can't be replaced
+    EXPECT_EQ(odid_register_decoder(ODID_MESSAGETYPE_LOCATION, countPrivateMessage, &count), ODID_FAIL);
+    EXPECT_EQ(odid_register_decoder(ODID_MESSAGETYPE_PACKED, countPrivateMessage, &count), ODID_FAIL);
+    EXPECT_EQ(odid_register_decoder(16, countPrivateMessage, &count), ODID_FAIL);
+    buildLocation(&msg, 51.4791, -0.0013);
+    EXPECT_EQ(decodeOpenDroneID(&uas, msg.rawData), ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(count, 1);
+
+    // The batch decoder uses the registered decoders too, packs stay invalid
+    ODID_Message_encoded batch[3];
+    batch[0] = msg;
+    memset(&batch[1], 0, sizeof(batch[1]));
+    batch[1].rawData[0] = (uint8_t) (privateType << 4) | ODID_PROTOCOL_VERSION;
+    batch[2] = batch[1];
+    batch[2].rawData[0] = (uint8_t) (ODID_MESSAGETYPE_PACKED << 4) | ODID_PROTOCOL_VERSION;
+    ODID_messagetype_t types[3];
+    EXPECT_EQ(odid_decode_batch(&uas, 1, batch, NULL, 3, types), 2u);
+    EXPECT_EQ(types[0], ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(types[1], (ODID_messagetype_t) privateType);
+    EXPECT_EQ(types[2], ODID_MESSAGETYPE_INVALID);
+    EXPECT_EQ(count, 2);
+
+    ASSERT_EQ(odid_register_decoder(privateType, NULL, NULL), ODID_SUCCESS);
+    msg.rawData[0] = (uint8_t) (privateType << 4) | ODID_PROTOCOL_VERSION;
+    EXPECT_EQ(decodeOpenDroneID(&uas, msg.rawData), ODID_MESSAGETYPE_INVALID);
+}
+
+static void buildPack(ODID_MessagePack_encoded *pack, const ODID_Message_encoded *msgs, int count)
+{
+    ODID_MessagePack_data data;
+    odid_initMessagePackData(&data);
+    for (int i = 0; i < count; i++)
+        data.Messages[i] = msgs[i];
+    data.MsgPackSize = (uint8_t) count;
+    ASSERT_EQ(encodeMessagePack(pack, &data), ODID_SUCCESS);
+}
+
+TEST(ODID, decode_merge_keeps_earlier_messages)
+{
+    ODID_UAS_Data uas;
+    ODID_UAS_Timestamps timestamps;
+    odid_initUasData(&uas);
+    odid_initUasTimestamps(&timestamps);
+
+    // First frame: serial number, an Auth page and a Location
+    ODID_Message_encoded msgs[3];
+    buildBasicID(&msgs[0], ODID_IDTYPE_SERIAL_NUMBER, "1596F0123456789ABCDE");
+    ODID_Auth_data auth;
+    odid_initAuthData(&auth);
+    auth.AuthType = ODID_AUTH_UAS_ID_SIGNATURE;
+    auth.Length = 10;
+    ASSERT_EQ(encodeAuthMessage(&msgs[1].auth, &auth), ODID_SUCCESS);
+    buildLocation(&msgs[2], 51.4791, -0.0013);
+    ODID_MessagePack_encoded pack;
+    buildPack(&pack, msgs, 3);
+    EXPECT_EQ(odid_message_merge_pack(&uas, &timestamps, 100, (const uint8_t *) &pack, sizeof(pack),
+                                      nullptr, nullptr),
+              (int) (offsetof(ODID_MessagePack_encoded, Messages) + 3 * ODID_MESSAGE_SIZE));
+
+    // Second frame: registration ID and a new Location
+    buildBasicID(&msgs[0], ODID_IDTYPE_CAA_REGISTRATION_ID, "GBR-REG-42");
+    buildLocation(&msgs[1], 51.48, -0.002);
+    buildPack(&pack, msgs, 2);
+    EXPECT_EQ(odid_decode_merge(&uas, &timestamps, 200, (const uint8_t *) &pack, nullptr, nullptr),
+              ODID_MESSAGETYPE_PACKED);
+
+    EXPECT_TRUE(uas.BasicIDValid[0]);
+    EXPECT_STREQ(uas.BasicID[0].UASID, "1596F0123456789ABCDE");
+    EXPECT_EQ(timestamps.BasicID[0], 100u);
+    EXPECT_TRUE(uas.BasicIDValid[1]);
+    EXPECT_STREQ(uas.BasicID[1].UASID, "GBR-REG-42");
+    EXPECT_EQ(timestamps.BasicID[1], 200u);
+    EXPECT_TRUE(uas.AuthValid[0]);
+    EXPECT_EQ(uas.Auth[0].Length, 10);
+    EXPECT_EQ(timestamps.Auth[0], 100u);
+    EXPECT_NEAR(uas.Location.Latitude, 51.48, 1e-6);
+    EXPECT_EQ(timestamps.Location, 200u);
+    EXPECT_FALSE(uas.SelfIDValid);
+    EXPECT_EQ(timestamps.SelfID, 0u);
+
+    // A single message is merged the same way
+    ODID_SelfID_data selfId;
+    odid_initSelfIDData(&selfId);
+    strcpy(selfId.Desc, "Survey flight");
+    ASSERT_EQ(encodeSelfIDMessage(&msgs[0].selfId, &selfId), ODID_SUCCESS);
+    EXPECT_EQ(odid_decode_merge(&uas, &timestamps, 300, msgs[0].rawData, nullptr, nullptr),
+              ODID_MESSAGETYPE_SELF_ID);
+    EXPECT_EQ(timestamps.SelfID, 300u);
+    EXPECT_EQ(timestamps.Location, 200u);
+
+    // The pack length is checked against the buffer
+    EXPECT_LT(odid_message_merge_pack(&uas, &timestamps, 400, (const uint8_t *) &pack, 10, nullptr, nullptr), 0);
+}
+
+TEST(ODID, decode_merge_reports_changes)
+{
+    ODID_UAS_Data uas;
+    ODID_UAS_Timestamps timestamps;
+    odid_initUasData(&uas);
+    odid_initUasTimestamps(&timestamps);
+
+    ODID_Message_encoded msg;
+    buildLocation(&msg, 51.4791, -0.0013);
+    uint32_t changed = 0;
+    EXPECT_EQ(odid_decode_merge(&uas, &timestamps, 1, msg.rawData, &changed, nullptr),
+              ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(changed, (uint32_t) ODID_CHANGED_LOCATION);
+
+    // Repeating the same message changes nothing
+    changed = 0;
+    odid_decode_merge(&uas, &timestamps, 2, msg.rawData, &changed, nullptr);
+    EXPECT_EQ(changed, 0u);
+
+    buildLocation(&msg, 51.4792, -0.0013);
+    odid_decode_merge(&uas, &timestamps, 3, msg.rawData, &changed, nullptr);
+    EXPECT_EQ(changed, (uint32_t) ODID_CHANGED_POSITION);
+
+    ODID_System_data system;
+    odid_initSystemData(&system);
+    system.OperatorLatitude = 51.48;
+    system.OperatorLongitude = -0.002;
+    ASSERT_EQ(encodeSystemMessage(&msg.system, &system), ODID_SUCCESS);
+    changed = 0;
+    odid_decode_merge(&uas, &timestamps, 4, msg.rawData, &changed, nullptr);
+    EXPECT_EQ(changed, (uint32_t) ODID_CHANGED_SYSTEM);
+    system.AreaCount = 2;
+    system.Timestamp = 1000;
+    ASSERT_EQ(encodeSystemMessage(&msg.system, &system), ODID_SUCCESS);
+    changed = 0;
+    odid_decode_merge(&uas, &timestamps, 5, msg.rawData, &changed, nullptr);
+    EXPECT_EQ(changed, (uint32_t) (ODID_CHANGED_AREA | ODID_CHANGED_SYSTEM_TIME));
+
+    // The stored data is the same as without change reporting. Compared
+    // through re-encoding, as struct padding may differ
+    ODID_UAS_Data plain;
+    ODID_UAS_Timestamps plainTimestamps;
+    odid_initUasData(&plain);
+    odid_initUasTimestamps(&plainTimestamps);
+    buildLocation(&msg, 51.4792, -0.0013);
+    odid_decode_merge(&plain, &plainTimestamps, 3, msg.rawData, nullptr, nullptr);
+    ASSERT_EQ(encodeSystemMessage(&msg.system, &system), ODID_SUCCESS);
+    odid_decode_merge(&plain, &plainTimestamps, 5, msg.rawData, nullptr, nullptr);
+    ODID_Message_encoded a, b;
+    ASSERT_EQ(encodeLocationMessage(&a.location, &plain.Location), ODID_SUCCESS);
+    ASSERT_EQ(encodeLocationMessage(&b.location, &uas.Location), ODID_SUCCESS);
+    EXPECT_EQ(memcmp(&a, &b, sizeof(a)), 0);
+    ASSERT_EQ(encodeSystemMessage(&a.system, &plain.System), ODID_SUCCESS);
+    ASSERT_EQ(encodeSystemMessage(&b.system, &uas.System), ODID_SUCCESS);
+    EXPECT_EQ(memcmp(&a, &b, sizeof(a)), 0);
+}
+
+TEST(ODID, decode_merge_memo_reports_same_changes)
+{
+    ODID_UAS_Data uas, plain;
+    ODID_UAS_Timestamps timestamps;
+    ODID_Message_memo memo;
+    odid_initUasData(&uas);
+    odid_initUasData(&plain);
+    odid_initUasTimestamps(&timestamps);
+    odid_initMessageMemo(&memo);
+
+    std::mt19937 gen(1357);
+    std::uniform_int_distribution<int> pick(0, 3);
+    for (int i = 0; i < 2000; i++) {
+        // Few distinct values per field, so that most fields repeat
+        ODID_Message_encoded msg;
+        if (gen() % 2) {
+            ODID_Location_data location;
+            odid_initLocationData(&location);
+            location.Status = (ODID_status_t) pick(gen);
+            location.Latitude = 51.4791 + pick(gen) * 1E-4;
+            location.Longitude = -0.0013;
+            location.AltitudeGeo = 100.0f + (float) pick(gen);
+            location.HeightType = (ODID_Height_reference_t) (pick(gen) % 2);
+            location.Direction = 90.0f * (float) pick(gen);
+            location.SpeedHorizontal = 70.0f * (float) (pick(gen) % 2);
+            location.HorizAccuracy = (ODID_Horizontal_accuracy_t) pick(gen);
+            location.TSAccuracy = (ODID_Timestamp_accuracy_t) pick(gen);
+            location.TimeStamp = 360.0f + (float) pick(gen);
+            ASSERT_EQ(encodeLocationMessage(&msg.location, &location), ODID_SUCCESS);
+        } else {
+            ODID_System_data system;
+            odid_initSystemData(&system);
+            system.OperatorLocationType = (ODID_operator_location_type_t) (pick(gen) % 3);
+            system.ClassificationType = (ODID_classification_type_t) (pick(gen) % 2);
+            system.OperatorLatitude = 51.48 + pick(gen) * 1E-4;
+            system.OperatorLongitude = -0.002;
+            system.AreaCount = (uint16_t) pick(gen);
+            system.CategoryEU = (ODID_category_EU_t) pick(gen);
+            system.OperatorAltitudeGeo = 20.0f * (float) pick(gen);
+            system.Timestamp = 1000 + (uint32_t) pick(gen);
+            ASSERT_EQ(encodeSystemMessage(&msg.system, &system), ODID_SUCCESS);
+        }
+        uint32_t changed = 0, expected = 0;
+        odid_decode_merge(&uas, &timestamps, i + 1, msg.rawData, &changed, &memo);
+        odid_decode_merge(&plain, &timestamps, i + 1, msg.rawData, &expected, nullptr);
+        ASSERT_EQ(changed, expected) << i;
+    }
+}
+
+TEST(ODID, decode_memo_skips_repeated_messages)
+{
+    ODID_UAS_Data uas;
+    ODID_Message_memo memo;
+    odid_initUasData(&uas);
+    odid_initMessageMemo(&memo);
+
+    ODID_Message_encoded msgs[2];
+    buildBasicID(&msgs[0], ODID_IDTYPE_SERIAL_NUMBER, "1596F0123456789ABCDE");
+    buildLocation(&msgs[1], 51.4791, -0.0013);
+    ODID_MessagePack_encoded pack;
+    buildPack(&pack, msgs, 2);
+    EXPECT_EQ(odid_decode_memo(&uas, &memo, (const uint8_t *) &pack), ODID_MESSAGETYPE_PACKED);
+    EXPECT_EQ(memo.Hits, 0u);
+    EXPECT_EQ(memo.Misses, 2u);
+
+    // Repeats are not decoded: changes made to the data by the application
+    // are kept, until the message itself changes
+    uas.Location.Latitude = 0;
+    EXPECT_EQ(odid_decode_memo(&uas, &memo, (const uint8_t *) &pack), ODID_MESSAGETYPE_PACKED);
+    EXPECT_EQ(memo.Hits, 2u);
+    EXPECT_EQ(memo.Misses, 2u);
+    EXPECT_EQ(uas.Location.Latitude, 0);
+    EXPECT_STREQ(uas.BasicID[0].UASID, "1596F0123456789ABCDE");
+
+    buildLocation(&msgs[1], 51.48, -0.002);
+    EXPECT_EQ(odid_decode_memo(&uas, &memo, msgs[1].rawData), ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(memo.Misses, 3u);
+    EXPECT_NEAR(uas.Location.Latitude, 51.48, 1e-6);
+
+    // A slot that is no longer valid is decoded again
+    uas.BasicIDValid[0] = 0;
+    EXPECT_EQ(odid_decode_memo(&uas, &memo, msgs[0].rawData), ODID_MESSAGETYPE_BASIC_ID);
+    EXPECT_EQ(memo.Misses, 4u);
+    EXPECT_TRUE(uas.BasicIDValid[0]);
+
+    // Merging with a memo still updates the receive time of repeats
+    ODID_UAS_Timestamps timestamps;
+    odid_initUasTimestamps(&timestamps);
+    uint32_t changed = 0;
+    EXPECT_EQ(odid_decode_merge(&uas, &timestamps, 7, msgs[1].rawData, &changed, &memo),
+              ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(memo.Hits, 3u);
+    EXPECT_EQ(changed, 0u);
+    EXPECT_EQ(timestamps.Location, 7u);
+}
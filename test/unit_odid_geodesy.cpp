@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+struct GeoReference {
+    double distance, bearing, x, y, z, east, north, up;
+};
+
+// Straightforward libm implementation of the batch geodesy functions
+static GeoReference geoReference(double lat0, double lon0, double alt0,
+                                 double lat, double lon, double alt)
+{
+    const double rad = M_PI / 180, a = 6378137.0, e2 = 6.69437999014E-3;
+    GeoReference r;
+    r.distance = odid_distance(lat0, lon0, lat, lon);
+    double dLon = (lon - lon0) * rad;
+    r.bearing = atan2(sin(dLon) * cos(lat * rad),
+                      cos(lat0 * rad) * sin(lat * rad) - sin(lat0 * rad) * cos(lat * rad) * cos(dLon)) / rad;
+    if (r.bearing < 0)
+        r.bearing += 360;
+
+    auto ecef = [&](double la, double lo, double h, double &x, double &y, double &z) {
+        double n = a / sqrt(1 - e2 * sin(la * rad) * sin(la * rad));
+        x = (n + h) * cos(la * rad) * cos(lo * rad);
+        y = (n + h) * cos(la * rad) * sin(lo * rad);
+        z = (n * (1 - e2) + h) * sin(la * rad);
+    };
+    double x0, y0, z0;
+    ecef(lat0, lon0, alt0, x0, y0, z0);
+    ecef(lat, lon, alt, r.x, r.y, r.z);
+    double dx = r.x - x0, dy = r.y - y0, dz = r.z - z0;
+    r.east = -sin(lon0 * rad) * dx + cos(lon0 * rad) * dy;
+    r.north = -sin(lat0 * rad) * (cos(lon0 * rad) * dx + sin(lon0 * rad) * dy) + cos(lat0 * rad) * dz;
+    r.up = cos(lat0 * rad) * (cos(lon0 * rad) * dx + sin(lon0 * rad) * dy) + sin(lat0 * rad) * dz;
+    return r;
+}
+
+struct GeoResults {
+    std::vector<double> distance, fast, bearing, x, y, z, east, north, up;
+
+    GeoResults(const ODID_Geo_points &points, size_t count, double lat0, double lon0, double alt0)
+        : distance(count), fast(count), bearing(count), x(count), y(count), z(count),
+          east(count), north(count), up(count)
+    {
+        EXPECT_EQ(odid_geo_distance(&points, count, lat0, lon0, distance.data()), ODID_SUCCESS);
+        EXPECT_EQ(odid_geo_distance_fast(&points, count, lat0, lon0, fast.data()), ODID_SUCCESS);
+        EXPECT_EQ(odid_geo_bearing(&points, count, lat0, lon0, bearing.data()), ODID_SUCCESS);
+        EXPECT_EQ(odid_geo_to_ecef(&points, count, x.data(), y.data(), z.data()), ODID_SUCCESS);
+        EXPECT_EQ(odid_geo_to_enu(&points, count, lat0, lon0, alt0,
+                                  east.data(), north.data(), up.data()), ODID_SUCCESS);
+    }
+};
+
+TEST(ODID, geodesy_batch_matches_reference)
+{
+    // Not a multiple of the block size, to cover the tail
+    const size_t count = 1003;
+    const double lat0 = 47.3977, lon0 = 8.5456, alt0 = 408;
+    std::vector<double> lat(count), lon(count);
+    std::vector<int32_t> latE7(count), lonE7(count);
+    std::vector<float> alt(count);
+    std::mt19937 gen(24680);
+    std::uniform_real_distribution<double> near(-0.2, 0.2), latAny(-89.9, 89.9), lonAny(-180, 180);
+    std::uniform_real_distribution<float> altitude(-100, 5000);
+    for (size_t i = 0; i < count; i++) {
+        // Mostly nearby positions, as seen by a receiver, and some anywhere
+        bool local = i % 8 != 0;
+        latE7[i] = (int32_t) lround((local ? lat0 + near(gen) : latAny(gen)) * 1E7);
+        lonE7[i] = (int32_t) lround((local ? lon0 + near(gen) : lonAny(gen)) * 1E7);
+        lat[i] = latE7[i] * 1E-7;
+        lon[i] = lonE7[i] * 1E-7;
+        alt[i] = altitude(gen);
+    }
+    ODID_Geo_points degrees = { lat.data(), lon.data(), nullptr, nullptr, alt.data() };
+    ODID_Geo_points encoded = { nullptr, nullptr, latE7.data(), lonE7.data(), alt.data() };
+
+    const ODID_simd_t levels[] = { ODID_SIMD_SCALAR, ODID_SIMD_SSE2, ODID_SIMD_AVX2 };
+    std::vector<GeoResults> results;
+    for (ODID_simd_t level : levels) {
+        odid_simd_select(level);
+        results.emplace_back(degrees, count, lat0, lon0, alt0);
+        GeoResults e7(encoded, count, lat0, lon0, alt0);
+        for (size_t i = 0; i < count; i++) {
+            // Both input formats give the same radians up to rounding
+            EXPECT_NEAR(e7.distance[i], results.back().distance[i], 1E-6) << i;
+            EXPECT_NEAR(e7.x[i], results.back().x[i], 1E-6) << i;
+        }
+    }
+    odid_simd_select(ODID_SIMD_AUTO);
+
+    for (size_t i = 0; i < count; i++) {
+        // All instruction sets give bit-identical results
+        for (size_t l = 1; l < results.size(); l++) {
+            EXPECT_EQ(results[l].distance[i], results[0].distance[i]) << i;
+            EXPECT_EQ(results[l].fast[i], results[0].fast[i]) << i;
+            EXPECT_EQ(results[l].bearing[i], results[0].bearing[i]) << i;
+            EXPECT_EQ(results[l].z[i], results[0].z[i]) << i;
+            EXPECT_EQ(results[l].east[i], results[0].east[i]) << i;
+            EXPECT_EQ(results[l].up[i], results[0].up[i]) << i;
+        }
+
+        const GeoResults &r = results[0];
+        GeoReference ref = geoReference(lat0, lon0, alt0, lat[i], lon[i], alt[i]);
+        EXPECT_NEAR(r.distance[i], ref.distance, 1E-6 + ref.distance * 1E-12) << i;
+        EXPECT_NEAR(r.bearing[i], ref.bearing, 1E-9) << i;
+        EXPECT_NEAR(r.x[i], ref.x, 1E-6) << i;
+        EXPECT_NEAR(r.y[i], ref.y, 1E-6) << i;
+        EXPECT_NEAR(r.z[i], ref.z, 1E-6) << i;
+        EXPECT_NEAR(r.east[i], ref.east, 1E-6) << i;
+        EXPECT_NEAR(r.north[i], ref.north, 1E-6) << i;
+        EXPECT_NEAR(r.up[i], ref.up, 1E-6) << i;
+        if (i % 8 != 0)
+            EXPECT_NEAR(r.fast[i], ref.distance, ref.distance * 1E-3) << i;
+    }
+
+    // The fast distance takes the short way around the antimeridian
+    double lonW = -179.9, fast;
+    ODID_Geo_points west = { &lat0, &lonW, nullptr, nullptr, nullptr };
+    ASSERT_EQ(odid_geo_distance_fast(&west, 1, lat0, 179.9, &fast), ODID_SUCCESS);
+    EXPECT_NEAR(fast, odid_distance(lat0, 179.9, lat0, lonW), 1);
+
+    // An incomplete pair in degrees is not used when the degE7 pair is complete
+    ODID_Geo_points mixed = encoded;
+    mixed.Latitude = lat.data();
+    std::vector<double> distance(count);
+    ASSERT_EQ(odid_geo_distance(&mixed, count, lat0, lon0, distance.data()), ODID_SUCCESS);
+    EXPECT_EQ(distance, GeoResults(encoded, count, lat0, lon0, alt0).distance);
+
+    ODID_Geo_points none = { nullptr, nullptr, nullptr, nullptr, nullptr };
+    EXPECT_EQ(odid_geo_distance(&none, 1, lat0, lon0, &fast), ODID_FAIL);
+    EXPECT_EQ(odid_geo_to_ecef(&degrees, count, &fast, nullptr, nullptr), ODID_FAIL);
+}
@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct ZoneSet {
+    std::vector<ODID_Geofence_zone> zones;
+    std::vector<ODID_Geofence_vertex> vertices;
+    std::vector<uint32_t> buckets;
+    std::vector<ODID_Geofence_ref> refs;
+    ODID_Geofence_zones set;
+
+    void add(uint32_t id, std::vector<ODID_Geofence_vertex> polygon,
+             float floor = INV_ALT, float ceiling = INV_ALT, uint64_t dwell = 0)
+    {
+        ODID_Geofence_zone zone = {};
+        zone.Id = id;
+        zone.FirstVertex = (uint32_t) vertices.size();
+        zone.VertexCount = (uint32_t) polygon.size();
+        zone.Floor = floor;
+        zone.Ceiling = ceiling;
+        zone.Dwell = dwell;
+        zones.push_back(zone);
+        vertices.insert(vertices.end(), polygon.begin(), polygon.end());
+    }
+
+    void build(double cellSize, uint32_t bucketCount)
+    {
+        ASSERT_EQ(odid_geofence_zones_init(&set, zones.data(), (uint32_t) zones.size(), vertices.data(),
+                                           (uint32_t) vertices.size(), cellSize), ODID_SUCCESS);
+        refs.resize(set.RefCount);
+        buckets.resize(bucketCount + 1);
+        ASSERT_EQ(odid_geofence_zones_build(&set, buckets.data(), bucketCount, refs.data(),
+                                            set.RefCount), ODID_SUCCESS);
+    }
+};
+
+struct Event {
+    uint32_t uas;
+    uint32_t zone;
+    ODID_geofence_event_t type;
+
+    bool operator==(const Event &other) const
+    {
+        return uas == other.uas && zone == other.zone && type == other.type;
+    }
+};
+
+static void recordEvent(ODID_Geofence *, uint32_t uas, uint32_t zoneId,
+                        ODID_geofence_event_t event, void *context)
+{
+    static_cast<std::vector<Event> *>(context)->push_back({ uas, zoneId, event });
+}
+
+// Even-odd rule in plain degrees, for zones away from the antimeridian
+static bool contains(const std::vector<ODID_Geofence_vertex> &v, double lat, double lon)
+{
+    bool inside = false;
+    for (size_t i = 0, j = v.size() - 1; i < v.size(); j = i++) {
+        if ((v[i].Latitude > lat) != (v[j].Latitude > lat) &&
+            lon < v[j].Longitude + (lat - v[j].Latitude) * (v[i].Longitude - v[j].Longitude) /
+                                   (v[i].Latitude - v[j].Latitude))
+            inside = !inside;
+    }
+    return inside;
+}
+
+TEST(ODID, geofence_find_matches_linear_scan)
+{
+    ZoneSet z;
+    std::vector<std::vector<ODID_Geofence_vertex>> polygons;
+    std::mt19937 gen(13579);
+    std::uniform_real_distribution<double> lat(44, 46), lon(4, 6), radius(0.005, 0.2), unit(0, 1);
+    for (uint32_t id = 0; id < 500; id++) {
+        // Random star shaped polygons, some of them concave
+        double cLat = lat(gen), cLon = lon(gen);
+        std::vector<ODID_Geofence_vertex> polygon;
+        int n = 3 + (int) (gen() % 8);
+        for (int k = 0; k < n; k++) {
+            double angle = 2 * M_PI * k / n;
+            double r = radius(gen) * (0.5 + unit(gen));
+            polygon.push_back({ cLat + r * sin(angle), cLon + r * cos(angle) });
+        }
+        polygons.push_back(polygon);
+        z.add(id, polygon, id % 3 == 0 ? 100.0f : INV_ALT, id % 3 == 0 ? 400.0f : INV_ALT);
+    }
+    // Few buckets, so that cells share buckets
+    z.build(0.05, 64);
+
+    std::vector<uint32_t> out(z.zones.size());
+    for (int i = 0; i < 5000; i++) {
+        double la = lat(gen), lo = lon(gen);
+        float altitude = i % 2 ? 50.0f : 200.0f;
+        std::vector<uint32_t> expected;
+        for (uint32_t id = 0; id < polygons.size(); id++) {
+            bool inAltitude = id % 3 != 0 || (altitude >= 100 && altitude <= 400);
+            if (inAltitude && contains(polygons[id], la, lo))
+                expected.push_back(id);
+        }
+        uint32_t found = odid_geofence_zones_find(&z.set, la, lo, altitude, out.data(), (uint32_t) out.size());
+        std::vector<uint32_t> ids(out.begin(), out.begin() + found);
+        std::sort(ids.begin(), ids.end());
+        EXPECT_EQ(ids, expected) << la << " " << lo;
+    }
+}
+
+TEST(ODID, geofence_enter_exit_dwell)
+{
+    ZoneSet z;
+    z.add(7, { { 10, 10 }, { 10, 11 }, { 11, 11 }, { 11, 10 } }, INV_ALT, INV_ALT, 30);
+    // Across the antimeridian, up to 120 m
+    z.add(9, { { 10, 179.5 }, { 10, -179.5 }, { 11, -179.5 }, { 11, 179.5 } }, INV_ALT, 120);
+    z.build(0.25, 16);
+
+    std::vector<ODID_Geofence_state> states(2);
+    uint64_t epochs[1];
+    std::vector<Event> events;
+    ODID_Geofence fence;
+    ASSERT_EQ(odid_geofence_init(&fence, states.data(), 2, epochs, 1, recordEvent, &events), ODID_SUCCESS);
+    EXPECT_EQ(odid_geofence_swap(&fence, &z.set), nullptr);
+
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Latitude = 10.5;
+    location.Longitude = 10.5;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 0, 0, &location), 1u);
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 0, 20, &location), 1u);
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 0, 30, &location), 1u);
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 0, 40, &location), 1u);
+    // An unknown position keeps the UAS where it was
+    location.Latitude = 0;
+    location.Longitude = 0;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 0, 50, &location), 1u);
+    location.Latitude = 10.5;
+    location.Longitude = 12;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 0, 60, &location), 0u);
+    std::vector<Event> expected = { { 0, 7, ODID_GEOFENCE_ENTER }, { 0, 7, ODID_GEOFENCE_DWELL },
+                                    { 0, 7, ODID_GEOFENCE_EXIT } };
+    EXPECT_EQ(events, expected);
+
+    events.clear();
+    location.Longitude = -179.8;
+    location.AltitudeGeo = 100;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 1, 0, &location), 1u);
+    location.Longitude = 179.8;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 1, 1, &location), 1u);
+    // Above the ceiling, then the barometric altitude is used when the geodetic one is not valid
+    location.AltitudeGeo = 150;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 1, 2, &location), 0u);
+    location.AltitudeGeo = INV_ALT;
+    location.AltitudeBaro = 80;
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 1, 3, &location), 1u);
+    expected = { { 1, 9, ODID_GEOFENCE_ENTER }, { 1, 9, ODID_GEOFENCE_EXIT },
+                 { 1, 9, ODID_GEOFENCE_ENTER } };
+    EXPECT_EQ(events, expected);
+
+    // Zones missing from a new set are exited at the next check
+    events.clear();
+    ZoneSet empty;
+    empty.build(1, 1);
+    EXPECT_EQ(odid_geofence_swap(&fence, &empty.set), &z.set);
+    EXPECT_EQ(odid_geofence_check(&fence, 0, 1, 4, &location), 0u);
+    expected = { { 1, 9, ODID_GEOFENCE_EXIT } };
+    EXPECT_EQ(events, expected);
+}
+
+TEST(ODID, geofence_operator_area)
+{
+    ZoneSet z;
+    z.add(1, { { 51.47, -0.49 }, { 51.47, -0.43 }, { 51.48, -0.43 }, { 51.48, -0.49 } }, INV_ALT, 150);
+    z.add(2, { { 51.50, -0.49 }, { 51.50, -0.43 }, { 51.51, -0.43 }, { 51.51, -0.49 } });
+    // Small cells, so that the zones and the area cover several of them
+    z.build(0.002, 64);
+
+    std::vector<ODID_Geofence_state> states(1);
+    uint64_t epochs[1];
+    ODID_Geofence fence;
+    ASSERT_EQ(odid_geofence_init(&fence, states.data(), 1, epochs, 1, nullptr, nullptr), ODID_SUCCESS);
+    odid_geofence_swap(&fence, &z.set);
+
+    ODID_System_data system;
+    odid_initSystemData(&system);
+    system.OperatorLatitude = 51.49;
+    system.OperatorLongitude = -0.46;
+    uint32_t out[4];
+    // 1.1 km from both zones
+    system.AreaRadius = 1000;
+    EXPECT_EQ(odid_geofence_check_area(&fence, 0, &system, out, 4), 0u);
+    system.AreaRadius = 1200;
+    ASSERT_EQ(odid_geofence_check_area(&fence, 0, &system, out, 4), 2u);
+    std::sort(out, out + 2);
+    EXPECT_EQ(out[0], 1u);
+    EXPECT_EQ(out[1], 2u);
+    // Above the ceiling of the first zone
+    system.AreaFloor = 200;
+    ASSERT_EQ(odid_geofence_check_area(&fence, 0, &system, out, 4), 1u);
+    EXPECT_EQ(out[0], 2u);
+    // The operator inside a zone
+    system.AreaRadius = 0;
+    system.OperatorLatitude = 51.505;
+    ASSERT_EQ(odid_geofence_check_area(&fence, 0, &system, out, 4), 1u);
+    EXPECT_EQ(out[0], 2u);
+}
+
+TEST(ODID, geofence_swap_while_checking)
+{
+    // Two zone sets with one zone each, swapped back and forth by this thread
+    ZoneSet a, b;
+    a.add(1, { { 0.5, 0.5 }, { 0.5, 2 }, { 2, 2 }, { 2, 0.5 } });
+    b.add(2, { { 0.5, 0.5 }, { 0.5, 2 }, { 2, 2 }, { 2, 0.5 } });
+    a.build(0.5, 8);
+    b.build(0.5, 8);
+
+    const uint32_t readers = 4;
+    std::vector<ODID_Geofence_state> states(readers);
+    std::vector<uint64_t> epochs(readers);
+    ODID_Geofence fence;
+    ASSERT_EQ(odid_geofence_init(&fence, states.data(), readers, epochs.data(), readers,
+                                 nullptr, nullptr), ODID_SUCCESS);
+    odid_geofence_swap(&fence, &a.set);
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint32_t> failures(0), checks(0);
+    std::vector<std::thread> threads;
+    for (uint32_t r = 0; r < readers; r++) {
+        threads.emplace_back([&, r]() {
+            ODID_Location_data location;
+            odid_initLocationData(&location);
+            location.Latitude = 1;
+            location.Longitude = 1;
+            while (!stop) {
+                if (odid_geofence_check(&fence, r, r, 0, &location) != 1)
+                    failures++;
+                checks++;
+                std::this_thread::yield();
+            }
+        });
+    }
+    ODID_Geofence_zones *spare = &b.set;
+    for (int i = 0; i < 500 || checks < 2000; i++) {
+        spare = odid_geofence_swap(&fence, spare);
+        // No reader uses the returned set anymore
+        uint32_t *buckets = spare->Buckets;
+        spare->Buckets = nullptr;
+        std::this_thread::yield();
+        spare->Buckets = buckets;
+    }
+    stop = true;
+    for (auto &t : threads)
+        t.join();
+    EXPECT_EQ(failures, 0u);
+}
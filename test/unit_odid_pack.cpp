@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <cerrno>
+
+static void buildTestData(ODID_UAS_Data *uas)
+{
+    odid_initUasData(uas);
+    uas->BasicID[0].UAType = ODID_UATYPE_HELICOPTER_OR_MULTIROTOR;
+    uas->BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas->BasicID[0].UASID, "1596F0123456789ABCDE");
+    uas->BasicIDValid[0] = 1;
+    uas->Location.Status = ODID_STATUS_AIRBORNE;
+    uas->Location.Latitude = 51.4791;
+    uas->Location.Longitude = -0.0013;
+    uas->Location.AltitudeGeo = 110.5f;
+    uas->LocationValid = 1;
+    uas->Auth[0].AuthType = ODID_AUTH_UAS_ID_SIGNATURE;
+    uas->Auth[0].Length = 10;
+    uas->AuthValid[0] = 1;
+    uas->SelfID.DescType = ODID_DESC_TYPE_TEXT;
+    strcpy(uas->SelfID.Desc, "Survey flight");
+    uas->SelfIDValid = 1;
+    uas->System.OperatorLatitude = 51.48;
+    uas->System.OperatorLongitude = -0.002;
+    uas->SystemValid = 1;
+    uas->OperatorID.OperatorIdType = ODID_OPERATOR_ID;
+    strcpy(uas->OperatorID.OperatorId, "GBR-OP-1234");
+    uas->OperatorIDValid = 1;
+}
+
+static void expectSamePack(ODID_Encoder_context *ctx, const ODID_UAS_Data *uas)
+{
+    uint8_t expected[sizeof(ODID_MessagePack_encoded)];
+    uint8_t cached[sizeof(ODID_MessagePack_encoded)];
+
+    int expectedLen = odid_message_build_pack(uas, expected, sizeof(expected));
+    int cachedLen = odid_message_build_pack_cached(ctx, uas, cached, sizeof(cached));
+    ASSERT_EQ(cachedLen, expectedLen);
+    if (expectedLen > 0)
+        EXPECT_EQ(memcmp(expected, cached, expectedLen), 0);
+}
+
+TEST(ODID, pack_cached_encodes_only_changed_messages)
+{
+    ODID_UAS_Data uas;
+    memset(&uas, 0, sizeof(uas));
+    buildTestData(&uas);
+
+    ODID_Encoder_context ctx;
+    odid_encoder_init(&ctx);
+    expectSamePack(&ctx, &uas);
+    EXPECT_EQ(ctx.encodes, 6u);
+
+    // Only the Location message changes from one cycle to the next
+    for (int i = 0; i < 10; i++) {
+        uas.Location.Latitude += 0.0001;
+        uas.Location.TimeStamp = (float) i;
+        expectSamePack(&ctx, &uas);
+    }
+    EXPECT_EQ(ctx.encodes, 6u + 10u);
+    EXPECT_EQ(ctx.hits, 10u * 5u);
+
+    // Changing or removing other messages is picked up as well
+    strcpy(uas.OperatorID.OperatorId, "GBR-OP-5678");
+    expectSamePack(&ctx, &uas);
+    EXPECT_EQ(ctx.encodes, 6u + 10u + 1u);
+    uas.SelfIDValid = 0;
+    expectSamePack(&ctx, &uas);
+    uas.SelfIDValid = 1;
+    expectSamePack(&ctx, &uas);
+
+    // Data that fails to encode is left out, like odid_message_build_pack() does
+    uas.Location.Latitude = 100;
+    expectSamePack(&ctx, &uas);
+}
+
+TEST(ODID, pack_cached_errors)
+{
+    ODID_UAS_Data uas;
+    memset(&uas, 0, sizeof(uas));
+    odid_initUasData(&uas);
+
+    ODID_Encoder_context ctx;
+    odid_encoder_init(&ctx);
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    EXPECT_EQ(odid_message_build_pack_cached(&ctx, &uas, pack, sizeof(pack)), -EINVAL);
+
+    buildTestData(&uas);
+    EXPECT_EQ(odid_message_build_pack_cached(&ctx, &uas, pack, 10), -ENOMEM);
+}
+
+TEST(ODID, pack_build_in_place)
+{
+    ODID_UAS_Data uas;
+    memset(&uas, 0, sizeof(uas));
+    buildTestData(&uas);
+    uas.BasicID[1] = uas.BasicID[0];
+    uas.BasicID[1].IDType = ODID_IDTYPE_CAA_REGISTRATION_ID;
+    uas.BasicIDValid[1] = 1;
+    uas.Auth[1].DataPage = 1;
+    uas.AuthValid[1] = 1;
+
+    // The same pack as the messages encoded one by one and packed
+    ODID_MessagePack_data data;
+    odid_initMessagePackData(&data);
+    ASSERT_EQ(encodeBasicIDMessage(&data.Messages[0].basicId, &uas.BasicID[0]), ODID_SUCCESS);
+    ASSERT_EQ(encodeBasicIDMessage(&data.Messages[1].basicId, &uas.BasicID[1]), ODID_SUCCESS);
+    ASSERT_EQ(encodeLocationMessage(&data.Messages[2].location, &uas.Location), ODID_SUCCESS);
+    ASSERT_EQ(encodeAuthMessage(&data.Messages[3].auth, &uas.Auth[0]), ODID_SUCCESS);
+    ASSERT_EQ(encodeAuthMessage(&data.Messages[4].auth, &uas.Auth[1]), ODID_SUCCESS);
+    ASSERT_EQ(encodeSelfIDMessage(&data.Messages[5].selfId, &uas.SelfID), ODID_SUCCESS);
+    ASSERT_EQ(encodeSystemMessage(&data.Messages[6].system, &uas.System), ODID_SUCCESS);
+    ASSERT_EQ(encodeOperatorIDMessage(&data.Messages[7].operatorId, &uas.OperatorID), ODID_SUCCESS);
+    data.MsgPackSize = 8;
+    ODID_MessagePack_encoded expected;
+    ASSERT_EQ(encodeMessagePack(&expected, &data), ODID_SUCCESS);
+
+    const int len = 3 + 8 * ODID_MESSAGE_SIZE;
+    uint8_t pack[sizeof(ODID_MessagePack_encoded)];
+    ASSERT_EQ(odid_message_build_pack(&uas, pack, len), len);
+    EXPECT_EQ(memcmp(pack, &expected, len), 0);
+    EXPECT_EQ(odid_message_build_pack(&uas, pack, len - 1), -ENOMEM);
+
+    // Data that fails to encode does not need room
+    uas.System.OperatorLatitude = 100;
+    uas.Location.Latitude = 100;
+    ASSERT_EQ(odid_message_build_pack(&uas, pack, len - 2 * ODID_MESSAGE_SIZE), len - 2 * ODID_MESSAGE_SIZE);
+    EXPECT_EQ(pack[2], 6);
+    EXPECT_EQ(pack[3 + 4 * ODID_MESSAGE_SIZE] >> 4, ODID_MESSAGETYPE_SELF_ID);
+
+    // More messages than fit in a pack
+    for (int i = 0; i < ODID_AUTH_MAX_PAGES; i++)
+        uas.AuthValid[i] = 1;
+    EXPECT_EQ(odid_message_build_pack(&uas, pack, sizeof(pack)), -EINVAL);
+}
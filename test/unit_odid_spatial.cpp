@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+struct SpatialIndex {
+    std::vector<ODID_Spatial_entry> entries;
+    std::vector<uint32_t> buckets;
+    ODID_Spatial_index index;
+
+    SpatialIndex(uint32_t count, uint32_t bucketCount, double cellSize)
+        : entries(count), buckets(bucketCount)
+    {
+        EXPECT_EQ(odid_spatial_init(&index, entries.data(), count, buckets.data(),
+                                    bucketCount, cellSize), ODID_SUCCESS);
+    }
+};
+
+struct Position {
+    double latitude;
+    double longitude;
+    bool indexed;
+};
+
+static std::vector<uint32_t> sorted(std::vector<uint32_t> ids, uint32_t count)
+{
+    ids.resize(count);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+TEST(ODID, spatial_queries_match_linear_scan)
+{
+    const uint32_t count = 2000;
+    // Few buckets, so that cells share buckets and large queries scan them all
+    SpatialIndex s(count, 256, 0.5);
+    std::vector<Position> positions(count);
+    std::mt19937 gen(97531);
+    // Clustered around the antimeridian and spread over the whole earth
+    std::uniform_real_distribution<double> lat(-90, 90), lon(-180, 180), near(-3, 3);
+
+    for (int round = 0; round < 3; round++) {
+        for (uint32_t id = 0; id < count; id++) {
+            Position &p = positions[id];
+            if (gen() % 10 == 0) {
+                odid_spatial_remove(&s.index, id);
+                p.indexed = false;
+                continue;
+            }
+            if (gen() % 2) {
+                p.latitude = lat(gen);
+                p.longitude = lon(gen);
+            } else {
+                p.latitude = 60 + near(gen);
+                p.longitude = 178 + near(gen);
+                if (p.longitude > 180)
+                    p.longitude -= 360;
+            }
+            p.indexed = true;
+            odid_spatial_update(&s.index, id, p.latitude, p.longitude);
+        }
+
+        const double boxes[][4] = { { 58, 177, 62, -179 }, { -10, -20, 30, 40 },
+                                    { 59.5, 179.5, 60.5, 179.9 }, { -90, -180, 90, 180 } };
+        for (auto &box : boxes) {
+            std::vector<uint32_t> expected;
+            for (uint32_t id = 0; id < count; id++) {
+                const Position &p = positions[id];
+                bool inLon = box[1] <= box[3] ? p.longitude >= box[1] && p.longitude <= box[3]
+                                              : p.longitude >= box[1] || p.longitude <= box[3];
+                if (p.indexed && p.latitude >= box[0] && p.latitude <= box[2] && inLon)
+                    expected.push_back(id);
+            }
+            std::vector<uint32_t> out(count);
+            uint32_t found = odid_spatial_box(&s.index, box[0], box[1], box[2], box[3], out.data(), count);
+            EXPECT_EQ(sorted(out, found), expected);
+        }
+
+        const double circles[][3] = { { 60, 179.9, 150000 }, { 60, -179.9, 1000 },
+                                      { 89, 0, 500000 }, { 0, 0, 20000000 } };
+        for (auto &circle : circles) {
+            std::vector<std::pair<double, uint32_t>> expected;
+            for (uint32_t id = 0; id < count; id++) {
+                const Position &p = positions[id];
+                double distance = odid_distance(circle[0], circle[1], p.latitude, p.longitude);
+                if (p.indexed && distance <= circle[2])
+                    expected.push_back({ distance, id });
+            }
+            std::sort(expected.begin(), expected.end());
+            std::vector<uint32_t> expectedIds;
+            for (auto &e : expected)
+                expectedIds.push_back(e.second);
+
+            std::vector<uint32_t> out(count);
+            uint32_t found = odid_spatial_radius(&s.index, circle[0], circle[1], circle[2],
+                                                 out.data(), count);
+            EXPECT_EQ(sorted(out, found), sorted(expectedIds, (uint32_t) expectedIds.size()));
+
+            // The nearest neighbours of the center are the first ones
+            const uint32_t k = 5;
+            uint32_t nearest[k];
+            double distances[k];
+            found = odid_spatial_nearest(&s.index, circle[0], circle[1], k, nearest, distances);
+            ASSERT_EQ(found, k);
+            if (expected.size() >= k) {
+                for (uint32_t i = 0; i < k; i++) {
+                    EXPECT_EQ(nearest[i], expected[i].second);
+                    EXPECT_DOUBLE_EQ(distances[i], expected[i].first);
+                }
+            }
+        }
+    }
+}
+
+TEST(ODID, spatial_track_positions)
+{
+    const uint32_t capacity = 4;
+    std::vector<ODID_Track> tracks(capacity);
+    std::vector<ODID_Track_slot> slots(odid_track_slot_count(capacity));
+    ODID_Track_table table;
+    ASSERT_EQ(odid_track_table_init(&table, tracks.data(), capacity, slots.data(),
+                                    (uint32_t) slots.size()), ODID_SUCCESS);
+    SpatialIndex s(capacity * ODID_TRACK_POSITIONS, 16, 0.01);
+    ASSERT_EQ(odid_track_enable_spatial(&table, &s.index), ODID_SUCCESS);
+
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    ODID_Message_encoded msg;
+    ASSERT_EQ(encodeLocationMessage(&msg.location, &location), ODID_SUCCESS);
+    ODID_Track_key key;
+    odid_track_key_uasid(&key, "1596F0123456789ABCDE");
+    odid_track_decode(&table, &key, 1, msg.rawData);
+
+    ODID_System_data system;
+    odid_initSystemData(&system);
+    system.OperatorLatitude = 51.48;
+    system.OperatorLongitude = -0.002;
+    ASSERT_EQ(encodeSystemMessage(&msg.system, &system), ODID_SUCCESS);
+    odid_track_decode(&table, &key, 2, msg.rawData);
+    ODID_Track *track = odid_track_find(&table, &key);
+    ASSERT_NE(track, nullptr);
+    uint32_t base = (uint32_t) (track - table.Tracks) * ODID_TRACK_POSITIONS;
+
+    uint32_t out[4];
+    ASSERT_EQ(odid_spatial_radius(&s.index, 51.4791, -0.0013, 50, out, 4), 1u);
+    EXPECT_EQ(out[0], base + ODID_TRACK_POSITION_UAS);
+    ASSERT_EQ(odid_spatial_radius(&s.index, 51.4791, -0.0013, 200, out, 4), 2u);
+
+    // The UAS moves out of the area, its operator stays
+    location.Latitude = 51.5;
+    ASSERT_EQ(encodeLocationMessage(&msg.location, &location), ODID_SUCCESS);
+    odid_track_decode(&table, &key, 3, msg.rawData);
+    ASSERT_EQ(odid_spatial_box(&s.index, 51.47, -0.01, 51.49, 0, out, 4), 1u);
+    EXPECT_EQ(out[0], base + ODID_TRACK_POSITION_OPERATOR);
+
+    odid_track_remove(&table, track);
+    EXPECT_EQ(s.index.Size, 0u);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+static void collectTimer(ODID_Timer_wheel *wheel, uint32_t timer, void *context)
+{
+    (void) wheel;
+    static_cast<std::set<uint32_t> *>(context)->insert(timer);
+}
+
+TEST(ODID, timer_wheel_matches_reference)
+{
+    const uint32_t count = 256;
+    const uint64_t resolution = 3;
+    std::vector<ODID_Timer> timers(count);
+    ODID_Timer_wheel wheel;
+    uint64_t now = 1000;
+    ASSERT_EQ(odid_timer_wheel_init(&wheel, timers.data(), count, now, resolution), ODID_SUCCESS);
+
+    std::mt19937 gen(2468);
+    std::uniform_int_distribution<uint32_t> timer(0, count - 1);
+    // Delays and steps covering all levels of the wheel and beyond
+    const uint64_t ranges[] = { 100, 5000, 300000, 60000000 };
+    std::map<uint32_t, uint64_t> expires; // Reference: timer -> expiry time
+
+    for (int i = 0; i < 20000; i++) {
+        uint32_t n = timer(gen);
+        switch (gen() % 4) {
+        case 0:
+            odid_timer_cancel(&wheel, n);
+            expires.erase(n);
+            break;
+        case 1:
+        case 2: {
+            uint64_t delay = std::uniform_int_distribution<uint64_t>(0, ranges[gen() % 4])(gen);
+            odid_timer_schedule(&wheel, n, now + delay);
+            // Rounded up to the resolution, at least the next tick
+            uint64_t tick = (now + delay + resolution - 1) / resolution;
+            expires[n] = std::max(tick, now / resolution + 1);
+            break;
+        }
+        default: {
+            now += std::uniform_int_distribution<uint64_t>(1, ranges[gen() % 3])(gen);
+            std::set<uint32_t> fired, expected;
+            for (auto it = expires.begin(); it != expires.end();) {
+                if (it->second <= now / resolution) {
+                    expected.insert(it->first);
+                    it = expires.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            EXPECT_EQ(odid_timer_wheel_advance(&wheel, now, collectTimer, &fired), expected.size());
+            ASSERT_EQ(fired, expected) << "at " << now;
+            break;
+        }
+        }
+        ASSERT_EQ(wheel.Pending, expires.size());
+    }
+
+    // Everything fires eventually
+    std::set<uint32_t> fired;
+    EXPECT_EQ(odid_timer_wheel_advance(&wheel, now + 100000000, collectTimer, &fired), expires.size());
+    EXPECT_EQ(wheel.Pending, 0u);
+}
+
+TEST(ODID, timer_wheel_skips_idle_rounds)
+{
+    std::vector<ODID_Timer> timers(2);
+    ODID_Timer_wheel wheel;
+    ASSERT_EQ(odid_timer_wheel_init(&wheel, timers.data(), 2, 0, 1), ODID_SUCCESS);
+
+    // Timers on the two highest levels, and one beyond the range of the wheel
+    const uint64_t far = (uint64_t) 1 << (ODID_WHEEL_SLOT_BITS * ODID_WHEEL_LEVELS);
+    odid_timer_schedule(&wheel, 0, 300000);
+    odid_timer_schedule(&wheel, 1, 3 * far + 12345);
+    std::set<uint32_t> fired;
+    EXPECT_EQ(odid_timer_wheel_advance(&wheel, 299999, collectTimer, &fired), 0u);
+    EXPECT_EQ(odid_timer_wheel_advance(&wheel, 300000, collectTimer, &fired), 1u);
+    EXPECT_EQ(fired, std::set<uint32_t>{ 0 });
+    EXPECT_EQ(odid_timer_wheel_advance(&wheel, 3 * far + 12344, collectTimer, &fired), 0u);
+    EXPECT_EQ(odid_timer_wheel_advance(&wheel, 3 * far + 12345, collectTimer, &fired), 1u);
+    EXPECT_EQ(wheel.Pending, 0u);
+    EXPECT_EQ(wheel.Tick, 3 * far + 12345);
+}
+
+struct Timeout {
+    uint32_t track;
+    ODID_messagetype_t type;
+};
+
+static void collectTimeout(ODID_Track_table *table, ODID_Track *track,
+                           ODID_messagetype_t type, void *context)
+{
+    uint32_t index = (uint32_t) (track - table->Tracks);
+    static_cast<std::vector<Timeout> *>(context)->push_back({ index, type });
+}
+
+TEST(ODID, timer_track_timeouts)
+{
+    const uint32_t capacity = 4;
+    std::vector<ODID_Track> tracks(capacity);
+    std::vector<ODID_Track_slot> slots(odid_track_slot_count(capacity));
+    std::vector<ODID_Timer> timers(capacity * ODID_TRACK_TIMERS);
+    ODID_Track_table table;
+    ASSERT_EQ(odid_track_table_init(&table, tracks.data(), capacity, slots.data(),
+                                    (uint32_t) slots.size()), ODID_SUCCESS);
+
+    std::vector<Timeout> timeouts;
+    ODID_Track_timeouts config = {};
+    config.Lost = 10000;
+    config.Stale[ODID_MESSAGETYPE_LOCATION] = 3000;
+    config.Callback = collectTimeout;
+    config.Context = &timeouts;
+    ASSERT_EQ(odid_track_enable_timeouts(&table, &config, timers.data(), 0, 100), ODID_SUCCESS);
+
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Latitude = 51.4791;
+    ODID_Message_encoded msg;
+    ASSERT_EQ(encodeLocationMessage(&msg.location, &location), ODID_SUCCESS);
+    ODID_Track_key key;
+    odid_track_key_uasid(&key, "1596F0123456789ABCDE");
+    odid_track_decode(&table, &key, 1000, msg.rawData);
+    ODID_Track *track = odid_track_find(&table, &key);
+    ASSERT_NE(track, nullptr);
+
+    // Location stale after 3 s without a new Location
+    EXPECT_EQ(odid_track_advance(&table, 3900), 0u);
+    EXPECT_EQ(odid_track_advance(&table, 4000), 1u);
+    ASSERT_EQ(timeouts.size(), 1u);
+    EXPECT_EQ(timeouts[0].type, ODID_MESSAGETYPE_LOCATION);
+    EXPECT_EQ(timeouts[0].track, (uint32_t) (track - table.Tracks));
+
+    // Other messages keep the track alive, but not the Location
+    ODID_SelfID_data selfId;
+    odid_initSelfIDData(&selfId);
+    ASSERT_EQ(encodeSelfIDMessage(&msg.selfId, &selfId), ODID_SUCCESS);
+    odid_track_decode(&table, &key, 9000, msg.rawData);
+    EXPECT_EQ(odid_track_advance(&table, 18000), 0u);
+    EXPECT_EQ(timeouts.size(), 1u);
+
+    // Lost contact: reported, then the track is removed
+    EXPECT_EQ(odid_track_advance(&table, 19000), 1u);
+    ASSERT_EQ(timeouts.size(), 2u);
+    EXPECT_EQ(timeouts[1].type, ODID_MESSAGETYPE_INVALID);
+    EXPECT_EQ(odid_track_find(&table, &key), nullptr);
+    EXPECT_EQ(table.Count, 0u);
+    EXPECT_EQ(config.Wheel.Pending, 0u);
+
+    // Removed tracks don't time out
+    odid_track_decode(&table, &key, 20000, msg.rawData);
+    odid_track_remove(&table, odid_track_find(&table, &key));
+    EXPECT_EQ(odid_track_advance(&table, 100000), 0u);
+}
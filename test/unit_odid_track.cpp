@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+struct TrackTable {
+    std::vector<ODID_Track> tracks;
+    std::vector<ODID_Track_slot> slots;
+    ODID_Track_table table;
+
+    explicit TrackTable(uint32_t capacity)
+        : tracks(capacity), slots(odid_track_slot_count(capacity))
+    {
+        EXPECT_EQ(odid_track_table_init(&table, tracks.data(), capacity,
+                                        slots.data(), (uint32_t) slots.size()), ODID_SUCCESS);
+    }
+};
+
+static ODID_Track_key macKey(uint32_t n)
+{
+    uint8_t mac[6] = { 0x02, 0x00, (uint8_t) (n >> 24), (uint8_t) (n >> 16),
+                       (uint8_t) (n >> 8), (uint8_t) n };
+    ODID_Track_key key;
+    odid_track_key_mac(&key, mac);
+    return key;
+}
+
+TEST(ODID, track_table_matches_reference)
+{
+    const uint32_t capacity = 64;
+    TrackTable t(capacity);
+    std::mt19937 gen(1357);
+    std::uniform_int_distribution<uint32_t> id(0, 199);
+    std::map<uint32_t, uint64_t> lastSeen; // Reference: id -> time last seen
+
+    for (uint64_t now = 1; now <= 20000; now++) {
+        uint32_t n = id(gen);
+        ODID_Track_key key = macKey(n);
+        if (gen() % 8 == 0) {
+            ODID_Track *track = odid_track_find(&t.table, &key);
+            EXPECT_EQ(track != nullptr, lastSeen.count(n) == 1);
+            odid_track_remove(&t.table, track);
+            lastSeen.erase(n);
+            continue;
+        }
+
+        if (!lastSeen.count(n) && lastSeen.size() == capacity) {
+            // The least recently seen track is evicted
+            auto oldest = lastSeen.begin();
+            for (auto it = lastSeen.begin(); it != lastSeen.end(); ++it)
+                if (it->second < oldest->second)
+                    oldest = it;
+            lastSeen.erase(oldest);
+        }
+        ODID_Track *track = odid_track_update(&t.table, &key, now);
+        ASSERT_NE(track, nullptr);
+        EXPECT_EQ(memcmp(&track->Key, &key, sizeof(key)), 0);
+        EXPECT_EQ(track->LastSeen, now);
+        lastSeen[n] = now;
+        ASSERT_EQ(t.table.Count, lastSeen.size());
+    }
+
+    for (uint32_t n = 0; n < 200; n++) {
+        ODID_Track_key key = macKey(n);
+        ODID_Track *track = odid_track_find(&t.table, &key);
+        ASSERT_EQ(track != nullptr, lastSeen.count(n) == 1) << n;
+        if (track)
+            EXPECT_EQ(track->LastSeen, lastSeen[n]);
+    }
+    EXPECT_GT(t.table.Evictions, 0u);
+
+    // Expire everything not seen during the last 100 time units
+    uint32_t expected = 0;
+    for (auto &entry : lastSeen)
+        if (20000 - entry.second > 100)
+            expected++;
+    EXPECT_EQ(odid_track_expire(&t.table, 20000, 100), expected);
+    EXPECT_EQ(t.table.Count, lastSeen.size() - expected);
+}
+
+TEST(ODID, track_decode_merges_messages)
+{
+    TrackTable t(4);
+    std::vector<ODID_Message_memo> memos(4);
+    odid_track_enable_memo(&t.table, memos.data());
+    ODID_Track_key key;
+    odid_track_key_uasid(&key, "1596F0123456789ABCDE");
+
+    ODID_Location_data location;
+    odid_initLocationData(&location);
+    location.Status = ODID_STATUS_AIRBORNE;
+    location.Latitude = 51.4791;
+    location.Longitude = -0.0013;
+    ODID_Message_encoded msg;
+    encodeLocationMessage(&msg.location, &location);
+    EXPECT_EQ(odid_track_decode(&t.table, &key, 10, msg.rawData), ODID_MESSAGETYPE_LOCATION);
+
+    ODID_OperatorID_data operatorId;
+    odid_initOperatorIDData(&operatorId);
+    strcpy(operatorId.OperatorId, "GBR-OP-1234");
+    encodeOperatorIDMessage(&msg.operatorId, &operatorId);
+    EXPECT_EQ(odid_track_decode(&t.table, &key, 20, msg.rawData), ODID_MESSAGETYPE_OPERATOR_ID);
+
+    ODID_Track *track = odid_track_find(&t.table, &key);
+    ASSERT_NE(track, nullptr);
+    EXPECT_EQ(track->FirstSeen, 10u);
+    EXPECT_EQ(track->LastSeen, 20u);
+    EXPECT_TRUE(track->Data.LocationValid);
+    EXPECT_TRUE(track->Data.OperatorIDValid);
+    EXPECT_NEAR(track->Data.Location.Latitude, 51.4791, 1e-6);
+    EXPECT_STREQ(track->Data.OperatorID.OperatorId, "GBR-OP-1234");
+
+    // The repeated Operator ID is only timestamped
+    track->Changed = 0;
+    EXPECT_EQ(odid_track_decode(&t.table, &key, 30, msg.rawData), ODID_MESSAGETYPE_OPERATOR_ID);
+    ODID_Message_memo *memo = odid_track_memo(&t.table, track);
+    ASSERT_NE(memo, nullptr);
+    EXPECT_EQ(memo->Hits, 1u);
+    EXPECT_EQ(memo->Misses, 2u);
+    EXPECT_EQ(track->Changed, 0u);
+    EXPECT_EQ(track->Timestamps.OperatorID, 30u);
+}
+
+TEST(ODID, track_nan_action_frame)
+{
+    TrackTable t(4);
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    uas.Location.Status = ODID_STATUS_AIRBORNE;
+    uas.Location.Latitude = 51.4791;
+    uas.LocationValid = 1;
+    strcpy(uas.SelfID.Desc, "Survey flight");
+    uas.SelfIDValid = 1;
+
+    const char mac[6] = { 0x02, 0x00, 0x5E, 0x10, 0x00, 0x01 };
+    uint8_t frame[1024];
+    int len = odid_wifi_build_message_pack_nan_action_frame(&uas, mac, 1, frame, sizeof(frame));
+    ASSERT_GT(len, 0);
+
+    ODID_Track *track = nullptr;
+    ASSERT_EQ(odid_wifi_track_message_pack_nan_action_frame(&t.table, 5, frame, len, &track), 0);
+    ODID_Track_key key;
+    odid_track_key_mac(&key, (const uint8_t *) mac);
+    EXPECT_EQ(odid_track_find(&t.table, &key), track);
+    EXPECT_TRUE(track->Data.LocationValid);
+    EXPECT_TRUE(track->Data.SelfIDValid);
+    EXPECT_STREQ(track->Data.SelfID.Desc, "Survey flight");
+
+    // A truncated frame is rejected without touching the table
+    EXPECT_LT(odid_wifi_track_message_pack_nan_action_frame(&t.table, 6, frame, len - 10, nullptr), 0);
+    EXPECT_EQ(track->LastSeen, 5u);
+
+    // The receive function still decodes the same frame
+    ODID_UAS_Data rx;
+    char rxMac[6];
+    ASSERT_EQ(odid_wifi_receive_message_pack_nan_action_frame(&rx, rxMac, frame, len), 0);
+    EXPECT_EQ(memcmp(rxMac, mac, sizeof(mac)), 0);
+    EXPECT_STREQ(rx.SelfID.Desc, "Survey flight");
+}
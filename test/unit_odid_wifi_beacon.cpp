@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <opendroneid.h>
 
+#include <cerrno>
+#include <cstring>
+
 ODID_UAS_Data testData = {
     .BasicID = {{ODID_UATYPE_HYBRID_LIFT, ODID_IDTYPE_SERIAL_NUMBER, "USS-Enterprise"},
                 {ODID_UATYPE_NONE, ODID_IDTYPE_NONE, ""}},
@@ -160,3 +163,120 @@ TEST(ODID, beacon_transport_build_frame)
     for (int i = 0; i < sizeof(expectedBuffer); i++)
             EXPECT_EQ(buffer[i], expectedBuffer[i]) << "failure @index " << i;
 }
+
+static void expectSameFrame(const uint8_t *frame, int frameLen, const uint8_t *expected, int expectedLen,
+                            bool timestamp)
+{
+    ASSERT_EQ(frameLen, expectedLen);
+    for (int i = 0; i < frameLen; i++) {
+        // The beacon timestamps are taken at different times
+        if (timestamp && i >= 24 && i < 32)
+            continue;
+        EXPECT_EQ(frame[i], expected[i]) << "failure @index " << i;
+    }
+}
+
+TEST(ODID, wifi_prepared_frames)
+{
+    ODID_UAS_Data uas = testData;
+    uint8_t prepared[512], expected[512];
+    ODID_Wifi_frame beacon, action, sync;
+
+    ASSERT_EQ(odid_wifi_prepare_frame(&beacon, ODID_WIFI_BEACON, mac, "testSSID", 8, 100,
+                                      prepared, sizeof(prepared)), 0);
+    for (int counter = 0; counter < 4; counter++) {
+        // The variable parts change between transmissions
+        uas.Location.Latitude = 47.1 + counter;
+        uas.SelfIDValid = counter & 1;
+        int len = odid_wifi_build_prepared_frame(&beacon, &uas, (uint8_t) counter);
+        int expectedLen = odid_wifi_build_message_pack_beacon_frame(&uas, mac, "testSSID", 8, 100,
+                                                                    (uint8_t) counter,
+                                                                    expected, sizeof(expected));
+        expectSameFrame(prepared, len, expected, expectedLen, true);
+    }
+
+    ASSERT_EQ(odid_wifi_prepare_frame(&action, ODID_WIFI_NAN_ACTION, mac, NULL, 0, 0,
+                                      prepared, sizeof(prepared)), 0);
+    for (int counter = 0; counter < 4; counter++) {
+        uas.SelfIDValid = counter & 1;
+        int len = odid_wifi_build_prepared_frame(&action, &uas, (uint8_t) counter);
+        int expectedLen = odid_wifi_build_message_pack_nan_action_frame(&uas, mac, (uint8_t) counter,
+                                                                        expected, sizeof(expected));
+        expectSameFrame(prepared, len, expected, expectedLen, false);
+    }
+
+    ASSERT_EQ(odid_wifi_prepare_frame(&sync, ODID_WIFI_NAN_SYNC, mac, NULL, 0, 0x0200,
+                                      prepared, sizeof(prepared)), 0);
+    expectSameFrame(prepared, odid_wifi_build_prepared_frame(&sync, NULL, 0), expected,
+                    odid_wifi_build_nan_sync_beacon_frame(mac, expected, sizeof(expected)), true);
+
+    // Invalid arguments and buffers too small for the frame
+    EXPECT_EQ(odid_wifi_prepare_frame(&beacon, ODID_WIFI_BEACON, mac, "", 0, 100,
+                                      prepared, sizeof(prepared)), -EINVAL);
+    EXPECT_EQ(odid_wifi_prepare_frame(&beacon, 3, mac, NULL, 0, 0, prepared, sizeof(prepared)), -EINVAL);
+    EXPECT_EQ(odid_wifi_prepare_frame(&action, ODID_WIFI_NAN_ACTION, mac, NULL, 0, 0, prepared, 40),
+              -ENOMEM);
+    ASSERT_EQ(odid_wifi_prepare_frame(&action, ODID_WIFI_NAN_ACTION, mac, NULL, 0, 0, prepared, 100), 0);
+    EXPECT_EQ(odid_wifi_build_prepared_frame(&action, &uas, 0), -ENOMEM);
+    EXPECT_EQ(odid_wifi_build_prepared_frame(&action, NULL, 0), -EINVAL);
+}
+
+TEST(ODID, beacon_transport_receive_frame)
+{
+    ODID_UAS_Data uas = testData, decoded;
+    uint8_t frame[512], captured[512];
+    const uint8_t *pack;
+    uint8_t counter = 0;
+    char sa[6];
+
+    int len = odid_wifi_build_message_pack_beacon_frame(&uas, mac, "testSSID", 8, 100, 0x42,
+                                                        frame, sizeof(frame));
+    ASSERT_GT(len, 0);
+    int packLen = odid_wifi_find_message_pack_beacon_frame(frame, len, sa, &pack, &counter);
+    ASSERT_EQ(packLen, 3 + 3 * 25);
+    EXPECT_EQ(pack, frame + len - packLen);
+    EXPECT_EQ(counter, 0x42);
+    EXPECT_EQ(memcmp(sa, mac, sizeof(mac)), 0);
+    ASSERT_EQ(odid_wifi_receive_message_pack_beacon_frame(&decoded, NULL, frame, len), 0);
+    EXPECT_EQ(decoded.LocationValid, 1);
+    EXPECT_STREQ(decoded.BasicID[0].UASID, "USS-Enterprise");
+
+    // Elements of an access point around the ODID element: DS parameter set,
+    // TIM, country, a WMM vendor element, and HT capabilities after it
+    const uint8_t before[] = {
+        0x03, 0x01, 0x06,
+        0x05, 0x04, 0x00, 0x01, 0x00, 0x00,
+        0x07, 0x06, 'F', 'R', 0x20, 0x01, 0x0d, 0x14,
+        0xdd, 0x07, 0x00, 0x50, 0xf2, 0x02, 0x00, 0x01, 0x00,
+    };
+    const uint8_t after[] = {
+        0x2d, 0x1a, 0xef, 0x11, 0x17, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    int body = 24 + 12 + 2 + 8 + 3;
+    int capturedLen = 0;
+    memcpy(captured, frame, body);
+    capturedLen += body;
+    memcpy(captured + capturedLen, before, sizeof(before));
+    capturedLen += sizeof(before);
+    memcpy(captured + capturedLen, frame + body, len - body);
+    capturedLen += len - body;
+    memcpy(captured + capturedLen, after, sizeof(after));
+    capturedLen += sizeof(after);
+    ASSERT_EQ(odid_wifi_find_message_pack_beacon_frame(captured, capturedLen, NULL, &pack, NULL), packLen);
+    EXPECT_EQ(memcmp(pack, frame + len - packLen, packLen), 0);
+
+    // Truncated frames, elements and packs
+    EXPECT_EQ(odid_wifi_find_message_pack_beacon_frame(frame, 30, NULL, &pack, NULL), -EINVAL);
+    EXPECT_EQ(odid_wifi_find_message_pack_beacon_frame(frame, len - 1, NULL, &pack, NULL), -EINVAL);
+    frame[len - packLen - 6] -= 25;
+    EXPECT_EQ(odid_wifi_find_message_pack_beacon_frame(frame, len, NULL, &pack, NULL), -EINVAL);
+    frame[len - packLen - 6] += 25;
+
+    // Beacons without ODID element and other frames
+    EXPECT_EQ(odid_wifi_find_message_pack_beacon_frame(frame, body, NULL, &pack, NULL), -EINVAL);
+    frame[len - packLen - 2] = 0x0E;
+    EXPECT_EQ(odid_wifi_find_message_pack_beacon_frame(frame, len, NULL, &pack, NULL), -EINVAL);
+    len = odid_wifi_build_message_pack_nan_action_frame(&uas, mac, 0, frame, sizeof(frame));
+    EXPECT_EQ(odid_wifi_find_message_pack_beacon_frame(frame, len, NULL, &pack, NULL), -EINVAL);
+}
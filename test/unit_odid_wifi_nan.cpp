@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+static const char mac[6] = { 0x02, 0x00, 0x5E, 0x10, 0x00, 0x01 };
+static const uint8_t odidServiceId[6] = { 0x88, 0x69, 0x19, 0x9D, 0x92, 0x09 };
+
+static void appendAttribute(std::vector<uint8_t> &frame, uint8_t id, const std::vector<uint8_t> &body)
+{
+    frame.push_back(id);
+    frame.push_back((uint8_t) body.size());
+    frame.push_back((uint8_t) (body.size() >> 8));
+    frame.insert(frame.end(), body.begin(), body.end());
+}
+
+// Service descriptor with the optional fields in front of the service info
+static std::vector<uint8_t> serviceDescriptor(const uint8_t *serviceId, uint8_t control,
+                                              uint8_t counter, const uint8_t *pack, int packLen)
+{
+    std::vector<uint8_t> body(serviceId, serviceId + 6);
+    body.push_back(0x01);                           // Instance ID
+    body.push_back(0x00);                           // Requestor instance ID
+    body.push_back(control);
+    if (control & 0x40)
+        body.insert(body.end(), { 0x01, 0x00 });    // Binding bitmap
+    if (control & 0x04)
+        body.insert(body.end(), { 0x02, 0xAA, 0xBB }); // Matching filter
+    if (control & 0x08)
+        body.insert(body.end(), { 0x01, 0xCC });    // Service response filter
+    if (control & 0x10) {
+        body.push_back((uint8_t) (1 + packLen));
+        body.push_back(counter);
+        body.insert(body.end(), pack, pack + packLen);
+    }
+    return body;
+}
+
+TEST(ODID, nan_action_frame_attributes)
+{
+    ODID_UAS_Data uas, rx;
+    odid_initUasData(&uas);
+    uas.Location.Status = ODID_STATUS_AIRBORNE;
+    uas.Location.Latitude = 51.4791;
+    uas.LocationValid = 1;
+    strcpy(uas.SelfID.Desc, "Survey flight");
+    uas.SelfIDValid = 1;
+
+    uint8_t built[512];
+    int len = odid_wifi_build_message_pack_nan_action_frame(&uas, mac, 7, built, sizeof(built));
+    ASSERT_GT(len, 0);
+
+    ODID_Wifi_nan_attributes attrs;
+    const uint8_t *descriptor, *pack;
+    uint8_t counter;
+    char sa[6];
+    ASSERT_EQ(odid_wifi_nan_action_frame_attributes(&attrs, built, len, sa), 0);
+    EXPECT_EQ(memcmp(sa, mac, sizeof(mac)), 0);
+    int packLen = odid_wifi_nan_next_message_pack(&attrs, &descriptor, &pack, &counter);
+    ASSERT_EQ(packLen, 3 + 2 * 25);
+    EXPECT_EQ(descriptor, built + 24 + 6);
+    EXPECT_EQ(pack, descriptor + 3 + 11);
+    EXPECT_EQ(counter, 7);
+    EXPECT_EQ(odid_wifi_nan_next_message_pack(&attrs, &descriptor, &pack, &counter), 0);
+
+    // As sent by another NAN stack: a device capability attribute, a service
+    // descriptor of another service, and two ODID service descriptors with
+    // optional fields, the second one with the System message only
+    uint8_t system[3 + 25];
+    ODID_UAS_Data systemOnly;
+    odid_initUasData(&systemOnly);
+    systemOnly.System.OperatorLatitude = 51.4780;
+    systemOnly.SystemValid = 1;
+    int systemLen = odid_message_build_pack(&systemOnly, system, sizeof(system));
+    ASSERT_EQ(systemLen, (int) sizeof(system));
+
+    const uint8_t otherServiceId[6] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+    std::vector<uint8_t> frame(built, built + 24 + 6);
+    appendAttribute(frame, 0x0F, { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 });
+    appendAttribute(frame, 0x03, serviceDescriptor(otherServiceId, 0x10, 0, system, systemLen));
+    appendAttribute(frame, 0x03, serviceDescriptor(odidServiceId, 0x5C, 8, pack, packLen));
+    appendAttribute(frame, 0x03, serviceDescriptor(odidServiceId, 0x02, 0, nullptr, 0));
+    appendAttribute(frame, 0x03, serviceDescriptor(odidServiceId, 0x10, 9, system, systemLen));
+    appendAttribute(frame, 0x0E, { 0x01, 0x00, 0x02, 0x09 });
+
+    ASSERT_EQ(odid_wifi_nan_action_frame_attributes(&attrs, frame.data(), frame.size(), NULL), 0);
+    ASSERT_EQ(odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, &counter), packLen);
+    EXPECT_EQ(counter, 8);
+    ASSERT_EQ(odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, &counter), systemLen);
+    EXPECT_EQ(counter, 9);
+    EXPECT_EQ(memcmp(pack, system, systemLen), 0);
+    EXPECT_EQ(odid_wifi_nan_next_message_pack(&attrs, NULL, &pack, &counter), 0);
+
+    // The messages of both service descriptors are decoded
+    ASSERT_EQ(odid_wifi_receive_message_pack_nan_action_frame(&rx, sa, frame.data(), frame.size()), 0);
+    EXPECT_STREQ(rx.SelfID.Desc, "Survey flight");
+    EXPECT_TRUE(rx.LocationValid);
+    EXPECT_TRUE(rx.SystemValid);
+    EXPECT_NEAR(rx.System.OperatorLatitude, 51.4780, 1e-6);
+
+    // Attributes and service info that do not fit
+    EXPECT_EQ(odid_wifi_receive_message_pack_nan_action_frame(&rx, sa, frame.data(), frame.size() - 9),
+              -EINVAL);
+    std::vector<uint8_t> truncated(built, built + 24 + 6);
+    std::vector<uint8_t> body = serviceDescriptor(odidServiceId, 0x10, 0, system, systemLen);
+    body.resize(body.size() - 25);
+    appendAttribute(truncated, 0x03, body);
+    EXPECT_EQ(odid_wifi_receive_message_pack_nan_action_frame(&rx, sa, truncated.data(), truncated.size()),
+              -EINVAL);
+    body[9] = (uint8_t) (body.size() - 10 + 1);
+    truncated.resize(24 + 6);
+    appendAttribute(truncated, 0x03, body);
+    EXPECT_EQ(odid_wifi_receive_message_pack_nan_action_frame(&rx, sa, truncated.data(), truncated.size()),
+              -EINVAL);
+
+    // Frames without ODID service descriptor and other frames
+    EXPECT_EQ(odid_wifi_receive_message_pack_nan_action_frame(&rx, sa, built, 24 + 6), -EINVAL);
+    frame[24 + 5] = 0x14;
+    EXPECT_EQ(odid_wifi_nan_action_frame_attributes(&attrs, frame.data(), frame.size(), NULL), -EINVAL);
+    len = odid_wifi_build_nan_sync_beacon_frame(mac, built, sizeof(built));
+    EXPECT_EQ(odid_wifi_nan_action_frame_attributes(&attrs, built, len, NULL), -EINVAL);
+}
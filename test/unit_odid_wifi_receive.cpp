@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <opendroneid.h>
+
+#include <cerrno>
+#include <cstring>
+
+static const char mac[6] = { 0x02, 0x00, 0x5E, 0x10, 0x00, 0x01 };
+
+static FRDID_UAS_Data frdidData()
+{
+    FRDID_UAS_Data uas;
+    uas.Identifier = "ABC00000000000000000000001234";
+    uas.ANSICTA2063Identifier = "1596F0123456789ABCDE";
+    uas.Latitude = 48.8584;
+    uas.Longitude = 2.2945;
+    uas.Altitude = 120;
+    uas.Height = 80;
+    uas.TakeoffLatitude = 48.8580;
+    uas.TakeoffLongitude = 2.2940;
+    uas.HorizontalSpeed = 12;
+    uas.TrueCourse = 215;
+    return uas;
+}
+
+TEST(ODID, frdid_decode)
+{
+    FRDID_UAS_Data uas = frdidData(), decoded;
+    char identifier[FRDID_ID_SIZE + 1], ansi[ODID_ID_SIZE + 1];
+    uint8_t buf[256];
+
+    int len = frdid_build(&uas, buf, sizeof(buf));
+    ASSERT_GT(len, 0);
+    ASSERT_EQ(frdid_decode(&decoded, identifier, ansi, buf, len), len);
+    EXPECT_STREQ(decoded.Identifier, uas.Identifier);
+    EXPECT_STREQ(decoded.ANSICTA2063Identifier, uas.ANSICTA2063Identifier);
+    EXPECT_NEAR(decoded.Latitude, uas.Latitude, 1e-5);
+    EXPECT_NEAR(decoded.Longitude, uas.Longitude, 1e-5);
+    EXPECT_EQ(decoded.Altitude, uas.Altitude);
+    EXPECT_EQ(decoded.Height, uas.Height);
+    EXPECT_NEAR(decoded.TakeoffLatitude, uas.TakeoffLatitude, 1e-5);
+    EXPECT_NEAR(decoded.TakeoffLongitude, uas.TakeoffLongitude, 1e-5);
+    EXPECT_EQ(decoded.HorizontalSpeed, uas.HorizontalSpeed);
+    EXPECT_EQ(decoded.TrueCourse, uas.TrueCourse);
+
+    // Fields left out by frdid_build() and negative values
+    uas.Identifier = NULL;
+    uas.Altitude = -12;
+    uas.Height = INV_ALT;
+    uas.TakeoffLatitude = uas.TakeoffLongitude = 0;
+    uas.TrueCourse = INV_DIR;
+    len = frdid_build(&uas, buf, sizeof(buf));
+    ASSERT_EQ(frdid_decode(&decoded, NULL, ansi, buf, len), len);
+    EXPECT_EQ(decoded.Identifier, nullptr);
+    EXPECT_EQ(decoded.Altitude, -12);
+    EXPECT_EQ(decoded.Height, INV_ALT);
+    EXPECT_EQ(decoded.TakeoffLatitude, 0);
+    EXPECT_EQ(decoded.TrueCourse, INV_DIR);
+
+    // ANSI/CTA-2063 identifiers longer than ODID_ID_SIZE are truncated
+    uas.ANSICTA2063Identifier = "1596F0123456789ABCDEFGHIJ";
+    len = frdid_build(&uas, buf, sizeof(buf));
+    ASSERT_EQ(frdid_decode(&decoded, NULL, ansi, buf, len), len);
+    EXPECT_STREQ(decoded.ANSICTA2063Identifier, "1596F0123456789ABCDE");
+
+    // Truncated TLVs, wrong lengths and versions
+    EXPECT_EQ(frdid_decode(&decoded, NULL, ansi, buf, len - 1), -EINVAL);
+    const uint8_t badLength[] = { 0x01, 0x01, 0x01, 0x06, 0x01, 0x10 };
+    EXPECT_EQ(frdid_decode(&decoded, NULL, ansi, badLength, sizeof(badLength)), -EINVAL);
+    const uint8_t noVersion[] = { 0x0a, 0x01, 0x10 };
+    EXPECT_EQ(frdid_decode(&decoded, NULL, ansi, noVersion, sizeof(noVersion)), -EINVAL);
+    const uint8_t laterType[] = { 0x01, 0x01, 0x01, 0x20, 0x02, 0x00, 0x00, 0x0a, 0x01, 0x10 };
+    ASSERT_EQ(frdid_decode(&decoded, NULL, ansi, laterType, sizeof(laterType)), (int) sizeof(laterType));
+    EXPECT_EQ(decoded.HorizontalSpeed, 16);
+}
+
+TEST(ODID, wifi_receive_frame)
+{
+    ODID_UAS_Data uas;
+    odid_initUasData(&uas);
+    uas.BasicID[0].IDType = ODID_IDTYPE_SERIAL_NUMBER;
+    strcpy(uas.BasicID[0].UASID, "1596F0123456789ABCDE");
+    uas.BasicIDValid[0] = 1;
+    uas.Location.Status = ODID_STATUS_AIRBORNE;
+    uas.Location.Latitude = 51.4791;
+    uas.LocationValid = 1;
+
+    ODID_Wifi_received rx;
+    uint8_t frame[512];
+    int len = odid_wifi_build_message_pack_nan_action_frame(&uas, mac, 3, frame, sizeof(frame));
+    ASSERT_EQ(odid_wifi_receive_frame(&rx, frame, len), ODID_WIFI_PROTOCOL_NAN);
+    EXPECT_EQ(rx.Protocol, ODID_WIFI_PROTOCOL_NAN);
+    EXPECT_EQ(memcmp(rx.Mac, mac, sizeof(mac)), 0);
+    EXPECT_EQ(rx.Counter, 3);
+    EXPECT_STREQ(rx.UAS_Data.BasicID[0].UASID, "1596F0123456789ABCDE");
+    EXPECT_NEAR(rx.UAS_Data.Location.Latitude, 51.4791, 1e-6);
+
+    len = odid_wifi_build_message_pack_beacon_frame(&uas, mac, "RID", 3, 100, 4, frame, sizeof(frame));
+    ASSERT_EQ(odid_wifi_receive_frame(&rx, frame, len), ODID_WIFI_PROTOCOL_BEACON);
+    EXPECT_EQ(rx.Counter, 4);
+    EXPECT_NEAR(rx.UAS_Data.Location.Latitude, 51.4791, 1e-6);
+
+    FRDID_UAS_Data frdid = frdidData();
+    len = frdid_wifi_build_beacon_frame(&frdid, mac, "FR", 2, 100, frame, sizeof(frame));
+    ASSERT_EQ(odid_wifi_receive_frame(&rx, frame, len), ODID_WIFI_PROTOCOL_FRDID);
+    EXPECT_EQ(memcmp(rx.Mac, mac, sizeof(mac)), 0);
+    EXPECT_STREQ(rx.FRDID.Identifier, frdid.Identifier);
+    EXPECT_EQ(rx.FRDID.Height, 80);
+    // The fields with an ODID equivalent
+    EXPECT_TRUE(rx.UAS_Data.BasicIDValid[0]);
+    EXPECT_STREQ(rx.UAS_Data.BasicID[0].UASID, frdid.ANSICTA2063Identifier);
+    EXPECT_TRUE(rx.UAS_Data.LocationValid);
+    EXPECT_NEAR(rx.UAS_Data.Location.Latitude, 48.8584, 1e-5);
+    EXPECT_EQ(rx.UAS_Data.Location.AltitudeGeo, 120);
+    EXPECT_EQ(rx.UAS_Data.Location.Height, 80);
+    EXPECT_EQ(rx.UAS_Data.Location.HeightType, ODID_HEIGHT_REF_OVER_TAKEOFF);
+    EXPECT_EQ(rx.UAS_Data.Location.SpeedHorizontal, 12);
+    EXPECT_EQ(rx.UAS_Data.Location.Direction, 215);
+    EXPECT_TRUE(rx.UAS_Data.SystemValid);
+    EXPECT_NEAR(rx.UAS_Data.System.OperatorLatitude, 48.8580, 1e-5);
+    EXPECT_EQ(rx.UAS_Data.System.OperatorLocationType, ODID_OPERATOR_LOCATION_TYPE_TAKEOFF);
+
+    // A malformed FRDID element
+    frame[len - 1] = 0x05;
+    EXPECT_EQ(odid_wifi_receive_frame(&rx, frame, len - 1), -EINVAL);
+
+    // Frames of no remote ID protocol: a beacon of an access point, another
+    // action frame, a data frame
+    len = odid_wifi_build_message_pack_beacon_frame(&uas, mac, "AP", 2, 100, 0, frame, sizeof(frame));
+    frame[24 + 12 + 2 + 2 + 3 + 2] = 0x50;
+    EXPECT_EQ(odid_wifi_receive_frame(&rx, frame, len), ODID_WIFI_PROTOCOL_NONE);
+    EXPECT_EQ(rx.Protocol, ODID_WIFI_PROTOCOL_NONE);
+    len = odid_wifi_build_message_pack_nan_action_frame(&uas, mac, 0, frame, sizeof(frame));
+    frame[24] = 0x05;
+    EXPECT_EQ(odid_wifi_receive_frame(&rx, frame, len), ODID_WIFI_PROTOCOL_NONE);
+    frame[0] = 0x08;
+    EXPECT_EQ(odid_wifi_receive_frame(&rx, frame, len), ODID_WIFI_PROTOCOL_NONE);
+    EXPECT_EQ(odid_wifi_receive_frame(&rx, frame, 10), -EINVAL);
+}